@@ -0,0 +1,1785 @@
+// Descrição: Implementação do backend nulo de LeanDX12 (LeanDX12Null.h).
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "LeanDX12NullInternal.h"
+#include "../Extensions/LeanDX12Format.h"
+
+namespace
+{
+	const char* const callNames[NULL_CALL_TYPE_COUNT] =
+	{
+		"GetAdapters", "GetHighestPerformanceAdapter", "GetAdapterDesc", "CreateDevice", "ReleaseDevice", "ReleaseAdapter",
+		"CreateBuffer", "DeleteBuffer", "CreateTexture", "DeleteTexture", "CreateRenderTarget", "DeleteRenderTarget",
+		"GetPrivateData", "SetPrivateData", "ReadbackData", "UploadData", "SetActiveMipLevel", "GetBufferDesc", "GetTextureDesc",
+		"MoveDescriptor", "GetDescriptorOffsetFromTableStart", "MapDescriptorTableOffsetToBaseRegister",
+		"InitBlendState", "InitRasterizerState", "InitDepthStencilState", "SetBlendState", "SetRasterizerState", "SetDepthStencilState",
+		"CreateInputLayout", "CreateRootSignature", "LoadShaderFromFile", "CreateGraphicsPipelineState",
+		"BeginScene", "EndScene", "SetRenderTarget", "Clear", "SetViewports", "SetScissorRects", "RenderFrame", "WaitForGPU",
+		"SetPrimitiveTopology", "SetVertexData", "SetInstanceData", "SetIndexData", "DrawInstanced", "DrawIndexedInstanced",
+		"Set32bitConstants", "ResolveTexture", "TexelSize", "SaveAsPNG", "LoadWavefrontOBJ"
+	};
+
+	const unsigned int rowPitchAlignment = 256;
+
+	// Registra a chamada e contabiliza os erros de validação. Retorna result.
+	LeanDX12Result Record(NULL_CALL_TYPE type, LeanDX12Result result,
+		unsigned long long argument0 = 0, unsigned long long argument1 = 0, unsigned long long argument2 = 0, unsigned long long argument3 = 0)
+	{
+		NULL_DEVICE& device = GetNullDevice();
+		device.stats.numCalls++;
+
+		if (result != LEANDX12_OK && result < LEANDX12_INFO_REQUIRED_ARRAY_LENGTH)
+		{
+			device.stats.numValidationErrors++;
+			device.stats.lastError = result;
+			device.stats.lastErrorCall = type;
+		}
+
+		if (device.recordCalls)
+		{
+			NULL_CALL call = { type, result, { argument0, argument1, argument2, argument3 } };
+			device.calls.push_back(call);
+		}
+
+		return result;
+	}
+
+	bool IsValidFeatureLevel(const char* featureLevel)
+	{
+		const char* featureLevels[] = { "11.0", "11.1", "12.0", "12.1", "12.2" };
+		for (const char* level : featureLevels)
+			if (strcmp(featureLevel, level) == 0)
+				return true;
+		return false;
+	}
+
+	bool IsDepthFormat(RESOURCE_FORMAT format)
+	{
+		return format == RESOURCE_FORMAT_D32_FLOAT || format == RESOURCE_FORMAT_D24_UNORM_S8_UINT || format == RESOURCE_FORMAT_D32_FLOAT_S8X24_UINT;
+	}
+
+	bool IsColorFormat(RESOURCE_FORMAT format)
+	{
+		return format != RESOURCE_FORMAT_UNKNOWN && !IsDepthFormat(format) && TexelSize(format) != 0;
+	}
+
+	unsigned int MipDimension(unsigned int dimension, unsigned short mipLevel)
+	{
+		unsigned int result = dimension >> mipLevel;
+		return result > 0 ? result : 1;
+	}
+
+	// Tamanho de um buffer de envio ou de leitura com linhas alinhadas a 256 bytes (a última linha não é completada).
+	unsigned long long FootprintSize(unsigned int texelSize, unsigned int width, unsigned int height, unsigned int depth, unsigned long long* rowPitch)
+	{
+		unsigned long long rowSize = (unsigned long long)texelSize * width;
+		unsigned long long pitch = (rowSize + rowPitchAlignment - 1) / rowPitchAlignment * rowPitchAlignment;
+		if (rowPitch != nullptr)
+			*rowPitch = pitch;
+		return pitch * ((unsigned long long)height * depth - 1) + rowSize;
+	}
+
+	unsigned long long TextureMemory(const Texture* texture)
+	{
+		unsigned long long memory = 0;
+		for (const std::vector<unsigned char>& mip : texture->mips)
+			memory += mip.size();
+		return memory + texture->depthData.size() * sizeof(float) + texture->stencilData.size();
+	}
+
+	// Copia os texels de um nível da textura para um buffer com linhas alinhadas (ou no sentido contrário).
+	void CopyFootprint(Texture* texture, unsigned short mipLevel, unsigned char* pBufferData, bool toBuffer)
+	{
+		unsigned int width = MipDimension(texture->width, mipLevel);
+		unsigned int rows = MipDimension(texture->height, mipLevel) * MipDimension(texture->depth, mipLevel);
+		unsigned long long rowPitch;
+		FootprintSize(texture->texelSize, width, 1, 1, &rowPitch);
+
+		size_t rowSize = (size_t)texture->texelSize * width;
+		unsigned char* pTexels = texture->mips[mipLevel].data();
+		for (unsigned int row = 0; row < rows; row++)
+		{
+			if (toBuffer)
+				memcpy(pBufferData + row * rowPitch, pTexels + row * rowSize, rowSize);
+			else
+				memcpy(pTexels + row * rowSize, pBufferData + row * rowPitch, rowSize);
+		}
+	}
+
+	void AddResource(unsigned long long memory)
+	{
+		NULL_DEVICE& device = GetNullDevice();
+		device.stats.numResources++;
+		device.stats.resourceMemory += memory;
+	}
+
+	void RemoveResource(unsigned long long memory)
+	{
+		NULL_DEVICE& device = GetNullDevice();
+		device.stats.numResources--;
+		device.stats.resourceMemory -= memory;
+	}
+
+	// Assim como na escrita de um descritor do Direct3D 12, o recurso anterior perde a posição.
+	void BindDescriptor(unsigned int offset, Buffer* buffer, Texture* texture)
+	{
+		NULL_DESCRIPTOR descriptor = { buffer, texture };
+		GetNullDevice().descriptors[offset] = descriptor;
+	}
+
+	void UnbindDescriptor(unsigned int offset, const void* resource)
+	{
+		NULL_DEVICE& device = GetNullDevice();
+		auto it = device.descriptors.find(offset);
+		if (it != device.descriptors.end() && (it->second.buffer == resource || it->second.texture == resource))
+			device.descriptors.erase(it);
+	}
+
+	LeanDX12Result MoveResourceDescriptor(unsigned int* descriptorOffset, Buffer* buffer, Texture* texture, unsigned int newOffset, BOOLEAN* swap)
+	{
+		NULL_DEVICE& device = GetNullDevice();
+		auto it = device.descriptors.find(newOffset);
+		bool occupied = it != device.descriptors.end() && (buffer != nullptr ? it->second.buffer != buffer : it->second.texture != texture);
+
+		if (occupied && (swap == NULL || *swap == 0))
+			return LEANDX12_ERROR_DESCRIPTOR_TABLE_OFFSET_CONFLICT;
+
+		NULL_DESCRIPTOR other = occupied ? it->second : NULL_DESCRIPTOR();
+		unsigned int oldOffset = *descriptorOffset;
+		UnbindDescriptor(oldOffset, buffer != nullptr ? (const void*)buffer : (const void*)texture);
+
+		if (occupied)
+		{
+			if (other.buffer != nullptr)
+				other.buffer->descriptorOffset = oldOffset;
+			else
+				other.texture->descriptorOffset = oldOffset;
+			device.descriptors[oldOffset] = other;
+		}
+
+		BindDescriptor(newOffset, buffer, texture);
+		*descriptorOffset = newOffset;
+		return LEANDX12_OK;
+	}
+
+	bool IsValidBlendFactor(BLEND_FACTOR factor)
+	{
+		return factor >= BLEND_FACTOR_ZERO && factor <= BLEND_FACTOR_INV_SRC1_ALPHA && factor != 12 && factor != 13;
+	}
+
+	bool IsValidStencilOperation(STENCIL_OPERATION operation)
+	{
+		return operation >= STENCIL_OPERATION_KEEP && operation <= STENCIL_OPERATION_DECR;
+	}
+
+	bool IsValidComparison(COMPARISON_FUNC func)
+	{
+		return func >= COMPARISON_FUNC_NEVER && func <= COMPARISON_FUNC_ALWAYS;
+	}
+
+	PRIMITIVE_TOPOLOGY_TYPE TopologyType(PRIMITIVE_TOPOLOGY topology)
+	{
+		switch (topology)
+		{
+		case PRIMITIVE_TOPOLOGY_POINTLIST:
+			return PRIMITIVE_TOPOLOGY_TYPE_POINT;
+		case PRIMITIVE_TOPOLOGY_LINELIST:
+		case PRIMITIVE_TOPOLOGY_LINESTRIP:
+		case PRIMITIVE_TOPOLOGY_LINELIST_ADJ:
+		case PRIMITIVE_TOPOLOGY_LINESTRIP_ADJ:
+			return PRIMITIVE_TOPOLOGY_TYPE_LINE;
+		case PRIMITIVE_TOPOLOGY_TRIANGLELIST:
+		case PRIMITIVE_TOPOLOGY_TRIANGLESTRIP:
+		case PRIMITIVE_TOPOLOGY_TRIANGLELIST_ADJ:
+		case PRIMITIVE_TOPOLOGY_TRIANGLESTRIP_ADJ:
+			return PRIMITIVE_TOPOLOGY_TYPE_TRIANGLE;
+		default:
+			if (topology >= PRIMITIVE_TOPOLOGY_1_CONTROL_POINT_PATCHLIST && topology <= PRIMITIVE_TOPOLOGY_32_CONTROL_POINT_PATCHLIST)
+				return PRIMITIVE_TOPOLOGY_TYPE_PATCH;
+			return (PRIMITIVE_TOPOLOGY_TYPE)0;
+		}
+	}
+
+	unsigned long long PrimitiveCount(PRIMITIVE_TOPOLOGY topology, unsigned int count)
+	{
+		switch (topology)
+		{
+		case PRIMITIVE_TOPOLOGY_POINTLIST: return count;
+		case PRIMITIVE_TOPOLOGY_LINELIST: return count / 2;
+		case PRIMITIVE_TOPOLOGY_LINESTRIP: return count > 1 ? count - 1 : 0;
+		case PRIMITIVE_TOPOLOGY_TRIANGLELIST: return count / 3;
+		case PRIMITIVE_TOPOLOGY_TRIANGLESTRIP: return count > 2 ? count - 2 : 0;
+		case PRIMITIVE_TOPOLOGY_LINELIST_ADJ: return count / 4;
+		case PRIMITIVE_TOPOLOGY_LINESTRIP_ADJ: return count > 3 ? count - 3 : 0;
+		case PRIMITIVE_TOPOLOGY_TRIANGLELIST_ADJ: return count / 6;
+		case PRIMITIVE_TOPOLOGY_TRIANGLESTRIP_ADJ: return count > 5 ? (count - 4) / 2 : 0;
+		default: return count / (topology - PRIMITIVE_TOPOLOGY_1_CONTROL_POINT_PATCHLIST + 1);
+		}
+	}
+
+	void ResetSceneState(NULL_DEVICE& device)
+	{
+		device.pipelineState = nullptr;
+		device.renderTarget = nullptr;
+		device.numViewports = 0;
+		device.numScissorRects = 0;
+		device.primitiveTopology = PRIMITIVE_TOPOLOGY_UNDEFINED;
+		device.vertexDataSet = false;
+		device.instanceDataSet = false;
+		device.indexDataSet = false;
+		device.descriptorTableBase = 0;
+		memset(device.rootConstants, 0, sizeof(device.rootConstants));
+	}
+
+	LeanDX12Result ValidateDraw(NULL_DEVICE& device, const NULL_DRAW_DESC* draw)
+	{
+		if (!device.inScene)
+			return LEANDX12_ERROR_INVALID_CALL;
+
+		if (device.renderTarget == nullptr)
+			return LEANDX12_ERROR_NO_RENDER_TARGET_SELECTED;
+
+		const PipelineState* pipelineState = device.pipelineState;
+		if (device.renderTarget->format != pipelineState->renderTargetFormat)
+			return LEANDX12_ERROR_RESOURCE_FORMATS_NOT_SAME;
+
+		if (device.numViewports == 0 || device.numScissorRects == 0 || device.primitiveTopology == PRIMITIVE_TOPOLOGY_UNDEFINED)
+			return LEANDX12_ERROR_INVALID_CALL;
+
+		const InputLayout& inputLayout = pipelineState->inputLayout;
+		unsigned long long numVertices = device.vertexDataSet ? device.vertexData.size() / device.vertexStride : 0;
+		if (!inputLayout.vertexElements.empty() && !device.vertexDataSet)
+			return LEANDX12_ERROR_INVALID_CALL;
+
+		if (!inputLayout.instanceElements.empty() && draw->instanceCount > 0)
+		{
+			if (!device.instanceDataSet)
+				return LEANDX12_ERROR_INVALID_CALL;
+
+			unsigned long long numInstances = device.instanceData.size() / device.instanceStride;
+			unsigned long long lastInstance = draw->startInstanceLocation + (unsigned long long)(draw->instanceCount - 1) / device.instanceStepRate;
+			if (lastInstance >= numInstances)
+				return LEANDX12_ERROR_OFFSET_OUT_OF_RANGE;
+		}
+
+		if (draw->countPerInstance == 0)
+			return LEANDX12_OK;
+
+		if (draw->indexed)
+		{
+			if (!device.indexDataSet)
+				return LEANDX12_ERROR_INVALID_CALL;
+
+			if ((unsigned long long)draw->startLocation + draw->countPerInstance > device.indexData.size())
+				return LEANDX12_ERROR_OFFSET_OUT_OF_RANGE;
+
+			if (!inputLayout.vertexElements.empty())
+			{
+				const unsigned int* pIndices = device.indexData.data() + draw->startLocation;
+				unsigned int maxIndex = *std::max_element(pIndices, pIndices + draw->countPerInstance);
+				if ((unsigned long long)maxIndex + draw->baseVertexLocation >= numVertices)
+					return LEANDX12_ERROR_OFFSET_OUT_OF_RANGE;
+			}
+		}
+		else if (!inputLayout.vertexElements.empty() && (unsigned long long)draw->startLocation + draw->countPerInstance > numVertices)
+			return LEANDX12_ERROR_OFFSET_OUT_OF_RANGE;
+
+		return LEANDX12_OK;
+	}
+
+	void Draw(NULL_CALL_TYPE callType, const NULL_DRAW_DESC* draw)
+	{
+		NULL_DEVICE& device = GetNullDevice();
+		LeanDX12Result result = ValidateDraw(device, draw);
+
+		if (result == LEANDX12_OK && TopologyType(device.primitiveTopology) != device.pipelineState->primitiveTopologyType)
+		{
+			// Incompatível com o pipeline, mas executado pelo Direct3D 12 sem a camada de depuração (LDX12VirtualCamera desenha o eixo
+			// com PRIMITIVE_TOPOLOGY_LINELIST em um pipeline de triângulos). O erro é contabilizado e o desenho é executado.
+			Record(callType, LEANDX12_ERROR_INVALID_CALL, draw->countPerInstance, draw->instanceCount, draw->startLocation, draw->startInstanceLocation);
+		}
+		else
+		{
+			Record(callType, result, draw->countPerInstance, draw->instanceCount, draw->startLocation, draw->startInstanceLocation);
+			if (result != LEANDX12_OK)
+				return;
+		}
+
+		device.stats.numDraws++;
+		if (draw->indexed)
+			device.stats.numIndexedDraws++;
+		device.stats.numInstances += draw->instanceCount;
+		device.stats.numVertices += (unsigned long long)draw->countPerInstance * draw->instanceCount;
+		device.stats.numPrimitives += PrimitiveCount(device.primitiveTopology, draw->countPerInstance) * draw->instanceCount;
+
+		if (device.hooks.Draw != nullptr && draw->countPerInstance > 0 && draw->instanceCount > 0)
+			device.hooks.Draw(draw, device.hooks.pUserData);
+	}
+
+	template <typename T>
+	T* CreatePipelineObject()
+	{
+		std::shared_ptr<T> object = std::make_shared<T>();
+		GetNullDevice().pipelineObjects.push_back(object);
+		return object.get();
+	}
+
+	bool ValidateInputElements(unsigned int numElements, const INPUT_ELEMENT_DESC* pElements, bool instanceData,
+		std::vector<NULL_INPUT_ELEMENT>* elements, unsigned int* size, LeanDX12Result* result)
+	{
+		*size = 0;
+		if (numElements > 0 && pElements == NULL)
+		{
+			*result = LEANDX12_ERROR_INVALID_CALL;
+			return false;
+		}
+
+		for (unsigned int i = 0; i < numElements; i++)
+		{
+			const INPUT_ELEMENT_DESC& desc = pElements[i];
+			if (desc.SemanticName == NULL || !IsColorFormat(desc.Format))
+			{
+				*result = LEANDX12_ERROR_INVALID_CALL;
+				return false;
+			}
+
+			if ((desc.InstanceDataStepRate != 0) != instanceData)
+			{
+				*result = LEANDX12_INVALID_STEP_RATE;
+				return false;
+			}
+
+			NULL_INPUT_ELEMENT element = { desc.SemanticName, desc.SemanticIndex, desc.Format, *size, desc.InstanceDataStepRate };
+			elements->push_back(element);
+			*size += TexelSize(desc.Format);
+		}
+
+		return true;
+	}
+
+	// PNG sem compressão (blocos "stored" do deflate).
+	unsigned int Crc32(unsigned int crc, const unsigned char* pData, size_t size)
+	{
+		static unsigned int table[256];
+		if (table[1] == 0)
+		{
+			for (unsigned int i = 0; i < 256; i++)
+			{
+				unsigned int value = i;
+				for (int bit = 0; bit < 8; bit++)
+					value = (value & 1) ? 0xEDB88320u ^ (value >> 1) : value >> 1;
+				table[i] = value;
+			}
+		}
+
+		crc = ~crc;
+		for (size_t i = 0; i < size; i++)
+			crc = table[(crc ^ pData[i]) & 0xFF] ^ (crc >> 8);
+		return ~crc;
+	}
+
+	void AppendBigEndian(std::vector<unsigned char>& data, unsigned int value)
+	{
+		data.push_back((unsigned char)(value >> 24));
+		data.push_back((unsigned char)(value >> 16));
+		data.push_back((unsigned char)(value >> 8));
+		data.push_back((unsigned char)value);
+	}
+
+	void AppendChunk(std::vector<unsigned char>& png, const char* type, const std::vector<unsigned char>& chunkData)
+	{
+		AppendBigEndian(png, (unsigned int)chunkData.size());
+		size_t typeStart = png.size();
+		png.insert(png.end(), type, type + 4);
+		png.insert(png.end(), chunkData.begin(), chunkData.end());
+		AppendBigEndian(png, Crc32(0, png.data() + typeStart, png.size() - typeStart));
+	}
+
+	// Índice de um vértice de uma face do arquivo .obj (iniciados em 1 ou negativos, relativos ao fim da lista).
+	unsigned int ObjIndex(const char* token, size_t count)
+	{
+		long index = strtol(token, NULL, 10);
+		if (index > 0)
+			return (unsigned int)(index - 1);
+		if (index < 0 && (size_t)(-index) <= count)
+			return (unsigned int)(count + index);
+		return 0xFFFFFFFFu;
+	}
+}
+
+NULL_DEVICE& GetNullDevice()
+{
+	static NULL_DEVICE device = NULL_DEVICE();
+	return device;
+}
+
+void SetNullBackendHooks(const NULL_BACKEND_HOOKS* hooks)
+{
+	NULL_DEVICE& device = GetNullDevice();
+	if (hooks != nullptr)
+		device.hooks = *hooks;
+	else
+		memset(&device.hooks, 0, sizeof(NULL_BACKEND_HOOKS));
+}
+
+const void* GetNullConstantRegister(unsigned int shaderRegister)
+{
+	NULL_DEVICE& device = GetNullDevice();
+	if (device.pipelineState == nullptr)
+		return NULL;
+
+	const RootSignature& rootSignature = device.pipelineState->rootSignature;
+	unsigned int numRootConstants = (unsigned int)rootSignature.num32bitValues.size();
+	if (shaderRegister < numRootConstants)
+	{
+		unsigned int offset = 0;
+		for (unsigned int i = 0; i < shaderRegister; i++)
+			offset += rootSignature.num32bitValues[i];
+		return device.rootConstants + offset;
+	}
+
+	if (shaderRegister - numRootConstants >= rootSignature.numConstantBuffers)
+		return NULL;
+
+	auto it = device.descriptors.find(device.descriptorTableBase + shaderRegister - numRootConstants);
+	if (it == device.descriptors.end() || it->second.buffer == nullptr)
+		return NULL;
+
+	return it->second.buffer->data.data();
+}
+
+const NULL_DESCRIPTOR* GetNullShaderResourceRegister(unsigned int shaderRegister)
+{
+	NULL_DEVICE& device = GetNullDevice();
+	if (device.pipelineState == nullptr || shaderRegister >= device.pipelineState->rootSignature.numShaderResources)
+		return NULL;
+
+	auto it = device.descriptors.find(device.descriptorTableBase + device.pipelineState->rootSignature.numConstantBuffers + shaderRegister);
+	return it != device.descriptors.end() ? &it->second : NULL;
+}
+
+void EnsureNullDepthStencil(Texture* renderTarget)
+{
+	if (!renderTarget->depthData.empty())
+		return;
+
+	size_t numTexels = (size_t)renderTarget->width * renderTarget->height;
+	renderTarget->depthData.assign(numTexels, 1.0f);
+	renderTarget->stencilData.assign(numTexels, 0);
+	GetNullDevice().stats.resourceMemory += numTexels * (sizeof(float) + 1);
+}
+
+// ------------------------------------------------------------ Adaptador de vídeo --------------------------------------------------------- //
+
+LeanDX12Result GetAdapters(const char* featureLevel, unsigned int* numHardwareAdapters, DisplayAdapter** pHardwareAdapter, unsigned int* numSoftwareAdapters, DisplayAdapter** pSoftwareAdapter)
+{
+	if (featureLevel == NULL)
+		return Record(NULL_CALL_GET_ADAPTERS, LEANDX12_ERROR_INVALID_CALL);
+	if (!IsValidFeatureLevel(featureLevel))
+		return Record(NULL_CALL_GET_ADAPTERS, LEANDX12_ERROR_FEATURE_LEVEL_NOT_SUPPORTED);
+
+	// O backend nulo possui apenas um adaptador de software.
+	if (numHardwareAdapters != NULL)
+		*numHardwareAdapters = 0;
+	if (numSoftwareAdapters != NULL)
+		*numSoftwareAdapters = 1;
+
+	if (pSoftwareAdapter == NULL)
+		return Record(NULL_CALL_GET_ADAPTERS, LEANDX12_INFO_REQUIRED_ARRAY_LENGTH);
+
+	(void)pHardwareAdapter;
+	return Record(NULL_CALL_GET_ADAPTERS, GetHighestPerformanceAdapter(featureLevel, &pSoftwareAdapter[0]));
+}
+
+LeanDX12Result GetHighestPerformanceAdapter(const char* featureLevel, DisplayAdapter** adapter)
+{
+	if (featureLevel == NULL || adapter == NULL)
+		return Record(NULL_CALL_GET_HIGHEST_PERFORMANCE_ADAPTER, LEANDX12_ERROR_INVALID_CALL);
+	if (!IsValidFeatureLevel(featureLevel))
+		return Record(NULL_CALL_GET_HIGHEST_PERFORMANCE_ADAPTER, LEANDX12_ERROR_FEATURE_LEVEL_NOT_SUPPORTED);
+
+	DisplayAdapter* newAdapter = new DisplayAdapter;
+	memset(&newAdapter->desc, 0, sizeof(ADAPTER_DESC));
+	strcpy(newAdapter->desc.Description, "LeanDX12 Null Adapter");
+
+	*adapter = newAdapter;
+	return Record(NULL_CALL_GET_HIGHEST_PERFORMANCE_ADAPTER, LEANDX12_OK);
+}
+
+LeanDX12Result GetAdapterDesc(DisplayAdapter* adapter, ADAPTER_DESC* adapterDesc)
+{
+	if (adapter == NULL || adapterDesc == NULL)
+		return Record(NULL_CALL_GET_ADAPTER_DESC, LEANDX12_ERROR_INVALID_CALL);
+
+	*adapterDesc = adapter->desc;
+	return Record(NULL_CALL_GET_ADAPTER_DESC, LEANDX12_OK);
+}
+
+LeanDX12Result CreateDevice(DisplayAdapter* adapter, const char* featureLevel)
+{
+	NULL_DEVICE& device = GetNullDevice();
+	if (adapter == NULL || featureLevel == NULL || device.deviceCreated)
+		return Record(NULL_CALL_CREATE_DEVICE, LEANDX12_ERROR_INVALID_CALL);
+	if (!IsValidFeatureLevel(featureLevel))
+		return Record(NULL_CALL_CREATE_DEVICE, LEANDX12_ERROR_FEATURE_LEVEL_NOT_SUPPORTED);
+
+	device.deviceCreated = true;
+	device.inScene = false;
+	device.lastPipelineState = nullptr;
+	ResetSceneState(device);
+	return Record(NULL_CALL_CREATE_DEVICE, LEANDX12_OK);
+}
+
+void ReleaseDevice()
+{
+	NULL_DEVICE& device = GetNullDevice();
+	Record(NULL_CALL_RELEASE_DEVICE, device.deviceCreated && !device.inScene ? LEANDX12_OK : LEANDX12_ERROR_INVALID_CALL);
+
+	device.deviceCreated = false;
+	device.inScene = false;
+	device.lastPipelineState = nullptr;
+	ResetSceneState(device);
+	device.pipelineObjects.clear();
+}
+
+void ReleaseAdapter(DisplayAdapter* adapter)
+{
+	Record(NULL_CALL_RELEASE_ADAPTER, adapter != NULL ? LEANDX12_OK : LEANDX12_ERROR_INVALID_CALL);
+	delete adapter;
+}
+
+// -------------------------------------------------------- Criação e exclusão de recursos ------------------------------------------------ //
+
+LeanDX12Result CreateBuffer(unsigned long long sizeInBytes, BUFFER_TYPE bufferType, Buffer** buffer, unsigned int offsetFromDescriptorTableStart, RESOURCE_FORMAT format, unsigned int numElements, unsigned int structureSize)
+{
+	if (!GetNullDevice().deviceCreated || buffer == NULL || sizeInBytes == 0 || bufferType > BUFFER_TYPE_READBACK)
+		return Record(NULL_CALL_CREATE_BUFFER, LEANDX12_ERROR_INVALID_CALL, sizeInBytes, bufferType, offsetFromDescriptorTableStart);
+
+	// Buffers estruturados (format = RESOURCE_FORMAT_UNKNOWN) precisam de numElements * structureSize bytes.
+	if (bufferType == BUFFER_TYPE_DEFAULT && format == RESOURCE_FORMAT_UNKNOWN && (unsigned long long)numElements * structureSize > sizeInBytes)
+		return Record(NULL_CALL_CREATE_BUFFER, LEANDX12_ERROR_INSUFFICIENT_BUFFER_SIZE, sizeInBytes, bufferType, offsetFromDescriptorTableStart);
+
+	Buffer* newBuffer = new Buffer;
+	newBuffer->type = bufferType;
+	newBuffer->data.assign((size_t)sizeInBytes, 0);
+	newBuffer->format = format;
+	newBuffer->numElements = numElements;
+	newBuffer->structureSize = structureSize;
+	newBuffer->descriptorOffset = offsetFromDescriptorTableStart;
+
+	if (bufferType == BUFFER_TYPE_DEFAULT)
+		BindDescriptor(offsetFromDescriptorTableStart, newBuffer, nullptr);
+
+	AddResource(sizeInBytes);
+	*buffer = newBuffer;
+	return Record(NULL_CALL_CREATE_BUFFER, LEANDX12_OK, sizeInBytes, bufferType, offsetFromDescriptorTableStart);
+}
+
+LeanDX12Result DeleteBuffer(Buffer* buffer)
+{
+	if (buffer == NULL)
+		return Record(NULL_CALL_DELETE_BUFFER, LEANDX12_ERROR_INVALID_CALL);
+
+	if (buffer->type == BUFFER_TYPE_DEFAULT)
+		UnbindDescriptor(buffer->descriptorOffset, buffer);
+
+	RemoveResource(buffer->data.size());
+	unsigned long long size = buffer->data.size();
+	delete buffer;
+	return Record(NULL_CALL_DELETE_BUFFER, LEANDX12_OK, size);
+}
+
+LeanDX12Result CreateTexture(unsigned int width, unsigned int height, unsigned int depth, unsigned short mipLevels, RESOURCE_FORMAT format, Texture** texture, unsigned int offsetFromDescriptorTableStart)
+{
+	if (!GetNullDevice().deviceCreated || texture == NULL || width == 0 || height == 0 || depth == 0 || !IsColorFormat(format))
+		return Record(NULL_CALL_CREATE_TEXTURE, LEANDX12_ERROR_INVALID_CALL, width, height, depth, mipLevels);
+
+	unsigned short maxMipLevels = 1;
+	for (unsigned int dimension = std::max(std::max(width, height), depth); dimension > 1; dimension >>= 1)
+		maxMipLevels++;
+
+	// mipLevels = 0 cria a cadeia completa de níveis.
+	if (mipLevels > maxMipLevels)
+		return Record(NULL_CALL_CREATE_TEXTURE, LEANDX12_ERROR_MIPLEVEL_NOT_FOUND, width, height, depth, mipLevels);
+	if (mipLevels == 0)
+		mipLevels = maxMipLevels;
+
+	Texture* newTexture = new Texture;
+	newTexture->isRenderTarget = false;
+	newTexture->width = width;
+	newTexture->height = height;
+	newTexture->depth = depth;
+	newTexture->mipLevels = mipLevels;
+	newTexture->activeMipLevel = 0;
+	newTexture->format = format;
+	newTexture->texelSize = TexelSize(format);
+	newTexture->sampleCount = 1;
+	newTexture->sampleQuality = 0;
+	memset(newTexture->clearColor, 0, sizeof(newTexture->clearColor));
+	newTexture->descriptorOffset = offsetFromDescriptorTableStart;
+
+	newTexture->mips.resize(mipLevels);
+	for (unsigned short mipLevel = 0; mipLevel < mipLevels; mipLevel++)
+	{
+		size_t mipSize = (size_t)newTexture->texelSize * MipDimension(width, mipLevel) * MipDimension(height, mipLevel) * MipDimension(depth, mipLevel);
+		newTexture->mips[mipLevel].assign(mipSize, 0);
+	}
+
+	BindDescriptor(offsetFromDescriptorTableStart, nullptr, newTexture);
+	AddResource(TextureMemory(newTexture));
+	*texture = newTexture;
+	return Record(NULL_CALL_CREATE_TEXTURE, LEANDX12_OK, width, height, depth, mipLevels);
+}
+
+LeanDX12Result DeleteTexture(Texture* texture)
+{
+	if (texture == NULL || texture->isRenderTarget)
+		return Record(NULL_CALL_DELETE_TEXTURE, LEANDX12_ERROR_INVALID_CALL);
+
+	UnbindDescriptor(texture->descriptorOffset, texture);
+	RemoveResource(TextureMemory(texture));
+	delete texture;
+	return Record(NULL_CALL_DELETE_TEXTURE, LEANDX12_OK);
+}
+
+LeanDX12Result CreateRenderTarget(unsigned int width, unsigned int height, RESOURCE_FORMAT format, const float colorRGBA[4], unsigned int sampleCount, unsigned int sampleQuality, Texture** renderTarget, unsigned int offsetFromDescriptorTableStart)
+{
+	if (!GetNullDevice().deviceCreated || renderTarget == NULL || width == 0 || height == 0 || !IsColorFormat(format) ||
+		sampleCount == 0 || sampleCount > 32 || (sampleCount & (sampleCount - 1)) != 0 || (sampleCount == 1 && sampleQuality != 0))
+		return Record(NULL_CALL_CREATE_RENDER_TARGET, LEANDX12_ERROR_INVALID_CALL, width, height, format, sampleCount);
+
+	Texture* newRenderTarget = new Texture;
+	newRenderTarget->isRenderTarget = true;
+	newRenderTarget->width = width;
+	newRenderTarget->height = height;
+	newRenderTarget->depth = 1;
+	newRenderTarget->mipLevels = 1;
+	newRenderTarget->activeMipLevel = 0;
+	newRenderTarget->format = format;
+	newRenderTarget->texelSize = TexelSize(format);
+	newRenderTarget->sampleCount = sampleCount;
+	newRenderTarget->sampleQuality = sampleQuality;
+	for (int i = 0; i < 4; i++)
+		newRenderTarget->clearColor[i] = colorRGBA != NULL ? colorRGBA[i] : 0.0f;
+	newRenderTarget->descriptorOffset = offsetFromDescriptorTableStart;
+
+	// Os render targets multiamostrados armazenam uma amostra por texel.
+	newRenderTarget->mips.resize(1);
+	newRenderTarget->mips[0].resize((size_t)newRenderTarget->texelSize * width * height);
+
+	unsigned char texel[16] = {};
+	ConvertFormat(RESOURCE_FORMAT_R32G32B32A32_FLOAT, newRenderTarget->clearColor, 0, format, texel, 0, 1, 1);
+	for (size_t offset = 0; offset < newRenderTarget->mips[0].size(); offset += newRenderTarget->texelSize)
+		memcpy(newRenderTarget->mips[0].data() + offset, texel, newRenderTarget->texelSize);
+
+	BindDescriptor(offsetFromDescriptorTableStart, nullptr, newRenderTarget);
+	AddResource(TextureMemory(newRenderTarget));
+	*renderTarget = newRenderTarget;
+	return Record(NULL_CALL_CREATE_RENDER_TARGET, LEANDX12_OK, width, height, format, sampleCount);
+}
+
+LeanDX12Result DeleteRenderTarget(Texture* renderTarget)
+{
+	NULL_DEVICE& device = GetNullDevice();
+	if (renderTarget == NULL || !renderTarget->isRenderTarget)
+		return Record(NULL_CALL_DELETE_RENDER_TARGET, LEANDX12_ERROR_INVALID_CALL);
+
+	if (device.renderTarget == renderTarget)
+		device.renderTarget = nullptr;
+
+	UnbindDescriptor(renderTarget->descriptorOffset, renderTarget);
+	RemoveResource(TextureMemory(renderTarget));
+	delete renderTarget;
+	return Record(NULL_CALL_DELETE_RENDER_TARGET, LEANDX12_OK);
+}
+
+// ------------------------------------------------------- Leitura e escrita (RAM e VRAM) -------------------------------------------------- //
+
+// As cópias são executadas imediatamente; as versões assíncronas equivalem às síncronas.
+
+LeanDX12Result GetPrivateDataAsync(Buffer* defaultBuffer, Buffer* readbackBuffer)
+{
+	return GetPrivateData(defaultBuffer, readbackBuffer);
+}
+
+LeanDX12Result GetPrivateDataAsync(Texture* texture, unsigned short mipLevel, unsigned long long* sizeInBytes, Buffer* readbackBuffer)
+{
+	return GetPrivateData(texture, mipLevel, sizeInBytes, readbackBuffer);
+}
+
+LeanDX12Result GetPrivateData(Buffer* defaultBuffer, Buffer* readbackBuffer)
+{
+	if (defaultBuffer == NULL || readbackBuffer == NULL)
+		return Record(NULL_CALL_GET_PRIVATE_DATA, LEANDX12_ERROR_INVALID_CALL);
+	if (defaultBuffer->type != BUFFER_TYPE_DEFAULT || readbackBuffer->type != BUFFER_TYPE_READBACK)
+		return Record(NULL_CALL_GET_PRIVATE_DATA, LEANDX12_ERROR_HEAP_TYPE_NOT_ALLOWED);
+	if (readbackBuffer->data.size() < defaultBuffer->data.size())
+		return Record(NULL_CALL_GET_PRIVATE_DATA, LEANDX12_ERROR_INSUFFICIENT_BUFFER_SIZE, defaultBuffer->data.size());
+
+	memcpy(readbackBuffer->data.data(), defaultBuffer->data.data(), defaultBuffer->data.size());
+	GetNullDevice().stats.bytesCopied += defaultBuffer->data.size();
+	return Record(NULL_CALL_GET_PRIVATE_DATA, LEANDX12_OK, defaultBuffer->data.size());
+}
+
+LeanDX12Result GetPrivateData(Texture* texture, unsigned short mipLevel, unsigned long long* sizeInBytes, Buffer* readbackBuffer)
+{
+	if (texture == NULL || (sizeInBytes == NULL && readbackBuffer == NULL))
+		return Record(NULL_CALL_GET_PRIVATE_DATA, LEANDX12_ERROR_INVALID_CALL, mipLevel);
+	if (mipLevel >= texture->mipLevels)
+		return Record(NULL_CALL_GET_PRIVATE_DATA, LEANDX12_ERROR_MIPLEVEL_NOT_FOUND, mipLevel);
+	if (texture->sampleCount > 1)
+		return Record(NULL_CALL_GET_PRIVATE_DATA, LEANDX12_ERROR_FIRST_PARAMETER_MULTISAMPLED, mipLevel);
+
+	unsigned long long requiredSize = FootprintSize(texture->texelSize, MipDimension(texture->width, mipLevel),
+		MipDimension(texture->height, mipLevel), MipDimension(texture->depth, mipLevel), NULL);
+	if (sizeInBytes != NULL)
+		*sizeInBytes = requiredSize;
+	if (readbackBuffer == NULL)
+		return Record(NULL_CALL_GET_PRIVATE_DATA, LEANDX12_INFO_REQUIRED_BUFFER_SIZE, mipLevel, requiredSize);
+
+	if (readbackBuffer->type != BUFFER_TYPE_READBACK)
+		return Record(NULL_CALL_GET_PRIVATE_DATA, LEANDX12_ERROR_HEAP_TYPE_NOT_ALLOWED, mipLevel, requiredSize);
+	if (readbackBuffer->data.size() < requiredSize)
+		return Record(NULL_CALL_GET_PRIVATE_DATA, LEANDX12_ERROR_INSUFFICIENT_BUFFER_SIZE, mipLevel, requiredSize);
+
+	CopyFootprint(texture, mipLevel, readbackBuffer->data.data(), true);
+	GetNullDevice().stats.bytesCopied += texture->mips[mipLevel].size();
+	return Record(NULL_CALL_GET_PRIVATE_DATA, LEANDX12_OK, mipLevel, requiredSize);
+}
+
+LeanDX12Result SetPrivateDataAsync(Buffer* defaultBuffer, Buffer* uploadBuffer)
+{
+	return SetPrivateData(defaultBuffer, uploadBuffer);
+}
+
+LeanDX12Result SetPrivateDataAsync(Texture* texture, unsigned short mipLevel, unsigned long long* sizeInBytes, Buffer* uploadBuffer)
+{
+	return SetPrivateData(texture, mipLevel, sizeInBytes, uploadBuffer);
+}
+
+LeanDX12Result SetPrivateData(Buffer* defaultBuffer, Buffer* uploadBuffer)
+{
+	if (defaultBuffer == NULL || uploadBuffer == NULL)
+		return Record(NULL_CALL_SET_PRIVATE_DATA, LEANDX12_ERROR_INVALID_CALL);
+	if (defaultBuffer->type != BUFFER_TYPE_DEFAULT || uploadBuffer->type != BUFFER_TYPE_UPLOAD)
+		return Record(NULL_CALL_SET_PRIVATE_DATA, LEANDX12_ERROR_HEAP_TYPE_NOT_ALLOWED);
+	if (uploadBuffer->data.size() < defaultBuffer->data.size())
+		return Record(NULL_CALL_SET_PRIVATE_DATA, LEANDX12_ERROR_INSUFFICIENT_BUFFER_SIZE, defaultBuffer->data.size());
+
+	memcpy(defaultBuffer->data.data(), uploadBuffer->data.data(), defaultBuffer->data.size());
+	GetNullDevice().stats.bytesCopied += defaultBuffer->data.size();
+	return Record(NULL_CALL_SET_PRIVATE_DATA, LEANDX12_OK, defaultBuffer->data.size());
+}
+
+LeanDX12Result SetPrivateData(Texture* texture, unsigned short mipLevel, unsigned long long* sizeInBytes, Buffer* uploadBuffer)
+{
+	if (texture == NULL || (sizeInBytes == NULL && uploadBuffer == NULL))
+		return Record(NULL_CALL_SET_PRIVATE_DATA, LEANDX12_ERROR_INVALID_CALL, mipLevel);
+	if (texture->isRenderTarget)
+		return Record(NULL_CALL_SET_PRIVATE_DATA, LEANDX12_ERROR_RENDER_TARGET_NOT_ALLOWED, mipLevel);
+	if (mipLevel >= texture->mipLevels)
+		return Record(NULL_CALL_SET_PRIVATE_DATA, LEANDX12_ERROR_MIPLEVEL_NOT_FOUND, mipLevel);
+
+	unsigned long long requiredSize = FootprintSize(texture->texelSize, MipDimension(texture->width, mipLevel),
+		MipDimension(texture->height, mipLevel), MipDimension(texture->depth, mipLevel), NULL);
+	if (sizeInBytes != NULL)
+		*sizeInBytes = requiredSize;
+	if (uploadBuffer == NULL)
+		return Record(NULL_CALL_SET_PRIVATE_DATA, LEANDX12_INFO_REQUIRED_BUFFER_SIZE, mipLevel, requiredSize);
+
+	if (uploadBuffer->type != BUFFER_TYPE_UPLOAD)
+		return Record(NULL_CALL_SET_PRIVATE_DATA, LEANDX12_ERROR_HEAP_TYPE_NOT_ALLOWED, mipLevel, requiredSize);
+	if (uploadBuffer->data.size() < requiredSize)
+		return Record(NULL_CALL_SET_PRIVATE_DATA, LEANDX12_ERROR_INSUFFICIENT_BUFFER_SIZE, mipLevel, requiredSize);
+
+	CopyFootprint(texture, mipLevel, uploadBuffer->data.data(), false);
+	GetNullDevice().stats.bytesCopied += texture->mips[mipLevel].size();
+	return Record(NULL_CALL_SET_PRIVATE_DATA, LEANDX12_OK, mipLevel, requiredSize);
+}
+
+LeanDX12Result ReadbackData(Buffer* readbackBuffer, unsigned int texelSize, unsigned int textureWidth, unsigned int textureHeight, unsigned int textureDepth, void* pData)
+{
+	if (readbackBuffer == NULL || pData == NULL || texelSize == 0 || textureWidth == 0 || textureHeight == 0 || textureDepth == 0)
+		return Record(NULL_CALL_READBACK_DATA, LEANDX12_ERROR_INVALID_CALL, texelSize, textureWidth, textureHeight, textureDepth);
+	if (readbackBuffer->type != BUFFER_TYPE_READBACK)
+		return Record(NULL_CALL_READBACK_DATA, LEANDX12_ERROR_HEAP_TYPE_NOT_ALLOWED, texelSize, textureWidth, textureHeight, textureDepth);
+
+	unsigned long long rowPitch;
+	if (FootprintSize(texelSize, textureWidth, textureHeight, textureDepth, &rowPitch) > readbackBuffer->data.size())
+		return Record(NULL_CALL_READBACK_DATA, LEANDX12_ERROR_INSUFFICIENT_BUFFER_SIZE, texelSize, textureWidth, textureHeight, textureDepth);
+
+	size_t rowSize = (size_t)texelSize * textureWidth;
+	unsigned long long rows = (unsigned long long)textureHeight * textureDepth;
+	for (unsigned long long row = 0; row < rows; row++)
+		memcpy((unsigned char*)pData + row * rowSize, readbackBuffer->data.data() + row * rowPitch, rowSize);
+
+	GetNullDevice().stats.bytesReadback += rowSize * rows;
+	return Record(NULL_CALL_READBACK_DATA, LEANDX12_OK, texelSize, textureWidth, textureHeight, textureDepth);
+}
+
+LeanDX12Result UploadData(Buffer* uploadBuffer, unsigned long long* requiredBufferSize, unsigned int texelSize, unsigned int textureWidth, unsigned int textureHeight, unsigned int textureDepth, void* pData)
+{
+	if (texelSize == 0 || textureWidth == 0 || textureHeight == 0 || textureDepth == 0)
+		return Record(NULL_CALL_UPLOAD_DATA, LEANDX12_ERROR_INVALID_CALL, texelSize, textureWidth, textureHeight, textureDepth);
+
+	unsigned long long rowPitch;
+	unsigned long long requiredSize = FootprintSize(texelSize, textureWidth, textureHeight, textureDepth, &rowPitch);
+	if (requiredBufferSize != NULL)
+		*requiredBufferSize = requiredSize;
+
+	if (uploadBuffer == NULL || pData == NULL)
+	{
+		LeanDX12Result result = requiredBufferSize != NULL ? LEANDX12_INFO_REQUIRED_BUFFER_SIZE : LEANDX12_ERROR_INVALID_CALL;
+		return Record(NULL_CALL_UPLOAD_DATA, result, texelSize, textureWidth, textureHeight, textureDepth);
+	}
+
+	if (uploadBuffer->type != BUFFER_TYPE_UPLOAD)
+		return Record(NULL_CALL_UPLOAD_DATA, LEANDX12_ERROR_HEAP_TYPE_NOT_ALLOWED, texelSize, textureWidth, textureHeight, textureDepth);
+	if (requiredSize > uploadBuffer->data.size())
+		return Record(NULL_CALL_UPLOAD_DATA, LEANDX12_ERROR_INSUFFICIENT_BUFFER_SIZE, texelSize, textureWidth, textureHeight, textureDepth);
+
+	size_t rowSize = (size_t)texelSize * textureWidth;
+	unsigned long long rows = (unsigned long long)textureHeight * textureDepth;
+	for (unsigned long long row = 0; row < rows; row++)
+		memcpy(uploadBuffer->data.data() + row * rowPitch, (const unsigned char*)pData + row * rowSize, rowSize);
+
+	GetNullDevice().stats.bytesUploaded += rowSize * rows;
+	return Record(NULL_CALL_UPLOAD_DATA, LEANDX12_OK, texelSize, textureWidth, textureHeight, textureDepth);
+}
+
+LeanDX12Result SetActiveMipLevel(Texture* texture, unsigned short mipLevel)
+{
+	if (texture == NULL)
+		return Record(NULL_CALL_SET_ACTIVE_MIP_LEVEL, LEANDX12_ERROR_INVALID_CALL, mipLevel);
+	if (mipLevel >= texture->mipLevels)
+		return Record(NULL_CALL_SET_ACTIVE_MIP_LEVEL, LEANDX12_ERROR_MIPLEVEL_NOT_FOUND, mipLevel);
+
+	texture->activeMipLevel = mipLevel;
+	return Record(NULL_CALL_SET_ACTIVE_MIP_LEVEL, LEANDX12_OK, mipLevel);
+}
+
+// ------------------------------------------------------- Informações sobre recursos ------------------------------------------------------ //
+
+LeanDX12Result GetBufferDesc(Buffer* buffer, BUFFER_TYPE* bufferType, unsigned long long* bufferSize)
+{
+	if (buffer == NULL)
+		return Record(NULL_CALL_GET_BUFFER_DESC, LEANDX12_ERROR_INVALID_CALL);
+
+	if (bufferType != NULL)
+		*bufferType = buffer->type;
+	if (bufferSize != NULL)
+		*bufferSize = buffer->data.size();
+	return Record(NULL_CALL_GET_BUFFER_DESC, LEANDX12_OK);
+}
+
+// mipDesc recebe as dimensões de todos os níveis (mipLevels elementos).
+LeanDX12Result GetTextureDesc(Texture* texture, RESOURCE_FORMAT* textureFormat, unsigned int* sampleCount, unsigned int* sampleQuality, unsigned short* mipLevels, MIP_DESC* mipDesc)
+{
+	if (texture == NULL)
+		return Record(NULL_CALL_GET_TEXTURE_DESC, LEANDX12_ERROR_INVALID_CALL);
+
+	if (textureFormat != NULL)
+		*textureFormat = texture->format;
+	if (sampleCount != NULL)
+		*sampleCount = texture->sampleCount;
+	if (sampleQuality != NULL)
+		*sampleQuality = texture->sampleQuality;
+	if (mipLevels != NULL)
+		*mipLevels = texture->mipLevels;
+
+	if (mipDesc != NULL)
+	{
+		for (unsigned short mipLevel = 0; mipLevel < texture->mipLevels; mipLevel++)
+		{
+			mipDesc[mipLevel].Width = MipDimension(texture->width, mipLevel);
+			mipDesc[mipLevel].Height = MipDimension(texture->height, mipLevel);
+			mipDesc[mipLevel].Depth = MipDimension(texture->depth, mipLevel);
+		}
+	}
+
+	return Record(NULL_CALL_GET_TEXTURE_DESC, LEANDX12_OK);
+}
+
+// ---------------------------------------------------------- Tabela de descritores -------------------------------------------------------- //
+
+// Se a nova posição estiver ocupada, os descritores são trocados quando *swap for verdadeiro; caso contrário, retorna
+// LEANDX12_ERROR_DESCRIPTOR_TABLE_OFFSET_CONFLICT.
+LeanDX12Result MoveDescriptor(Buffer* resource, unsigned int newOffsetFromDescriptorTableStart, BOOLEAN* swap)
+{
+	if (resource == NULL || resource->type != BUFFER_TYPE_DEFAULT)
+		return Record(NULL_CALL_MOVE_DESCRIPTOR, LEANDX12_ERROR_INVALID_CALL, newOffsetFromDescriptorTableStart);
+
+	LeanDX12Result result = MoveResourceDescriptor(&resource->descriptorOffset, resource, nullptr, newOffsetFromDescriptorTableStart, swap);
+	return Record(NULL_CALL_MOVE_DESCRIPTOR, result, newOffsetFromDescriptorTableStart);
+}
+
+LeanDX12Result MoveDescriptor(Texture* resource, unsigned int newOffsetFromDescriptorTableStart, BOOLEAN* swap)
+{
+	if (resource == NULL)
+		return Record(NULL_CALL_MOVE_DESCRIPTOR, LEANDX12_ERROR_INVALID_CALL, newOffsetFromDescriptorTableStart);
+
+	LeanDX12Result result = MoveResourceDescriptor(&resource->descriptorOffset, nullptr, resource, newOffsetFromDescriptorTableStart, swap);
+	return Record(NULL_CALL_MOVE_DESCRIPTOR, result, newOffsetFromDescriptorTableStart);
+}
+
+LeanDX12Result GetDescriptorOffsetFromTableStart(Buffer* buffer, unsigned int* descriptorOffset)
+{
+	if (buffer == NULL || descriptorOffset == NULL || buffer->type != BUFFER_TYPE_DEFAULT)
+		return Record(NULL_CALL_GET_DESCRIPTOR_OFFSET_FROM_TABLE_START, LEANDX12_ERROR_INVALID_CALL);
+
+	*descriptorOffset = buffer->descriptorOffset;
+	return Record(NULL_CALL_GET_DESCRIPTOR_OFFSET_FROM_TABLE_START, LEANDX12_OK, *descriptorOffset);
+}
+
+LeanDX12Result GetDescriptorOffsetFromTableStart(Texture* texture, unsigned int* descriptorOffset)
+{
+	if (texture == NULL || descriptorOffset == NULL)
+		return Record(NULL_CALL_GET_DESCRIPTOR_OFFSET_FROM_TABLE_START, LEANDX12_ERROR_INVALID_CALL);
+
+	*descriptorOffset = texture->descriptorOffset;
+	return Record(NULL_CALL_GET_DESCRIPTOR_OFFSET_FROM_TABLE_START, LEANDX12_OK, *descriptorOffset);
+}
+
+LeanDX12Result MapDescriptorTableOffsetToBaseRegister(unsigned int descriptorTableOffset)
+{
+	NULL_DEVICE& device = GetNullDevice();
+	if (!device.inScene)
+		return Record(NULL_CALL_MAP_DESCRIPTOR_TABLE_OFFSET_TO_BASE_REGISTER, LEANDX12_ERROR_INVALID_CALL, descriptorTableOffset);
+
+	if (device.descriptorTableBase != descriptorTableOffset)
+	{
+		device.descriptorTableBase = descriptorTableOffset;
+		device.stats.numStateChanges++;
+	}
+
+	return Record(NULL_CALL_MAP_DESCRIPTOR_TABLE_OFFSET_TO_BASE_REGISTER, LEANDX12_OK, descriptorTableOffset);
+}
+
+// ------------------------------------------------------------- Pipeline gráfico ---------------------------------------------------------- //
+
+// Os estados iniciais são os valores padrão do Direct3D 12.
+LeanDX12Result InitBlendState(BlendState** blendState)
+{
+	if (blendState == NULL)
+		return Record(NULL_CALL_INIT_BLEND_STATE, LEANDX12_ERROR_INVALID_CALL);
+
+	BlendState* newState = CreatePipelineObject<BlendState>();
+	BLEND_DESC& desc = newState->desc;
+	memset(&desc, 0, sizeof(BLEND_DESC));
+	desc.SrcBlend = BLEND_FACTOR_ONE;
+	desc.DestBlend = BLEND_FACTOR_ZERO;
+	desc.BlendOp = BLEND_OPERATION_ADD;
+	desc.SrcBlendAlpha = BLEND_FACTOR_ONE;
+	desc.DestBlendAlpha = BLEND_FACTOR_ZERO;
+	desc.BlendOpAlpha = BLEND_OPERATION_ADD;
+	desc.LogicOp = LOGIC_OPERATION_NOOP;
+
+	*blendState = newState;
+	return Record(NULL_CALL_INIT_BLEND_STATE, LEANDX12_OK);
+}
+
+LeanDX12Result InitRasterizerState(RasterizerState** rasterizerState)
+{
+	if (rasterizerState == NULL)
+		return Record(NULL_CALL_INIT_RASTERIZER_STATE, LEANDX12_ERROR_INVALID_CALL);
+
+	RasterizerState* newState = CreatePipelineObject<RasterizerState>();
+	RASTERIZER_DESC& desc = newState->desc;
+	memset(&desc, 0, sizeof(RASTERIZER_DESC));
+	desc.FillMode = FILL_MODE_SOLID;
+	desc.CullMode = CULL_MODE_BACK;
+	desc.DepthClipEnable = 1;
+	desc.SampleCount = 1;
+
+	*rasterizerState = newState;
+	return Record(NULL_CALL_INIT_RASTERIZER_STATE, LEANDX12_OK);
+}
+
+LeanDX12Result InitDepthStencilState(DepthStencilState** depthStencilState)
+{
+	if (depthStencilState == NULL)
+		return Record(NULL_CALL_INIT_DEPTH_STENCIL_STATE, LEANDX12_ERROR_INVALID_CALL);
+
+	DepthStencilState* newState = CreatePipelineObject<DepthStencilState>();
+	DEPTH_STENCIL_DESC& desc = newState->desc;
+	memset(&desc, 0, sizeof(DEPTH_STENCIL_DESC));
+	desc.DepthEnable = 1;
+	desc.DepthFunc = COMPARISON_FUNC_LESS;
+	desc.StencilReadMask = 0xFF;
+	desc.StencilWriteMask = 0xFF;
+	desc.FrontFaceStencilFunc = COMPARISON_FUNC_ALWAYS;
+	desc.FrontFaceStencilPassOp = STENCIL_OPERATION_KEEP;
+	desc.FrontFaceStencilDepthFailOp = STENCIL_OPERATION_KEEP;
+	desc.FrontFaceStencilFailOp = STENCIL_OPERATION_KEEP;
+	desc.BackFaceStencilFunc = COMPARISON_FUNC_ALWAYS;
+	desc.BackFaceStencilPassOp = STENCIL_OPERATION_KEEP;
+	desc.BackFaceStencilDepthFailOp = STENCIL_OPERATION_KEEP;
+	desc.BackFaceStencilFailOp = STENCIL_OPERATION_KEEP;
+
+	*depthStencilState = newState;
+	return Record(NULL_CALL_INIT_DEPTH_STENCIL_STATE, LEANDX12_OK);
+}
+
+LeanDX12Result SetBlendState(BLEND_DESC blendDesc, BlendState* blendState)
+{
+	bool valid = blendState != NULL && !(blendDesc.BlendEnable != 0 && blendDesc.LogicOpEnable != 0) &&
+		(blendDesc.BlendEnable == 0 || (IsValidBlendFactor(blendDesc.SrcBlend) && IsValidBlendFactor(blendDesc.DestBlend) &&
+			IsValidBlendFactor(blendDesc.SrcBlendAlpha) && IsValidBlendFactor(blendDesc.DestBlendAlpha) &&
+			blendDesc.BlendOp >= BLEND_OPERATION_ADD && blendDesc.BlendOp <= BLEND_OPERATION_OP_MAX &&
+			blendDesc.BlendOpAlpha >= BLEND_OPERATION_ADD && blendDesc.BlendOpAlpha <= BLEND_OPERATION_OP_MAX)) &&
+		(blendDesc.LogicOpEnable == 0 || blendDesc.LogicOp <= LOGIC_OPERATION_OR_INVERTED);
+	if (!valid)
+		return Record(NULL_CALL_SET_BLEND_STATE, LEANDX12_ERROR_INVALID_CALL);
+
+	blendState->desc = blendDesc;
+	return Record(NULL_CALL_SET_BLEND_STATE, LEANDX12_OK, blendDesc.BlendEnable, blendDesc.SrcBlend, blendDesc.DestBlend, blendDesc.BlendOp);
+}
+
+LeanDX12Result SetRasterizerState(RASTERIZER_DESC rasterizerDesc, RasterizerState* rasterizerState)
+{
+	if (rasterizerState == NULL || rasterizerDesc.FillMode < FILL_MODE_WIREFRAME || rasterizerDesc.FillMode > FILL_MODE_SOLID ||
+		rasterizerDesc.CullMode < CULL_MODE_NONE || rasterizerDesc.CullMode > CULL_MODE_BACK)
+		return Record(NULL_CALL_SET_RASTERIZER_STATE, LEANDX12_ERROR_INVALID_CALL);
+
+	rasterizerState->desc = rasterizerDesc;
+	return Record(NULL_CALL_SET_RASTERIZER_STATE, LEANDX12_OK, rasterizerDesc.FillMode, rasterizerDesc.CullMode, rasterizerDesc.FrontCounterClockwise);
+}
+
+LeanDX12Result SetDepthStencilState(DEPTH_STENCIL_DESC depthStencilDesc, DepthStencilState* depthStencilState)
+{
+	const DEPTH_STENCIL_DESC& desc = depthStencilDesc;
+	bool valid = depthStencilState != NULL && (desc.DepthEnable == 0 || IsValidComparison(desc.DepthFunc)) &&
+		(desc.StencilEnable == 0 || (IsValidComparison(desc.FrontFaceStencilFunc) && IsValidComparison(desc.BackFaceStencilFunc) &&
+			IsValidStencilOperation(desc.FrontFaceStencilPassOp) && IsValidStencilOperation(desc.FrontFaceStencilDepthFailOp) &&
+			IsValidStencilOperation(desc.FrontFaceStencilFailOp) && IsValidStencilOperation(desc.BackFaceStencilPassOp) &&
+			IsValidStencilOperation(desc.BackFaceStencilDepthFailOp) && IsValidStencilOperation(desc.BackFaceStencilFailOp)));
+	if (!valid)
+		return Record(NULL_CALL_SET_DEPTH_STENCIL_STATE, LEANDX12_ERROR_INVALID_CALL);
+
+	depthStencilState->desc = depthStencilDesc;
+	return Record(NULL_CALL_SET_DEPTH_STENCIL_STATE, LEANDX12_OK, desc.DepthEnable, desc.DepthFunc, desc.StencilEnable);
+}
+
+LeanDX12Result CreateInputLayout(unsigned int numVertexDataElements, INPUT_ELEMENT_DESC* vertexDataElements, unsigned int numInstanceDataElements, INPUT_ELEMENT_DESC* instanceDataElements, InputLayout** inputLayout)
+{
+	if (inputLayout == NULL)
+		return Record(NULL_CALL_CREATE_INPUT_LAYOUT, LEANDX12_ERROR_INVALID_CALL, numVertexDataElements, numInstanceDataElements);
+
+	InputLayout layout;
+	LeanDX12Result result = LEANDX12_OK;
+	if (!ValidateInputElements(numVertexDataElements, vertexDataElements, false, &layout.vertexElements, &layout.vertexSize, &result) ||
+		!ValidateInputElements(numInstanceDataElements, instanceDataElements, true, &layout.instanceElements, &layout.instanceSize, &result))
+		return Record(NULL_CALL_CREATE_INPUT_LAYOUT, result, numVertexDataElements, numInstanceDataElements);
+
+	InputLayout* newLayout = CreatePipelineObject<InputLayout>();
+	*newLayout = layout;
+	*inputLayout = newLayout;
+	return Record(NULL_CALL_CREATE_INPUT_LAYOUT, LEANDX12_OK, numVertexDataElements, numInstanceDataElements);
+}
+
+LeanDX12Result CreateRootSignature(unsigned int num32bitConstants, unsigned int* num32bitValues, unsigned int numConstantBuffers, unsigned int numShaderResources, RootSignature** rootSignature)
+{
+	if (!GetNullDevice().deviceCreated || rootSignature == NULL || (num32bitConstants > 0 && num32bitValues == NULL))
+		return Record(NULL_CALL_CREATE_ROOT_SIGNATURE, LEANDX12_ERROR_INVALID_CALL, num32bitConstants, numConstantBuffers, numShaderResources);
+
+	// A assinatura raiz comporta 64 valores de 32 bits: as constantes e um valor para a tabela de descritores.
+	unsigned int numValues = numConstantBuffers + numShaderResources > 0 ? 1 : 0;
+	for (unsigned int i = 0; i < num32bitConstants; i++)
+	{
+		if (num32bitValues[i] == 0)
+			return Record(NULL_CALL_CREATE_ROOT_SIGNATURE, LEANDX12_ERROR_INVALID_CALL, num32bitConstants, numConstantBuffers, numShaderResources);
+		numValues += num32bitValues[i];
+	}
+
+	if (numValues > NULL_MAX_ROOT_CONSTANTS)
+		return Record(NULL_CALL_CREATE_ROOT_SIGNATURE, LEANDX12_ERROR_NUMBER_OF_CONSTANTS_EXCEEDED_REGISTER_LIMIT, num32bitConstants, numConstantBuffers, numShaderResources);
+
+	RootSignature* newRootSignature = CreatePipelineObject<RootSignature>();
+	newRootSignature->num32bitValues.assign(num32bitValues, num32bitValues + num32bitConstants);
+	newRootSignature->numConstantBuffers = numConstantBuffers;
+	newRootSignature->numShaderResources = numShaderResources;
+
+	*rootSignature = newRootSignature;
+	return Record(NULL_CALL_CREATE_ROOT_SIGNATURE, LEANDX12_OK, num32bitConstants, numConstantBuffers, numShaderResources);
+}
+
+LeanDX12Result LoadShaderFromFile(const char* filename, ShaderBinary** shaderBinary)
+{
+	NULL_DEVICE& device = GetNullDevice();
+	if (filename == NULL || shaderBinary == NULL)
+		return Record(NULL_CALL_LOAD_SHADER_FROM_FILE, LEANDX12_ERROR_INVALID_CALL);
+
+	ShaderBinary shader;
+	shader.filename = filename;
+	shader.pProgram = NULL;
+
+	auto it = device.registeredShaders.find(filename);
+	if (it != device.registeredShaders.end())
+		shader.pProgram = it->second;
+	else
+	{
+		std::ifstream file(filename, std::ios::binary);
+		if (!file)
+			return Record(NULL_CALL_LOAD_SHADER_FROM_FILE, LEANDX12_ERROR_OPEN_FILE_FAILED);
+
+		shader.bytecode.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+		if (shader.bytecode.size() < 4 || memcmp(shader.bytecode.data(), "DXBC", 4) != 0)
+			return Record(NULL_CALL_LOAD_SHADER_FROM_FILE, LEANDX12_ERROR_INVALID_CALL, shader.bytecode.size());
+	}
+
+	ShaderBinary* newShader = CreatePipelineObject<ShaderBinary>();
+	*newShader = shader;
+	*shaderBinary = newShader;
+	return Record(NULL_CALL_LOAD_SHADER_FROM_FILE, LEANDX12_OK, shader.bytecode.size());
+}
+
+LeanDX12Result CreateGraphicsPipelineState(GRAPHICS_PIPELINE_STATE_DESC graphicsPipelineStateDesc, PipelineState** pipelineState)
+{
+	const GRAPHICS_PIPELINE_STATE_DESC& desc = graphicsPipelineStateDesc;
+	bool hasTessellation = desc.hullShader != NULL && desc.domainShader != NULL;
+	bool valid = GetNullDevice().deviceCreated && pipelineState != NULL && desc.rootSignature != NULL && desc.vertexShader != NULL &&
+		desc.rasterState != NULL && desc.blendState != NULL && desc.depthStencilState != NULL &&
+		(desc.hullShader == NULL) == (desc.domainShader == NULL) &&
+		desc.primitiveTopologyType >= PRIMITIVE_TOPOLOGY_TYPE_POINT && desc.primitiveTopologyType <= PRIMITIVE_TOPOLOGY_TYPE_PATCH &&
+		(desc.primitiveTopologyType == PRIMITIVE_TOPOLOGY_TYPE_PATCH) == hasTessellation &&
+		IsColorFormat(desc.renderTargetFormat) && (desc.depthStencilFormat == RESOURCE_FORMAT_UNKNOWN || IsDepthFormat(desc.depthStencilFormat));
+	if (!valid)
+		return Record(NULL_CALL_CREATE_GRAPHICS_PIPELINE_STATE, LEANDX12_ERROR_INVALID_CALL, desc.primitiveTopologyType, desc.renderTargetFormat, desc.depthStencilFormat);
+
+	PipelineState* newPipelineState = CreatePipelineObject<PipelineState>();
+	newPipelineState->rootSignature = *desc.rootSignature;
+	if (desc.inputLayout != NULL)
+		newPipelineState->inputLayout = *desc.inputLayout;
+	else
+		newPipelineState->inputLayout.vertexSize = newPipelineState->inputLayout.instanceSize = 0;
+	newPipelineState->pVertexProgram = desc.vertexShader->pProgram;
+	newPipelineState->pPixelProgram = desc.pixelShader != NULL ? desc.pixelShader->pProgram : NULL;
+	newPipelineState->primitiveTopologyType = desc.primitiveTopologyType;
+	newPipelineState->blendDesc = desc.blendState->desc;
+	newPipelineState->rasterizerDesc = desc.rasterState->desc;
+	newPipelineState->depthStencilDesc = desc.depthStencilState->desc;
+	newPipelineState->renderTargetFormat = desc.renderTargetFormat;
+	newPipelineState->depthStencilFormat = desc.depthStencilFormat;
+
+	*pipelineState = newPipelineState;
+	return Record(NULL_CALL_CREATE_GRAPHICS_PIPELINE_STATE, LEANDX12_OK, desc.primitiveTopologyType, desc.renderTargetFormat, desc.depthStencilFormat);
+}
+
+// ---------------------------------------------------------------- Renderização ----------------------------------------------------------- //
+
+LeanDX12Result BeginScene(PipelineState* pipelineState)
+{
+	NULL_DEVICE& device = GetNullDevice();
+	if (!device.deviceCreated || device.inScene || pipelineState == NULL)
+		return Record(NULL_CALL_BEGIN_SCENE, LEANDX12_ERROR_INVALID_CALL);
+
+	ResetSceneState(device);
+	device.inScene = true;
+	device.pipelineState = pipelineState;
+	device.stats.numScenes++;
+
+	if (device.lastPipelineState != pipelineState)
+	{
+		device.lastPipelineState = pipelineState;
+		device.stats.numStateChanges++;
+		device.stats.numPipelineStateChanges++;
+	}
+
+	return Record(NULL_CALL_BEGIN_SCENE, LEANDX12_OK);
+}
+
+void EndScene()
+{
+	NULL_DEVICE& device = GetNullDevice();
+	Record(NULL_CALL_END_SCENE, device.inScene ? LEANDX12_OK : LEANDX12_ERROR_INVALID_CALL);
+	device.inScene = false;
+}
+
+void SetRenderTarget(Texture* renderTarget)
+{
+	NULL_DEVICE& device = GetNullDevice();
+	LeanDX12Result result = LEANDX12_OK;
+	if (!device.inScene || renderTarget == NULL || !renderTarget->isRenderTarget)
+		result = LEANDX12_ERROR_INVALID_CALL;
+	else if (renderTarget->format != device.pipelineState->renderTargetFormat)
+		result = LEANDX12_ERROR_RESOURCE_FORMATS_NOT_SAME;
+
+	Record(NULL_CALL_SET_RENDER_TARGET, result, renderTarget != NULL ? (unsigned long long)renderTarget->format : 0);
+	if (result != LEANDX12_OK)
+		return;
+
+	if (device.renderTarget != renderTarget)
+	{
+		device.renderTarget = renderTarget;
+		device.stats.numStateChanges++;
+	}
+}
+
+LeanDX12Result Clear(unsigned int count, const CLEAR_RECT* pRects, unsigned int flags, const float colorRGBA[4], float z, unsigned int stencil)
+{
+	NULL_DEVICE& device = GetNullDevice();
+	if (!device.inScene || (count > 0 && pRects == NULL) || flags == 0 || (flags & ~(CLEAR_STENCIL | CLEAR_TARGET | CLEAR_DEPTH)) != 0 ||
+		((flags & CLEAR_TARGET) != 0 && colorRGBA == NULL) || ((flags & CLEAR_DEPTH) != 0 && !(z >= 0.0f && z <= 1.0f)) || stencil > 0xFF)
+		return Record(NULL_CALL_CLEAR, LEANDX12_ERROR_INVALID_CALL, count, flags);
+
+	Texture* renderTarget = device.renderTarget;
+	if (renderTarget == nullptr)
+		return Record(NULL_CALL_CLEAR, LEANDX12_ERROR_NO_RENDER_TARGET_SELECTED, count, flags);
+
+	unsigned char texel[16] = {};
+	if ((flags & CLEAR_TARGET) != 0)
+	{
+		LeanDX12Result result = ConvertFormat(RESOURCE_FORMAT_R32G32B32A32_FLOAT, colorRGBA, 0, renderTarget->format, texel, 0, 1, 1);
+		if (result != LEANDX12_OK)
+			return Record(NULL_CALL_CLEAR, result, count, flags);
+	}
+
+	if ((flags & (CLEAR_DEPTH | CLEAR_STENCIL)) != 0)
+		EnsureNullDepthStencil(renderTarget);
+
+	CLEAR_RECT fullRect = { 0, 0, renderTarget->width, renderTarget->height };
+	unsigned int numRects = count > 0 ? count : 1;
+	for (unsigned int i = 0; i < numRects; i++)
+	{
+		CLEAR_RECT rect = count > 0 ? pRects[i] : fullRect;
+		rect.Right = std::min(rect.Right, renderTarget->width);
+		rect.Bottom = std::min(rect.Bottom, renderTarget->height);
+
+		if (rect.Left >= rect.Right || rect.Top >= rect.Bottom)
+			continue;
+
+		// A primeira linha é preenchida texel a texel e copiada para as demais.
+		unsigned int width = rect.Right - rect.Left;
+		size_t firstRow = (size_t)rect.Top * renderTarget->width + rect.Left;
+		for (unsigned int y = rect.Top; y < rect.Bottom; y++)
+		{
+			size_t rowStart = (size_t)y * renderTarget->width + rect.Left;
+			if ((flags & CLEAR_TARGET) != 0)
+			{
+				unsigned char* pRow = renderTarget->mips[0].data() + rowStart * renderTarget->texelSize;
+				if (y == rect.Top)
+					for (unsigned int x = 0; x < width; x++)
+						memcpy(pRow + (size_t)x * renderTarget->texelSize, texel, renderTarget->texelSize);
+				else
+					memcpy(pRow, renderTarget->mips[0].data() + firstRow * renderTarget->texelSize, (size_t)width * renderTarget->texelSize);
+			}
+			if ((flags & CLEAR_DEPTH) != 0)
+				std::fill_n(renderTarget->depthData.begin() + rowStart, width, z);
+			if ((flags & CLEAR_STENCIL) != 0)
+				memset(renderTarget->stencilData.data() + rowStart, (int)stencil, width);
+		}
+	}
+
+	device.stats.numClears++;
+	return Record(NULL_CALL_CLEAR, LEANDX12_OK, count, flags);
+}
+
+LeanDX12Result SetViewports(unsigned int numViewports, VIEWPORT* pViewports)
+{
+	NULL_DEVICE& device = GetNullDevice();
+	if (!device.inScene || numViewports == 0 || numViewports > NULL_MAX_VIEWPORTS || pViewports == NULL)
+		return Record(NULL_CALL_SET_VIEWPORTS, LEANDX12_ERROR_INVALID_CALL, numViewports);
+
+	for (unsigned int i = 0; i < numViewports; i++)
+		if (pViewports[i].Left >= pViewports[i].Right || pViewports[i].Top >= pViewports[i].Bottom)
+			return Record(NULL_CALL_SET_VIEWPORTS, LEANDX12_ERROR_INVALID_CALL, numViewports);
+
+	if (numViewports != device.numViewports || memcmp(device.viewports, pViewports, numViewports * sizeof(VIEWPORT)) != 0)
+	{
+		device.numViewports = numViewports;
+		memcpy(device.viewports, pViewports, numViewports * sizeof(VIEWPORT));
+		device.stats.numStateChanges++;
+	}
+
+	return Record(NULL_CALL_SET_VIEWPORTS, LEANDX12_OK, numViewports);
+}
+
+LeanDX12Result SetScissorRects(unsigned int numScissorRects, SCISSOR_RECT* pScissorRects)
+{
+	NULL_DEVICE& device = GetNullDevice();
+	if (!device.inScene || numScissorRects == 0 || numScissorRects > NULL_MAX_VIEWPORTS || pScissorRects == NULL)
+		return Record(NULL_CALL_SET_SCISSOR_RECTS, LEANDX12_ERROR_INVALID_CALL, numScissorRects);
+
+	for (unsigned int i = 0; i < numScissorRects; i++)
+		if (pScissorRects[i].Left > pScissorRects[i].Right || pScissorRects[i].Top > pScissorRects[i].Bottom)
+			return Record(NULL_CALL_SET_SCISSOR_RECTS, LEANDX12_ERROR_INVALID_CALL, numScissorRects);
+
+	if (numScissorRects != device.numScissorRects || memcmp(device.scissorRects, pScissorRects, numScissorRects * sizeof(SCISSOR_RECT)) != 0)
+	{
+		device.numScissorRects = numScissorRects;
+		memcpy(device.scissorRects, pScissorRects, numScissorRects * sizeof(SCISSOR_RECT));
+		device.stats.numStateChanges++;
+	}
+
+	return Record(NULL_CALL_SET_SCISSOR_RECTS, LEANDX12_OK, numScissorRects);
+}
+
+void RenderFrameAsync()
+{
+	RenderFrame();
+}
+
+void RenderFrame()
+{
+	NULL_DEVICE& device = GetNullDevice();
+	bool valid = device.deviceCreated && !device.inScene;
+	Record(NULL_CALL_RENDER_FRAME, valid ? LEANDX12_OK : LEANDX12_ERROR_INVALID_CALL, device.stats.numFrames);
+	if (!valid)
+		return;
+
+	device.stats.numFrames++;
+	if (device.hooks.RenderFrame != nullptr)
+		device.hooks.RenderFrame(device.hooks.pUserData);
+}
+
+void WaitForGPU()
+{
+	Record(NULL_CALL_WAIT_FOR_GPU, GetNullDevice().deviceCreated ? LEANDX12_OK : LEANDX12_ERROR_INVALID_CALL);
+}
+
+void SetPrimitiveTopology(PRIMITIVE_TOPOLOGY primitiveTopology)
+{
+	NULL_DEVICE& device = GetNullDevice();
+	bool valid = device.inScene && TopologyType(primitiveTopology) != 0;
+	Record(NULL_CALL_SET_PRIMITIVE_TOPOLOGY, valid ? LEANDX12_OK : LEANDX12_ERROR_INVALID_CALL, primitiveTopology);
+	if (!valid)
+		return;
+
+	if (device.primitiveTopology != primitiveTopology)
+	{
+		device.primitiveTopology = primitiveTopology;
+		device.stats.numStateChanges++;
+	}
+}
+
+LeanDX12Result SetVertexData(void* pVertexData, unsigned int vertexDataSize, unsigned int dataSizePerVertex)
+{
+	NULL_DEVICE& device = GetNullDevice();
+	if (!device.inScene || pVertexData == NULL || dataSizePerVertex == 0 || vertexDataSize < dataSizePerVertex)
+		return Record(NULL_CALL_SET_VERTEX_DATA, LEANDX12_ERROR_INVALID_CALL, vertexDataSize, dataSizePerVertex);
+	if (dataSizePerVertex < device.pipelineState->inputLayout.vertexSize)
+		return Record(NULL_CALL_SET_VERTEX_DATA, LEANDX12_ERROR_INSUFFICIENT_BUFFER_SIZE, vertexDataSize, dataSizePerVertex);
+
+	device.vertexData.assign((const unsigned char*)pVertexData, (const unsigned char*)pVertexData + vertexDataSize);
+	device.vertexStride = dataSizePerVertex;
+	device.vertexDataSet = true;
+	device.stats.bytesUploaded += vertexDataSize;
+	device.stats.numStateChanges++;
+	return Record(NULL_CALL_SET_VERTEX_DATA, LEANDX12_OK, vertexDataSize, dataSizePerVertex);
+}
+
+LeanDX12Result SetInstanceData(void* pInstanceData, unsigned int instanceDataSize, unsigned int dataSizePerInstance, unsigned int stepRate)
+{
+	NULL_DEVICE& device = GetNullDevice();
+	if (stepRate == 0)
+		return Record(NULL_CALL_SET_INSTANCE_DATA, LEANDX12_INVALID_STEP_RATE, instanceDataSize, dataSizePerInstance, stepRate);
+	if (!device.inScene || pInstanceData == NULL || dataSizePerInstance == 0 || instanceDataSize < dataSizePerInstance)
+		return Record(NULL_CALL_SET_INSTANCE_DATA, LEANDX12_ERROR_INVALID_CALL, instanceDataSize, dataSizePerInstance, stepRate);
+	if (dataSizePerInstance < device.pipelineState->inputLayout.instanceSize)
+		return Record(NULL_CALL_SET_INSTANCE_DATA, LEANDX12_ERROR_INSUFFICIENT_BUFFER_SIZE, instanceDataSize, dataSizePerInstance, stepRate);
+
+	device.instanceData.assign((const unsigned char*)pInstanceData, (const unsigned char*)pInstanceData + instanceDataSize);
+	device.instanceStride = dataSizePerInstance;
+	device.instanceStepRate = stepRate;
+	device.instanceDataSet = true;
+	device.stats.bytesUploaded += instanceDataSize;
+	device.stats.numStateChanges++;
+	return Record(NULL_CALL_SET_INSTANCE_DATA, LEANDX12_OK, instanceDataSize, dataSizePerInstance, stepRate);
+}
+
+LeanDX12Result SetIndexData(unsigned int* pIndexData, unsigned int indexDataSize)
+{
+	NULL_DEVICE& device = GetNullDevice();
+	if (!device.inScene || pIndexData == NULL || indexDataSize == 0 || indexDataSize % sizeof(unsigned int) != 0)
+		return Record(NULL_CALL_SET_INDEX_DATA, LEANDX12_ERROR_INVALID_CALL, indexDataSize);
+
+	device.indexData.assign(pIndexData, pIndexData + indexDataSize / sizeof(unsigned int));
+	device.indexDataSet = true;
+	device.stats.bytesUploaded += indexDataSize;
+	device.stats.numStateChanges++;
+	return Record(NULL_CALL_SET_INDEX_DATA, LEANDX12_OK, indexDataSize);
+}
+
+void DrawInstanced(unsigned int vertexCountPerInstance, unsigned int instanceCount, unsigned int startVertexCount, unsigned int startInstanceLocation)
+{
+	NULL_DRAW_DESC draw = { false, vertexCountPerInstance, instanceCount, startVertexCount, 0, startInstanceLocation };
+	Draw(NULL_CALL_DRAW_INSTANCED, &draw);
+}
+
+void DrawIndexedInstanced(unsigned int indexCountPerInstance, unsigned int instanceCount, unsigned int startIndexCount, unsigned int startVertexCount, unsigned int startInstanceLocation)
+{
+	NULL_DRAW_DESC draw = { true, indexCountPerInstance, instanceCount, startIndexCount, startVertexCount, startInstanceLocation };
+	Draw(NULL_CALL_DRAW_INDEXED_INSTANCED, &draw);
+}
+
+LeanDX12Result Set32bitConstants(unsigned int shaderRegister, unsigned int num32bitValues, void* pConstants, unsigned int destOffset)
+{
+	NULL_DEVICE& device = GetNullDevice();
+	if (!device.inScene || pConstants == NULL || num32bitValues == 0)
+		return Record(NULL_CALL_SET_32BIT_CONSTANTS, LEANDX12_ERROR_INVALID_CALL, shaderRegister, num32bitValues, destOffset);
+
+	const RootSignature& rootSignature = device.pipelineState->rootSignature;
+	if (shaderRegister >= rootSignature.num32bitValues.size())
+		return Record(NULL_CALL_SET_32BIT_CONSTANTS, LEANDX12_ERROR_INVALID_SHADER_REGISTER, shaderRegister, num32bitValues, destOffset);
+	if ((unsigned long long)destOffset + num32bitValues > rootSignature.num32bitValues[shaderRegister])
+		return Record(NULL_CALL_SET_32BIT_CONSTANTS, LEANDX12_ERROR_NUMBER_OF_CONSTANTS_EXCEEDED_REGISTER_LIMIT, shaderRegister, num32bitValues, destOffset);
+
+	unsigned int* pValues = (unsigned int*)GetNullConstantRegister(shaderRegister) + destOffset;
+	memcpy(pValues, pConstants, num32bitValues * sizeof(unsigned int));
+	device.stats.bytesUploaded += num32bitValues * sizeof(unsigned int);
+	device.stats.numStateChanges++;
+	return Record(NULL_CALL_SET_32BIT_CONSTANTS, LEANDX12_OK, shaderRegister, num32bitValues, destOffset);
+}
+
+LeanDX12Result ResolveTextureAsync(Texture* nonMultisampledTexture, Texture* multisampledTexture)
+{
+	return ResolveTexture(nonMultisampledTexture, multisampledTexture);
+}
+
+LeanDX12Result ResolveTexture(Texture* nonMultisampledTexture, Texture* multisampledTexture)
+{
+	if (nonMultisampledTexture == NULL || multisampledTexture == NULL)
+		return Record(NULL_CALL_RESOLVE_TEXTURE, LEANDX12_ERROR_INVALID_CALL);
+	if (nonMultisampledTexture->sampleCount > 1)
+		return Record(NULL_CALL_RESOLVE_TEXTURE, LEANDX12_ERROR_FIRST_PARAMETER_MULTISAMPLED);
+	if (multisampledTexture->sampleCount < 2)
+		return Record(NULL_CALL_RESOLVE_TEXTURE, LEANDX12_ERROR_SECOND_PARAMETER_NOT_MULTISAMPLED);
+	if (nonMultisampledTexture->format != multisampledTexture->format)
+		return Record(NULL_CALL_RESOLVE_TEXTURE, LEANDX12_ERROR_RESOURCE_FORMATS_NOT_SAME);
+	if (nonMultisampledTexture->width != multisampledTexture->width || nonMultisampledTexture->height != multisampledTexture->height ||
+		nonMultisampledTexture->depth != 1)
+		return Record(NULL_CALL_RESOLVE_TEXTURE, LEANDX12_ERROR_TEXTURE_DIMENSIONS_NOT_SAME);
+
+	// Uma amostra por texel: a resolução é uma cópia.
+	nonMultisampledTexture->mips[0] = multisampledTexture->mips[0];
+	GetNullDevice().stats.bytesCopied += multisampledTexture->mips[0].size();
+	return Record(NULL_CALL_RESOLVE_TEXTURE, LEANDX12_OK, multisampledTexture->mips[0].size());
+}
+
+// ------------------------------------------------------------ Funções auxiliares --------------------------------------------------------- //
+
+unsigned int TexelSize(RESOURCE_FORMAT resourceFormat)
+{
+	switch (resourceFormat)
+	{
+	case RESOURCE_FORMAT_R8_UNORM:
+	case RESOURCE_FORMAT_R8_SNORM:
+	case RESOURCE_FORMAT_R8_UINT:
+	case RESOURCE_FORMAT_R8_SINT:
+		return 1;
+	case RESOURCE_FORMAT_R16_FLOAT:
+	case RESOURCE_FORMAT_R16_UNORM:
+	case RESOURCE_FORMAT_R16_SNORM:
+	case RESOURCE_FORMAT_R16_UINT:
+	case RESOURCE_FORMAT_R16_SINT:
+	case RESOURCE_FORMAT_R8G8_UNORM:
+	case RESOURCE_FORMAT_R8G8_SNORM:
+	case RESOURCE_FORMAT_R8G8_UINT:
+	case RESOURCE_FORMAT_R8G8_SINT:
+		return 2;
+	case RESOURCE_FORMAT_R8G8B8A8_UNORM:
+	case RESOURCE_FORMAT_R8G8B8A8_UNORM_SRGB:
+	case RESOURCE_FORMAT_R10G10B10A2_UNORM:
+	case RESOURCE_FORMAT_R10G10B10_XR_BIAS_A2_UNORM:
+	case RESOURCE_FORMAT_R32_FLOAT:
+	case RESOURCE_FORMAT_R32_UINT:
+	case RESOURCE_FORMAT_R32_SINT:
+	case RESOURCE_FORMAT_R16G16_FLOAT:
+	case RESOURCE_FORMAT_R16G16_UNORM:
+	case RESOURCE_FORMAT_R16G16_SNORM:
+	case RESOURCE_FORMAT_R16G16_UINT:
+	case RESOURCE_FORMAT_R16G16_SINT:
+	case RESOURCE_FORMAT_R11G11B10_FLOAT:
+	case RESOURCE_FORMAT_R8G8B8A8_SNORM:
+	case RESOURCE_FORMAT_R8G8B8A8_UINT:
+	case RESOURCE_FORMAT_R8G8B8A8_SINT:
+	case RESOURCE_FORMAT_R10G10B10A2_UINT:
+	case RESOURCE_FORMAT_D32_FLOAT:
+	case RESOURCE_FORMAT_D24_UNORM_S8_UINT:
+		return 4;
+	case RESOURCE_FORMAT_R16G16B16A16_FLOAT:
+	case RESOURCE_FORMAT_R32G32_FLOAT:
+	case RESOURCE_FORMAT_R32G32_UINT:
+	case RESOURCE_FORMAT_R32G32_SINT:
+	case RESOURCE_FORMAT_R16G16B16A16_UNORM:
+	case RESOURCE_FORMAT_R16G16B16A16_SNORM:
+	case RESOURCE_FORMAT_R16G16B16A16_UINT:
+	case RESOURCE_FORMAT_R16G16B16A16_SINT:
+	case RESOURCE_FORMAT_D32_FLOAT_S8X24_UINT:
+		return 8;
+	case RESOURCE_FORMAT_R32G32B32_FLOAT:
+	case RESOURCE_FORMAT_R32G32B32_UINT:
+	case RESOURCE_FORMAT_R32G32B32_SINT:
+		return 12;
+	case RESOURCE_FORMAT_R32G32B32A32_FLOAT:
+	case RESOURCE_FORMAT_R32G32B32A32_UINT:
+	case RESOURCE_FORMAT_R32G32B32A32_SINT:
+		return 16;
+	default:
+		return 0;
+	}
+}
+
+// pImageData contém texels R8G8B8A8 (4 bytes por texel, linhas contíguas).
+LeanDX12Result SaveAsPNG(const char* filename, void* pImageData, unsigned long long imageDataSize, unsigned int width, unsigned int height)
+{
+	if (filename == NULL || pImageData == NULL || width == 0 || height == 0)
+		return Record(NULL_CALL_SAVE_AS_PNG, LEANDX12_ERROR_INVALID_CALL, imageDataSize, width, height);
+
+	size_t rowSize = (size_t)width * 4;
+	if (imageDataSize < (unsigned long long)rowSize * height)
+		return Record(NULL_CALL_SAVE_AS_PNG, LEANDX12_ERROR_INSUFFICIENT_BUFFER_SIZE, imageDataSize, width, height);
+
+	// Linhas com o filtro 0 (nenhum), em blocos deflate sem compressão.
+	std::vector<unsigned char> scanlines;
+	scanlines.reserve((rowSize + 1) * height);
+	for (unsigned int y = 0; y < height; y++)
+	{
+		scanlines.push_back(0);
+		const unsigned char* pRow = (const unsigned char*)pImageData + y * rowSize;
+		scanlines.insert(scanlines.end(), pRow, pRow + rowSize);
+	}
+
+	std::vector<unsigned char> zlib = { 0x78, 0x01 };
+	size_t offset = 0;
+	do
+	{
+		size_t blockSize = std::min<size_t>(scanlines.size() - offset, 65535);
+		zlib.push_back(offset + blockSize == scanlines.size() ? 1 : 0);
+		zlib.push_back((unsigned char)blockSize);
+		zlib.push_back((unsigned char)(blockSize >> 8));
+		zlib.push_back((unsigned char)~blockSize);
+		zlib.push_back((unsigned char)(~blockSize >> 8));
+		zlib.insert(zlib.end(), scanlines.begin() + offset, scanlines.begin() + offset + blockSize);
+		offset += blockSize;
+	} while (offset < scanlines.size());
+
+	unsigned int a = 1, b = 0;
+	for (unsigned char value : scanlines)
+	{
+		a = (a + value) % 65521;
+		b = (b + a) % 65521;
+	}
+	AppendBigEndian(zlib, (b << 16) | a);
+
+	std::vector<unsigned char> header;
+	AppendBigEndian(header, width);
+	AppendBigEndian(header, height);
+	header.insert(header.end(), { 8, 6, 0, 0, 0 });		// 8 bits por canal, RGBA.
+
+	std::vector<unsigned char> png = { 0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n' };
+	AppendChunk(png, "IHDR", header);
+	AppendChunk(png, "IDAT", zlib);
+	AppendChunk(png, "IEND", std::vector<unsigned char>());
+
+	FILE* file = fopen(filename, "wb");
+	if (file == NULL)
+		return Record(NULL_CALL_SAVE_AS_PNG, LEANDX12_ERROR_SAVE_FILE_FAILED, imageDataSize, width, height);
+
+	bool written = fwrite(png.data(), 1, png.size(), file) == png.size();
+	written = fclose(file) == 0 && written;
+	return Record(NULL_CALL_SAVE_AS_PNG, written ? LEANDX12_OK : LEANDX12_ERROR_SAVE_FILE_FAILED, imageDataSize, width, height);
+}
+
+// Os índices ausentes nas faces (por exemplo, "f 1//1" sem coordenada de textura) são retornados como 0xFFFFFFFF.
+LeanDX12Result LoadWavefrontOBJ(
+	const char* filename,
+	float* vertices, unsigned int* numVertices, unsigned int* numVertexCoordinates,
+	float* textureCoordinates, unsigned int* numUVWTexture, unsigned int* numTextureCoordinates,
+	float* vertexNormals, unsigned int* numVertexNormals, unsigned int* numNormalCoordinates,
+	unsigned int* vertexIndices, unsigned int* textureCoordinateIndices, unsigned int* vertexNormalIndices, unsigned int* numFaces)
+{
+	if (filename == NULL)
+		return Record(NULL_CALL_LOAD_WAVEFRONT_OBJ, LEANDX12_ERROR_INVALID_CALL);
+
+	std::ifstream file(filename);
+	if (!file)
+		return Record(NULL_CALL_LOAD_WAVEFRONT_OBJ, LEANDX12_ERROR_OPEN_FILE_FAILED);
+
+	// Listas de coordenadas (v, vt e vn) e vértices dos triângulos (índices de v, vt e vn).
+	std::vector<std::vector<float>> lists[3];
+	unsigned int numCoordinates[3] = {};
+	std::vector<unsigned int> triangles[3];
+
+	std::string line;
+	std::vector<unsigned int> face[3];
+	while (std::getline(file, line))
+	{
+		const char* pLine = line.c_str();
+		int list = strncmp(pLine, "v ", 2) == 0 ? 0 : strncmp(pLine, "vt ", 3) == 0 ? 1 : strncmp(pLine, "vn ", 3) == 0 ? 2 : -1;
+		if (list >= 0)
+		{
+			std::vector<float> coordinates;
+			char* pEnd;
+			const char* pValue = pLine + (list == 0 ? 2 : 3);
+			for (float value = strtof(pValue, &pEnd); pEnd != pValue; value = strtof(pValue, &pEnd))
+			{
+				coordinates.push_back(value);
+				pValue = pEnd;
+			}
+
+			numCoordinates[list] = std::max(numCoordinates[list], (unsigned int)coordinates.size());
+			lists[list].push_back(coordinates);
+		}
+		else if (strncmp(pLine, "f ", 2) == 0)
+		{
+			for (int i = 0; i < 3; i++)
+				face[i].clear();
+
+			// Vértices no formato v, v/vt, v//vn ou v/vt/vn.
+			const char* pToken = pLine + 2;
+			while (*pToken != '\0')
+			{
+				while (*pToken == ' ' || *pToken == '\t' || *pToken == '\r')
+					pToken++;
+				if (*pToken == '\0')
+					break;
+
+				for (int i = 0; i < 3; i++)
+				{
+					bool present = *pToken != '/' && *pToken != ' ' && *pToken != '\t' && *pToken != '\r' && *pToken != '\0';
+					face[i].push_back(present ? ObjIndex(pToken, lists[i].size()) : 0xFFFFFFFFu);
+					while (*pToken != '/' && *pToken != ' ' && *pToken != '\t' && *pToken != '\r' && *pToken != '\0')
+						pToken++;
+					if (*pToken == '/')
+						pToken++;
+					else
+					{
+						for (int j = i + 1; j < 3; j++)
+							face[j].push_back(0xFFFFFFFFu);
+						break;
+					}
+				}
+			}
+
+			// Divisão em leque.
+			for (size_t corner = 2; corner < face[0].size(); corner++)
+			{
+				for (int i = 0; i < 3; i++)
+				{
+					triangles[i].push_back(face[i][0]);
+					triangles[i].push_back(face[i][corner - 1]);
+					triangles[i].push_back(face[i][corner]);
+				}
+			}
+		}
+	}
+
+	unsigned int* counts[3] = { numVertices, numUVWTexture, numVertexNormals };
+	unsigned int* coordinateCounts[3] = { numVertexCoordinates, numTextureCoordinates, numNormalCoordinates };
+	float* outputs[3] = { vertices, textureCoordinates, vertexNormals };
+	unsigned int* indexOutputs[3] = { vertexIndices, textureCoordinateIndices, vertexNormalIndices };
+
+	for (int list = 0; list < 3; list++)
+	{
+		if (counts[list] != NULL)
+			*counts[list] = (unsigned int)lists[list].size();
+		if (coordinateCounts[list] != NULL)
+			*coordinateCounts[list] = numCoordinates[list];
+
+		// Coordenadas ausentes são preenchidas com 0 (w = 1 nas posições homogêneas).
+		if (outputs[list] != NULL)
+		{
+			for (size_t i = 0; i < lists[list].size(); i++)
+				for (unsigned int j = 0; j < numCoordinates[list]; j++)
+					outputs[list][i * numCoordinates[list] + j] = j < lists[list][i].size() ? lists[list][i][j] : (list == 0 && j == 3 ? 1.0f : 0.0f);
+		}
+
+		if (indexOutputs[list] != NULL && !triangles[list].empty())
+			memcpy(indexOutputs[list], triangles[list].data(), triangles[list].size() * sizeof(unsigned int));
+	}
+
+	if (numFaces != NULL)
+		*numFaces = (unsigned int)(triangles[0].size() / 3);
+
+	return Record(NULL_CALL_LOAD_WAVEFRONT_OBJ, LEANDX12_OK, lists[0].size(), triangles[0].size() / 3);
+}
+
+// ------------------------------------------------------------------ Backend nulo --------------------------------------------------------- //
+
+void GetNullBackendStats(NULL_BACKEND_STATS* stats)
+{
+	if (stats != nullptr)
+		*stats = GetNullDevice().stats;
+}
+
+void ResetNullBackendStats()
+{
+	NULL_BACKEND_STATS& stats = GetNullDevice().stats;
+	unsigned int numResources = stats.numResources;
+	unsigned long long resourceMemory = stats.resourceMemory;
+
+	memset(&stats, 0, sizeof(NULL_BACKEND_STATS));
+	stats.numResources = numResources;
+	stats.resourceMemory = resourceMemory;
+}
+
+void SetNullCallRecording(BOOLEAN enable)
+{
+	GetNullDevice().recordCalls = enable != 0;
+}
+
+LeanDX12Result GetNullRecordedCalls(unsigned int* numCalls, NULL_CALL* pCalls)
+{
+	NULL_DEVICE& device = GetNullDevice();
+	if (numCalls == nullptr)
+		return LEANDX12_ERROR_INVALID_CALL;
+
+	if (pCalls == nullptr)
+	{
+		*numCalls = (unsigned int)device.calls.size();
+		return LEANDX12_INFO_REQUIRED_ARRAY_LENGTH;
+	}
+
+	if (*numCalls < device.calls.size())
+		return LEANDX12_ERROR_INSUFFICIENT_BUFFER_SIZE;
+
+	*numCalls = (unsigned int)device.calls.size();
+	if (!device.calls.empty())
+		memcpy(pCalls, device.calls.data(), device.calls.size() * sizeof(NULL_CALL));
+	return LEANDX12_OK;
+}
+
+void ClearNullRecordedCalls()
+{
+	GetNullDevice().calls.clear();
+}
+
+const char* GetNullCallName(NULL_CALL_TYPE callType)
+{
+	return callType < NULL_CALL_TYPE_COUNT ? callNames[callType] : "";
+}
+
+LeanDX12Result SaveNullCallStream(const char* filename)
+{
+	if (filename == nullptr)
+		return LEANDX12_ERROR_INVALID_CALL;
+
+	FILE* file = fopen(filename, "w");
+	if (file == NULL)
+		return LEANDX12_ERROR_SAVE_FILE_FAILED;
+
+	for (const NULL_CALL& call : GetNullDevice().calls)
+	{
+		fprintf(file, "%s 0x%X %llu %llu %llu %llu\n", GetNullCallName(call.type), (unsigned int)call.result,
+			call.arguments[0], call.arguments[1], call.arguments[2], call.arguments[3]);
+	}
+
+	return fclose(file) == 0 ? LEANDX12_OK : LEANDX12_ERROR_SAVE_FILE_FAILED;
+}
+
+LeanDX12Result RegisterNullShader(const char* filename, const void* pProgram)
+{
+	if (filename == nullptr)
+		return LEANDX12_ERROR_INVALID_CALL;
+
+	GetNullDevice().registeredShaders[filename] = pProgram;
+	return LEANDX12_OK;
+}
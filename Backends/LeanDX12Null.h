@@ -0,0 +1,161 @@
+/*
+* LeanDX12 - Backend nulo
+* Descrição: Implementação de todas as funções de LeanDX12.h sem Direct3D 12 e sem GPU, para executar a montagem das cenas e o envio
+* dos comandos em máquinas sem Windows ou sem placa de vídeo (integração contínua, coordenadores de render farm). O backend é compilado
+* no lugar de LeanDX12.lib, junto com LeanDX12Format.cpp e LeanDX12Parallel.cpp (Extensions).
+*
+*	•	Os recursos são alocados na memória do sistema: UploadData, SetPrivateData, GetPrivateData, ReadbackData e ResolveTexture copiam
+*		os dados de fato (com o alinhamento de 256 bytes por linha dos buffers de envio e leitura de texturas), e Clear preenche o render
+*		target. Os desenhos são apenas validados e contabilizados (LeanDX12Software.h os executa na CPU);
+*	•	Os parâmetros e o estado (cena ativa, pipeline, render target, viewports, topologia, dados de vértices, instâncias e índices,
+*		registradores e constantes) são validados. As funções sem valor de retorno registram o erro nas estatísticas;
+*	•	Cada chamada pode ser gravada (SetNullCallRecording) com o seu resultado e até quatro parâmetros inteiros, na ordem da declaração;
+*	•	As estatísticas contabilizam desenhos, vértices, primitivas, bytes enviados, copiados e lidos, e mudanças de estado.
+*
+*	Os arquivos de shader são lidos por LoadShaderFromFile e devem ser contêineres DXBC (.cso). Shaders registrados por RegisterNullShader
+*	não precisam existir no disco (por exemplo, em máquinas sem o compilador de shaders).
+*
+*	O render target possui um buffer de profundidade e stencil associado, alocado na primeira utilização (Clear com CLEAR_DEPTH ou
+*	CLEAR_STENCIL, ou desenho com um pipeline que define depthStencilFormat).
+*
+*	Assim como LeanDX12.lib, o backend mantém um único dispositivo global e as suas funções não devem ser chamadas por várias threads ao
+*	mesmo tempo.
+*
+*   Organização do arquivo de cabeçalho:
+*	1.	Enumerações
+*	2.	Estruturas
+*	3.	Declaração das funções
+*		•	Funções de LeanDX12.h presentes apenas nas versões mais recentes da biblioteca
+*		•	Backend nulo
+*/
+
+#ifndef _LEANDX12_NULL_
+#define _LEANDX12_NULL_
+
+#include <cstddef>
+
+#include "LeanDX12.h"
+
+// ----------------------------------------------------------- 1. Enumerações ------------------------------------------------------------- //
+
+typedef enum NULL_CALL_TYPE
+{
+	NULL_CALL_GET_ADAPTERS,
+	NULL_CALL_GET_HIGHEST_PERFORMANCE_ADAPTER,
+	NULL_CALL_GET_ADAPTER_DESC,
+	NULL_CALL_CREATE_DEVICE,
+	NULL_CALL_RELEASE_DEVICE,
+	NULL_CALL_RELEASE_ADAPTER,
+	NULL_CALL_CREATE_BUFFER,
+	NULL_CALL_DELETE_BUFFER,
+	NULL_CALL_CREATE_TEXTURE,
+	NULL_CALL_DELETE_TEXTURE,
+	NULL_CALL_CREATE_RENDER_TARGET,
+	NULL_CALL_DELETE_RENDER_TARGET,
+	NULL_CALL_GET_PRIVATE_DATA,							// Inclui as versões assíncronas e as versões para texturas.
+	NULL_CALL_SET_PRIVATE_DATA,
+	NULL_CALL_READBACK_DATA,
+	NULL_CALL_UPLOAD_DATA,
+	NULL_CALL_SET_ACTIVE_MIP_LEVEL,
+	NULL_CALL_GET_BUFFER_DESC,
+	NULL_CALL_GET_TEXTURE_DESC,
+	NULL_CALL_MOVE_DESCRIPTOR,
+	NULL_CALL_GET_DESCRIPTOR_OFFSET_FROM_TABLE_START,
+	NULL_CALL_MAP_DESCRIPTOR_TABLE_OFFSET_TO_BASE_REGISTER,
+	NULL_CALL_INIT_BLEND_STATE,
+	NULL_CALL_INIT_RASTERIZER_STATE,
+	NULL_CALL_INIT_DEPTH_STENCIL_STATE,
+	NULL_CALL_SET_BLEND_STATE,
+	NULL_CALL_SET_RASTERIZER_STATE,
+	NULL_CALL_SET_DEPTH_STENCIL_STATE,
+	NULL_CALL_CREATE_INPUT_LAYOUT,
+	NULL_CALL_CREATE_ROOT_SIGNATURE,
+	NULL_CALL_LOAD_SHADER_FROM_FILE,
+	NULL_CALL_CREATE_GRAPHICS_PIPELINE_STATE,
+	NULL_CALL_BEGIN_SCENE,
+	NULL_CALL_END_SCENE,
+	NULL_CALL_SET_RENDER_TARGET,
+	NULL_CALL_CLEAR,
+	NULL_CALL_SET_VIEWPORTS,
+	NULL_CALL_SET_SCISSOR_RECTS,
+	NULL_CALL_RENDER_FRAME,								// Inclui RenderFrameAsync.
+	NULL_CALL_WAIT_FOR_GPU,
+	NULL_CALL_SET_PRIMITIVE_TOPOLOGY,
+	NULL_CALL_SET_VERTEX_DATA,
+	NULL_CALL_SET_INSTANCE_DATA,
+	NULL_CALL_SET_INDEX_DATA,
+	NULL_CALL_DRAW_INSTANCED,
+	NULL_CALL_DRAW_INDEXED_INSTANCED,
+	NULL_CALL_SET_32BIT_CONSTANTS,
+	NULL_CALL_RESOLVE_TEXTURE,
+	NULL_CALL_TEXEL_SIZE,
+	NULL_CALL_SAVE_AS_PNG,
+	NULL_CALL_LOAD_WAVEFRONT_OBJ,
+	NULL_CALL_TYPE_COUNT
+} NULL_CALL_TYPE;
+
+// ------------------------------------------------------------ 2. Estruturas ------------------------------------------------------------- //
+
+typedef struct NULL_CALL
+{
+	NULL_CALL_TYPE type;
+	LeanDX12Result result;
+	unsigned long long arguments[4];				// Parâmetros inteiros (tamanhos, contagens, deslocamentos e enumerações).
+} NULL_CALL;
+
+typedef struct NULL_BACKEND_STATS
+{
+	unsigned long long numCalls;
+	unsigned long long numValidationErrors;
+	LeanDX12Result lastError;
+	NULL_CALL_TYPE lastErrorCall;
+	unsigned int numScenes;
+	unsigned int numFrames;
+	unsigned int numDraws;
+	unsigned int numIndexedDraws;
+	unsigned long long numInstances;
+	unsigned long long numVertices;					// Vértices processados (vértices ou índices por instância * instâncias).
+	unsigned long long numPrimitives;
+	unsigned int numClears;
+	unsigned int numStateChanges;					// Alterações efetivas do estado da cena (inclui as de pipeline).
+	unsigned int numPipelineStateChanges;
+	unsigned long long bytesUploaded;				// UploadData, SetVertexData, SetInstanceData, SetIndexData e Set32bitConstants.
+	unsigned long long bytesCopied;					// SetPrivateData, GetPrivateData e ResolveTexture.
+	unsigned long long bytesReadback;				// ReadbackData.
+	unsigned int numResources;						// Buffers, texturas e render targets existentes.
+	unsigned long long resourceMemory;				// Memória ocupada pelos recursos existentes.
+} NULL_BACKEND_STATS;
+
+// ------------------------------------------------------ 3. Declaração das funções ------------------------------------------------------- //
+
+// ------------------- 3.1. Funções de LeanDX12.h presentes apenas nas versões mais recentes da biblioteca (exemplos) -------------------- //
+
+void ReleaseDevice();
+// Faces com mais de três vértices são divididas em triângulos (em leque) e contabilizadas em numFaces. Os índices retornados iniciam
+// em zero.
+LeanDX12Result LoadWavefrontOBJ(
+	const char* filename,
+	float* vertices, unsigned int* numVertices, unsigned int* numVertexCoordinates,
+	float* textureCoordinates, unsigned int* numUVWTexture, unsigned int* numTextureCoordinates,
+	float* vertexNormals, unsigned int* numVertexNormals, unsigned int* numNormalCoordinates,
+	unsigned int* vertexIndices, unsigned int* textureCoordinateIndices, unsigned int* vertexNormalIndices, unsigned int* numFaces);
+
+// ------------------------------------------------------- 3.2. Backend nulo -------------------------------------------------------------- //
+
+void GetNullBackendStats(NULL_BACKEND_STATS* stats);
+// Zera os contadores (numResources e resourceMemory são preservados).
+void ResetNullBackendStats();
+
+void SetNullCallRecording(BOOLEAN enable);
+// Copia as chamadas gravadas para pCalls. Se pCalls for NULL, retorna a quantidade em numCalls (LEANDX12_INFO_REQUIRED_ARRAY_LENGTH).
+LeanDX12Result GetNullRecordedCalls(unsigned int* numCalls, NULL_CALL* pCalls);
+void ClearNullRecordedCalls();
+const char* GetNullCallName(NULL_CALL_TYPE callType);
+// Grava as chamadas em um arquivo de texto (uma por linha), para comparação entre execuções.
+LeanDX12Result SaveNullCallStream(const char* filename);
+
+// Registra um shader que LoadShaderFromFile(filename) carrega sem ler o disco. pProgram é associado ao ShaderBinary, para backends que
+// executam os shaders na CPU, e pode ser NULL no backend nulo.
+LeanDX12Result RegisterNullShader(const char* filename, const void* pProgram);
+
+#endif  // _LEANDX12_NULL_
@@ -0,0 +1,204 @@
+/*
+* LeanDX12 - Backend nulo (estruturas internas)
+* Descrição: Definição das estruturas opacas de LeanDX12.h e do estado do dispositivo do backend nulo, compartilhadas com os backends
+* que executam os desenhos na CPU. Não deve ser incluído pelas aplicações.
+*
+*   Organização do arquivo de cabeçalho:
+*	1.	Estruturas
+*		•	Estruturas opacas de LeanDX12.h
+*		•	Estado do dispositivo
+*	2.	Declaração das funções
+*/
+
+#ifndef _LEANDX12_NULL_INTERNAL_
+#define _LEANDX12_NULL_INTERNAL_
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "LeanDX12.h"
+#include "LeanDX12Null.h"
+
+// Limites do estado da cena (os mesmos do Direct3D 12).
+#define NULL_MAX_VIEWPORTS 16
+#define NULL_MAX_ROOT_CONSTANTS 64
+
+// ------------------------------------------------------------ 1. Estruturas ------------------------------------------------------------- //
+
+// -------------------------------------------------- 1.1. Estruturas opacas de LeanDX12.h ------------------------------------------------ //
+
+struct DisplayAdapter
+{
+	ADAPTER_DESC desc;
+};
+
+struct Buffer
+{
+	BUFFER_TYPE type;
+	std::vector<unsigned char> data;
+	RESOURCE_FORMAT format;
+	unsigned int numElements;
+	unsigned int structureSize;
+	unsigned int descriptorOffset;					// Apenas buffers do tipo BUFFER_TYPE_DEFAULT possuem descritor.
+};
+
+struct Texture
+{
+	bool isRenderTarget;
+	unsigned int width;
+	unsigned int height;
+	unsigned int depth;
+	unsigned short mipLevels;
+	unsigned short activeMipLevel;
+	RESOURCE_FORMAT format;
+	unsigned int texelSize;
+	unsigned int sampleCount;
+	unsigned int sampleQuality;
+	float clearColor[4];
+	std::vector<std::vector<unsigned char>> mips;	// Texels contíguos de cada nível (uma amostra por texel).
+	std::vector<float> depthData;					// Profundidade e stencil dos render targets (alocados na primeira utilização).
+	std::vector<unsigned char> stencilData;
+	unsigned int descriptorOffset;
+};
+
+struct BlendState
+{
+	BLEND_DESC desc;
+};
+
+struct RasterizerState
+{
+	RASTERIZER_DESC desc;
+};
+
+struct DepthStencilState
+{
+	DEPTH_STENCIL_DESC desc;
+};
+
+typedef struct NULL_INPUT_ELEMENT
+{
+	std::string semanticName;
+	unsigned int semanticIndex;
+	RESOURCE_FORMAT format;
+	unsigned int offset;							// Deslocamento no vértice ou na instância (elementos consecutivos).
+	unsigned int instanceDataStepRate;
+} NULL_INPUT_ELEMENT;
+
+struct InputLayout
+{
+	std::vector<NULL_INPUT_ELEMENT> vertexElements;
+	std::vector<NULL_INPUT_ELEMENT> instanceElements;
+	unsigned int vertexSize;
+	unsigned int instanceSize;
+};
+
+struct RootSignature
+{
+	std::vector<unsigned int> num32bitValues;		// Quantidade de valores de cada registrador de constantes de 32 bits.
+	unsigned int numConstantBuffers;
+	unsigned int numShaderResources;
+};
+
+struct ShaderBinary
+{
+	std::string filename;
+	std::vector<unsigned char> bytecode;
+	const void* pProgram;							// Registrado por RegisterNullShader.
+};
+
+// As descrições dos estados são copiadas na criação, como em um pipeline do Direct3D 12.
+struct PipelineState
+{
+	RootSignature rootSignature;
+	InputLayout inputLayout;
+	const void* pVertexProgram;
+	const void* pPixelProgram;
+	PRIMITIVE_TOPOLOGY_TYPE primitiveTopologyType;
+	BLEND_DESC blendDesc;
+	RASTERIZER_DESC rasterizerDesc;
+	DEPTH_STENCIL_DESC depthStencilDesc;
+	RESOURCE_FORMAT renderTargetFormat;
+	RESOURCE_FORMAT depthStencilFormat;
+};
+
+// ---------------------------------------------------- 1.2. Estado do dispositivo -------------------------------------------------------- //
+
+typedef struct NULL_DESCRIPTOR
+{
+	Buffer* buffer;
+	Texture* texture;
+} NULL_DESCRIPTOR;
+
+typedef struct NULL_DRAW_DESC
+{
+	bool indexed;
+	unsigned int countPerInstance;					// Vértices ou índices por instância.
+	unsigned int instanceCount;
+	unsigned int startLocation;						// Primeiro vértice ou primeiro índice.
+	unsigned int baseVertexLocation;				// Somado aos índices (apenas desenhos indexados).
+	unsigned int startInstanceLocation;
+} NULL_DRAW_DESC;
+
+// Funções chamadas pelo backend nulo após a validação das operações executadas na CPU por outros backends.
+typedef struct NULL_BACKEND_HOOKS
+{
+	void (*Draw)(const NULL_DRAW_DESC* draw, void* pUserData);
+	void (*RenderFrame)(void* pUserData);
+	void* pUserData;
+} NULL_BACKEND_HOOKS;
+
+typedef struct NULL_DEVICE
+{
+	bool deviceCreated;
+	bool inScene;
+
+	// Estado da cena (reiniciado por BeginScene).
+	PipelineState* pipelineState;
+	Texture* renderTarget;
+	unsigned int numViewports;
+	VIEWPORT viewports[NULL_MAX_VIEWPORTS];
+	unsigned int numScissorRects;
+	SCISSOR_RECT scissorRects[NULL_MAX_VIEWPORTS];
+	PRIMITIVE_TOPOLOGY primitiveTopology;
+	std::vector<unsigned char> vertexData;
+	unsigned int vertexStride;
+	bool vertexDataSet;
+	std::vector<unsigned char> instanceData;
+	unsigned int instanceStride;
+	unsigned int instanceStepRate;
+	bool instanceDataSet;
+	std::vector<unsigned int> indexData;
+	bool indexDataSet;
+	unsigned int descriptorTableBase;
+	unsigned int rootConstants[NULL_MAX_ROOT_CONSTANTS];	// Valores dos registradores, na ordem da assinatura raiz.
+
+	PipelineState* lastPipelineState;				// Pipeline da cena anterior (para contabilizar as mudanças de pipeline).
+
+	std::unordered_map<unsigned int, NULL_DESCRIPTOR> descriptors;
+	std::unordered_map<std::string, const void*> registeredShaders;
+	std::vector<std::shared_ptr<void>> pipelineObjects;	// Objetos do pipeline gráfico (excluídos por ReleaseDevice).
+
+	NULL_BACKEND_STATS stats;
+	bool recordCalls;
+	std::vector<NULL_CALL> calls;
+	NULL_BACKEND_HOOKS hooks;
+} NULL_DEVICE;
+
+// ------------------------------------------------------ 2. Declaração das funções ------------------------------------------------------- //
+
+NULL_DEVICE& GetNullDevice();
+void SetNullBackendHooks(const NULL_BACKEND_HOOKS* hooks);
+
+// Recursos associados aos registradores do pipeline ativo (b: constantes de 32 bits seguidas dos constant buffers da tabela de
+// descritores; t: shader resources da tabela). Retornam NULL se o registrador não estiver associado a um recurso.
+const void* GetNullConstantRegister(unsigned int shaderRegister);
+const NULL_DESCRIPTOR* GetNullShaderResourceRegister(unsigned int shaderRegister);
+
+// Alocação do buffer de profundidade e stencil de um render target.
+void EnsureNullDepthStencil(Texture* renderTarget);
+
+#endif  // _LEANDX12_NULL_INTERNAL_
@@ -0,0 +1,1546 @@
+// Descrição: Implementação do rasterizador de software de LeanDX12 (LeanDX12Software.h).
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstring>
+#include <memory>
+#include <unordered_set>
+#include <vector>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define LEANDX12_SSE2
+#include <emmintrin.h>
+#endif
+
+#include "LeanDX12Software.h"
+#include "LeanDX12NullInternal.h"
+#include "../Extensions/LeanDX12Format.h"
+#include "../Extensions/LeanDX12Parallel.h"
+
+// Precisão das coordenadas de tela (1/16 de pixel). Os triângulos são recortados em |x|, |y| <= SOFTWARE_GUARD_BAND pixels, o que mantém
+// as funções de aresta de uma linha de um bloco dentro de 32 bits.
+#define SOFTWARE_SUBPIXEL_BITS 4
+#define SOFTWARE_SUBPIXEL_SCALE 16
+#define SOFTWARE_GUARD_BAND 16384.0f
+// Primitivas por bloco de trabalho de ParallelFor na montagem e vértices por bloco no vertex program.
+#define SOFTWARE_PRIMITIVES_PER_TASK 1024
+#define SOFTWARE_VERTICES_PER_TASK 256
+// Nos desenhos indexados, a posição de cada vértice processado é obtida por uma tabela indexada pelo valor quando o intervalo de valores
+// tem no máximo SOFTWARE_VERTEX_TABLE_RATIO entradas por índice, e por busca binária nos valores ordenados caso contrário.
+#define SOFTWARE_VERTEX_TABLE_RATIO 4
+// Vértices de um polígono recortado (3 + um por plano de recorte) e floats de um vértice (posição + valores interpolados).
+#define SOFTWARE_MAX_CLIP_VERTICES 10
+#define SOFTWARE_MAX_VERTEX_SIZE (4 + SOFTWARE_MAX_VARYINGS)
+// LeanDX12.h não define o valor de referência do stencil.
+#define SOFTWARE_STENCIL_REFERENCE 0
+
+namespace
+{
+	typedef struct SOFTWARE_PROGRAM
+	{
+		SOFTWARE_VERTEX_PROGRAM vertexProgram;
+		SOFTWARE_PIXEL_PROGRAM pixelProgram;
+		unsigned int numVaryings;
+		void* pUserData;
+	} SOFTWARE_PROGRAM;
+
+	typedef enum PRIMITIVE_KIND
+	{
+		PRIMITIVE_KIND_NONE,
+		PRIMITIVE_KIND_POINT,
+		PRIMITIVE_KIND_LINE,
+		PRIMITIVE_KIND_TRIANGLE
+	} PRIMITIVE_KIND;
+
+	// Primitiva preparada para a rasterização. Os atributos (profundidade, 1/w e valores interpolados divididos por w) ficam em
+	// BIN_CHUNK::attributes: planos (valor no vértice de referência, derivadas em x e y) nos triângulos, valores nas duas extremidades
+	// nas linhas e o valor do vértice nos pontos.
+	typedef struct RASTER_PRIMITIVE
+	{
+		PRIMITIVE_KIND kind;
+		bool frontFace;
+		unsigned int primitiveID;
+		int minX, minY, maxX, maxY;					// Retângulo de pixels (inclusivo), dentro da área de rasterização.
+		int edgeA[3], edgeB[3];						// Funções de aresta dos triângulos: A * x + B * y + C >= 0 no interior (1/16 de pixel).
+		long long edgeC[3];
+		float x0, y0, x1, y1;						// Vértice de referência (triângulos) ou extremidades (linhas).
+		unsigned int attributeOffset;
+	} RASTER_PRIMITIVE;
+
+	// Resultado da montagem de um grupo de primitivas: as listas dos blocos preservam a ordem das primitivas.
+	typedef struct BIN_CHUNK
+	{
+		std::vector<RASTER_PRIMITIVE> primitives;
+		std::vector<float> attributes;
+		std::vector<std::vector<unsigned int>> tiles;
+		unsigned long long numPrimitives;
+		unsigned long long numCulled;
+		unsigned long long numClipped;
+		unsigned long long numBinned;
+	} BIN_CHUNK;
+
+	typedef struct SCREEN_VERTEX
+	{
+		float x, y, z, invW;
+		const float* varyings;						// Valores interpolados (não divididos por w).
+	} SCREEN_VERTEX;
+
+	typedef struct DRAW_CONTEXT
+	{
+		const NULL_DEVICE* device;
+		const PipelineState* pipelineState;
+		const SOFTWARE_PROGRAM* vertexProgram;
+		const SOFTWARE_PROGRAM* pixelProgram;			// NULL: apenas profundidade e stencil.
+		SOFTWARE_SHADER_REGISTERS registers;
+		NULL_DRAW_DESC draw;
+
+		unsigned int numVaryings;
+		unsigned int numAttributes;						// Profundidade, 1/w e valores interpolados.
+		unsigned int vertexSize;						// Floats por vértice processado.
+		unsigned int rangeStart;						// Menor valor de índice (ou primeiro vértice) do desenho.
+		unsigned int numVertices;						// Vértices processados por instância.
+		const unsigned int* vertexValues;				// Valores de índice processados (NULL nos desenhos não indexados).
+		const unsigned int* vertexPositions;			// Posição de cada valor a partir de rangeStart (NULL: busca binária).
+		const float* shadedVertices;
+
+		PRIMITIVE_TOPOLOGY topology;
+		PRIMITIVE_KIND kind;
+		unsigned int primitivesPerInstance;
+		unsigned int numPrimitives;
+
+		float viewportX, viewportY, viewportHalfWidth, viewportHalfHeight;
+		float guardBandMinX, guardBandMaxX, guardBandMinY, guardBandMaxY;
+		int rectMinX, rectMinY, rectMaxX, rectMaxY;		// Viewport, scissor e render target (inclusivo).
+		bool depthClip;
+		bool wireframe;
+		CULL_MODE cullMode;
+		bool frontCounterClockwise;
+		float depthBias, depthBiasClamp, slopeScaledDepthBias;
+		bool unormDepth;
+
+		unsigned char* pColor;
+		float* pDepth;									// NULL se o pipeline não possuir buffer de profundidade.
+		unsigned char* pStencil;
+		unsigned int width, height, texelSize;
+		RESOURCE_FORMAT format;
+		bool unormColor;
+		unsigned int numTilesX, numTilesY;
+		bool depthEnable, stencilEnable;
+		DEPTH_STENCIL_DESC depthStencilDesc;
+		BLEND_DESC blendDesc;
+
+		std::vector<BIN_CHUNK>* chunks;					// Grupos de montagem (mantidos entre os desenhos, com a memória já alocada).
+		unsigned int numChunks;
+		const std::vector<unsigned int>* activeTiles;
+	} DRAW_CONTEXT;
+
+	typedef struct PIXEL_COUNTERS
+	{
+		unsigned long long numShaded;
+		unsigned long long numWritten;
+	} PIXEL_COUNTERS;
+
+	typedef struct SOFTWARE_RASTERIZER
+	{
+		bool initialized;
+		std::vector<std::unique_ptr<SOFTWARE_PROGRAM>> programs;	// Mantidos até o fim do programa (referenciados pelos ShaderBinary).
+		std::unordered_set<const void*> vertexPrograms;
+		std::unordered_set<const void*> pixelPrograms;
+		std::vector<float> shadedVertices;
+		std::vector<unsigned int> vertexValues, vertexPositions;
+		std::vector<BIN_CHUNK> chunks;
+		std::vector<unsigned int> activeTiles;
+		std::atomic<unsigned long long> stats[sizeof(SOFTWARE_RASTERIZER_STATS) / sizeof(unsigned long long)];
+	} SOFTWARE_RASTERIZER;
+
+	enum STAT_INDEX
+	{
+		STAT_DRAWS, STAT_SKIPPED_DRAWS, STAT_VERTICES_SHADED, STAT_PRIMITIVES, STAT_PRIMITIVES_CULLED, STAT_PRIMITIVES_CLIPPED,
+		STAT_BINNED_PRIMITIVES, STAT_PIXELS_SHADED, STAT_PIXELS_WRITTEN
+	};
+
+	SOFTWARE_RASTERIZER& GetRasterizer()
+	{
+		static SOFTWARE_RASTERIZER rasterizer;
+		return rasterizer;
+	}
+
+	void AddStat(STAT_INDEX index, unsigned long long value)
+	{
+		if (value != 0)
+			GetRasterizer().stats[index].fetch_add(value, std::memory_order_relaxed);
+	}
+
+	// ---------------------------------------------------------- Cores e blending ------------------------------------------------------- //
+
+	float SrgbToLinear(float value)
+	{
+		return value <= 0.04045f ? value / 12.92f : powf((value + 0.055f) / 1.055f, 2.4f);
+	}
+
+	float LinearToSrgb(float value)
+	{
+		return value <= 0.0031308f ? value * 12.92f : 1.055f * powf(value, 1.0f / 2.4f) - 0.055f;
+	}
+
+	const float* GetSrgbTable()
+	{
+		static float table[256];
+		static bool initialized = [] { for (int i = 0; i < 256; i++) table[i] = SrgbToLinear(i / 255.0f); return true; }();
+		(void)initialized;
+		return table;
+	}
+
+	float Saturate(float value)
+	{
+		return value > 0.0f ? (value < 1.0f ? value : 1.0f) : 0.0f;
+	}
+
+	bool IsDirectFormat(RESOURCE_FORMAT format)
+	{
+		return format == RESOURCE_FORMAT_R8G8B8A8_UNORM || format == RESOURCE_FORMAT_R8G8B8A8_UNORM_SRGB ||
+			format == RESOURCE_FORMAT_R16G16B16A16_FLOAT || format == RESOURCE_FORMAT_R32G32B32A32_FLOAT || format == RESOURCE_FORMAT_R32_FLOAT;
+	}
+
+	void LoadColor(const DRAW_CONTEXT& context, const unsigned char* pTexel, float color[4])
+	{
+		switch (context.format)
+		{
+		case RESOURCE_FORMAT_R8G8B8A8_UNORM:
+			for (int i = 0; i < 4; i++)
+				color[i] = pTexel[i] / 255.0f;
+			break;
+		case RESOURCE_FORMAT_R8G8B8A8_UNORM_SRGB:
+			for (int i = 0; i < 3; i++)
+				color[i] = GetSrgbTable()[pTexel[i]];
+			color[3] = pTexel[3] / 255.0f;
+			break;
+		case RESOURCE_FORMAT_R16G16B16A16_FLOAT:
+			for (int i = 0; i < 4; i++)
+				color[i] = HalfToFloat(((const unsigned short*)pTexel)[i]);
+			break;
+		case RESOURCE_FORMAT_R32G32B32A32_FLOAT:
+			memcpy(color, pTexel, 4 * sizeof(float));
+			break;
+		case RESOURCE_FORMAT_R32_FLOAT:
+			memcpy(color, pTexel, sizeof(float));
+			color[1] = color[2] = 0.0f;
+			color[3] = 1.0f;
+			break;
+		default:
+			ConvertFormat(context.format, pTexel, 0, RESOURCE_FORMAT_R32G32B32A32_FLOAT, color, 0, 1, 1);
+			break;
+		}
+	}
+
+	void StoreColor(const DRAW_CONTEXT& context, unsigned char* pTexel, const float color[4])
+	{
+		switch (context.format)
+		{
+		case RESOURCE_FORMAT_R8G8B8A8_UNORM:
+		{
+#if defined(LEANDX12_SSE2)
+			__m128 value = _mm_min_ps(_mm_max_ps(_mm_loadu_ps(color), _mm_setzero_ps()), _mm_set1_ps(1.0f));
+			__m128i integer = _mm_cvtps_epi32(_mm_mul_ps(value, _mm_set1_ps(255.0f)));
+			integer = _mm_packus_epi16(_mm_packs_epi32(integer, integer), integer);
+			int packed = _mm_cvtsi128_si32(integer);
+			memcpy(pTexel, &packed, 4);
+#else
+			for (int i = 0; i < 4; i++)
+				pTexel[i] = (unsigned char)(Saturate(color[i]) * 255.0f + 0.5f);
+#endif
+			break;
+		}
+		case RESOURCE_FORMAT_R8G8B8A8_UNORM_SRGB:
+			for (int i = 0; i < 3; i++)
+				pTexel[i] = (unsigned char)(LinearToSrgb(Saturate(color[i])) * 255.0f + 0.5f);
+			pTexel[3] = (unsigned char)(Saturate(color[3]) * 255.0f + 0.5f);
+			break;
+		case RESOURCE_FORMAT_R16G16B16A16_FLOAT:
+			for (int i = 0; i < 4; i++)
+				((unsigned short*)pTexel)[i] = FloatToHalf(color[i]);
+			break;
+		case RESOURCE_FORMAT_R32G32B32A32_FLOAT:
+			memcpy(pTexel, color, 4 * sizeof(float));
+			break;
+		case RESOURCE_FORMAT_R32_FLOAT:
+			memcpy(pTexel, color, sizeof(float));
+			break;
+		default:
+			ConvertFormat(RESOURCE_FORMAT_R32G32B32A32_FLOAT, color, 0, context.format, pTexel, 0, 1, 1);
+			break;
+		}
+	}
+
+	// Fator de blending do canal channel (0 a 2: cor, 3: alfa). O fator constante é (1, 1, 1, 1) e os fatores SRC1 usam a cor de origem.
+	float BlendFactor(BLEND_FACTOR factor, const float source[4], const float dest[4], int channel)
+	{
+		switch (factor)
+		{
+		case BLEND_FACTOR_ZERO: return 0.0f;
+		case BLEND_FACTOR_ONE: return 1.0f;
+		case BLEND_FACTOR_SRC_COLOR: case BLEND_FACTOR_SRC1_COLOR: return source[channel];
+		case BLEND_FACTOR_INV_SRC_COLOR: case BLEND_FACTOR_INV_SRC1_COLOR: return 1.0f - source[channel];
+		case BLEND_FACTOR_SRC_ALPHA: case BLEND_FACTOR_SRC1_ALPHA: return source[3];
+		case BLEND_FACTOR_INV_SRC_ALPHA: case BLEND_FACTOR_INV_SRC1_ALPHA: return 1.0f - source[3];
+		case BLEND_FACTOR_DEST_ALPHA: return dest[3];
+		case BLEND_FACTOR_INV_DEST_ALPHA: return 1.0f - dest[3];
+		case BLEND_FACTOR_DEST_COLOR: return dest[channel];
+		case BLEND_FACTOR_INV_DEST_COLOR: return 1.0f - dest[channel];
+		case BLEND_FACTOR_SRC_ALPHA_SAT: return channel < 3 ? std::min(source[3], 1.0f - dest[3]) : 1.0f;
+		case BLEND_FACTOR_CUSTOM: return 1.0f;
+		case BLEND_FACTOR_INV_CUSTOM: return 0.0f;
+		default: return 0.0f;
+		}
+	}
+
+	float BlendChannel(BLEND_OPERATION operation, float source, float sourceFactor, float dest, float destFactor)
+	{
+		switch (operation)
+		{
+		case BLEND_OPERATION_SUBTRACT: return source * sourceFactor - dest * destFactor;
+		case BLEND_OPERATION_REV_SUBTRACT: return dest * destFactor - source * sourceFactor;
+		case BLEND_OPERATION_OP_MIN: return std::min(source, dest);
+		case BLEND_OPERATION_OP_MAX: return std::max(source, dest);
+		default: return source * sourceFactor + dest * destFactor;
+		}
+	}
+
+	void WriteColor(const DRAW_CONTEXT& context, int x, int y, float color[4])
+	{
+		unsigned char* pTexel = context.pColor + ((size_t)y * context.width + x) * context.texelSize;
+		if (context.unormColor)
+			for (int i = 0; i < 4; i++)
+				color[i] = Saturate(color[i]);
+
+		const BLEND_DESC& blend = context.blendDesc;
+		if (blend.BlendEnable)
+		{
+			float dest[4];
+			LoadColor(context, pTexel, dest);
+
+			float result[4];
+			for (int i = 0; i < 4; i++)
+			{
+				BLEND_FACTOR sourceFactor = i < 3 ? blend.SrcBlend : blend.SrcBlendAlpha;
+				BLEND_FACTOR destFactor = i < 3 ? blend.DestBlend : blend.DestBlendAlpha;
+				BLEND_OPERATION operation = i < 3 ? blend.BlendOp : blend.BlendOpAlpha;
+				result[i] = BlendChannel(operation, color[i], BlendFactor(sourceFactor, color, dest, i), dest[i],
+					BlendFactor(destFactor, color, dest, i));
+			}
+			memcpy(color, result, sizeof(result));
+		}
+
+		StoreColor(context, pTexel, color);
+	}
+
+	// ------------------------------------------------------- Profundidade e stencil ---------------------------------------------------- //
+
+	template <typename T>
+	bool Compare(COMPARISON_FUNC func, T a, T b)
+	{
+		switch (func)
+		{
+		case COMPARISON_FUNC_NEVER: return false;
+		case COMPARISON_FUNC_LESS: return a < b;
+		case COMPARISON_FUNC_EQUAL: return a == b;
+		case COMPARISON_FUNC_LESS_EQUAL: return a <= b;
+		case COMPARISON_FUNC_GREATER: return a > b;
+		case COMPARISON_FUNC_NOT_EQUAL: return a != b;
+		case COMPARISON_FUNC_GREATER_EQUAL: return a >= b;
+		default: return true;
+		}
+	}
+
+	void ApplyStencilOperation(const DRAW_CONTEXT& context, STENCIL_OPERATION operation, unsigned char* pStencil)
+	{
+		unsigned char value = *pStencil;
+		switch (operation)
+		{
+		case STENCIL_OPERATION_ZERO: value = 0; break;
+		case STENCIL_OPERATION_REPLACE: value = SOFTWARE_STENCIL_REFERENCE; break;
+		case STENCIL_OPERATION_INCR_SAT: value = value < 0xFF ? value + 1 : value; break;
+		case STENCIL_OPERATION_DECR_SAT: value = value > 0 ? value - 1 : value; break;
+		case STENCIL_OPERATION_INVERT: value = ~value; break;
+		case STENCIL_OPERATION_INCR: value++; break;
+		case STENCIL_OPERATION_DECR: value--; break;
+		default: return;
+		}
+
+		unsigned char writeMask = context.depthStencilDesc.StencilWriteMask;
+		*pStencil = (unsigned char)((*pStencil & ~writeMask) | (value & writeMask));
+	}
+
+	// Testes de stencil e profundidade (antes do pixel program, sem gravação). As operações de falha são aplicadas aqui.
+	bool DepthStencilTest(const DRAW_CONTEXT& context, size_t index, float z, bool frontFace)
+	{
+		if (context.pDepth == nullptr)
+			return true;
+
+		const DEPTH_STENCIL_DESC& desc = context.depthStencilDesc;
+		if (context.stencilEnable)
+		{
+			COMPARISON_FUNC func = frontFace ? desc.FrontFaceStencilFunc : desc.BackFaceStencilFunc;
+			unsigned char mask = desc.StencilReadMask;
+			if (!Compare(func, (unsigned char)(SOFTWARE_STENCIL_REFERENCE & mask), (unsigned char)(context.pStencil[index] & mask)))
+			{
+				ApplyStencilOperation(context, frontFace ? desc.FrontFaceStencilFailOp : desc.BackFaceStencilFailOp, &context.pStencil[index]);
+				return false;
+			}
+		}
+
+		if (context.depthEnable && !Compare(desc.DepthFunc, z, context.pDepth[index]))
+		{
+			if (context.stencilEnable)
+			{
+				STENCIL_OPERATION operation = frontFace ? desc.FrontFaceStencilDepthFailOp : desc.BackFaceStencilDepthFailOp;
+				ApplyStencilOperation(context, operation, &context.pStencil[index]);
+			}
+			return false;
+		}
+
+		return true;
+	}
+
+	void DepthStencilWrite(const DRAW_CONTEXT& context, size_t index, float z, bool frontFace)
+	{
+		if (context.pDepth == nullptr)
+			return;
+
+		if (context.stencilEnable)
+		{
+			const DEPTH_STENCIL_DESC& desc = context.depthStencilDesc;
+			ApplyStencilOperation(context, frontFace ? desc.FrontFaceStencilPassOp : desc.BackFaceStencilPassOp, &context.pStencil[index]);
+		}
+
+		if (context.depthEnable)
+			context.pDepth[index] = z;
+	}
+
+	// Processa um pixel coberto. interpolate(&w) retorna os valores interpolados e o w de recorte do pixel, e é chamada apenas se os
+	// testes de profundidade e stencil forem aprovados.
+	template <typename INTERPOLATE>
+	void ShadePixel(const DRAW_CONTEXT& context, const RASTER_PRIMITIVE& primitive, int x, int y, float z, INTERPOLATE interpolate,
+		PIXEL_COUNTERS& counters)
+	{
+		z = Saturate(z);
+		size_t index = (size_t)y * context.width + x;
+		if (!DepthStencilTest(context, index, z, primitive.frontFace))
+			return;
+
+		float color[4];
+		if (context.pixelProgram != nullptr)
+		{
+			float w;
+			const float* varyings = interpolate(&w);
+
+			SOFTWARE_PIXEL_INPUT input;
+			input.registers = &context.registers;
+			input.position[0] = x + 0.5f;
+			input.position[1] = y + 0.5f;
+			input.position[2] = z;
+			input.position[3] = w;
+			input.frontFace = primitive.frontFace;
+			input.primitiveID = primitive.primitiveID;
+
+			counters.numShaded++;
+			if (!context.pixelProgram->pixelProgram(&input, varyings, color, context.pixelProgram->pUserData))
+				return;
+		}
+
+		DepthStencilWrite(context, index, z, primitive.frontFace);
+		if (context.pixelProgram != nullptr)
+		{
+			WriteColor(context, x, y, color);
+			counters.numWritten++;
+		}
+	}
+
+	// ---------------------------------------------------------- Rasterização ----------------------------------------------------------- //
+
+	int ClampEdge(long long value)
+	{
+		const long long limit = 1ll << 30;
+		return (int)(value > limit ? limit : (value < -limit ? -limit : value));
+	}
+
+#if defined(LEANDX12_SSE2)
+	// Funções de aresta de 4 pixels consecutivos (step: variação por pixel).
+	__m128i LaneEdges(int value, int step)
+	{
+		return _mm_add_epi32(_mm_set1_epi32(value), _mm_setr_epi32(0, step, 2 * step, 3 * step));
+	}
+#endif
+
+	void RasterizeTriangle(const DRAW_CONTEXT& context, const RASTER_PRIMITIVE& primitive, const float* attributes,
+		int minX, int minY, int maxX, int maxY, PIXEL_COUNTERS& counters)
+	{
+		const int scale = SOFTWARE_SUBPIXEL_SCALE;
+		const float* zPlane = attributes;
+		const float* invWPlane = attributes + 3;
+		const float* varyingPlanes = attributes + 6;
+		unsigned int numVaryings = context.numVaryings;
+#if !defined(LEANDX12_SSE2)
+		float varyings[SOFTWARE_MAX_VARYINGS];
+#endif
+
+		for (int y = minY; y <= maxY; y++)
+		{
+			float dy = y + 0.5f - primitive.y0;
+
+			// A função de aresta no início da linha é calculada em 64 bits; ao longo do bloco, a variação cabe em 32 bits.
+			int rowEdge[3];
+			for (int edge = 0; edge < 3; edge++)
+				rowEdge[edge] = ClampEdge((long long)primitive.edgeA[edge] * (scale * minX + scale / 2) +
+					(long long)primitive.edgeB[edge] * (scale * y + scale / 2) + primitive.edgeC[edge]);
+
+#if defined(LEANDX12_SSE2)
+			__m128i edge0 = LaneEdges(rowEdge[0], primitive.edgeA[0] * scale);
+			__m128i edge1 = LaneEdges(rowEdge[1], primitive.edgeA[1] * scale);
+			__m128i edge2 = LaneEdges(rowEdge[2], primitive.edgeA[2] * scale);
+			const __m128i step0 = _mm_set1_epi32(4 * primitive.edgeA[0] * scale);
+			const __m128i step1 = _mm_set1_epi32(4 * primitive.edgeA[1] * scale);
+			const __m128i step2 = _mm_set1_epi32(4 * primitive.edgeA[2] * scale);
+			const __m128 laneOffsets = _mm_setr_ps(0.5f, 1.5f, 2.5f, 3.5f);
+			const __m128 zRow = _mm_set1_ps(zPlane[0] + zPlane[2] * dy);
+			const __m128 invWRow = _mm_set1_ps(invWPlane[0] + invWPlane[2] * dy);
+
+			for (int x = minX; x <= maxX; x += 4)
+			{
+				// Os pixels com as três funções de aresta não negativas (bit de sinal zerado) estão cobertos.
+				__m128i edges = _mm_or_si128(_mm_or_si128(edge0, edge1), edge2);
+				int mask = ~_mm_movemask_ps(_mm_castsi128_ps(edges)) & 0xF;
+				if (maxX - x < 3)
+					mask &= (1 << (maxX - x + 1)) - 1;
+
+				if (mask != 0)
+				{
+					__m128 dx = _mm_sub_ps(_mm_add_ps(_mm_set1_ps((float)x), laneOffsets), _mm_set1_ps(primitive.x0));
+					float z[4];
+					_mm_storeu_ps(z, _mm_add_ps(zRow, _mm_mul_ps(_mm_set1_ps(zPlane[1]), dx)));
+
+					// Os valores interpolados dos 4 pixels são calculados juntos, na primeira vez em que um deles é necessário.
+					float w[4];
+					float laneVaryings[4][SOFTWARE_MAX_VARYINGS];
+					bool interpolated = false;
+					auto interpolateLanes = [&]()
+					{
+						__m128 w4 = _mm_div_ps(_mm_set1_ps(1.0f), _mm_add_ps(invWRow, _mm_mul_ps(_mm_set1_ps(invWPlane[1]), dx)));
+						_mm_storeu_ps(w, w4);
+						for (unsigned int i = 0; i < numVaryings; i++)
+						{
+							const float* plane = varyingPlanes + 3 * i;
+							__m128 value = _mm_add_ps(_mm_set1_ps(plane[0] + plane[2] * dy), _mm_mul_ps(_mm_set1_ps(plane[1]), dx));
+							float values[4];
+							_mm_storeu_ps(values, _mm_mul_ps(value, w4));
+							for (int lane = 0; lane < 4; lane++)
+								laneVaryings[lane][i] = values[lane];
+						}
+						interpolated = true;
+					};
+
+					for (int lane = 0; lane < 4; lane++)
+					{
+						if ((mask & (1 << lane)) == 0)
+							continue;
+
+						ShadePixel(context, primitive, x + lane, y, z[lane], [&](float* pW) -> const float*
+						{
+							if (!interpolated)
+								interpolateLanes();
+							*pW = w[lane];
+							return laneVaryings[lane];
+						}, counters);
+					}
+				}
+
+				edge0 = _mm_add_epi32(edge0, step0);
+				edge1 = _mm_add_epi32(edge1, step1);
+				edge2 = _mm_add_epi32(edge2, step2);
+			}
+#else
+			for (int x = minX; x <= maxX; x++)
+			{
+				int offset = (x - minX) * scale;
+				if ((rowEdge[0] + primitive.edgeA[0] * offset) < 0 || (rowEdge[1] + primitive.edgeA[1] * offset) < 0 ||
+					(rowEdge[2] + primitive.edgeA[2] * offset) < 0)
+					continue;
+
+				float pixelDx = x + 0.5f - primitive.x0;
+				float z = zPlane[0] + zPlane[1] * pixelDx + zPlane[2] * dy;
+				ShadePixel(context, primitive, x, y, z, [&](float* pW) -> const float*
+				{
+					float w = 1.0f / (invWPlane[0] + invWPlane[1] * pixelDx + invWPlane[2] * dy);
+					for (unsigned int i = 0; i < numVaryings; i++)
+					{
+						const float* plane = varyingPlanes + 3 * i;
+						varyings[i] = (plane[0] + plane[1] * pixelDx + plane[2] * dy) * w;
+					}
+					*pW = w;
+					return varyings;
+				}, counters);
+			}
+#endif
+		}
+	}
+
+	// Pixels cujos centros estão no intervalo [início, fim) do eixo principal da linha.
+	void RasterizeLine(const DRAW_CONTEXT& context, const RASTER_PRIMITIVE& primitive, const float* attributes,
+		int minX, int minY, int maxX, int maxY, PIXEL_COUNTERS& counters)
+	{
+		float dx = primitive.x1 - primitive.x0;
+		float dy = primitive.y1 - primitive.y0;
+		bool xMajor = fabsf(dx) >= fabsf(dy);
+
+		float start = xMajor ? primitive.x0 : primitive.y0;
+		float end = xMajor ? primitive.x1 : primitive.y1;
+		float delta = xMajor ? dx : dy;
+		int first, last;
+		if (delta > 0.0f)
+		{
+			first = (int)ceilf(start - 0.5f);
+			last = (int)ceilf(end - 0.5f) - 1;
+		}
+		else
+		{
+			first = (int)floorf(end - 0.5f) + 1;
+			last = (int)floorf(start - 0.5f);
+		}
+
+		first = std::max(first, xMajor ? minX : minY);
+		last = std::min(last, xMajor ? maxX : maxY);
+
+		unsigned int numVaryings = context.numVaryings;
+		float varyings[SOFTWARE_MAX_VARYINGS];
+		for (int major = first; major <= last; major++)
+		{
+			float t = (major + 0.5f - start) / delta;
+			float minorValue = xMajor ? primitive.y0 + t * dy : primitive.x0 + t * dx;
+			int minor = (int)floorf(minorValue);
+			int x = xMajor ? major : minor;
+			int y = xMajor ? minor : major;
+			if (x < minX || x > maxX || y < minY || y > maxY)
+				continue;
+
+			float z = attributes[0] + t * (attributes[1] - attributes[0]);
+			ShadePixel(context, primitive, x, y, z, [&](float* pW) -> const float*
+			{
+				float w = 1.0f / (attributes[2] + t * (attributes[3] - attributes[2]));
+				for (unsigned int i = 0; i < numVaryings; i++)
+				{
+					const float* values = attributes + 4 + 2 * i;
+					varyings[i] = (values[0] + t * (values[1] - values[0])) * w;
+				}
+				*pW = w;
+				return varyings;
+			}, counters);
+		}
+	}
+
+	void RasterizePoint(const DRAW_CONTEXT& context, const RASTER_PRIMITIVE& primitive, const float* attributes,
+		int minX, int minY, int maxX, int maxY, PIXEL_COUNTERS& counters)
+	{
+		if (primitive.minX < minX || primitive.minX > maxX || primitive.minY < minY || primitive.minY > maxY)
+			return;
+
+		unsigned int numVaryings = context.numVaryings;
+		float varyings[SOFTWARE_MAX_VARYINGS];
+		ShadePixel(context, primitive, primitive.minX, primitive.minY, attributes[0], [&](float* pW) -> const float*
+		{
+			float w = 1.0f / attributes[1];
+			for (unsigned int i = 0; i < numVaryings; i++)
+				varyings[i] = attributes[2 + i] * w;
+			*pW = w;
+			return varyings;
+		}, counters);
+	}
+
+	void RasterizeTiles(unsigned int begin, unsigned int end, void* pUserData)
+	{
+		const DRAW_CONTEXT& context = *(const DRAW_CONTEXT*)pUserData;
+		PIXEL_COUNTERS counters = {};
+
+		for (unsigned int i = begin; i < end; i++)
+		{
+			unsigned int tile = (*context.activeTiles)[i];
+			int tileMinX = std::max(context.rectMinX, (int)(tile % context.numTilesX) * SOFTWARE_TILE_SIZE);
+			int tileMinY = std::max(context.rectMinY, (int)(tile / context.numTilesX) * SOFTWARE_TILE_SIZE);
+			int tileMaxX = std::min(context.rectMaxX, (int)(tile % context.numTilesX) * SOFTWARE_TILE_SIZE + SOFTWARE_TILE_SIZE - 1);
+			int tileMaxY = std::min(context.rectMaxY, (int)(tile / context.numTilesX) * SOFTWARE_TILE_SIZE + SOFTWARE_TILE_SIZE - 1);
+
+			for (unsigned int chunkIndex = 0; chunkIndex < context.numChunks; chunkIndex++)
+			{
+				const BIN_CHUNK& chunk = (*context.chunks)[chunkIndex];
+				for (unsigned int primitiveIndex : chunk.tiles[tile])
+				{
+					const RASTER_PRIMITIVE& primitive = chunk.primitives[primitiveIndex];
+					const float* attributes = chunk.attributes.data() + primitive.attributeOffset;
+					int minX = std::max(tileMinX, primitive.minX);
+					int minY = std::max(tileMinY, primitive.minY);
+					int maxX = std::min(tileMaxX, primitive.maxX);
+					int maxY = std::min(tileMaxY, primitive.maxY);
+					if (minX > maxX || minY > maxY)
+						continue;
+
+					switch (primitive.kind)
+					{
+					case PRIMITIVE_KIND_TRIANGLE: RasterizeTriangle(context, primitive, attributes, minX, minY, maxX, maxY, counters); break;
+					case PRIMITIVE_KIND_LINE: RasterizeLine(context, primitive, attributes, minX, minY, maxX, maxY, counters); break;
+					default: RasterizePoint(context, primitive, attributes, minX, minY, maxX, maxY, counters); break;
+					}
+				}
+			}
+		}
+
+		AddStat(STAT_PIXELS_SHADED, counters.numShaded);
+		AddStat(STAT_PIXELS_WRITTEN, counters.numWritten);
+	}
+
+	// ------------------------------------------------------ Montagem e distribuição ---------------------------------------------------- //
+
+	long long FloorDivide(long long value, long long divisor)
+	{
+		return value >= 0 ? value / divisor : -((-value + divisor - 1) / divisor);
+	}
+
+	void BinPrimitive(const DRAW_CONTEXT& context, BIN_CHUNK& chunk, const RASTER_PRIMITIVE& primitive)
+	{
+		unsigned int primitiveIndex = (unsigned int)chunk.primitives.size();
+		chunk.primitives.push_back(primitive);
+
+		for (int tileY = primitive.minY / SOFTWARE_TILE_SIZE; tileY <= primitive.maxY / SOFTWARE_TILE_SIZE; tileY++)
+		{
+			for (int tileX = primitive.minX / SOFTWARE_TILE_SIZE; tileX <= primitive.maxX / SOFTWARE_TILE_SIZE; tileX++)
+			{
+				chunk.tiles[tileY * context.numTilesX + tileX].push_back(primitiveIndex);
+				chunk.numBinned++;
+			}
+		}
+	}
+
+	bool IsCulled(const DRAW_CONTEXT& context, bool frontFace)
+	{
+		return (context.cullMode == CULL_MODE_FRONT && frontFace) || (context.cullMode == CULL_MODE_BACK && !frontFace);
+	}
+
+	SCREEN_VERTEX ToScreen(const DRAW_CONTEXT& context, const float* vertex)
+	{
+		SCREEN_VERTEX screen;
+		screen.invW = 1.0f / vertex[3];
+		screen.x = context.viewportX + (vertex[0] * screen.invW + 1.0f) * context.viewportHalfWidth;
+		screen.y = context.viewportY + (1.0f - vertex[1] * screen.invW) * context.viewportHalfHeight;
+		screen.z = vertex[2] * screen.invW;
+		screen.varyings = vertex + 4;
+		return screen;
+	}
+
+	float DepthBias(const DRAW_CONTEXT& context, float maxDepth, float maxSlope)
+	{
+		if (context.depthBias == 0.0f && context.slopeScaledDepthBias == 0.0f)
+			return 0.0f;
+
+		// Unidade mínima de profundidade: 2^-24 em formatos UNORM de 24 bits e 2^(expoente(z) - 23) em formatos de ponto flutuante.
+		float unit;
+		if (context.unormDepth)
+			unit = 1.0f / 16777216.0f;
+		else
+		{
+			int exponent;
+			frexpf(std::max(maxDepth, 1e-30f), &exponent);
+			unit = ldexpf(1.0f, exponent - 1 - 23);
+		}
+
+		float bias = context.depthBias * unit + context.slopeScaledDepthBias * maxSlope;
+		if (context.depthBiasClamp > 0.0f)
+			bias = std::min(bias, context.depthBiasClamp);
+		else if (context.depthBiasClamp < 0.0f)
+			bias = std::max(bias, context.depthBiasClamp);
+		return bias;
+	}
+
+	void SetupTriangle(const DRAW_CONTEXT& context, BIN_CHUNK& chunk, SCREEN_VERTEX vertices[3], unsigned int primitiveID)
+	{
+		int x[3], y[3];
+		for (int i = 0; i < 3; i++)
+		{
+			x[i] = (int)lrintf(vertices[i].x * SOFTWARE_SUBPIXEL_SCALE);
+			y[i] = (int)lrintf(vertices[i].y * SOFTWARE_SUBPIXEL_SCALE);
+		}
+
+		// Área positiva: vértices no sentido horário na tela (y para baixo).
+		long long area = (long long)(x[1] - x[0]) * (y[2] - y[0]) - (long long)(x[2] - x[0]) * (y[1] - y[0]);
+		if (area == 0)
+		{
+			chunk.numCulled++;
+			return;
+		}
+
+		RASTER_PRIMITIVE primitive;
+		primitive.kind = PRIMITIVE_KIND_TRIANGLE;
+		primitive.frontFace = (area > 0) != context.frontCounterClockwise;
+		primitive.primitiveID = primitiveID;
+		if (IsCulled(context, primitive.frontFace))
+		{
+			chunk.numCulled++;
+			return;
+		}
+
+		if (area < 0)
+		{
+			std::swap(x[1], x[2]);
+			std::swap(y[1], y[2]);
+			std::swap(vertices[1], vertices[2]);
+			area = -area;
+		}
+
+		// Pixels cujos centros (16 * i + 8) estão dentro do retângulo do triângulo.
+		const int scale = SOFTWARE_SUBPIXEL_SCALE;
+		primitive.minX = std::max(context.rectMinX, (int)-FloorDivide(-(std::min(x[0], std::min(x[1], x[2])) - scale / 2), scale));
+		primitive.minY = std::max(context.rectMinY, (int)-FloorDivide(-(std::min(y[0], std::min(y[1], y[2])) - scale / 2), scale));
+		primitive.maxX = std::min(context.rectMaxX, (int)FloorDivide(std::max(x[0], std::max(x[1], x[2])) - scale / 2, scale));
+		primitive.maxY = std::min(context.rectMaxY, (int)FloorDivide(std::max(y[0], std::max(y[1], y[2])) - scale / 2, scale));
+		if (primitive.minX > primitive.maxX || primitive.minY > primitive.maxY)
+		{
+			chunk.numCulled++;
+			return;
+		}
+
+		// Regra top-left: pixels exatamente sobre arestas que não são superiores nem esquerdas não são cobertos.
+		for (int edge = 0; edge < 3; edge++)
+		{
+			int next = (edge + 1) % 3;
+			primitive.edgeA[edge] = y[edge] - y[next];
+			primitive.edgeB[edge] = x[next] - x[edge];
+			primitive.edgeC[edge] = (long long)x[edge] * y[next] - (long long)x[next] * y[edge];
+
+			bool topLeft = primitive.edgeA[edge] > 0 || (primitive.edgeA[edge] == 0 && primitive.edgeB[edge] > 0);
+			if (!topLeft)
+				primitive.edgeC[edge]--;
+		}
+
+		float fx[3], fy[3];
+		for (int i = 0; i < 3; i++)
+		{
+			fx[i] = (float)x[i] / scale;
+			fy[i] = (float)y[i] / scale;
+		}
+
+		primitive.x0 = fx[0];
+		primitive.y0 = fy[0];
+		primitive.x1 = primitive.y1 = 0.0f;
+		primitive.attributeOffset = (unsigned int)chunk.attributes.size();
+
+		// Planos dos atributos: valor no vértice 0 e derivadas em x e y.
+		float inverseArea = (float)(scale * scale) / (float)area;
+		auto addPlane = [&](float a0, float a1, float a2)
+		{
+			float dadx = ((a1 - a0) * (fy[2] - fy[0]) - (a2 - a0) * (fy[1] - fy[0])) * inverseArea;
+			float dady = ((a2 - a0) * (fx[1] - fx[0]) - (a1 - a0) * (fx[2] - fx[0])) * inverseArea;
+			chunk.attributes.push_back(a0);
+			chunk.attributes.push_back(dadx);
+			chunk.attributes.push_back(dady);
+		};
+
+		addPlane(vertices[0].z, vertices[1].z, vertices[2].z);
+		float* zPlane = &chunk.attributes[primitive.attributeOffset];
+		float maxDepth = std::max(fabsf(vertices[0].z), std::max(fabsf(vertices[1].z), fabsf(vertices[2].z)));
+		zPlane[0] += DepthBias(context, maxDepth, std::max(fabsf(zPlane[1]), fabsf(zPlane[2])));
+
+		addPlane(vertices[0].invW, vertices[1].invW, vertices[2].invW);
+		for (unsigned int i = 0; i < context.numVaryings; i++)
+			addPlane(vertices[0].varyings[i] * vertices[0].invW, vertices[1].varyings[i] * vertices[1].invW,
+				vertices[2].varyings[i] * vertices[2].invW);
+
+		BinPrimitive(context, chunk, primitive);
+	}
+
+	void SetupLine(const DRAW_CONTEXT& context, BIN_CHUNK& chunk, const SCREEN_VERTEX& vertex0, const SCREEN_VERTEX& vertex1,
+		unsigned int primitiveID)
+	{
+		RASTER_PRIMITIVE primitive;
+		primitive.kind = PRIMITIVE_KIND_LINE;
+		primitive.frontFace = true;
+		primitive.primitiveID = primitiveID;
+		primitive.x0 = roundf(vertex0.x * SOFTWARE_SUBPIXEL_SCALE) / SOFTWARE_SUBPIXEL_SCALE;
+		primitive.y0 = roundf(vertex0.y * SOFTWARE_SUBPIXEL_SCALE) / SOFTWARE_SUBPIXEL_SCALE;
+		primitive.x1 = roundf(vertex1.x * SOFTWARE_SUBPIXEL_SCALE) / SOFTWARE_SUBPIXEL_SCALE;
+		primitive.y1 = roundf(vertex1.y * SOFTWARE_SUBPIXEL_SCALE) / SOFTWARE_SUBPIXEL_SCALE;
+		if (primitive.x0 == primitive.x1 && primitive.y0 == primitive.y1)
+		{
+			chunk.numCulled++;
+			return;
+		}
+
+		primitive.minX = std::max(context.rectMinX, (int)floorf(std::min(primitive.x0, primitive.x1)));
+		primitive.minY = std::max(context.rectMinY, (int)floorf(std::min(primitive.y0, primitive.y1)));
+		primitive.maxX = std::min(context.rectMaxX, (int)floorf(std::max(primitive.x0, primitive.x1)));
+		primitive.maxY = std::min(context.rectMaxY, (int)floorf(std::max(primitive.y0, primitive.y1)));
+		if (primitive.minX > primitive.maxX || primitive.minY > primitive.maxY)
+		{
+			chunk.numCulled++;
+			return;
+		}
+
+		primitive.attributeOffset = (unsigned int)chunk.attributes.size();
+		float bias = DepthBias(context, std::max(fabsf(vertex0.z), fabsf(vertex1.z)), 0.0f);
+		chunk.attributes.push_back(vertex0.z + bias);
+		chunk.attributes.push_back(vertex1.z + bias);
+		chunk.attributes.push_back(vertex0.invW);
+		chunk.attributes.push_back(vertex1.invW);
+		for (unsigned int i = 0; i < context.numVaryings; i++)
+		{
+			chunk.attributes.push_back(vertex0.varyings[i] * vertex0.invW);
+			chunk.attributes.push_back(vertex1.varyings[i] * vertex1.invW);
+		}
+
+		BinPrimitive(context, chunk, primitive);
+	}
+
+	void SetupPoint(const DRAW_CONTEXT& context, BIN_CHUNK& chunk, const SCREEN_VERTEX& vertex, unsigned int primitiveID)
+	{
+		RASTER_PRIMITIVE primitive;
+		primitive.kind = PRIMITIVE_KIND_POINT;
+		primitive.frontFace = true;
+		primitive.primitiveID = primitiveID;
+		primitive.minX = primitive.maxX = (int)floorf(vertex.x);
+		primitive.minY = primitive.maxY = (int)floorf(vertex.y);
+		if (primitive.minX < context.rectMinX || primitive.minX > context.rectMaxX ||
+			primitive.minY < context.rectMinY || primitive.minY > context.rectMaxY)
+		{
+			chunk.numCulled++;
+			return;
+		}
+
+		primitive.x0 = vertex.x;
+		primitive.y0 = vertex.y;
+		primitive.x1 = primitive.y1 = 0.0f;
+		primitive.attributeOffset = (unsigned int)chunk.attributes.size();
+		chunk.attributes.push_back(vertex.z + DepthBias(context, fabsf(vertex.z), 0.0f));
+		chunk.attributes.push_back(vertex.invW);
+		for (unsigned int i = 0; i < context.numVaryings; i++)
+			chunk.attributes.push_back(vertex.varyings[i] * vertex.invW);
+
+		BinPrimitive(context, chunk, primitive);
+	}
+
+	// Distância (com sinal) do vértice aos planos de recorte: w > 0, próximo e distante (DepthClipEnable) e banda de guarda.
+	float ClipDistance(const DRAW_CONTEXT& context, const float* vertex, int plane)
+	{
+		switch (plane)
+		{
+		case 0: return vertex[3] - 1e-6f;
+		case 1: return context.depthClip ? vertex[2] : 1.0f;
+		case 2: return context.depthClip ? vertex[3] - vertex[2] : 1.0f;
+		case 3: return vertex[0] - context.guardBandMinX * vertex[3];
+		case 4: return context.guardBandMaxX * vertex[3] - vertex[0];
+		case 5: return vertex[1] - context.guardBandMinY * vertex[3];
+		default: return context.guardBandMaxY * vertex[3] - vertex[1];
+		}
+	}
+
+	// Códigos de região: bits 0 a 6 para os planos de recorte e bits 8 a 11 para o frustum em x e y (descarte trivial).
+	unsigned int OutCode(const DRAW_CONTEXT& context, const float* vertex)
+	{
+		unsigned int code = 0;
+		for (int plane = 0; plane < 7; plane++)
+			if (ClipDistance(context, vertex, plane) < 0.0f)
+				code |= 1u << plane;
+
+		float w = vertex[3];
+		code |= (vertex[0] < -w ? 1u << 8 : 0) | (vertex[0] > w ? 1u << 9 : 0);
+		code |= (vertex[1] < -w ? 1u << 10 : 0) | (vertex[1] > w ? 1u << 11 : 0);
+		return code;
+	}
+
+	void Interpolate(const DRAW_CONTEXT& context, const float* from, const float* to, float t, float* result)
+	{
+		for (unsigned int i = 0; i < context.vertexSize; i++)
+			result[i] = from[i] + t * (to[i] - from[i]);
+	}
+
+	// Recorta o polígono (Sutherland-Hodgman) contra os planos indicados em planeMask. Cada plano adiciona no máximo um vértice.
+	unsigned int ClipPolygon(const DRAW_CONTEXT& context, float (*vertices)[SOFTWARE_MAX_VERTEX_SIZE], unsigned int numVertices,
+		unsigned int planeMask, bool closed)
+	{
+		float clipped[SOFTWARE_MAX_CLIP_VERTICES][SOFTWARE_MAX_VERTEX_SIZE];
+
+		for (int plane = 0; plane < 7 && numVertices >= 2; plane++)
+		{
+			if ((planeMask & (1u << plane)) == 0)
+				continue;
+
+			unsigned int numClipped = 0;
+			unsigned int numEdges = closed ? numVertices : numVertices - 1;
+			for (unsigned int i = 0; i < numVertices; i++)
+			{
+				const float* current = vertices[i];
+				float currentDistance = ClipDistance(context, current, plane);
+				if (currentDistance >= 0.0f)
+					memcpy(clipped[numClipped++], current, context.vertexSize * sizeof(float));
+
+				if (i >= numEdges)
+					continue;
+
+				const float* next = vertices[(i + 1) % numVertices];
+				float nextDistance = ClipDistance(context, next, plane);
+				if ((currentDistance >= 0.0f) != (nextDistance >= 0.0f))
+					Interpolate(context, current, next, currentDistance / (currentDistance - nextDistance), clipped[numClipped++]);
+			}
+
+			memcpy(vertices, clipped, numClipped * sizeof(clipped[0]));
+			numVertices = numClipped;
+		}
+
+		return numVertices;
+	}
+
+	// Posição, no desenho, dos vértices da primitiva primitive de uma instância. Retorna a quantidade de vértices (1 a 3).
+	unsigned int PrimitiveElements(PRIMITIVE_TOPOLOGY topology, unsigned int primitive, unsigned int elements[3])
+	{
+		unsigned int p = primitive;
+		switch (topology)
+		{
+		case PRIMITIVE_TOPOLOGY_POINTLIST: elements[0] = p; return 1;
+		case PRIMITIVE_TOPOLOGY_LINELIST: elements[0] = 2 * p; elements[1] = 2 * p + 1; return 2;
+		case PRIMITIVE_TOPOLOGY_LINESTRIP: elements[0] = p; elements[1] = p + 1; return 2;
+		case PRIMITIVE_TOPOLOGY_LINELIST_ADJ: elements[0] = 4 * p + 1; elements[1] = 4 * p + 2; return 2;
+		case PRIMITIVE_TOPOLOGY_LINESTRIP_ADJ: elements[0] = p + 1; elements[1] = p + 2; return 2;
+		case PRIMITIVE_TOPOLOGY_TRIANGLELIST: elements[0] = 3 * p; elements[1] = 3 * p + 1; elements[2] = 3 * p + 2; return 3;
+		case PRIMITIVE_TOPOLOGY_TRIANGLELIST_ADJ: elements[0] = 6 * p; elements[1] = 6 * p + 2; elements[2] = 6 * p + 4; return 3;
+		case PRIMITIVE_TOPOLOGY_TRIANGLESTRIP:
+			// Os triângulos ímpares da faixa têm a ordem invertida, preservando o sentido dos vértices.
+			elements[0] = p;
+			elements[1] = p % 2 == 0 ? p + 1 : p + 2;
+			elements[2] = p % 2 == 0 ? p + 2 : p + 1;
+			return 3;
+		default:
+			elements[0] = 2 * p;
+			elements[1] = p % 2 == 0 ? 2 * p + 2 : 2 * p + 4;
+			elements[2] = p % 2 == 0 ? 2 * p + 4 : 2 * p + 2;
+			return 3;
+		}
+	}
+
+	unsigned int PrimitivesPerInstance(PRIMITIVE_TOPOLOGY topology, unsigned int count)
+	{
+		switch (topology)
+		{
+		case PRIMITIVE_TOPOLOGY_POINTLIST: return count;
+		case PRIMITIVE_TOPOLOGY_LINELIST: return count / 2;
+		case PRIMITIVE_TOPOLOGY_LINESTRIP: return count > 1 ? count - 1 : 0;
+		case PRIMITIVE_TOPOLOGY_LINELIST_ADJ: return count / 4;
+		case PRIMITIVE_TOPOLOGY_LINESTRIP_ADJ: return count > 3 ? count - 3 : 0;
+		case PRIMITIVE_TOPOLOGY_TRIANGLELIST: return count / 3;
+		case PRIMITIVE_TOPOLOGY_TRIANGLELIST_ADJ: return count / 6;
+		case PRIMITIVE_TOPOLOGY_TRIANGLESTRIP: return count > 2 ? count - 2 : 0;
+		case PRIMITIVE_TOPOLOGY_TRIANGLESTRIP_ADJ: return count > 5 ? (count - 4) / 2 : 0;
+		default: return 0;
+		}
+	}
+
+	PRIMITIVE_KIND PrimitiveKind(PRIMITIVE_TOPOLOGY topology)
+	{
+		switch (topology)
+		{
+		case PRIMITIVE_TOPOLOGY_POINTLIST:
+			return PRIMITIVE_KIND_POINT;
+		case PRIMITIVE_TOPOLOGY_LINELIST:
+		case PRIMITIVE_TOPOLOGY_LINESTRIP:
+		case PRIMITIVE_TOPOLOGY_LINELIST_ADJ:
+		case PRIMITIVE_TOPOLOGY_LINESTRIP_ADJ:
+			return PRIMITIVE_KIND_LINE;
+		case PRIMITIVE_TOPOLOGY_TRIANGLELIST:
+		case PRIMITIVE_TOPOLOGY_TRIANGLESTRIP:
+		case PRIMITIVE_TOPOLOGY_TRIANGLELIST_ADJ:
+		case PRIMITIVE_TOPOLOGY_TRIANGLESTRIP_ADJ:
+			return PRIMITIVE_KIND_TRIANGLE;
+		default:
+			return PRIMITIVE_KIND_NONE;
+		}
+	}
+
+	// Posição do vértice processado correspondente ao elemento element do desenho.
+	const float* ShadedVertex(const DRAW_CONTEXT& context, unsigned int instance, unsigned int element)
+	{
+		unsigned int location = context.draw.startLocation + element;
+		unsigned int position;
+		if (!context.draw.indexed)
+			position = location - context.rangeStart;
+		else if (context.vertexPositions != nullptr)
+			position = context.vertexPositions[context.device->indexData[location] - context.rangeStart];
+		else
+			position = (unsigned int)(std::lower_bound(context.vertexValues, context.vertexValues + context.numVertices,
+				context.device->indexData[location]) - context.vertexValues);
+
+		return context.shadedVertices + ((size_t)instance * context.numVertices + position) * context.vertexSize;
+	}
+
+	void SetupPolygon(const DRAW_CONTEXT& context, BIN_CHUNK& chunk, float (*polygon)[SOFTWARE_MAX_VERTEX_SIZE], unsigned int numVertices,
+		unsigned int primitiveID)
+	{
+		SCREEN_VERTEX screen[SOFTWARE_MAX_CLIP_VERTICES];
+		for (unsigned int i = 0; i < numVertices; i++)
+			screen[i] = ToScreen(context, polygon[i]);
+
+		if (!context.wireframe)
+		{
+			for (unsigned int i = 1; i + 1 < numVertices; i++)
+			{
+				SCREEN_VERTEX triangle[3] = { screen[0], screen[i], screen[i + 1] };
+				SetupTriangle(context, chunk, triangle, primitiveID);
+			}
+			return;
+		}
+
+		// Wireframe: as arestas do polígono recortado são desenhadas como linhas, após o descarte por orientação.
+		float area = 0.0f;
+		for (unsigned int i = 0; i < numVertices; i++)
+		{
+			const SCREEN_VERTEX& current = screen[i];
+			const SCREEN_VERTEX& next = screen[(i + 1) % numVertices];
+			area += current.x * next.y - next.x * current.y;
+		}
+
+		if (area == 0.0f || IsCulled(context, (area > 0.0f) != context.frontCounterClockwise))
+		{
+			chunk.numCulled++;
+			return;
+		}
+
+		for (unsigned int i = 0; i < numVertices; i++)
+			SetupLine(context, chunk, screen[i], screen[(i + 1) % numVertices], primitiveID);
+	}
+
+	void SetupPrimitives(unsigned int begin, unsigned int end, void* pUserData)
+	{
+		const DRAW_CONTEXT& context = *(const DRAW_CONTEXT*)pUserData;
+
+		for (unsigned int chunkIndex = begin; chunkIndex < end; chunkIndex++)
+		{
+			BIN_CHUNK& chunk = (*context.chunks)[chunkIndex];
+			unsigned int firstPrimitive = chunkIndex * SOFTWARE_PRIMITIVES_PER_TASK;
+			unsigned int lastPrimitive = std::min(context.numPrimitives, firstPrimitive + SOFTWARE_PRIMITIVES_PER_TASK);
+
+			for (unsigned int globalPrimitive = firstPrimitive; globalPrimitive < lastPrimitive; globalPrimitive++)
+			{
+				unsigned int instance = globalPrimitive / context.primitivesPerInstance;
+				unsigned int primitiveID = globalPrimitive % context.primitivesPerInstance;
+				unsigned int elements[3];
+				unsigned int numVertices = PrimitiveElements(context.topology, primitiveID, elements);
+				chunk.numPrimitives++;
+
+				const float* vertices[3];
+				unsigned int andCode = ~0u, orCode = 0;
+				for (unsigned int i = 0; i < numVertices; i++)
+				{
+					vertices[i] = ShadedVertex(context, instance, elements[i]);
+					unsigned int code = OutCode(context, vertices[i]);
+					andCode &= code;
+					orCode |= code;
+				}
+
+				if (andCode != 0)
+				{
+					chunk.numCulled++;
+					continue;
+				}
+
+				if ((orCode & 0x7F) == 0)
+				{
+					if (numVertices == 1)
+						SetupPoint(context, chunk, ToScreen(context, vertices[0]), primitiveID);
+					else if (numVertices == 2)
+						SetupLine(context, chunk, ToScreen(context, vertices[0]), ToScreen(context, vertices[1]), primitiveID);
+					else if (!context.wireframe)
+					{
+						SCREEN_VERTEX screen[3];
+						for (unsigned int i = 0; i < 3; i++)
+							screen[i] = ToScreen(context, vertices[i]);
+						SetupTriangle(context, chunk, screen, primitiveID);
+					}
+					else
+					{
+						float polygon[3][SOFTWARE_MAX_VERTEX_SIZE];
+						for (unsigned int i = 0; i < 3; i++)
+							memcpy(polygon[i], vertices[i], context.vertexSize * sizeof(float));
+						SetupPolygon(context, chunk, polygon, 3, primitiveID);
+					}
+					continue;
+				}
+
+				// Pontos fora dos planos de recorte são descartados; linhas e triângulos são recortados.
+				chunk.numClipped++;
+				if (numVertices == 1)
+				{
+					chunk.numCulled++;
+					continue;
+				}
+
+				float polygon[SOFTWARE_MAX_CLIP_VERTICES][SOFTWARE_MAX_VERTEX_SIZE];
+				for (unsigned int i = 0; i < numVertices; i++)
+					memcpy(polygon[i], vertices[i], context.vertexSize * sizeof(float));
+
+				unsigned int numClipped = ClipPolygon(context, polygon, numVertices, orCode & 0x7F, numVertices == 3);
+				if (numClipped < numVertices)
+				{
+					chunk.numCulled++;
+					continue;
+				}
+
+				if (numVertices == 2)
+					SetupLine(context, chunk, ToScreen(context, polygon[0]), ToScreen(context, polygon[1]), primitiveID);
+				else
+					SetupPolygon(context, chunk, polygon, numClipped, primitiveID);
+			}
+		}
+	}
+
+	// ------------------------------------------------------------ Vertex program ------------------------------------------------------- //
+
+	void ShadeVertices(unsigned int begin, unsigned int end, void* pUserData)
+	{
+		const DRAW_CONTEXT& context = *(const DRAW_CONTEXT*)pUserData;
+		const NULL_DEVICE& device = *context.device;
+		float* shadedVertices = (float*)context.shadedVertices;
+
+		SOFTWARE_VERTEX_INPUT input;
+		input.registers = &context.registers;
+
+		for (unsigned int i = begin; i < end; i++)
+		{
+			unsigned int instance = i / context.numVertices;
+			unsigned int position = i % context.numVertices;
+			unsigned int value = context.vertexValues != nullptr ? context.vertexValues[position] : context.rangeStart + position;
+			unsigned int vertex = context.draw.indexed ? value + context.draw.baseVertexLocation : value;
+
+			// Como no Direct3D, SV_VertexID é o valor do índice, sem BaseVertexLocation.
+			input.vertexID = value;
+			input.instanceID = instance;
+			input.pVertex = NULL;
+			input.pInstance = NULL;
+
+			if (device.vertexDataSet && ((size_t)vertex + 1) * device.vertexStride <= device.vertexData.size())
+				input.pVertex = device.vertexData.data() + (size_t)vertex * device.vertexStride;
+
+			if (device.instanceDataSet)
+			{
+				size_t instanceIndex = (size_t)context.draw.startInstanceLocation + instance / std::max(1u, device.instanceStepRate);
+				if ((instanceIndex + 1) * device.instanceStride <= device.instanceData.size())
+					input.pInstance = device.instanceData.data() + instanceIndex * device.instanceStride;
+			}
+
+			float* output = shadedVertices + (size_t)i * context.vertexSize;
+			context.vertexProgram->vertexProgram(&input, output, output + 4, context.vertexProgram->pUserData);
+		}
+	}
+
+	void FillRegisters(SOFTWARE_SHADER_REGISTERS* registers)
+	{
+		memset(registers, 0, sizeof(SOFTWARE_SHADER_REGISTERS));
+
+		for (unsigned int i = 0; i < SOFTWARE_MAX_CONSTANT_REGISTERS; i++)
+			registers->constantBuffers[i] = GetNullConstantRegister(i);
+
+		for (unsigned int i = 0; i < SOFTWARE_MAX_SHADER_RESOURCES; i++)
+		{
+			const NULL_DESCRIPTOR* descriptor = GetNullShaderResourceRegister(i);
+			if (descriptor == nullptr)
+				continue;
+
+			SOFTWARE_RESOURCE& resource = registers->shaderResources[i];
+			if (descriptor->buffer != nullptr)
+			{
+				resource.pData = descriptor->buffer->data.data();
+				resource.format = descriptor->buffer->format;
+				resource.width = (unsigned int)descriptor->buffer->data.size();
+				resource.height = resource.depth = 1;
+				resource.rowPitch = resource.width;
+				resource.structureSize = descriptor->buffer->structureSize;
+			}
+			else
+			{
+				const Texture* texture = descriptor->texture;
+				unsigned short mipLevel = texture->activeMipLevel;
+				resource.pData = texture->mips[mipLevel].data();
+				resource.format = texture->format;
+				resource.width = std::max(1u, texture->width >> mipLevel);
+				resource.height = std::max(1u, texture->height >> mipLevel);
+				resource.depth = std::max(1u, texture->depth >> mipLevel);
+				resource.rowPitch = resource.width * texture->texelSize;
+			}
+		}
+	}
+
+	// Executa um desenho validado pelo backend nulo.
+	void Draw(const NULL_DRAW_DESC* draw, void* pUserData)
+	{
+		(void)pUserData;
+		SOFTWARE_RASTERIZER& rasterizer = GetRasterizer();
+		NULL_DEVICE& device = GetNullDevice();
+		const PipelineState* pipelineState = device.pipelineState;
+		Texture* renderTarget = device.renderTarget;
+
+		DRAW_CONTEXT context;
+		context.device = &device;
+		context.pipelineState = pipelineState;
+		context.draw = *draw;
+		context.topology = device.primitiveTopology;
+		context.kind = PrimitiveKind(context.topology);
+
+		bool hasVertexProgram = rasterizer.vertexPrograms.count(pipelineState->pVertexProgram) != 0;
+		bool validPixelProgram = pipelineState->pPixelProgram == NULL || rasterizer.pixelPrograms.count(pipelineState->pPixelProgram) != 0;
+		if (!hasVertexProgram || !validPixelProgram || context.kind == PRIMITIVE_KIND_NONE ||
+			(!IsDirectFormat(renderTarget->format) && !IsConversionSupported(renderTarget->format)))
+		{
+			AddStat(STAT_SKIPPED_DRAWS, 1);
+			return;
+		}
+
+		context.vertexProgram = (const SOFTWARE_PROGRAM*)pipelineState->pVertexProgram;
+		context.pixelProgram = (const SOFTWARE_PROGRAM*)pipelineState->pPixelProgram;
+		context.numVaryings = context.vertexProgram->numVaryings;
+		context.numAttributes = 2 + context.numVaryings;
+		context.vertexSize = 4 + context.numVaryings;
+		FillRegisters(&context.registers);
+
+		context.primitivesPerInstance = PrimitivesPerInstance(context.topology, draw->countPerInstance);
+		unsigned long long numPrimitives = (unsigned long long)context.primitivesPerInstance * draw->instanceCount;
+		if (numPrimitives == 0 || numPrimitives > 0xFFFFFFFFull)
+		{
+			AddStat(STAT_SKIPPED_DRAWS, numPrimitives == 0 ? 0 : 1);
+			return;
+		}
+		context.numPrimitives = (unsigned int)numPrimitives;
+
+		// Área de rasterização: viewport 0, scissor 0 e render target.
+		const VIEWPORT& viewport = device.viewports[0];
+		const SCISSOR_RECT& scissorRect = device.scissorRects[0];
+		context.rectMinX = (int)std::max(viewport.Left, scissorRect.Left);
+		context.rectMinY = (int)std::max(viewport.Top, scissorRect.Top);
+		context.rectMaxX = (int)std::min(std::min(viewport.Right, scissorRect.Right), renderTarget->width) - 1;
+		context.rectMaxY = (int)std::min(std::min(viewport.Bottom, scissorRect.Bottom), renderTarget->height) - 1;
+		if (context.rectMinX > context.rectMaxX || context.rectMinY > context.rectMaxY)
+			return;
+
+		context.viewportX = (float)viewport.Left;
+		context.viewportY = (float)viewport.Top;
+		context.viewportHalfWidth = 0.5f * (viewport.Right - viewport.Left);
+		context.viewportHalfHeight = 0.5f * (viewport.Bottom - viewport.Top);
+		context.guardBandMinX = (-SOFTWARE_GUARD_BAND - context.viewportX) / context.viewportHalfWidth - 1.0f;
+		context.guardBandMaxX = (SOFTWARE_GUARD_BAND - context.viewportX) / context.viewportHalfWidth - 1.0f;
+		context.guardBandMinY = 1.0f - (SOFTWARE_GUARD_BAND - context.viewportY) / context.viewportHalfHeight;
+		context.guardBandMaxY = 1.0f + (SOFTWARE_GUARD_BAND + context.viewportY) / context.viewportHalfHeight;
+
+		const RASTERIZER_DESC& rasterizerDesc = pipelineState->rasterizerDesc;
+		context.depthClip = rasterizerDesc.DepthClipEnable != 0;
+		context.wireframe = rasterizerDesc.FillMode == FILL_MODE_WIREFRAME && context.kind == PRIMITIVE_KIND_TRIANGLE;
+		context.cullMode = rasterizerDesc.CullMode;
+		context.frontCounterClockwise = rasterizerDesc.FrontCounterClockwise != 0;
+		context.depthBias = rasterizerDesc.DepthBias;
+		context.depthBiasClamp = rasterizerDesc.DepthBiasClamp;
+		context.slopeScaledDepthBias = rasterizerDesc.SlopeScaledDepthBias;
+		context.unormDepth = pipelineState->depthStencilFormat == RESOURCE_FORMAT_D24_UNORM_S8_UINT;
+
+		context.width = renderTarget->width;
+		context.height = renderTarget->height;
+		context.texelSize = renderTarget->texelSize;
+		context.format = renderTarget->format;
+		context.unormColor = context.format == RESOURCE_FORMAT_R8G8B8A8_UNORM || context.format == RESOURCE_FORMAT_R8G8B8A8_UNORM_SRGB;
+		context.pColor = renderTarget->mips[0].data();
+		context.blendDesc = pipelineState->blendDesc;
+		context.depthStencilDesc = pipelineState->depthStencilDesc;
+		context.depthEnable = context.depthStencilDesc.DepthEnable != 0;
+		context.stencilEnable = context.depthStencilDesc.StencilEnable != 0 && pipelineState->depthStencilFormat != RESOURCE_FORMAT_D32_FLOAT;
+		context.pDepth = nullptr;
+		context.pStencil = nullptr;
+		if (pipelineState->depthStencilFormat != RESOURCE_FORMAT_UNKNOWN && (context.depthEnable || context.stencilEnable))
+		{
+			EnsureNullDepthStencil(renderTarget);
+			context.pDepth = renderTarget->depthData.data();
+			context.pStencil = renderTarget->stencilData.data();
+		}
+
+		// 1. Vertex program sobre os vértices referenciados pelo desenho, para todas as instâncias.
+		context.vertexValues = nullptr;
+		context.vertexPositions = nullptr;
+		if (draw->indexed)
+		{
+			const unsigned int* pIndices = device.indexData.data() + draw->startLocation;
+			auto range = std::minmax_element(pIndices, pIndices + draw->countPerInstance);
+			unsigned long long rangeSize = (unsigned long long)*range.second - *range.first + 1;
+			context.rangeStart = *range.first;
+
+			// Valores distintos na ordem da primeira ocorrência (tabela) ou em ordem crescente (busca binária).
+			std::vector<unsigned int>& values = rasterizer.vertexValues;
+			std::vector<unsigned int>& positions = rasterizer.vertexPositions;
+			values.clear();
+			if (rangeSize <= (unsigned long long)draw->countPerInstance * SOFTWARE_VERTEX_TABLE_RATIO)
+			{
+				positions.assign((size_t)rangeSize, ~0u);
+				for (unsigned int i = 0; i < draw->countPerInstance; i++)
+				{
+					unsigned int& position = positions[pIndices[i] - context.rangeStart];
+					if (position == ~0u)
+					{
+						position = (unsigned int)values.size();
+						values.push_back(pIndices[i]);
+					}
+				}
+				context.vertexPositions = positions.data();
+			}
+			else
+			{
+				values.assign(pIndices, pIndices + draw->countPerInstance);
+				std::sort(values.begin(), values.end());
+				values.erase(std::unique(values.begin(), values.end()), values.end());
+			}
+
+			context.vertexValues = values.data();
+			context.numVertices = (unsigned int)values.size();
+		}
+		else
+		{
+			context.rangeStart = draw->startLocation;
+			context.numVertices = draw->countPerInstance;
+		}
+
+		unsigned long long numShadedVertices = (unsigned long long)context.numVertices * draw->instanceCount;
+		if (numShadedVertices > 0xFFFFFFFFull)
+		{
+			AddStat(STAT_SKIPPED_DRAWS, 1);
+			return;
+		}
+
+		rasterizer.shadedVertices.resize((size_t)numShadedVertices * context.vertexSize);
+		context.shadedVertices = rasterizer.shadedVertices.data();
+		ParallelFor((unsigned int)numShadedVertices, SOFTWARE_VERTICES_PER_TASK, ShadeVertices, &context);
+
+		// 2. Montagem, recorte e distribuição das primitivas entre os blocos.
+		context.numTilesX = (context.width + SOFTWARE_TILE_SIZE - 1) / SOFTWARE_TILE_SIZE;
+		context.numTilesY = (context.height + SOFTWARE_TILE_SIZE - 1) / SOFTWARE_TILE_SIZE;
+		unsigned int numTiles = context.numTilesX * context.numTilesY;
+		unsigned int numChunks = (context.numPrimitives + SOFTWARE_PRIMITIVES_PER_TASK - 1) / SOFTWARE_PRIMITIVES_PER_TASK;
+
+		if (rasterizer.chunks.size() < numChunks)
+			rasterizer.chunks.resize(numChunks);
+		for (unsigned int i = 0; i < numChunks; i++)
+		{
+			BIN_CHUNK& chunk = rasterizer.chunks[i];
+			chunk.primitives.clear();
+			chunk.attributes.clear();
+			chunk.tiles.resize(numTiles);
+			for (std::vector<unsigned int>& tile : chunk.tiles)
+				tile.clear();
+			chunk.numPrimitives = chunk.numCulled = chunk.numClipped = chunk.numBinned = 0;
+		}
+
+		context.chunks = &rasterizer.chunks;
+		context.numChunks = numChunks;
+		ParallelFor(numChunks, 1, SetupPrimitives, &context);
+
+		// 3. Rasterização dos blocos com primitivas.
+		rasterizer.activeTiles.clear();
+		for (unsigned int tile = 0; tile < numTiles; tile++)
+		{
+			for (unsigned int i = 0; i < numChunks; i++)
+			{
+				if (!rasterizer.chunks[i].tiles[tile].empty())
+				{
+					rasterizer.activeTiles.push_back(tile);
+					break;
+				}
+			}
+		}
+
+		context.activeTiles = &rasterizer.activeTiles;
+		ParallelFor((unsigned int)rasterizer.activeTiles.size(), 1, RasterizeTiles, &context);
+
+		AddStat(STAT_DRAWS, 1);
+		AddStat(STAT_VERTICES_SHADED, numShadedVertices);
+		for (unsigned int i = 0; i < numChunks; i++)
+		{
+			const BIN_CHUNK& chunk = rasterizer.chunks[i];
+			AddStat(STAT_PRIMITIVES, chunk.numPrimitives);
+			AddStat(STAT_PRIMITIVES_CULLED, chunk.numCulled);
+			AddStat(STAT_PRIMITIVES_CLIPPED, chunk.numClipped);
+			AddStat(STAT_BINNED_PRIMITIVES, chunk.numBinned);
+		}
+	}
+
+	LeanDX12Result RegisterProgram(const char* filename, const SOFTWARE_PROGRAM& program, bool vertexProgram)
+	{
+		if (filename == nullptr)
+			return LEANDX12_ERROR_INVALID_CALL;
+
+		SOFTWARE_RASTERIZER& rasterizer = GetRasterizer();
+		rasterizer.programs.emplace_back(new SOFTWARE_PROGRAM(program));
+		const void* pProgram = rasterizer.programs.back().get();
+		(vertexProgram ? rasterizer.vertexPrograms : rasterizer.pixelPrograms).insert(pProgram);
+
+		return RegisterNullShader(filename, pProgram);
+	}
+}
+
+LeanDX12Result InitSoftwareRasterizer()
+{
+	SOFTWARE_RASTERIZER& rasterizer = GetRasterizer();
+	if (rasterizer.initialized)
+		return LEANDX12_ERROR_INVALID_CALL;
+
+	NULL_BACKEND_HOOKS hooks = {};
+	hooks.Draw = Draw;
+	SetNullBackendHooks(&hooks);
+
+	rasterizer.initialized = true;
+	return LEANDX12_OK;
+}
+
+void ReleaseSoftwareRasterizer()
+{
+	SOFTWARE_RASTERIZER& rasterizer = GetRasterizer();
+	if (!rasterizer.initialized)
+		return;
+
+	SetNullBackendHooks(NULL);
+	std::vector<float>().swap(rasterizer.shadedVertices);
+	std::vector<BIN_CHUNK>().swap(rasterizer.chunks);
+	std::vector<unsigned int>().swap(rasterizer.activeTiles);
+	rasterizer.initialized = false;
+}
+
+LeanDX12Result RegisterSoftwareVertexProgram(const char* filename, SOFTWARE_VERTEX_PROGRAM program, unsigned int numVaryings, void* pUserData)
+{
+	if (program == nullptr || numVaryings > SOFTWARE_MAX_VARYINGS)
+		return LEANDX12_ERROR_INVALID_CALL;
+
+	SOFTWARE_PROGRAM vertexProgram = { program, nullptr, numVaryings, pUserData };
+	return RegisterProgram(filename, vertexProgram, true);
+}
+
+LeanDX12Result RegisterSoftwarePixelProgram(const char* filename, SOFTWARE_PIXEL_PROGRAM program, void* pUserData)
+{
+	if (program == nullptr)
+		return LEANDX12_ERROR_INVALID_CALL;
+
+	SOFTWARE_PROGRAM pixelProgram = { nullptr, program, 0, pUserData };
+	return RegisterProgram(filename, pixelProgram, false);
+}
+
+void GetSoftwareRasterizerStats(SOFTWARE_RASTERIZER_STATS* stats)
+{
+	if (stats == nullptr)
+		return;
+
+	SOFTWARE_RASTERIZER& rasterizer = GetRasterizer();
+	unsigned long long* pValues = (unsigned long long*)stats;
+	for (size_t i = 0; i < sizeof(SOFTWARE_RASTERIZER_STATS) / sizeof(unsigned long long); i++)
+		pValues[i] = rasterizer.stats[i].load();
+}
+
+void ResetSoftwareRasterizerStats()
+{
+	SOFTWARE_RASTERIZER& rasterizer = GetRasterizer();
+	for (std::atomic<unsigned long long>& value : rasterizer.stats)
+		value.store(0);
+}
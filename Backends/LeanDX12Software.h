@@ -0,0 +1,119 @@
+/*
+* LeanDX12 - Rasterizador de software
+* Descrição: Execução dos desenhos na CPU sobre o backend nulo (LeanDX12Null.h), para gerar imagens em máquinas sem GPU (por exemplo,
+* servidores de compilação em Linux e testes de regressão de imagens). O backend nulo continua responsável pelos recursos, pelo estado e
+* pela validação das chamadas; o rasterizador executa os desenhos validados sobre o render target selecionado, e o resultado é obtido
+* com GetPrivateData e ReadbackData, como no Direct3D 12.
+*
+*	Os shaders são substituídos por programas em C++: RegisterSoftwareVertexProgram e RegisterSoftwarePixelProgram associam uma função
+*	ao nome do arquivo .cso, e LoadShaderFromFile passa a retornar o programa registrado (sem ler o disco).
+*
+*	Execução de um desenho:
+*		1.	Os vértices referenciados pelo desenho (de todas as instâncias) são processados em paralelo pelo vertex program;
+*		2.	As primitivas são montadas, recortadas (plano próximo, plano distante com DepthClipEnable e banda de guarda), descartadas
+*			(CullMode) e distribuídas entre blocos de SOFTWARE_TILE_SIZE x SOFTWARE_TILE_SIZE pixels, em paralelo por grupos de
+*			primitivas;
+*		3.	Os blocos são rasterizados em paralelo (cada bloco processa as suas primitivas na ordem dos desenhos). A cobertura dos
+*			triângulos é calculada com funções de aresta inteiras (precisão de 1/16 de pixel, regra top-left), 4 pixels por vez (SSE2).
+*
+*	Suportados: topologias de pontos, linhas e triângulos (com adjacência, ignorando os vértices adjacentes), FILL_MODE_WIREFRAME,
+*	CullMode, FrontCounterClockwise, DepthBias, DepthClipEnable, teste de profundidade e stencil (valor de referência 0, pois LeanDX12.h
+*	não define a referência), blending (fator constante igual a 1 e fatores SRC1 equivalentes aos SRC) e interpolação com correção de
+*	perspectiva. Render targets R8G8B8A8_UNORM(_SRGB), R16G16B16A16_FLOAT, R32G32B32A32_FLOAT e R32_FLOAT possuem caminhos diretos; os
+*	demais formatos aceitos por LeanDX12Format.h são convertidos texel a texel.
+*	Não suportados: tesselação, geometry shaders, operações lógicas, alpha-to-coverage, multiamostragem (render targets
+*	multiamostrados são rasterizados com uma amostra no centro do pixel) e seleção do viewport e do retângulo de recorte por primitiva
+*	(SV_ViewportArrayIndex): apenas o viewport 0 e o retângulo de recorte 0 são utilizados, como no Direct3D 12 sem geometry shaders.
+*
+*	O buffer de profundidade e stencil do render target é utilizado quando o pipeline define depthStencilFormat (LeanDX12Null.h).
+*
+*   Organização do arquivo de cabeçalho:
+*	1.	Estruturas
+*	2.	Declaração das funções
+*/
+
+#ifndef _LEANDX12_SOFTWARE_
+#define _LEANDX12_SOFTWARE_
+
+#include <cstddef>
+
+#include "LeanDX12.h"
+#include "LeanDX12Null.h"
+
+#define SOFTWARE_TILE_SIZE 64
+#define SOFTWARE_MAX_VARYINGS 32						// Valores interpolados por vértice (floats).
+#define SOFTWARE_MAX_CONSTANT_REGISTERS 14				// b0 a b13.
+#define SOFTWARE_MAX_SHADER_RESOURCES 16				// t0 a t15.
+
+// ------------------------------------------------------------ 1. Estruturas ------------------------------------------------------------- //
+
+// Recurso associado a um registrador t (textura no nível ativo ou buffer). pData é NULL se o registrador não estiver associado.
+typedef struct SOFTWARE_RESOURCE
+{
+	const void* pData;
+	RESOURCE_FORMAT format;
+	unsigned int width;								// Buffers: tamanho em bytes.
+	unsigned int height;
+	unsigned int depth;
+	unsigned int rowPitch;							// Texels contíguos (width * tamanho do texel).
+	unsigned int structureSize;						// Buffers estruturados.
+} SOFTWARE_RESOURCE;
+
+// Registradores do pipeline ativo, na ordem da assinatura raiz: constantes de 32 bits seguidas dos constant buffers da tabela de
+// descritores (b) e shader resources da tabela (t).
+typedef struct SOFTWARE_SHADER_REGISTERS
+{
+	const void* constantBuffers[SOFTWARE_MAX_CONSTANT_REGISTERS];
+	SOFTWARE_RESOURCE shaderResources[SOFTWARE_MAX_SHADER_RESOURCES];
+} SOFTWARE_SHADER_REGISTERS;
+
+typedef struct SOFTWARE_VERTEX_INPUT
+{
+	const SOFTWARE_SHADER_REGISTERS* registers;
+	const void* pVertex;							// Elementos do layout de entrada (consecutivos). NULL sem dados de vértices.
+	const void* pInstance;							// NULL sem dados de instâncias.
+	unsigned int vertexID;							// SV_VertexID (valor do índice, sem startVertexCount, nos desenhos indexados).
+	unsigned int instanceID;						// SV_InstanceID (não inclui startInstanceLocation).
+} SOFTWARE_VERTEX_INPUT;
+
+typedef struct SOFTWARE_PIXEL_INPUT
+{
+	const SOFTWARE_SHADER_REGISTERS* registers;
+	float position[4];								// SV_Position: centro do pixel, profundidade e w de recorte.
+	BOOLEAN frontFace;								// SV_IsFrontFace (verdadeiro para pontos e linhas).
+	unsigned int primitiveID;						// SV_PrimitiveID.
+} SOFTWARE_PIXEL_INPUT;
+
+// Calcula a posição em coordenadas de recorte (SV_Position) e os numVaryings valores interpolados para o pixel program.
+typedef void (*SOFTWARE_VERTEX_PROGRAM)(const SOFTWARE_VERTEX_INPUT* input, float position[4], float* varyings, void* pUserData);
+// Calcula a cor do pixel (SV_Target0). Retorna falso para descartar o pixel (discard).
+typedef BOOLEAN (*SOFTWARE_PIXEL_PROGRAM)(const SOFTWARE_PIXEL_INPUT* input, const float* varyings, float colorRGBA[4], void* pUserData);
+
+typedef struct SOFTWARE_RASTERIZER_STATS
+{
+	unsigned long long numDraws;
+	unsigned long long numSkippedDraws;				// Sem vertex program registrado, topologia ou formato não suportado.
+	unsigned long long numVerticesShaded;
+	unsigned long long numPrimitives;				// Primitivas montadas.
+	unsigned long long numPrimitivesCulled;			// Fora do frustum, degeneradas ou descartadas por CullMode.
+	unsigned long long numPrimitivesClipped;
+	unsigned long long numBinnedPrimitives;			// Soma, em todos os blocos, das primitivas distribuídas para o bloco.
+	unsigned long long numPixelsShaded;				// Execuções do pixel program.
+	unsigned long long numPixelsWritten;
+} SOFTWARE_RASTERIZER_STATS;
+
+// ------------------------------------------------------ 2. Declaração das funções ------------------------------------------------------- //
+
+// Instala o rasterizador no backend nulo: os desenhos seguintes são executados na CPU.
+LeanDX12Result InitSoftwareRasterizer();
+// Remove o rasterizador (os desenhos voltam a ser apenas validados) e libera a memória temporária.
+void ReleaseSoftwareRasterizer();
+
+// Associa um programa ao nome do arquivo .cso carregado por LoadShaderFromFile. O nome deve ser registrado antes do carregamento.
+LeanDX12Result RegisterSoftwareVertexProgram(const char* filename, SOFTWARE_VERTEX_PROGRAM program, unsigned int numVaryings, void* pUserData);
+LeanDX12Result RegisterSoftwarePixelProgram(const char* filename, SOFTWARE_PIXEL_PROGRAM program, void* pUserData);
+
+void GetSoftwareRasterizerStats(SOFTWARE_RASTERIZER_STATS* stats);
+void ResetSoftwareRasterizerStats();
+
+#endif  // _LEANDX12_SOFTWARE_
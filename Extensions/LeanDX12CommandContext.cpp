@@ -0,0 +1,722 @@
+// Descrição: Implementação dos contextos de comandos das extensões LeanDX12 (LeanDX12CommandContext.h).
+
+#include <cstring>
+#include <vector>
+
+#include "LeanDX12CommandContext.h"
+
+namespace
+{
+	typedef enum COMMAND_TYPE
+	{
+		COMMAND_TYPE_BEGIN_SCENE,
+		COMMAND_TYPE_END_SCENE,
+		COMMAND_TYPE_SET_RENDER_TARGET,
+		COMMAND_TYPE_CLEAR,
+		COMMAND_TYPE_SET_VIEWPORTS,
+		COMMAND_TYPE_SET_SCISSOR_RECTS,
+		COMMAND_TYPE_SET_PRIMITIVE_TOPOLOGY,
+		COMMAND_TYPE_SET_VERTEX_DATA,
+		COMMAND_TYPE_SET_INSTANCE_DATA,
+		COMMAND_TYPE_SET_INDEX_DATA,
+		COMMAND_TYPE_DRAW_INSTANCED,
+		COMMAND_TYPE_DRAW_INDEXED_INSTANCED,
+		COMMAND_TYPE_SET_32BIT_CONSTANTS,
+		COMMAND_TYPE_MAP_DESCRIPTOR_TABLE_OFFSET,
+		COMMAND_TYPE_RESOLVE_TEXTURE,
+		COMMAND_TYPE_EXECUTE_BUNDLE
+	} COMMAND_TYPE;
+
+	// Comando gravado. Dados de tamanho variável (retângulos, viewports e constantes) são armazenados no vetor payload do contexto e
+	// referenciados por payloadOffset (em palavras de 32 bits).
+	typedef struct RECORDED_COMMAND
+	{
+		COMMAND_TYPE type;
+		union
+		{
+			struct { PipelineState* pipelineState; } beginScene;
+			struct { Texture* renderTarget; } setRenderTarget;
+			struct { unsigned int count; unsigned int payloadOffset; unsigned int flags; float colorRGBA[4]; float z; unsigned int stencil; BOOLEAN hasColor; } clear;
+			struct { unsigned int count; unsigned int payloadOffset; } rects;
+			struct { PRIMITIVE_TOPOLOGY primitiveTopology; } setPrimitiveTopology;
+			struct { void* pData; unsigned int dataSize; unsigned int dataSizePerElement; unsigned int stepRate; } setData;
+			struct { unsigned int vertexCountPerInstance; unsigned int instanceCount; unsigned int startVertexCount; unsigned int startInstanceLocation; } drawInstanced;
+			struct { unsigned int indexCountPerInstance; unsigned int instanceCount; unsigned int startIndexCount; unsigned int startVertexCount; unsigned int startInstanceLocation; } drawIndexedInstanced;
+			struct { unsigned int shaderRegister; unsigned int num32bitValues; unsigned int payloadOffset; unsigned int destOffset; } set32bitConstants;
+			struct { unsigned int descriptorTableOffset; } mapDescriptorTableOffset;
+			struct { Texture* nonMultisampledTexture; Texture* multisampledTexture; } resolveTexture;
+			struct { CommandBundle* bundle; } executeBundle;
+		};
+	} RECORDED_COMMAND;
+}
+
+struct CommandContext
+{
+	std::vector<RECORDED_COMMAND> commands;
+	std::vector<unsigned int> payload;
+};
+
+// Os índices de alteração referenciam as posições dos comandos Set32bitConstants e MapDescriptorTableOffsetToBaseRegister em commands.
+struct CommandBundle
+{
+	CommandContext commands;
+	std::vector<unsigned int> constantPatches;
+	std::vector<unsigned int> descriptorTablePatches;
+};
+
+namespace
+{
+	RECORDED_COMMAND* AppendCommand(CommandContext* context, COMMAND_TYPE type)
+	{
+		context->commands.emplace_back();
+		RECORDED_COMMAND* command = &context->commands.back();
+		command->type = type;
+		return command;
+	}
+
+	unsigned int AppendPayload(CommandContext* context, const void* pData, unsigned int sizeInBytes)
+	{
+		unsigned int offset = (unsigned int)context->payload.size();
+		context->payload.resize(offset + (sizeInBytes + 3) / 4);
+		memcpy(&context->payload[offset], pData, sizeInBytes);
+		return offset;
+	}
+
+	// Número de registradores de constantes acompanhados pelo estado sombra. Constantes de registradores maiores são sempre enviadas.
+	const unsigned int MAX_SHADOWED_CONSTANT_REGISTERS = 16;
+
+	// Cópia do estado enviado ao contexto padrão durante a execução dos contextos, utilizada para descartar comandos que não alteram o
+	// estado. O estado é invalidado no início de cada execução e a cada BeginScene/EndScene, pois o contexto padrão pode ter sido alterado
+	// fora dos contextos de comandos.
+	typedef struct SHADOW_STATE
+	{
+		bool renderTargetValid;
+		Texture* renderTarget;
+		bool viewportsValid;
+		std::vector<unsigned int> viewports;
+		bool scissorRectsValid;
+		std::vector<unsigned int> scissorRects;
+		bool primitiveTopologyValid;
+		PRIMITIVE_TOPOLOGY primitiveTopology;
+		bool vertexDataValid;
+		void* pVertexData;
+		unsigned int vertexDataSize;
+		unsigned int dataSizePerVertex;
+		bool instanceDataValid;
+		void* pInstanceData;
+		unsigned int instanceDataSize;
+		unsigned int dataSizePerInstance;
+		unsigned int instanceStepRate;
+		bool indexDataValid;
+		unsigned int* pIndexData;
+		unsigned int indexDataSize;
+		bool descriptorTableOffsetValid;
+		unsigned int descriptorTableOffset;
+		// Valores (e indicação de validade) de cada constante de cada registrador.
+		std::vector<unsigned int> constants[MAX_SHADOWED_CONSTANT_REGISTERS];
+		std::vector<unsigned char> constantsValid[MAX_SHADOWED_CONSTANT_REGISTERS];
+	} SHADOW_STATE;
+
+	struct ReplayState
+	{
+		bool filteringEnabled = true;
+		SHADOW_STATE shadow;
+		COMMAND_CONTEXT_STATS stats = {};
+	};
+
+	// Os contextos são executados apenas pela thread de renderização.
+	ReplayState& GetReplayState()
+	{
+		static ReplayState state;
+		return state;
+	}
+
+	void InvalidateShadowState(SHADOW_STATE& shadow)
+	{
+		shadow.renderTargetValid = false;
+		shadow.viewportsValid = false;
+		shadow.scissorRectsValid = false;
+		shadow.primitiveTopologyValid = false;
+		shadow.vertexDataValid = false;
+		shadow.instanceDataValid = false;
+		shadow.indexDataValid = false;
+		shadow.descriptorTableOffsetValid = false;
+		for (unsigned int i = 0; i < MAX_SHADOWED_CONSTANT_REGISTERS; i++)
+			shadow.constantsValid[i].clear();
+	}
+
+	bool SameWords(bool valid, const std::vector<unsigned int>& shadow, const unsigned int* pWords, size_t numWords)
+	{
+		return valid && shadow.size() == numWords && memcmp(shadow.data(), pWords, numWords * sizeof(unsigned int)) == 0;
+	}
+
+	bool SameConstants(const SHADOW_STATE& shadow, unsigned int shaderRegister, unsigned int destOffset, const unsigned int* pValues, unsigned int numValues)
+	{
+		if (shaderRegister >= MAX_SHADOWED_CONSTANT_REGISTERS || shadow.constantsValid[shaderRegister].size() < destOffset + numValues)
+			return false;
+
+		for (unsigned int i = 0; i < numValues; i++)
+			if (!shadow.constantsValid[shaderRegister][destOffset + i] || shadow.constants[shaderRegister][destOffset + i] != pValues[i])
+				return false;
+
+		return true;
+	}
+
+	void UpdateConstants(SHADOW_STATE& shadow, unsigned int shaderRegister, unsigned int destOffset, const unsigned int* pValues, unsigned int numValues, bool valid)
+	{
+		if (shaderRegister >= MAX_SHADOWED_CONSTANT_REGISTERS)
+			return;
+
+		if (shadow.constantsValid[shaderRegister].size() < destOffset + numValues)
+		{
+			shadow.constants[shaderRegister].resize(destOffset + numValues);
+			shadow.constantsValid[shaderRegister].resize(destOffset + numValues, 0);
+		}
+
+		for (unsigned int i = 0; i < numValues; i++)
+		{
+			shadow.constants[shaderRegister][destOffset + i] = pValues[i];
+			shadow.constantsValid[shaderRegister][destOffset + i] = valid ? 1 : 0;
+		}
+	}
+
+	LeanDX12Result ExecuteCommands(const CommandContext* context);
+
+	// Executa um comando, descartando-o se o estado que ele define já estiver ativo. Um comando de estado que retornar erro invalida o
+	// estado sombra correspondente.
+	LeanDX12Result ExecuteCommand(const CommandContext* context, const RECORDED_COMMAND& command)
+	{
+		ReplayState& state = GetReplayState();
+		SHADOW_STATE& shadow = state.shadow;
+		bool filter = state.filteringEnabled;
+		const unsigned int* payload = context->payload.data();
+		LeanDX12Result result = LEANDX12_OK;
+
+		switch (command.type)
+		{
+		case COMMAND_TYPE_BEGIN_SCENE:
+			InvalidateShadowState(shadow);
+			result = BeginScene(command.beginScene.pipelineState);
+			break;
+
+		case COMMAND_TYPE_END_SCENE:
+			InvalidateShadowState(shadow);
+			EndScene();
+			break;
+
+		case COMMAND_TYPE_SET_RENDER_TARGET:
+			if (filter && shadow.renderTargetValid && shadow.renderTarget == command.setRenderTarget.renderTarget)
+			{
+				state.stats.numCallsFiltered++;
+				return LEANDX12_OK;
+			}
+			SetRenderTarget(command.setRenderTarget.renderTarget);
+			shadow.renderTargetValid = true;
+			shadow.renderTarget = command.setRenderTarget.renderTarget;
+			break;
+
+		case COMMAND_TYPE_CLEAR:
+			result = Clear(command.clear.count, command.clear.count ? (const CLEAR_RECT*)&payload[command.clear.payloadOffset] : NULL,
+				command.clear.flags, command.clear.hasColor ? command.clear.colorRGBA : NULL, command.clear.z, command.clear.stencil);
+			break;
+
+		case COMMAND_TYPE_SET_VIEWPORTS:
+		case COMMAND_TYPE_SET_SCISSOR_RECTS:
+		{
+			bool viewports = command.type == COMMAND_TYPE_SET_VIEWPORTS;
+			bool& valid = viewports ? shadow.viewportsValid : shadow.scissorRectsValid;
+			std::vector<unsigned int>& words = viewports ? shadow.viewports : shadow.scissorRects;
+			const unsigned int* pRects = &payload[command.rects.payloadOffset];
+			size_t numWords = command.rects.count * sizeof(VIEWPORT) / sizeof(unsigned int);
+
+			if (filter && SameWords(valid, words, pRects, numWords))
+			{
+				state.stats.numCallsFiltered++;
+				return LEANDX12_OK;
+			}
+
+			result = viewports ? SetViewports(command.rects.count, (VIEWPORT*)pRects) : SetScissorRects(command.rects.count, (SCISSOR_RECT*)pRects);
+			valid = result == LEANDX12_OK;
+			words.assign(pRects, pRects + numWords);
+			break;
+		}
+
+		case COMMAND_TYPE_SET_PRIMITIVE_TOPOLOGY:
+			if (filter && shadow.primitiveTopologyValid && shadow.primitiveTopology == command.setPrimitiveTopology.primitiveTopology)
+			{
+				state.stats.numCallsFiltered++;
+				return LEANDX12_OK;
+			}
+			SetPrimitiveTopology(command.setPrimitiveTopology.primitiveTopology);
+			shadow.primitiveTopologyValid = true;
+			shadow.primitiveTopology = command.setPrimitiveTopology.primitiveTopology;
+			break;
+
+		case COMMAND_TYPE_SET_VERTEX_DATA:
+			if (filter && shadow.vertexDataValid && shadow.pVertexData == command.setData.pData &&
+				shadow.vertexDataSize == command.setData.dataSize && shadow.dataSizePerVertex == command.setData.dataSizePerElement)
+			{
+				state.stats.numCallsFiltered++;
+				return LEANDX12_OK;
+			}
+			result = SetVertexData(command.setData.pData, command.setData.dataSize, command.setData.dataSizePerElement);
+			shadow.vertexDataValid = result == LEANDX12_OK;
+			shadow.pVertexData = command.setData.pData;
+			shadow.vertexDataSize = command.setData.dataSize;
+			shadow.dataSizePerVertex = command.setData.dataSizePerElement;
+			break;
+
+		case COMMAND_TYPE_SET_INSTANCE_DATA:
+			if (filter && shadow.instanceDataValid && shadow.pInstanceData == command.setData.pData &&
+				shadow.instanceDataSize == command.setData.dataSize && shadow.dataSizePerInstance == command.setData.dataSizePerElement &&
+				shadow.instanceStepRate == command.setData.stepRate)
+			{
+				state.stats.numCallsFiltered++;
+				return LEANDX12_OK;
+			}
+			result = SetInstanceData(command.setData.pData, command.setData.dataSize, command.setData.dataSizePerElement, command.setData.stepRate);
+			shadow.instanceDataValid = result == LEANDX12_OK;
+			shadow.pInstanceData = command.setData.pData;
+			shadow.instanceDataSize = command.setData.dataSize;
+			shadow.dataSizePerInstance = command.setData.dataSizePerElement;
+			shadow.instanceStepRate = command.setData.stepRate;
+			break;
+
+		case COMMAND_TYPE_SET_INDEX_DATA:
+			if (filter && shadow.indexDataValid && shadow.pIndexData == command.setData.pData && shadow.indexDataSize == command.setData.dataSize)
+			{
+				state.stats.numCallsFiltered++;
+				return LEANDX12_OK;
+			}
+			result = SetIndexData((unsigned int*)command.setData.pData, command.setData.dataSize);
+			shadow.indexDataValid = result == LEANDX12_OK;
+			shadow.pIndexData = (unsigned int*)command.setData.pData;
+			shadow.indexDataSize = command.setData.dataSize;
+			break;
+
+		case COMMAND_TYPE_DRAW_INSTANCED:
+			DrawInstanced(command.drawInstanced.vertexCountPerInstance, command.drawInstanced.instanceCount,
+				command.drawInstanced.startVertexCount, command.drawInstanced.startInstanceLocation);
+			break;
+
+		case COMMAND_TYPE_DRAW_INDEXED_INSTANCED:
+			DrawIndexedInstanced(command.drawIndexedInstanced.indexCountPerInstance, command.drawIndexedInstanced.instanceCount,
+				command.drawIndexedInstanced.startIndexCount, command.drawIndexedInstanced.startVertexCount,
+				command.drawIndexedInstanced.startInstanceLocation);
+			break;
+
+		case COMMAND_TYPE_SET_32BIT_CONSTANTS:
+		{
+			const unsigned int* pValues = &payload[command.set32bitConstants.payloadOffset];
+			unsigned int shaderRegister = command.set32bitConstants.shaderRegister;
+			unsigned int destOffset = command.set32bitConstants.destOffset;
+			unsigned int numValues = command.set32bitConstants.num32bitValues;
+
+			if (filter && SameConstants(shadow, shaderRegister, destOffset, pValues, numValues))
+			{
+				state.stats.numCallsFiltered++;
+				return LEANDX12_OK;
+			}
+			result = Set32bitConstants(shaderRegister, numValues, (void*)pValues, destOffset);
+			UpdateConstants(shadow, shaderRegister, destOffset, pValues, numValues, result == LEANDX12_OK);
+			break;
+		}
+
+		case COMMAND_TYPE_MAP_DESCRIPTOR_TABLE_OFFSET:
+			if (filter && shadow.descriptorTableOffsetValid && shadow.descriptorTableOffset == command.mapDescriptorTableOffset.descriptorTableOffset)
+			{
+				state.stats.numCallsFiltered++;
+				return LEANDX12_OK;
+			}
+			result = MapDescriptorTableOffsetToBaseRegister(command.mapDescriptorTableOffset.descriptorTableOffset);
+			shadow.descriptorTableOffsetValid = result == LEANDX12_OK;
+			shadow.descriptorTableOffset = command.mapDescriptorTableOffset.descriptorTableOffset;
+			break;
+
+		case COMMAND_TYPE_RESOLVE_TEXTURE:
+			result = ResolveTextureAsync(command.resolveTexture.nonMultisampledTexture, command.resolveTexture.multisampledTexture);
+			break;
+
+		case COMMAND_TYPE_EXECUTE_BUNDLE:
+			return ExecuteCommands(&command.executeBundle.bundle->commands);
+
+		default:
+			return LEANDX12_ERROR_INVALID_CALL;
+		}
+
+		state.stats.numCallsIssued++;
+		return result;
+	}
+
+	LeanDX12Result ExecuteCommands(const CommandContext* context)
+	{
+		GetReplayState().stats.numCommandsExecuted += (unsigned int)context->commands.size();
+
+		for (size_t i = 0; i < context->commands.size(); i++)
+		{
+			LeanDX12Result result = ExecuteCommand(context, context->commands[i]);
+			if (result != LEANDX12_OK)
+				return result;
+		}
+
+		return LEANDX12_OK;
+	}
+}
+
+// ---------------------------------------------------- Criação e execução de contextos ---------------------------------------------------- //
+
+LeanDX12Result CreateCommandContext(CommandContext** context)
+{
+	if (context == nullptr)
+		return LEANDX12_ERROR_INVALID_CALL;
+
+	*context = new CommandContext;
+	return LEANDX12_OK;
+}
+
+void DeleteCommandContext(CommandContext* context)
+{
+	delete context;
+}
+
+void ResetCommandContext(CommandContext* context)
+{
+	if (context == nullptr)
+		return;
+
+	context->commands.clear();
+	context->payload.clear();
+}
+
+unsigned int GetCommandCount(CommandContext* context)
+{
+	return context != nullptr ? (unsigned int)context->commands.size() : 0;
+}
+
+LeanDX12Result ExecuteCommandContexts(unsigned int numContexts, CommandContext* const* contexts)
+{
+	if (numContexts > 0 && contexts == nullptr)
+		return LEANDX12_ERROR_INVALID_CALL;
+
+	InvalidateShadowState(GetReplayState().shadow);
+
+	for (unsigned int i = 0; i < numContexts; i++)
+	{
+		if (contexts[i] == nullptr)
+			return LEANDX12_ERROR_INVALID_CALL;
+
+		LeanDX12Result result = ExecuteCommands(contexts[i]);
+		if (result != LEANDX12_OK)
+			return result;
+	}
+
+	return LEANDX12_OK;
+}
+
+void SetCommandContextStateFiltering(BOOLEAN enable)
+{
+	GetReplayState().filteringEnabled = enable != 0;
+}
+
+void GetCommandContextStats(COMMAND_CONTEXT_STATS* stats)
+{
+	if (stats != nullptr)
+		*stats = GetReplayState().stats;
+}
+
+void ResetCommandContextStats()
+{
+	GetReplayState().stats = COMMAND_CONTEXT_STATS();
+}
+
+// ---------------------------------------------------------- Gravação de comandos --------------------------------------------------------- //
+
+LeanDX12Result BeginScene(CommandContext* context, PipelineState* pipelineState)
+{
+	if (context == nullptr || pipelineState == nullptr)
+		return LEANDX12_ERROR_INVALID_CALL;
+
+	AppendCommand(context, COMMAND_TYPE_BEGIN_SCENE)->beginScene.pipelineState = pipelineState;
+	return LEANDX12_OK;
+}
+
+LeanDX12Result EndScene(CommandContext* context)
+{
+	if (context == nullptr)
+		return LEANDX12_ERROR_INVALID_CALL;
+
+	AppendCommand(context, COMMAND_TYPE_END_SCENE);
+	return LEANDX12_OK;
+}
+
+LeanDX12Result SetRenderTarget(CommandContext* context, Texture* renderTarget)
+{
+	if (context == nullptr)
+		return LEANDX12_ERROR_INVALID_CALL;
+
+	AppendCommand(context, COMMAND_TYPE_SET_RENDER_TARGET)->setRenderTarget.renderTarget = renderTarget;
+	return LEANDX12_OK;
+}
+
+LeanDX12Result Clear(CommandContext* context, unsigned int count, const CLEAR_RECT* pRects, unsigned int flags, const float colorRGBA[4], float z, unsigned int stencil)
+{
+	if (context == nullptr || (count > 0 && pRects == nullptr))
+		return LEANDX12_ERROR_INVALID_CALL;
+
+	unsigned int payloadOffset = count > 0 ? AppendPayload(context, pRects, count * sizeof(CLEAR_RECT)) : 0;
+
+	RECORDED_COMMAND* command = AppendCommand(context, COMMAND_TYPE_CLEAR);
+	command->clear.count = count;
+	command->clear.payloadOffset = payloadOffset;
+	command->clear.flags = flags;
+	command->clear.hasColor = colorRGBA != nullptr;
+	if (colorRGBA != nullptr)
+		memcpy(command->clear.colorRGBA, colorRGBA, sizeof(command->clear.colorRGBA));
+	command->clear.z = z;
+	command->clear.stencil = stencil;
+
+	return LEANDX12_OK;
+}
+
+LeanDX12Result SetViewports(CommandContext* context, unsigned int numViewports, const VIEWPORT* pViewports)
+{
+	if (context == nullptr || numViewports == 0 || pViewports == nullptr)
+		return LEANDX12_ERROR_INVALID_CALL;
+
+	unsigned int payloadOffset = AppendPayload(context, pViewports, numViewports * sizeof(VIEWPORT));
+
+	RECORDED_COMMAND* command = AppendCommand(context, COMMAND_TYPE_SET_VIEWPORTS);
+	command->rects.count = numViewports;
+	command->rects.payloadOffset = payloadOffset;
+
+	return LEANDX12_OK;
+}
+
+LeanDX12Result SetScissorRects(CommandContext* context, unsigned int numScissorRects, const SCISSOR_RECT* pScissorRects)
+{
+	if (context == nullptr || numScissorRects == 0 || pScissorRects == nullptr)
+		return LEANDX12_ERROR_INVALID_CALL;
+
+	unsigned int payloadOffset = AppendPayload(context, pScissorRects, numScissorRects * sizeof(SCISSOR_RECT));
+
+	RECORDED_COMMAND* command = AppendCommand(context, COMMAND_TYPE_SET_SCISSOR_RECTS);
+	command->rects.count = numScissorRects;
+	command->rects.payloadOffset = payloadOffset;
+
+	return LEANDX12_OK;
+}
+
+LeanDX12Result SetPrimitiveTopology(CommandContext* context, PRIMITIVE_TOPOLOGY primitiveTopology)
+{
+	if (context == nullptr)
+		return LEANDX12_ERROR_INVALID_CALL;
+
+	AppendCommand(context, COMMAND_TYPE_SET_PRIMITIVE_TOPOLOGY)->setPrimitiveTopology.primitiveTopology = primitiveTopology;
+	return LEANDX12_OK;
+}
+
+LeanDX12Result SetVertexData(CommandContext* context, void* pVertexData, unsigned int vertexDataSize, unsigned int dataSizePerVertex)
+{
+	if (context == nullptr || pVertexData == nullptr)
+		return LEANDX12_ERROR_INVALID_CALL;
+
+	RECORDED_COMMAND* command = AppendCommand(context, COMMAND_TYPE_SET_VERTEX_DATA);
+	command->setData.pData = pVertexData;
+	command->setData.dataSize = vertexDataSize;
+	command->setData.dataSizePerElement = dataSizePerVertex;
+	command->setData.stepRate = 0;
+
+	return LEANDX12_OK;
+}
+
+LeanDX12Result SetInstanceData(CommandContext* context, void* pInstanceData, unsigned int instanceDataSize, unsigned int dataSizePerInstance, unsigned int stepRate)
+{
+	if (context == nullptr || pInstanceData == nullptr)
+		return LEANDX12_ERROR_INVALID_CALL;
+
+	RECORDED_COMMAND* command = AppendCommand(context, COMMAND_TYPE_SET_INSTANCE_DATA);
+	command->setData.pData = pInstanceData;
+	command->setData.dataSize = instanceDataSize;
+	command->setData.dataSizePerElement = dataSizePerInstance;
+	command->setData.stepRate = stepRate;
+
+	return LEANDX12_OK;
+}
+
+LeanDX12Result SetIndexData(CommandContext* context, unsigned int* pIndexData, unsigned int indexDataSize)
+{
+	if (context == nullptr || pIndexData == nullptr)
+		return LEANDX12_ERROR_INVALID_CALL;
+
+	RECORDED_COMMAND* command = AppendCommand(context, COMMAND_TYPE_SET_INDEX_DATA);
+	command->setData.pData = pIndexData;
+	command->setData.dataSize = indexDataSize;
+	command->setData.dataSizePerElement = sizeof(unsigned int);
+	command->setData.stepRate = 0;
+
+	return LEANDX12_OK;
+}
+
+LeanDX12Result DrawInstanced(CommandContext* context, unsigned int vertexCountPerInstance, unsigned int instanceCount, unsigned int startVertexCount, unsigned int startInstanceLocation)
+{
+	if (context == nullptr)
+		return LEANDX12_ERROR_INVALID_CALL;
+
+	RECORDED_COMMAND* command = AppendCommand(context, COMMAND_TYPE_DRAW_INSTANCED);
+	command->drawInstanced.vertexCountPerInstance = vertexCountPerInstance;
+	command->drawInstanced.instanceCount = instanceCount;
+	command->drawInstanced.startVertexCount = startVertexCount;
+	command->drawInstanced.startInstanceLocation = startInstanceLocation;
+
+	return LEANDX12_OK;
+}
+
+LeanDX12Result DrawIndexedInstanced(CommandContext* context, unsigned int indexCountPerInstance, unsigned int instanceCount, unsigned int startIndexCount, unsigned int startVertexCount, unsigned int startInstanceLocation)
+{
+	if (context == nullptr)
+		return LEANDX12_ERROR_INVALID_CALL;
+
+	RECORDED_COMMAND* command = AppendCommand(context, COMMAND_TYPE_DRAW_INDEXED_INSTANCED);
+	command->drawIndexedInstanced.indexCountPerInstance = indexCountPerInstance;
+	command->drawIndexedInstanced.instanceCount = instanceCount;
+	command->drawIndexedInstanced.startIndexCount = startIndexCount;
+	command->drawIndexedInstanced.startVertexCount = startVertexCount;
+	command->drawIndexedInstanced.startInstanceLocation = startInstanceLocation;
+
+	return LEANDX12_OK;
+}
+
+LeanDX12Result Set32bitConstants(CommandContext* context, unsigned int shaderRegister, unsigned int num32bitValues, const void* pConstants, unsigned int destOffset)
+{
+	if (context == nullptr || num32bitValues == 0 || pConstants == nullptr)
+		return LEANDX12_ERROR_INVALID_CALL;
+
+	unsigned int payloadOffset = AppendPayload(context, pConstants, num32bitValues * sizeof(unsigned int));
+
+	RECORDED_COMMAND* command = AppendCommand(context, COMMAND_TYPE_SET_32BIT_CONSTANTS);
+	command->set32bitConstants.shaderRegister = shaderRegister;
+	command->set32bitConstants.num32bitValues = num32bitValues;
+	command->set32bitConstants.payloadOffset = payloadOffset;
+	command->set32bitConstants.destOffset = destOffset;
+
+	return LEANDX12_OK;
+}
+
+LeanDX12Result MapDescriptorTableOffsetToBaseRegister(CommandContext* context, unsigned int descriptorTableOffset)
+{
+	if (context == nullptr)
+		return LEANDX12_ERROR_INVALID_CALL;
+
+	AppendCommand(context, COMMAND_TYPE_MAP_DESCRIPTOR_TABLE_OFFSET)->mapDescriptorTableOffset.descriptorTableOffset = descriptorTableOffset;
+	return LEANDX12_OK;
+}
+
+LeanDX12Result ResolveTextureAsync(CommandContext* context, Texture* nonMultisampledTexture, Texture* multisampledTexture)
+{
+	if (context == nullptr || nonMultisampledTexture == nullptr || multisampledTexture == nullptr)
+		return LEANDX12_ERROR_INVALID_CALL;
+
+	RECORDED_COMMAND* command = AppendCommand(context, COMMAND_TYPE_RESOLVE_TEXTURE);
+	command->resolveTexture.nonMultisampledTexture = nonMultisampledTexture;
+	command->resolveTexture.multisampledTexture = multisampledTexture;
+
+	return LEANDX12_OK;
+}
+
+// ---------------------------------------------------------- Pacotes de comandos ---------------------------------------------------------- //
+
+LeanDX12Result CreateCommandBundle(CommandContext* context, CommandBundle** bundle)
+{
+	if (context == nullptr || bundle == nullptr)
+		return LEANDX12_ERROR_INVALID_CALL;
+
+	CommandBundle* newBundle = new CommandBundle;
+	newBundle->commands.commands = context->commands;
+	newBundle->commands.payload = context->payload;
+
+	for (size_t i = 0; i < context->commands.size(); i++)
+	{
+		switch (context->commands[i].type)
+		{
+		case COMMAND_TYPE_BEGIN_SCENE:
+		case COMMAND_TYPE_END_SCENE:
+		case COMMAND_TYPE_SET_RENDER_TARGET:
+		case COMMAND_TYPE_CLEAR:
+		case COMMAND_TYPE_RESOLVE_TEXTURE:
+		case COMMAND_TYPE_EXECUTE_BUNDLE:
+			delete newBundle;
+			return LEANDX12_ERROR_INVALID_CALL;
+
+		case COMMAND_TYPE_SET_32BIT_CONSTANTS:
+			newBundle->constantPatches.push_back((unsigned int)i);
+			break;
+
+		case COMMAND_TYPE_MAP_DESCRIPTOR_TABLE_OFFSET:
+			newBundle->descriptorTablePatches.push_back((unsigned int)i);
+			break;
+
+		default:
+			break;
+		}
+	}
+
+	*bundle = newBundle;
+	return LEANDX12_OK;
+}
+
+void DeleteCommandBundle(CommandBundle* bundle)
+{
+	delete bundle;
+}
+
+void GetCommandBundlePatchCount(CommandBundle* bundle, unsigned int* numConstantPatches, unsigned int* numDescriptorTablePatches)
+{
+	if (numConstantPatches != nullptr)
+		*numConstantPatches = bundle != nullptr ? (unsigned int)bundle->constantPatches.size() : 0;
+	if (numDescriptorTablePatches != nullptr)
+		*numDescriptorTablePatches = bundle != nullptr ? (unsigned int)bundle->descriptorTablePatches.size() : 0;
+}
+
+LeanDX12Result PatchCommandBundleConstants(CommandBundle* bundle, unsigned int patchIndex, unsigned int num32bitValues, const void* pConstants, unsigned int offset)
+{
+	if (bundle == nullptr || pConstants == nullptr)
+		return LEANDX12_ERROR_INVALID_CALL;
+	if (patchIndex >= bundle->constantPatches.size())
+		return LEANDX12_ERROR_OFFSET_OUT_OF_RANGE;
+
+	const RECORDED_COMMAND& command = bundle->commands.commands[bundle->constantPatches[patchIndex]];
+	if (offset > command.set32bitConstants.num32bitValues || num32bitValues > command.set32bitConstants.num32bitValues - offset)
+		return LEANDX12_ERROR_OFFSET_OUT_OF_RANGE;
+
+	memcpy(&bundle->commands.payload[command.set32bitConstants.payloadOffset + offset], pConstants, num32bitValues * sizeof(unsigned int));
+	return LEANDX12_OK;
+}
+
+LeanDX12Result PatchCommandBundleDescriptorTableOffset(CommandBundle* bundle, unsigned int patchIndex, unsigned int descriptorTableOffset)
+{
+	if (bundle == nullptr)
+		return LEANDX12_ERROR_INVALID_CALL;
+	if (patchIndex >= bundle->descriptorTablePatches.size())
+		return LEANDX12_ERROR_OFFSET_OUT_OF_RANGE;
+
+	bundle->commands.commands[bundle->descriptorTablePatches[patchIndex]].mapDescriptorTableOffset.descriptorTableOffset = descriptorTableOffset;
+	return LEANDX12_OK;
+}
+
+LeanDX12Result ExecuteCommandBundle(CommandBundle* bundle)
+{
+	if (bundle == nullptr)
+		return LEANDX12_ERROR_INVALID_CALL;
+
+	InvalidateShadowState(GetReplayState().shadow);
+	return ExecuteCommands(&bundle->commands);
+}
+
+LeanDX12Result ExecuteCommandBundle(CommandContext* context, CommandBundle* bundle)
+{
+	if (context == nullptr || bundle == nullptr)
+		return LEANDX12_ERROR_INVALID_CALL;
+
+	AppendCommand(context, COMMAND_TYPE_EXECUTE_BUNDLE)->executeBundle.bundle = bundle;
+	return LEANDX12_OK;
+}
@@ -0,0 +1,122 @@
+/*
+* LeanDX12 - Contextos de comandos
+* Descrição: Gravação de comandos de renderização em contextos independentes, permitindo que várias threads gravem comandos ao mesmo
+* tempo. Cada contexto possui a sua própria memória de comandos e nenhum estado global é acessado durante a gravação; um mesmo contexto
+* não deve ser utilizado por duas threads ao mesmo tempo.
+*
+*	As funções de gravação são sobrecargas das funções da seção 3.5 de LeanDX12.h que recebem o contexto como primeiro parâmetro. Os
+*	contextos gravados são executados, na ordem em que foram informados, por ExecuteCommandContexts, que deve ser chamada da thread de
+*	renderização e reproduz os comandos por meio das funções de LeanDX12.h (o contexto padrão). Em seguida, o quadro é submetido
+*	normalmente (RenderFrame, RenderFrameAsync ou SubmitFrame).
+*
+*	Nota: a gravação em paralelo apenas preenche listas na memória do processador; todas as chamadas reais ao Direct3D 12 são feitas
+*	em série, na thread de renderização, durante ExecuteCommandContexts. O custo dessas chamadas (e o da reprodução) não é dividido
+*	entre as threads, pois LeanDX12.h expõe uma única lista de comandos e nenhuma forma de gravar listas secundárias. Os contextos
+*	servem para organizar a gravação por thread e fixar a ordem de submissão, e só reduzem o tempo da thread de renderização quando
+*	a preparação dos comandos (percorrer a cena, calcular constantes) custa mais do que as chamadas em si.
+*
+*	Durante a execução, o estado enviado ao contexto padrão (render target, viewports, retângulos de recorte, topologia, dados de
+*	vértices, instâncias e índices, constantes e deslocamento da tabela de descritores) é acompanhado, e os comandos que não o alteram
+*	são descartados. O estado acompanhado é reinicializado a cada execução e a cada BeginScene/EndScene. GetCommandContextStats informa
+*	quantas chamadas chegaram ao contexto padrão e quantas foram descartadas desde ResetCommandContextStats (chamada a cada quadro).
+*
+*	Viewports, retângulos e constantes são copiados para o contexto durante a gravação. Os dados de vértices, instâncias e índices NÃO
+*	são copiados: os ponteiros informados devem permanecer válidos até a execução do contexto.
+*
+*	Um pacote de comandos (CommandBundle) é criado a partir de um contexto gravado uma única vez e pode ser reproduzido várias vezes
+*	dentro de qualquer cena (entre BeginScene e EndScene), diretamente (ExecuteCommandBundle) ou a partir de outro contexto. Pacotes
+*	contêm apenas comandos de estado e de desenho (não podem conter BeginScene, EndScene, SetRenderTarget, Clear, ResolveTextureAsync
+*	nem outros pacotes). Entre as reproduções, apenas as constantes (Set32bitConstants) e os deslocamentos de tabela de descritores
+*	(MapDescriptorTableOffsetToBaseRegister) podem ser alterados, referenciados pelo índice do comando entre os comandos do mesmo tipo
+*	na ordem de gravação.
+*
+*	Nota: um pacote não é um pacote do Direct3D 12 (ID3D12GraphicsCommandList do tipo BUNDLE), que LeanDX12.h não expõe. Cada
+*	reprodução refaz, uma a uma, as mesmas chamadas às funções de LeanDX12.h que a gravação original faria (apenas as que não alteram
+*	o estado são descartadas), portanto não há economia de processador na reprodução: o ganho se limita a não percorrer novamente a
+*	lógica que gerou os comandos.
+*
+*   Organização do arquivo de cabeçalho:
+*	1.	Estruturas
+*		•	Estruturas opacas
+*		•	Estruturas transparentes
+*	2.	Declaração das funções
+*		•	Criação e execução de contextos
+*		•	Gravação de comandos
+*		•	Pacotes de comandos
+*/
+
+#ifndef _LEANDX12_COMMAND_CONTEXT_
+#define _LEANDX12_COMMAND_CONTEXT_
+
+#include <cstddef>
+
+#include "LeanDX12.h"
+
+// ------------------------------------------------------------ 1. Estruturas ------------------------------------------------------------- //
+
+// -------------------------------------------------------- 1.1. Estruturas opacas -------------------------------------------------------- //
+
+typedef struct CommandContext CommandContext;
+typedef struct CommandBundle CommandBundle;
+
+// ---------------------------------------------------- 1.2. Estruturas transparentes ----------------------------------------------------- //
+
+typedef struct COMMAND_CONTEXT_STATS
+{
+	unsigned int numCommandsExecuted;
+	unsigned int numCallsIssued;					// Chamadas feitas ao contexto padrão.
+	unsigned int numCallsFiltered;					// Comandos descartados por não alterarem o estado.
+} COMMAND_CONTEXT_STATS;
+
+// ------------------------------------------------------ 2. Declaração das funções ------------------------------------------------------- //
+
+// ---------------------------------------------------- 2.1. Criação e execução de contextos ---------------------------------------------- //
+
+LeanDX12Result CreateCommandContext(CommandContext** context);
+void DeleteCommandContext(CommandContext* context);
+// Descarta os comandos gravados, preservando a memória alocada para os próximos quadros.
+void ResetCommandContext(CommandContext* context);
+unsigned int GetCommandCount(CommandContext* context);
+// Executa os contextos na ordem do vetor. A execução é interrompida no primeiro comando que retornar erro.
+LeanDX12Result ExecuteCommandContexts(unsigned int numContexts, CommandContext* const* contexts);
+// Ativa ou desativa o descarte de comandos que não alteram o estado (ativado por padrão).
+void SetCommandContextStateFiltering(BOOLEAN enable);
+void GetCommandContextStats(COMMAND_CONTEXT_STATS* stats);
+void ResetCommandContextStats();
+
+// -------------------------------------------------------- 2.2. Gravação de comandos ----------------------------------------------------- //
+
+LeanDX12Result BeginScene(CommandContext* context, PipelineState* pipelineState);
+LeanDX12Result EndScene(CommandContext* context);
+LeanDX12Result SetRenderTarget(CommandContext* context, Texture* renderTarget);
+LeanDX12Result Clear(CommandContext* context, unsigned int count, const CLEAR_RECT* pRects, unsigned int flags, const float colorRGBA[4], float z, unsigned int stencil);
+LeanDX12Result SetViewports(CommandContext* context, unsigned int numViewports, const VIEWPORT* pViewports);
+LeanDX12Result SetScissorRects(CommandContext* context, unsigned int numScissorRects, const SCISSOR_RECT* pScissorRects);
+LeanDX12Result SetPrimitiveTopology(CommandContext* context, PRIMITIVE_TOPOLOGY primitiveTopology);
+LeanDX12Result SetVertexData(CommandContext* context, void* pVertexData, unsigned int vertexDataSize, unsigned int dataSizePerVertex);
+LeanDX12Result SetInstanceData(CommandContext* context, void* pInstanceData, unsigned int instanceDataSize, unsigned int dataSizePerInstance, unsigned int stepRate);
+LeanDX12Result SetIndexData(CommandContext* context, unsigned int* pIndexData, unsigned int indexDataSize);
+LeanDX12Result DrawInstanced(CommandContext* context, unsigned int vertexCountPerInstance, unsigned int instanceCount, unsigned int startVertexCount, unsigned int startInstanceLocation);
+LeanDX12Result DrawIndexedInstanced(CommandContext* context, unsigned int indexCountPerInstance, unsigned int instanceCount, unsigned int startIndexCount, unsigned int startVertexCount, unsigned int startInstanceLocation);
+LeanDX12Result Set32bitConstants(CommandContext* context, unsigned int shaderRegister, unsigned int num32bitValues, const void* pConstants, unsigned int destOffset);
+LeanDX12Result MapDescriptorTableOffsetToBaseRegister(CommandContext* context, unsigned int descriptorTableOffset);
+LeanDX12Result ResolveTextureAsync(CommandContext* context, Texture* nonMultisampledTexture, Texture* multisampledTexture);
+
+// -------------------------------------------------------- 2.3. Pacotes de comandos ------------------------------------------------------ //
+
+// Copia os comandos gravados em context para um novo pacote. O contexto pode ser reinicializado e reutilizado em seguida.
+LeanDX12Result CreateCommandBundle(CommandContext* context, CommandBundle** bundle);
+void DeleteCommandBundle(CommandBundle* bundle);
+// Número de comandos Set32bitConstants e MapDescriptorTableOffsetToBaseRegister do pacote (índices válidos para as funções de alteração).
+void GetCommandBundlePatchCount(CommandBundle* bundle, unsigned int* numConstantPatches, unsigned int* numDescriptorTablePatches);
+// Substitui num32bitValues valores, a partir de offset, das constantes do comando Set32bitConstants de índice patchIndex.
+LeanDX12Result PatchCommandBundleConstants(CommandBundle* bundle, unsigned int patchIndex, unsigned int num32bitValues, const void* pConstants, unsigned int offset);
+// Substitui o deslocamento do comando MapDescriptorTableOffsetToBaseRegister de índice patchIndex.
+LeanDX12Result PatchCommandBundleDescriptorTableOffset(CommandBundle* bundle, unsigned int patchIndex, unsigned int descriptorTableOffset);
+// Reproduz o pacote na cena atual (contexto padrão), com o mesmo custo de fazer as chamadas gravadas diretamente.
+LeanDX12Result ExecuteCommandBundle(CommandBundle* bundle);
+// Grava a reprodução do pacote em context. O pacote é referenciado (não copiado) e deve permanecer válido até a execução do contexto;
+// alterações feitas antes da execução são visíveis na reprodução.
+LeanDX12Result ExecuteCommandBundle(CommandContext* context, CommandBundle* bundle);
+
+#endif  // _LEANDX12_COMMAND_CONTEXT_
@@ -0,0 +1,173 @@
+// Descrição: Implementação do alocador de constant buffers das extensões LeanDX12 (LeanDX12ConstantAllocator.h).
+
+#include <cstring>
+#include <vector>
+
+#include "LeanDX12ConstantAllocator.h"
+
+static_assert(CONSTANT_PAGE_SIZE % CONSTANT_BLOCK_SIZE == 0, "CONSTANT_PAGE_SIZE deve ser múltiplo de CONSTANT_BLOCK_SIZE.");
+
+namespace
+{
+	typedef struct CONSTANT_PAGE
+	{
+		Buffer* constantBuffer;
+		Buffer* uploadBuffer;
+		std::vector<unsigned char> data;				// Cópia na CPU, enviada por CommitConstantAllocator.
+		unsigned int numBlocksUsed;
+	} CONSTANT_PAGE;
+}
+
+struct ConstantAllocator
+{
+	unsigned int firstDescriptorOffset = 0;
+	unsigned int maxPages = 0;
+	std::vector<CONSTANT_PAGE> pages;
+	unsigned int currentPage = 0;						// Primeira página com blocos livres.
+	CONSTANT_ALLOCATOR_STATS stats = {};
+};
+
+namespace
+{
+	LeanDX12Result AddPage(ConstantAllocator* allocator)
+	{
+		if ((unsigned int)allocator->pages.size() >= allocator->maxPages)
+			return LEANDX12_ERROR_INSUFFICIENT_BUFFER_SIZE;
+
+		CONSTANT_PAGE page = {};
+		unsigned int descriptorOffset = allocator->firstDescriptorOffset + (unsigned int)allocator->pages.size();
+
+		LeanDX12Result result = CreateBuffer(CONSTANT_PAGE_SIZE, BUFFER_TYPE_DEFAULT, &page.constantBuffer, descriptorOffset);
+		if (result != LEANDX12_OK)
+			return result;
+
+		result = CreateBuffer(CONSTANT_PAGE_SIZE, BUFFER_TYPE_UPLOAD, &page.uploadBuffer);
+		if (result != LEANDX12_OK)
+		{
+			DeleteBuffer(page.constantBuffer);
+			return result;
+		}
+
+		page.data.resize(CONSTANT_PAGE_SIZE);
+		allocator->pages.push_back(std::move(page));
+		allocator->stats.numPages = (unsigned int)allocator->pages.size();
+		return LEANDX12_OK;
+	}
+}
+
+LeanDX12Result CreateConstantAllocator(unsigned int firstDescriptorOffset, unsigned int maxPages, ConstantAllocator** allocator)
+{
+	if (allocator == nullptr || maxPages == 0)
+		return LEANDX12_ERROR_INVALID_CALL;
+
+	ConstantAllocator* newAllocator = new ConstantAllocator;
+	newAllocator->firstDescriptorOffset = firstDescriptorOffset;
+	newAllocator->maxPages = maxPages;
+	newAllocator->pages.reserve(maxPages);
+
+	*allocator = newAllocator;
+	return LEANDX12_OK;
+}
+
+void DeleteConstantAllocator(ConstantAllocator* allocator)
+{
+	if (allocator == nullptr)
+		return;
+
+	for (CONSTANT_PAGE& page : allocator->pages)
+	{
+		DeleteBuffer(page.constantBuffer);
+		DeleteBuffer(page.uploadBuffer);
+	}
+
+	delete allocator;
+}
+
+void ResetConstantAllocator(ConstantAllocator* allocator)
+{
+	if (allocator == nullptr)
+		return;
+
+	for (CONSTANT_PAGE& page : allocator->pages)
+		page.numBlocksUsed = 0;
+
+	allocator->currentPage = 0;
+	allocator->stats.numAllocations = 0;
+	allocator->stats.numBlocksUsed = 0;
+	allocator->stats.bytesRequested = 0;
+}
+
+LeanDX12Result AllocateConstants(ConstantAllocator* allocator, unsigned int sizeInBytes, CONSTANT_ALLOCATION* allocation)
+{
+	if (allocator == nullptr || allocation == nullptr || sizeInBytes == 0)
+		return LEANDX12_ERROR_INVALID_CALL;
+
+	if (sizeInBytes > CONSTANT_PAGE_SIZE)
+		return LEANDX12_ERROR_INSUFFICIENT_BUFFER_SIZE;
+
+	unsigned int numBlocks = (sizeInBytes + CONSTANT_BLOCK_SIZE - 1) / CONSTANT_BLOCK_SIZE;
+
+	// Os blocos de uma reserva ficam na mesma página; o restante da página atual é descartado quando não há espaço.
+	while (allocator->currentPage < (unsigned int)allocator->pages.size() &&
+		allocator->pages[allocator->currentPage].numBlocksUsed + numBlocks > CONSTANT_BLOCKS_PER_PAGE)
+		allocator->currentPage++;
+
+	if (allocator->currentPage == (unsigned int)allocator->pages.size())
+	{
+		LeanDX12Result result = AddPage(allocator);
+		if (result != LEANDX12_OK)
+			return result;
+	}
+
+	CONSTANT_PAGE& page = allocator->pages[allocator->currentPage];
+	unsigned char* pData = page.data.data() + page.numBlocksUsed * CONSTANT_BLOCK_SIZE;
+	memset(pData, 0, numBlocks * CONSTANT_BLOCK_SIZE);
+
+	allocation->pData = pData;
+	allocation->pageIndex = allocator->currentPage;
+	allocation->descriptorTableOffset = allocator->firstDescriptorOffset + allocator->currentPage;
+	allocation->blockIndex = page.numBlocksUsed;
+	allocation->numBlocks = numBlocks;
+
+	page.numBlocksUsed += numBlocks;
+	allocator->stats.numAllocations++;
+	allocator->stats.numBlocksUsed += numBlocks;
+	allocator->stats.bytesRequested += sizeInBytes;
+	return LEANDX12_OK;
+}
+
+LeanDX12Result CommitConstantAllocator(ConstantAllocator* allocator)
+{
+	if (allocator == nullptr)
+		return LEANDX12_ERROR_INVALID_CALL;
+
+	allocator->stats.bytesUploaded = 0;
+
+	for (CONSTANT_PAGE& page : allocator->pages)
+	{
+		if (page.numBlocksUsed == 0)
+			continue;
+
+		// Apenas os blocos utilizados são enviados; o restante do buffer de envio mantém dados antigos que não são lidos.
+		unsigned int usedBytes = page.numBlocksUsed * CONSTANT_BLOCK_SIZE;
+		LeanDX12Result result = UploadData(page.uploadBuffer, NULL, 1, usedBytes, 1, 1, page.data.data());
+		if (result != LEANDX12_OK)
+			return result;
+
+		result = SetPrivateData(page.constantBuffer, page.uploadBuffer);
+		if (result != LEANDX12_OK)
+			return result;
+
+		allocator->stats.bytesUploaded += usedBytes;
+	}
+
+	return LEANDX12_OK;
+}
+
+void GetConstantAllocatorStats(ConstantAllocator* allocator, CONSTANT_ALLOCATOR_STATS* stats)
+{
+	if (allocator == nullptr || stats == nullptr)
+		return;
+
+	*stats = allocator->stats;
+}
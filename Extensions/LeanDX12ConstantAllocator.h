@@ -0,0 +1,109 @@
+/*
+* LeanDX12 - Alocador de constant buffers
+* Descrição: Subalocação de blocos de constantes em páginas de 64 KB (o tamanho máximo de um constant buffer), com granularidade de
+* 256 bytes. Cada página é um único Buffer com um único descritor, e os descritores das páginas ocupam posições consecutivas da tabela
+* de descritores, portanto milhares de blocos de constantes por objeto custam um recurso (e um descritor) a cada 256 blocos.
+*
+*	Uso por quadro:
+*		1.	ResetConstantAllocator (os blocos do quadro anterior são descartados e as páginas são reaproveitadas);
+*		2.	AllocateConstants ou Allocate<T> para cada bloco, preenchido diretamente na memória retornada;
+*		3.	CommitConstantAllocator (fora das cenas), que envia apenas a parte utilizada de cada página;
+*		4.	nos desenhos, MapDescriptorTableOffsetToBaseRegister(allocation.descriptorTableOffset) seleciona a página e blockIndex
+*			(enviado como constante de 32 bits) seleciona o bloco.
+*
+*	No shader, a página é declarada como um vetor de blocos de 256 bytes:
+*
+*		struct ObjectBlock { float4x4 world; float4 color; float4 padding[11]; };		// 256 bytes
+*		cbuffer ObjectPage : register(b1) { ObjectBlock blocks[256]; };
+*		cbuffer ObjectIndex : register(b0) { uint blockIndex; };					// Constante de 32 bits.
+*
+*	Allocate<T> verifica em tempo de compilação as regras de empacotamento de constant buffers do HLSL que podem ser verificadas sem
+*	conhecer os membros (tipo copiável byte a byte, tamanho múltiplo de 16 bytes e alinhamento de no máximo 16 bytes).
+*	LEANDX12_CHECK_CONSTANT_MEMBER verifica um membro (que não seja um vetor): membros não podem cruzar um limite de 16 bytes.
+*
+*	As páginas são atualizadas por SetPrivateData, portanto CommitConstantAllocator deve ser chamada após a conclusão dos desenhos que
+*	utilizaram os blocos do quadro anterior. Um mesmo alocador não deve ser utilizado por várias threads ao mesmo tempo.
+*
+*   Organização do arquivo de cabeçalho:
+*	1.	Estruturas
+*		•	Estruturas opacas
+*		•	Estruturas transparentes
+*	2.	Declaração das funções
+*/
+
+#ifndef _LEANDX12_CONSTANT_ALLOCATOR_
+#define _LEANDX12_CONSTANT_ALLOCATOR_
+
+#include <cstddef>
+#include <type_traits>
+
+#include "LeanDX12.h"
+
+#define CONSTANT_BLOCK_SIZE 256
+#define CONSTANT_PAGE_SIZE 65536
+#define CONSTANT_BLOCKS_PER_PAGE (CONSTANT_PAGE_SIZE / CONSTANT_BLOCK_SIZE)
+
+// Verifica se o membro member de Type (que não seja um vetor) respeita as regras de empacotamento do HLSL: um membro não pode cruzar
+// um limite de 16 bytes, exceto se iniciar em um limite de 16 bytes.
+#define LEANDX12_CHECK_CONSTANT_MEMBER(Type, member) \
+	static_assert(offsetof(Type, member) % 16 == 0 || \
+		offsetof(Type, member) / 16 == (offsetof(Type, member) + sizeof(((Type*)nullptr)->member) - 1) / 16, \
+		#Type "::" #member " cruza um limite de 16 bytes (regras de empacotamento do HLSL).")
+
+// ------------------------------------------------------------ 1. Estruturas ------------------------------------------------------------- //
+
+// -------------------------------------------------------- 1.1. Estruturas opacas -------------------------------------------------------- //
+
+typedef struct ConstantAllocator ConstantAllocator;
+
+// ---------------------------------------------------- 1.2. Estruturas transparentes ----------------------------------------------------- //
+
+typedef struct CONSTANT_ALLOCATION
+{
+	void* pData;									// Memória do bloco (válida até ResetConstantAllocator).
+	unsigned int pageIndex;
+	unsigned int descriptorTableOffset;				// Posição do descritor da página na tabela.
+	unsigned int blockIndex;						// Índice do primeiro bloco de 256 bytes na página.
+	unsigned int numBlocks;
+} CONSTANT_ALLOCATION;
+
+typedef struct CONSTANT_ALLOCATOR_STATS
+{
+	unsigned int numPages;
+	unsigned int numAllocations;
+	unsigned int numBlocksUsed;
+	unsigned long long bytesRequested;				// Soma dos tamanhos solicitados (antes do arredondamento para 256 bytes).
+	unsigned long long bytesUploaded;				// Enviados pelo último CommitConstantAllocator.
+} CONSTANT_ALLOCATOR_STATS;
+
+// ------------------------------------------------------ 2. Declaração das funções ------------------------------------------------------- //
+
+// As páginas são criadas sob demanda (até maxPages), com os descritores em firstDescriptorOffset, firstDescriptorOffset + 1, ...
+LeanDX12Result CreateConstantAllocator(unsigned int firstDescriptorOffset, unsigned int maxPages, ConstantAllocator** allocator);
+// Os Buffers das páginas são excluídos imediatamente; aguarde a conclusão dos desenhos que os utilizam.
+void DeleteConstantAllocator(ConstantAllocator* allocator);
+
+void ResetConstantAllocator(ConstantAllocator* allocator);
+// Reserva sizeInBytes (arredondado para múltiplos de 256 bytes, no máximo CONSTANT_PAGE_SIZE) em uma única página. O bloco é
+// preenchido com zeros.
+LeanDX12Result AllocateConstants(ConstantAllocator* allocator, unsigned int sizeInBytes, CONSTANT_ALLOCATION* allocation);
+LeanDX12Result CommitConstantAllocator(ConstantAllocator* allocator);
+
+void GetConstantAllocatorStats(ConstantAllocator* allocator, CONSTANT_ALLOCATOR_STATS* stats);
+
+// Reserva um bloco para T e retorna o ponteiro para ele (NULL em caso de erro).
+template <typename T>
+T* Allocate(ConstantAllocator* allocator, CONSTANT_ALLOCATION* allocation)
+{
+	static_assert(std::is_trivially_copyable<T>::value, "Constantes devem ser copiáveis byte a byte.");
+	static_assert(sizeof(T) % 16 == 0, "O tamanho das constantes deve ser múltiplo de 16 bytes (regras de empacotamento do HLSL).");
+	static_assert(alignof(T) <= 16, "O alinhamento das constantes não pode exceder 16 bytes.");
+	static_assert(sizeof(T) <= CONSTANT_PAGE_SIZE, "As constantes não cabem em uma página (64 KB).");
+
+	if (AllocateConstants(allocator, (unsigned int)sizeof(T), allocation) != LEANDX12_OK)
+		return NULL;
+
+	return (T*)allocation->pData;
+}
+
+#endif  // _LEANDX12_CONSTANT_ALLOCATOR_
@@ -0,0 +1,183 @@
+// Descrição: Implementação das constantes compactas das extensões LeanDX12 (LeanDX12Constants.h).
+
+#include <cmath>
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define LEANDX12_SSE2
+#include <xmmintrin.h>
+#endif
+
+#include "LeanDX12Constants.h"
+
+static_assert(sizeof(FRAME_CONSTANTS) <= FRAME_CONSTANTS_BUFFER_SIZE, "FRAME_CONSTANTS excede FRAME_CONSTANTS_BUFFER_SIZE.");
+static_assert(sizeof(INSTANCE_TRANSFORM) == OBJECT_CONSTANTS_NUM_32BIT_VALUES * sizeof(unsigned int), "INSTANCE_TRANSFORM deve ocupar 12 constantes de 32 bits.");
+
+namespace
+{
+	const float degreesToRadians = 3.14159265358979f / 180.0f;
+
+	void SetIdentity(float matrix[4][4])
+	{
+		memset(matrix, 0, 16 * sizeof(float));
+		for (int i = 0; i < 4; i++)
+			matrix[i][i] = 1.0f;
+	}
+
+	// Matrizes equivalentes às do DirectXMath (vetores linha).
+	void SetTranslation(float x, float y, float z, float matrix[4][4])
+	{
+		SetIdentity(matrix);
+		matrix[3][0] = x;
+		matrix[3][1] = y;
+		matrix[3][2] = z;
+	}
+
+	void SetRotationX(float angle, float matrix[4][4])
+	{
+		float c = cosf(angle), s = sinf(angle);
+		SetIdentity(matrix);
+		matrix[1][1] = c;
+		matrix[1][2] = s;
+		matrix[2][1] = -s;
+		matrix[2][2] = c;
+	}
+
+	void SetRotationY(float angle, float matrix[4][4])
+	{
+		float c = cosf(angle), s = sinf(angle);
+		SetIdentity(matrix);
+		matrix[0][0] = c;
+		matrix[0][2] = -s;
+		matrix[2][0] = s;
+		matrix[2][2] = c;
+	}
+
+	void SetRotationZ(float angle, float matrix[4][4])
+	{
+		float c = cosf(angle), s = sinf(angle);
+		SetIdentity(matrix);
+		matrix[0][0] = c;
+		matrix[0][1] = s;
+		matrix[1][0] = -s;
+		matrix[1][1] = c;
+	}
+
+	// XMMatrixPerspectiveFovLH e XMMatrixOrthographicLH (largura = aspectRatio, altura = 1, como em SetCamera dos exemplos).
+	void SetProjection(const CAMERA_DESC* cameraDesc, float matrix[4][4])
+	{
+		float nearPlane = cameraDesc->nearClippingPlane;
+		float farPlane = cameraDesc->farClippingPlane;
+		memset(matrix, 0, 16 * sizeof(float));
+
+		if (cameraDesc->isPerspectiveProjection != 0)
+		{
+			float height = 1.0f / tanf(0.5f * cameraDesc->fovAngleY * degreesToRadians);
+			float range = farPlane / (farPlane - nearPlane);
+			matrix[0][0] = height / cameraDesc->aspectRatio;
+			matrix[1][1] = height;
+			matrix[2][2] = range;
+			matrix[2][3] = 1.0f;
+			matrix[3][2] = -range * nearPlane;
+		}
+		else
+		{
+			float range = 1.0f / (farPlane - nearPlane);
+			matrix[0][0] = 2.0f / cameraDesc->aspectRatio;
+			matrix[1][1] = 2.0f;
+			matrix[2][2] = range;
+			matrix[3][2] = -range * nearPlane;
+			matrix[3][3] = 1.0f;
+		}
+	}
+}
+
+void MultiplyMatrices(const float a[4][4], const float b[4][4], float result[4][4])
+{
+	if (a == nullptr || b == nullptr || result == nullptr)
+		return;
+
+	// Cada linha do resultado é a combinação das linhas de b pelos elementos da linha correspondente de a.
+#if defined(LEANDX12_SSE2)
+	__m128 rowsB[4] = { _mm_loadu_ps(b[0]), _mm_loadu_ps(b[1]), _mm_loadu_ps(b[2]), _mm_loadu_ps(b[3]) };
+	__m128 rows[4];
+	for (int row = 0; row < 4; row++)
+	{
+		rows[row] = _mm_add_ps(_mm_add_ps(_mm_mul_ps(_mm_set1_ps(a[row][0]), rowsB[0]), _mm_mul_ps(_mm_set1_ps(a[row][1]), rowsB[1])),
+			_mm_add_ps(_mm_mul_ps(_mm_set1_ps(a[row][2]), rowsB[2]), _mm_mul_ps(_mm_set1_ps(a[row][3]), rowsB[3])));
+	}
+	for (int row = 0; row < 4; row++)
+		_mm_storeu_ps(result[row], rows[row]);
+#else
+	float product[4][4];
+	for (int row = 0; row < 4; row++)
+		for (int column = 0; column < 4; column++)
+			product[row][column] = a[row][0] * b[0][column] + a[row][1] * b[1][column] + a[row][2] * b[2][column] + a[row][3] * b[3][column];
+	memcpy(result, product, sizeof(product));
+#endif
+}
+
+void ComputeFrameConstants(const CAMERA_DESC* cameraDesc, FRAME_CONSTANTS* frameConstants)
+{
+	if (cameraDesc == nullptr || frameConstants == nullptr)
+		return;
+
+	float translation[4][4], roll[4][4], yaw[4][4], pitch[4][4], projection[4][4];
+	SetTranslation(-cameraDesc->position[0], -cameraDesc->position[1], -cameraDesc->position[2], translation);
+	SetRotationZ(-cameraDesc->rotation[2] * degreesToRadians, roll);
+	SetRotationY(-cameraDesc->rotation[1] * degreesToRadians, yaw);
+	SetRotationX(-cameraDesc->rotation[0] * degreesToRadians, pitch);
+	SetProjection(cameraDesc, projection);
+
+	float (*viewProjection)[4] = frameConstants->viewProjection;
+	MultiplyMatrices(translation, roll, viewProjection);
+	MultiplyMatrices(viewProjection, yaw, viewProjection);
+	MultiplyMatrices(viewProjection, pitch, viewProjection);
+	MultiplyMatrices(viewProjection, projection, viewProjection);
+
+	for (int axis = 0; axis < 3; axis++)
+		frameConstants->cameraPosition[axis] = cameraDesc->position[axis];
+	frameConstants->cameraPosition[3] = 1.0f;
+}
+
+LeanDX12Result CreateFrameConstantBuffers(unsigned int offsetFromDescriptorTableStart, Buffer** constantBuffer, Buffer** uploadBuffer)
+{
+	if (constantBuffer == nullptr || uploadBuffer == nullptr)
+		return LEANDX12_ERROR_INVALID_CALL;
+
+	LeanDX12Result result = CreateBuffer(FRAME_CONSTANTS_BUFFER_SIZE, BUFFER_TYPE_DEFAULT, constantBuffer, offsetFromDescriptorTableStart);
+	if (result != LEANDX12_OK)
+		return result;
+
+	result = CreateBuffer(FRAME_CONSTANTS_BUFFER_SIZE, BUFFER_TYPE_UPLOAD, uploadBuffer);
+	if (result != LEANDX12_OK)
+	{
+		DeleteBuffer(*constantBuffer);
+		*constantBuffer = nullptr;
+	}
+
+	return result;
+}
+
+LeanDX12Result UpdateFrameConstants(Buffer* constantBuffer, Buffer* uploadBuffer, const FRAME_CONSTANTS* frameConstants)
+{
+	if (constantBuffer == nullptr || uploadBuffer == nullptr || frameConstants == nullptr)
+		return LEANDX12_ERROR_INVALID_CALL;
+
+	unsigned char data[FRAME_CONSTANTS_BUFFER_SIZE] = {};
+	memcpy(data, frameConstants, sizeof(FRAME_CONSTANTS));
+
+	LeanDX12Result result = UploadData(uploadBuffer, NULL, 1, FRAME_CONSTANTS_BUFFER_SIZE, 1, 1, data);
+	if (result != LEANDX12_OK)
+		return result;
+
+	return SetPrivateData(constantBuffer, uploadBuffer);
+}
+
+LeanDX12Result SetObjectConstants(unsigned int shaderRegister, const INSTANCE_TRANSFORM* world)
+{
+	if (world == nullptr)
+		return LEANDX12_ERROR_INVALID_CALL;
+
+	return Set32bitConstants(shaderRegister, OBJECT_CONSTANTS_NUM_32BIT_VALUES, (void*)world->rows, 0);
+}
@@ -0,0 +1,77 @@
+/*
+* LeanDX12 - Constantes compactas
+* Descrição: Constantes de transformação compactas: uma única matriz do mundo por objeto, enviada como constantes de 32 bits da
+* assinatura raiz (48 bytes), e uma matriz de visão-projeção compartilhada por todos os objetos, enviada uma vez por quadro em um
+* constant buffer. Substitui as oito matrizes por objeto (512 bytes e oito multiplicações 4x4 por vértice) da estrutura
+* WorldViewProjection dos exemplos.
+*
+*	As matrizes da câmera (translação, roll, yaw, pitch e projeção, nas convenções de SetCamera dos exemplos) são concatenadas na CPU
+*	com SSE2 (quando disponível). A matriz do mundo é uma INSTANCE_TRANSFORM (LeanDX12Instancing.h), obtida por
+*	ComposeInstanceTransform ou pelo grafo de cena (LeanDX12Scene.h).
+*
+*	Uso no vertex shader (registradores de exemplo):
+*
+*		cbuffer ObjectConstants : register(b0) { float4 world[3]; };		// Constantes de 32 bits (12 valores).
+*		cbuffer FrameConstants : register(b1) { float4x4 viewProjection; float4 cameraPosition; };
+*
+*		float4 p = float4(input.position, 1.0f);
+*		float3 worldPosition = float3(dot(world[0], p), dot(world[1], p), dot(world[2], p));
+*		output.position = mul(viewProjection, float4(worldPosition, 1.0f));
+*		output.normal = float3(dot(world[0].xyz, input.normal), dot(world[1].xyz, input.normal), dot(world[2].xyz, input.normal));
+*
+*	A normal transformada pela matriz do mundo é correta para escalas uniformes. viewProjection é armazenada na convenção do
+*	DirectXMath (vetores linha, como XMFLOAT4X4), assim como as matrizes dos exemplos, e pode ser utilizada diretamente por
+*	ExtractFrustumPlanes (LeanDX12Culling.h) e pelo descarte por oclusão (LeanDX12Occlusion.h).
+*
+*   Organização do arquivo de cabeçalho:
+*	1.	Estruturas
+*	2.	Declaração das funções
+*/
+
+#ifndef _LEANDX12_CONSTANTS_
+#define _LEANDX12_CONSTANTS_
+
+#include <cstddef>
+
+#include "LeanDX12.h"
+#include "LeanDX12Instancing.h"
+
+// Quantidade de constantes de 32 bits por objeto (valor de num32bitValues na assinatura raiz).
+#define OBJECT_CONSTANTS_NUM_32BIT_VALUES 12
+// Tamanho do constant buffer das constantes do quadro (múltiplo de 256 bytes).
+#define FRAME_CONSTANTS_BUFFER_SIZE 256
+
+// ------------------------------------------------------------ 1. Estruturas ------------------------------------------------------------- //
+
+typedef struct CAMERA_DESC
+{
+	float position[3];
+	float rotation[3];								// Pitch, yaw e roll em graus.
+	float aspectRatio;
+	float nearClippingPlane;
+	float farClippingPlane;
+	BOOLEAN isPerspectiveProjection;
+	float fovAngleY;								// Em graus (apenas projeção perspectiva).
+} CAMERA_DESC;
+
+typedef struct FRAME_CONSTANTS
+{
+	float viewProjection[4][4];
+	float cameraPosition[4];
+} FRAME_CONSTANTS;
+
+// ------------------------------------------------------ 2. Declaração das funções ------------------------------------------------------- //
+
+// Calcula viewProjection = translação * roll * yaw * pitch * projeção (vetores linha) e a posição da câmera.
+void ComputeFrameConstants(const CAMERA_DESC* cameraDesc, FRAME_CONSTANTS* frameConstants);
+// Multiplica matrizes 4x4 armazenadas por linhas (result = a * b). result pode ser a ou b.
+void MultiplyMatrices(const float a[4][4], const float b[4][4], float result[4][4]);
+
+// Cria o constant buffer das constantes do quadro (DEFAULT, com o descritor em offsetFromDescriptorTableStart) e o buffer de envio.
+LeanDX12Result CreateFrameConstantBuffers(unsigned int offsetFromDescriptorTableStart, Buffer** constantBuffer, Buffer** uploadBuffer);
+// Envia as constantes do quadro (uma vez por quadro, fora das cenas).
+LeanDX12Result UpdateFrameConstants(Buffer* constantBuffer, Buffer* uploadBuffer, const FRAME_CONSTANTS* frameConstants);
+// Envia a matriz do mundo de um objeto como constantes de 32 bits do registrador shaderRegister (dentro de uma cena).
+LeanDX12Result SetObjectConstants(unsigned int shaderRegister, const INSTANCE_TRANSFORM* world);
+
+#endif  // _LEANDX12_CONSTANTS_
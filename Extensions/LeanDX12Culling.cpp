@@ -0,0 +1,787 @@
+// Descrição: Implementação do descarte por frustum das extensões LeanDX12 (LeanDX12Culling.h).
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <vector>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define LEANDX12_SSE2
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#define LEANDX12_TARGET_AVX2
+#else
+#define LEANDX12_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+#endif
+
+#include "LeanDX12Culling.h"
+#include "LeanDX12Parallel.h"
+
+// Quantidade mínima de objetos por bloco de trabalho de ParallelFor.
+#define CULLING_OBJECTS_PER_TASK 1024
+// Quantidade máxima de objetos por folha da hierarquia.
+#define CULLING_OBJECTS_PER_LEAF 16
+#define CULLING_ALL_PLANES 0x3Fu
+#define CULLING_NO_NODE 0xFFFFFFFFu
+
+namespace
+{
+	typedef struct HIERARCHY_NODE
+	{
+		float center[3];
+		float extent[3];
+		unsigned int begin, end;						// Intervalo de posições dos objetos em memória.
+		unsigned int firstChild;						// 0 = folha; os filhos estão em firstChild e firstChild + 1.
+	} HIERARCHY_NODE;
+
+	typedef struct CULL_TASK
+	{
+		unsigned int nodeIndex;							// CULLING_NO_NODE = intervalo [begin, end) sem hierarquia.
+		unsigned int planeMask;
+		bool acceptAll;
+		unsigned int begin, end;
+		unsigned int numVisible;
+		unsigned int numObjectsTested;
+		unsigned int numNodesVisited;
+		unsigned int numNodesRejected;
+		unsigned int numNodesAccepted;
+	} CULL_TASK;
+
+	// Planos preparados para os testes de esferas (distância do centro) e de AABBs (distância do centro e raio projetado da caixa).
+	typedef struct CULLING_PLANES
+	{
+		float normal[6][3];
+		float absNormal[6][3];
+		float distance[6];
+	} CULLING_PLANES;
+
+	bool IsValidBounds(const CULLING_BOUNDS* bounds)
+	{
+		if (!(bounds->sphereRadius >= 0.0f))
+			return false;
+
+		for (int axis = 0; axis < 3; axis++)
+			if (!(bounds->aabbMin[axis] <= bounds->aabbMax[axis]))
+				return false;
+
+		return true;
+	}
+
+	// ---------------------------------------------------------- Suporte a AVX2 ------------------------------------------------------------- //
+
+	bool DetectAVX2()
+	{
+#if defined(LEANDX12_SSE2) && defined(_MSC_VER)
+		int cpuInfo[4];
+		__cpuid(cpuInfo, 0);
+		if (cpuInfo[0] < 7)
+			return false;
+
+		__cpuid(cpuInfo, 1);
+		bool osxsave = (cpuInfo[2] & (1 << 27)) != 0;
+		bool avx = (cpuInfo[2] & (1 << 28)) != 0;
+		if (!osxsave || !avx || (_xgetbv(0) & 0x6) != 0x6)
+			return false;
+
+		__cpuidex(cpuInfo, 7, 0);
+		return (cpuInfo[1] & (1 << 5)) != 0;
+#elif defined(LEANDX12_SSE2)
+		__builtin_cpu_init();
+		return __builtin_cpu_supports("avx2");
+#else
+		return false;
+#endif
+	}
+
+	bool HasAVX2()
+	{
+		static const bool hasAVX2 = DetectAVX2();
+		return hasAVX2;
+	}
+}
+
+struct CullingSet
+{
+	unsigned int maxObjects = 0;
+	unsigned int numObjects = 0;
+	// Volumes por posição em memória (SoA). Os vetores possuem 8 posições extras para as leituras vetoriais do fim dos intervalos.
+	std::vector<float> sphereX, sphereY, sphereZ, sphereRadius;
+	std::vector<float> boxX, boxY, boxZ, extentX, extentY, extentZ;
+	std::vector<unsigned int> objectAtSlot, slotOfObject;
+	std::vector<HIERARCHY_NODE> nodes;
+	bool hasHierarchy = false;
+	bool hierarchyDirty = false;
+	std::vector<CULL_TASK> tasks;
+	CULLING_STATS stats = {};
+};
+
+namespace
+{
+	typedef struct CULL_JOB
+	{
+		const CullingSet* cullingSet;
+		CULLING_PLANES planes;
+		unsigned int* visibleObjects;
+		bool useAVX2;
+		CULL_TASK* tasks;
+	} CULL_JOB;
+
+	void WriteSlot(CullingSet* cullingSet, unsigned int slot, const CULLING_BOUNDS* bounds)
+	{
+		cullingSet->sphereX[slot] = bounds->sphereCenter[0];
+		cullingSet->sphereY[slot] = bounds->sphereCenter[1];
+		cullingSet->sphereZ[slot] = bounds->sphereCenter[2];
+		cullingSet->sphereRadius[slot] = bounds->sphereRadius;
+		cullingSet->boxX[slot] = 0.5f * (bounds->aabbMin[0] + bounds->aabbMax[0]);
+		cullingSet->boxY[slot] = 0.5f * (bounds->aabbMin[1] + bounds->aabbMax[1]);
+		cullingSet->boxZ[slot] = 0.5f * (bounds->aabbMin[2] + bounds->aabbMax[2]);
+		cullingSet->extentX[slot] = 0.5f * (bounds->aabbMax[0] - bounds->aabbMin[0]);
+		cullingSet->extentY[slot] = 0.5f * (bounds->aabbMax[1] - bounds->aabbMin[1]);
+		cullingSet->extentZ[slot] = 0.5f * (bounds->aabbMax[2] - bounds->aabbMin[2]);
+	}
+
+	// ------------------------------------------------------------ Hierarquia --------------------------------------------------------------- //
+
+	void SetNodeBounds(HIERARCHY_NODE& node, const float boundsMin[3], const float boundsMax[3])
+	{
+		for (int axis = 0; axis < 3; axis++)
+		{
+			node.center[axis] = 0.5f * (boundsMin[axis] + boundsMax[axis]);
+			node.extent[axis] = 0.5f * (boundsMax[axis] - boundsMin[axis]);
+		}
+	}
+
+	// Recalcula os volumes dos nós a partir dos objetos. Os filhos sempre possuem índices maiores que os dos pais.
+	void RefitHierarchy(CullingSet* cullingSet)
+	{
+		for (size_t i = cullingSet->nodes.size(); i-- > 0; )
+		{
+			HIERARCHY_NODE& node = cullingSet->nodes[i];
+			float boundsMin[3] = { INFINITY, INFINITY, INFINITY };
+			float boundsMax[3] = { -INFINITY, -INFINITY, -INFINITY };
+
+			if (node.firstChild == 0)
+			{
+				for (unsigned int slot = node.begin; slot < node.end; slot++)
+				{
+					const float center[3] = { cullingSet->boxX[slot], cullingSet->boxY[slot], cullingSet->boxZ[slot] };
+					const float extent[3] = { cullingSet->extentX[slot], cullingSet->extentY[slot], cullingSet->extentZ[slot] };
+					for (int axis = 0; axis < 3; axis++)
+					{
+						boundsMin[axis] = std::min(boundsMin[axis], center[axis] - extent[axis]);
+						boundsMax[axis] = std::max(boundsMax[axis], center[axis] + extent[axis]);
+					}
+				}
+			}
+			else
+			{
+				for (unsigned int child = node.firstChild; child < node.firstChild + 2; child++)
+				{
+					const HIERARCHY_NODE& childNode = cullingSet->nodes[child];
+					for (int axis = 0; axis < 3; axis++)
+					{
+						boundsMin[axis] = std::min(boundsMin[axis], childNode.center[axis] - childNode.extent[axis]);
+						boundsMax[axis] = std::max(boundsMax[axis], childNode.center[axis] + childNode.extent[axis]);
+					}
+				}
+			}
+
+			SetNodeBounds(node, boundsMin, boundsMax);
+		}
+	}
+
+	typedef struct BUILD_ITEM
+	{
+		float centroid[3];
+		unsigned int objectIndex;
+	} BUILD_ITEM;
+
+	// Divide os objetos pela mediana dos centros no eixo de maior extensão, até CULLING_OBJECTS_PER_LEAF objetos por folha.
+	void BuildNode(std::vector<HIERARCHY_NODE>& nodes, std::vector<BUILD_ITEM>& items, unsigned int nodeIndex, unsigned int begin, unsigned int end)
+	{
+		nodes[nodeIndex].begin = begin;
+		nodes[nodeIndex].end = end;
+		nodes[nodeIndex].firstChild = 0;
+
+		if (end - begin <= CULLING_OBJECTS_PER_LEAF)
+			return;
+
+		float centroidMin[3] = { INFINITY, INFINITY, INFINITY };
+		float centroidMax[3] = { -INFINITY, -INFINITY, -INFINITY };
+		for (unsigned int i = begin; i < end; i++)
+		{
+			for (int axis = 0; axis < 3; axis++)
+			{
+				centroidMin[axis] = std::min(centroidMin[axis], items[i].centroid[axis]);
+				centroidMax[axis] = std::max(centroidMax[axis], items[i].centroid[axis]);
+			}
+		}
+
+		int splitAxis = 0;
+		for (int axis = 1; axis < 3; axis++)
+			if (centroidMax[axis] - centroidMin[axis] > centroidMax[splitAxis] - centroidMin[splitAxis])
+				splitAxis = axis;
+
+		unsigned int middle = begin + (end - begin) / 2;
+		std::nth_element(items.begin() + begin, items.begin() + middle, items.begin() + end,
+			[splitAxis](const BUILD_ITEM& a, const BUILD_ITEM& b) { return a.centroid[splitAxis] < b.centroid[splitAxis]; });
+
+		unsigned int firstChild = (unsigned int)nodes.size();
+		nodes[nodeIndex].firstChild = firstChild;
+		nodes.resize(nodes.size() + 2);
+
+		BuildNode(nodes, items, firstChild, begin, middle);
+		BuildNode(nodes, items, firstChild + 1, middle, end);
+	}
+
+	// ------------------------------------------------------------ Testes ------------------------------------------------------------------- //
+
+	void PreparePlanes(const FRUSTUM_PLANES* frustum, CULLING_PLANES* planes)
+	{
+		for (int plane = 0; plane < 6; plane++)
+		{
+			for (int axis = 0; axis < 3; axis++)
+			{
+				planes->normal[plane][axis] = frustum->planes[plane][axis];
+				planes->absNormal[plane][axis] = fabsf(frustum->planes[plane][axis]);
+			}
+			planes->distance[plane] = frustum->planes[plane][3];
+		}
+	}
+
+	// Retorna -1 se o nó estiver inteiramente fora do frustum, 1 se estiver inteiramente dentro e 0 caso contrário. Os planos dos quais
+	// o nó está inteiramente do lado interno são removidos de planeMask.
+	int TestNode(const HIERARCHY_NODE& node, const CULLING_PLANES& planes, unsigned int& planeMask)
+	{
+		for (int plane = 0; plane < 6; plane++)
+		{
+			if ((planeMask & (1u << plane)) == 0)
+				continue;
+
+			float distance = planes.normal[plane][0] * node.center[0] + planes.normal[plane][1] * node.center[1] +
+				planes.normal[plane][2] * node.center[2] + planes.distance[plane];
+			float radius = planes.absNormal[plane][0] * node.extent[0] + planes.absNormal[plane][1] * node.extent[1] +
+				planes.absNormal[plane][2] * node.extent[2];
+
+			if (distance + radius < 0.0f)
+				return -1;
+			if (distance - radius >= 0.0f)
+				planeMask &= ~(1u << plane);
+		}
+
+		return planeMask == 0 ? 1 : 0;
+	}
+
+	// Testa os objetos das posições [begin, end) contra os planos de planeMask e grava os índices dos visíveis em pVisible.
+	unsigned int TestObjectsScalar(const CullingSet* cullingSet, const CULLING_PLANES& planes, unsigned int planeMask,
+		unsigned int begin, unsigned int end, unsigned int* pVisible)
+	{
+		unsigned int numVisible = 0;
+
+		for (unsigned int slot = begin; slot < end; slot++)
+		{
+			bool visible = true;
+			for (int plane = 0; plane < 6 && visible; plane++)
+			{
+				if ((planeMask & (1u << plane)) == 0)
+					continue;
+
+				const float* normal = planes.normal[plane];
+				const float* absNormal = planes.absNormal[plane];
+
+				float sphereDistance = normal[0] * cullingSet->sphereX[slot] + normal[1] * cullingSet->sphereY[slot] +
+					normal[2] * cullingSet->sphereZ[slot] + planes.distance[plane];
+				float boxDistance = normal[0] * cullingSet->boxX[slot] + normal[1] * cullingSet->boxY[slot] +
+					normal[2] * cullingSet->boxZ[slot] + planes.distance[plane];
+				float boxRadius = absNormal[0] * cullingSet->extentX[slot] + absNormal[1] * cullingSet->extentY[slot] +
+					absNormal[2] * cullingSet->extentZ[slot];
+
+				visible = sphereDistance + cullingSet->sphereRadius[slot] >= 0.0f && boxDistance + boxRadius >= 0.0f;
+			}
+
+			if (visible)
+				pVisible[numVisible++] = cullingSet->objectAtSlot[slot];
+		}
+
+		return numVisible;
+	}
+
+#if defined(LEANDX12_SSE2)
+	LEANDX12_TARGET_AVX2 unsigned int TestObjectsAVX2(const CullingSet* cullingSet, const CULLING_PLANES& planes, unsigned int planeMask,
+		unsigned int begin, unsigned int end, unsigned int* pVisible)
+	{
+		unsigned int numVisible = 0;
+		const __m256 zero = _mm256_setzero_ps();
+
+		for (unsigned int slot = begin; slot < end; slot += 8)
+		{
+			__m256 sphereX = _mm256_loadu_ps(&cullingSet->sphereX[slot]);
+			__m256 sphereY = _mm256_loadu_ps(&cullingSet->sphereY[slot]);
+			__m256 sphereZ = _mm256_loadu_ps(&cullingSet->sphereZ[slot]);
+			__m256 sphereRadius = _mm256_loadu_ps(&cullingSet->sphereRadius[slot]);
+			__m256 boxX = _mm256_loadu_ps(&cullingSet->boxX[slot]);
+			__m256 boxY = _mm256_loadu_ps(&cullingSet->boxY[slot]);
+			__m256 boxZ = _mm256_loadu_ps(&cullingSet->boxZ[slot]);
+			__m256 extentX = _mm256_loadu_ps(&cullingSet->extentX[slot]);
+			__m256 extentY = _mm256_loadu_ps(&cullingSet->extentY[slot]);
+			__m256 extentZ = _mm256_loadu_ps(&cullingSet->extentZ[slot]);
+
+			__m256 visible = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+			for (int plane = 0; plane < 6; plane++)
+			{
+				if ((planeMask & (1u << plane)) == 0)
+					continue;
+
+				__m256 normalX = _mm256_set1_ps(planes.normal[plane][0]);
+				__m256 normalY = _mm256_set1_ps(planes.normal[plane][1]);
+				__m256 normalZ = _mm256_set1_ps(planes.normal[plane][2]);
+				__m256 distance = _mm256_set1_ps(planes.distance[plane]);
+
+				__m256 sphereDistance = _mm256_add_ps(_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(normalX, sphereX),
+					_mm256_mul_ps(normalY, sphereY)), _mm256_mul_ps(normalZ, sphereZ)), distance);
+				__m256 boxDistance = _mm256_add_ps(_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(normalX, boxX),
+					_mm256_mul_ps(normalY, boxY)), _mm256_mul_ps(normalZ, boxZ)), distance);
+				__m256 boxRadius = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(planes.absNormal[plane][0]), extentX),
+					_mm256_mul_ps(_mm256_set1_ps(planes.absNormal[plane][1]), extentY)), _mm256_mul_ps(_mm256_set1_ps(planes.absNormal[plane][2]), extentZ));
+
+				visible = _mm256_and_ps(visible, _mm256_cmp_ps(_mm256_add_ps(sphereDistance, sphereRadius), zero, _CMP_GE_OQ));
+				visible = _mm256_and_ps(visible, _mm256_cmp_ps(_mm256_add_ps(boxDistance, boxRadius), zero, _CMP_GE_OQ));
+			}
+
+			unsigned int mask = (unsigned int)_mm256_movemask_ps(visible);
+			if (end - slot < 8)
+				mask &= (1u << (end - slot)) - 1;
+
+			for (unsigned int lane = 0; mask != 0; lane++, mask >>= 1)
+				if ((mask & 1) != 0)
+					pVisible[numVisible++] = cullingSet->objectAtSlot[slot + lane];
+		}
+
+		return numVisible;
+	}
+#endif
+
+	unsigned int TestObjects(const CULL_JOB* job, unsigned int planeMask, unsigned int begin, unsigned int end, unsigned int* pVisible)
+	{
+#if defined(LEANDX12_SSE2)
+		if (job->useAVX2)
+			return TestObjectsAVX2(job->cullingSet, job->planes, planeMask, begin, end, pVisible);
+#endif
+		return TestObjectsScalar(job->cullingSet, job->planes, planeMask, begin, end, pVisible);
+	}
+
+	unsigned int AcceptObjects(const CullingSet* cullingSet, unsigned int begin, unsigned int end, unsigned int* pVisible)
+	{
+		memcpy(pVisible, &cullingSet->objectAtSlot[begin], (end - begin) * sizeof(unsigned int));
+		return end - begin;
+	}
+
+	void CullNode(const CULL_JOB* job, unsigned int nodeIndex, unsigned int planeMask, CULL_TASK& task, unsigned int* pVisible)
+	{
+		const HIERARCHY_NODE& node = job->cullingSet->nodes[nodeIndex];
+		task.numNodesVisited++;
+
+		int result = TestNode(node, job->planes, planeMask);
+		if (result < 0)
+		{
+			task.numNodesRejected++;
+			return;
+		}
+
+		if (result > 0)
+		{
+			task.numNodesAccepted++;
+			task.numVisible += AcceptObjects(job->cullingSet, node.begin, node.end, pVisible + task.numVisible);
+			return;
+		}
+
+		if (node.firstChild == 0)
+		{
+			task.numObjectsTested += node.end - node.begin;
+			task.numVisible += TestObjects(job, planeMask, node.begin, node.end, pVisible + task.numVisible);
+			return;
+		}
+
+		CullNode(job, node.firstChild, planeMask, task, pVisible);
+		CullNode(job, node.firstChild + 1, planeMask, task, pVisible);
+	}
+
+	void CullTasks(unsigned int begin, unsigned int end, void* pUserData)
+	{
+		const CULL_JOB* job = (const CULL_JOB*)pUserData;
+
+		for (unsigned int i = begin; i < end; i++)
+		{
+			CULL_TASK& task = job->tasks[i];
+			unsigned int* pVisible = job->visibleObjects + task.begin;
+
+			if (task.acceptAll)
+				task.numVisible = AcceptObjects(job->cullingSet, task.begin, task.end, pVisible);
+			else if (task.nodeIndex != CULLING_NO_NODE)
+				CullNode(job, task.nodeIndex, task.planeMask, task, pVisible);
+			else
+			{
+				task.numObjectsTested = task.end - task.begin;
+				task.numVisible = TestObjects(job, task.planeMask, task.begin, task.end, pVisible);
+			}
+		}
+	}
+
+	CULL_TASK MakeTask(unsigned int nodeIndex, unsigned int planeMask, bool acceptAll, unsigned int begin, unsigned int end)
+	{
+		CULL_TASK task = {};
+		task.nodeIndex = nodeIndex;
+		task.planeMask = planeMask;
+		task.acceptAll = acceptAll;
+		task.begin = begin;
+		task.end = end;
+		return task;
+	}
+
+	// Percorre os níveis superiores da hierarquia na thread chamadora até obter subárvores com no máximo maxTaskObjects objetos, que são
+	// processadas em paralelo. As tarefas são geradas na ordem das posições, o que permite compactar a lista de visíveis no final.
+	void GatherTasks(CullingSet* cullingSet, const CULLING_PLANES& planes, unsigned int nodeIndex, unsigned int planeMask, unsigned int maxTaskObjects)
+	{
+		const HIERARCHY_NODE& node = cullingSet->nodes[nodeIndex];
+		if (node.firstChild == 0 || node.end - node.begin <= maxTaskObjects)
+		{
+			cullingSet->tasks.push_back(MakeTask(nodeIndex, planeMask, false, node.begin, node.end));
+			return;
+		}
+
+		cullingSet->stats.numNodesVisited++;
+
+		int result = TestNode(node, planes, planeMask);
+		if (result < 0)
+		{
+			cullingSet->stats.numNodesRejected++;
+			return;
+		}
+
+		if (result > 0)
+		{
+			cullingSet->stats.numNodesAccepted++;
+			cullingSet->tasks.push_back(MakeTask(CULLING_NO_NODE, 0, true, node.begin, node.end));
+			return;
+		}
+
+		GatherTasks(cullingSet, planes, node.firstChild, planeMask, maxTaskObjects);
+		GatherTasks(cullingSet, planes, node.firstChild + 1, planeMask, maxTaskObjects);
+	}
+}
+
+void ExtractFrustumPlanes(const float viewProjection[4][4], FRUSTUM_PLANES* frustum)
+{
+	if (viewProjection == nullptr || frustum == nullptr)
+		return;
+
+	// Com vetores linha, a coordenada de recorte i é o produto de (x, y, z, 1) pela coluna i da matriz.
+	for (int row = 0; row < 4; row++)
+	{
+		float x = viewProjection[row][0], y = viewProjection[row][1], z = viewProjection[row][2], w = viewProjection[row][3];
+		frustum->planes[0][row] = w + x;				// -w <= x
+		frustum->planes[1][row] = w - x;				// x <= w
+		frustum->planes[2][row] = w + y;				// -w <= y
+		frustum->planes[3][row] = w - y;				// y <= w
+		frustum->planes[4][row] = z;					// 0 <= z
+		frustum->planes[5][row] = w - z;				// z <= w
+	}
+
+	// Os planos são normalizados para que as distâncias possam ser comparadas com os raios das esferas.
+	for (int plane = 0; plane < 6; plane++)
+	{
+		float* p = frustum->planes[plane];
+		float length = sqrtf(p[0] * p[0] + p[1] * p[1] + p[2] * p[2]);
+		if (length > 0.0f)
+			for (int i = 0; i < 4; i++)
+				p[i] /= length;
+	}
+}
+
+void ComputeCullingBounds(unsigned int numPositions, const void* pPositions, unsigned int stride, CULLING_BOUNDS* bounds)
+{
+	if (bounds == nullptr)
+		return;
+
+	memset(bounds, 0, sizeof(CULLING_BOUNDS));
+	if (numPositions == 0 || pPositions == nullptr)
+		return;
+
+	if (stride == 0)
+		stride = 3 * sizeof(float);
+
+	const unsigned char* pData = (const unsigned char*)pPositions;
+	float position[3];
+
+	memcpy(position, pData, sizeof(position));
+	for (int axis = 0; axis < 3; axis++)
+		bounds->aabbMin[axis] = bounds->aabbMax[axis] = position[axis];
+
+	for (unsigned int i = 1; i < numPositions; i++)
+	{
+		memcpy(position, pData + (size_t)i * stride, sizeof(position));
+		for (int axis = 0; axis < 3; axis++)
+		{
+			bounds->aabbMin[axis] = std::min(bounds->aabbMin[axis], position[axis]);
+			bounds->aabbMax[axis] = std::max(bounds->aabbMax[axis], position[axis]);
+		}
+	}
+
+	for (int axis = 0; axis < 3; axis++)
+		bounds->sphereCenter[axis] = 0.5f * (bounds->aabbMin[axis] + bounds->aabbMax[axis]);
+
+	float maxDistanceSquared = 0.0f;
+	for (unsigned int i = 0; i < numPositions; i++)
+	{
+		memcpy(position, pData + (size_t)i * stride, sizeof(position));
+		float dx = position[0] - bounds->sphereCenter[0];
+		float dy = position[1] - bounds->sphereCenter[1];
+		float dz = position[2] - bounds->sphereCenter[2];
+		maxDistanceSquared = std::max(maxDistanceSquared, dx * dx + dy * dy + dz * dz);
+	}
+
+	bounds->sphereRadius = sqrtf(maxDistanceSquared);
+}
+
+void TransformCullingBounds(const CULLING_BOUNDS* bounds, const float transform[3][4], CULLING_BOUNDS* result)
+{
+	if (bounds == nullptr || transform == nullptr || result == nullptr)
+		return;
+
+	CULLING_BOUNDS transformed;
+	float maxScaleSquared = 0.0f;
+
+	for (int column = 0; column < 3; column++)
+	{
+		float scaleSquared = transform[0][column] * transform[0][column] + transform[1][column] * transform[1][column] +
+			transform[2][column] * transform[2][column];
+		maxScaleSquared = std::max(maxScaleSquared, scaleSquared);
+	}
+
+	// A caixa transformada é envolvida por uma nova AABB: centro transformado e extensão somada pelos valores absolutos da matriz.
+	for (int row = 0; row < 3; row++)
+	{
+		float sphereCenter = transform[row][3];
+		float boxCenter = transform[row][3];
+		float boxExtent = 0.0f;
+
+		for (int column = 0; column < 3; column++)
+		{
+			sphereCenter += transform[row][column] * bounds->sphereCenter[column];
+			boxCenter += transform[row][column] * 0.5f * (bounds->aabbMin[column] + bounds->aabbMax[column]);
+			boxExtent += fabsf(transform[row][column]) * 0.5f * (bounds->aabbMax[column] - bounds->aabbMin[column]);
+		}
+
+		transformed.sphereCenter[row] = sphereCenter;
+		transformed.aabbMin[row] = boxCenter - boxExtent;
+		transformed.aabbMax[row] = boxCenter + boxExtent;
+	}
+
+	transformed.sphereRadius = bounds->sphereRadius * sqrtf(maxScaleSquared);
+	*result = transformed;
+}
+
+LeanDX12Result CreateCullingSet(unsigned int maxObjects, CullingSet** cullingSet)
+{
+	if (cullingSet == nullptr || maxObjects == 0 || maxObjects > 0xFFFFFFFFu - 8)
+		return LEANDX12_ERROR_INVALID_CALL;
+
+	CullingSet* newSet = new CullingSet;
+	newSet->maxObjects = maxObjects;
+
+	size_t paddedSize = (size_t)maxObjects + 8;
+	std::vector<float>* components[] =
+	{
+		&newSet->sphereX, &newSet->sphereY, &newSet->sphereZ, &newSet->sphereRadius,
+		&newSet->boxX, &newSet->boxY, &newSet->boxZ, &newSet->extentX, &newSet->extentY, &newSet->extentZ
+	};
+	for (size_t i = 0; i < sizeof(components) / sizeof(components[0]); i++)
+		components[i]->assign(paddedSize, 0.0f);
+
+	newSet->objectAtSlot.assign(paddedSize, 0);
+	newSet->slotOfObject.assign(maxObjects, 0);
+
+	*cullingSet = newSet;
+	return LEANDX12_OK;
+}
+
+void DeleteCullingSet(CullingSet* cullingSet)
+{
+	delete cullingSet;
+}
+
+void ResetCullingSet(CullingSet* cullingSet)
+{
+	if (cullingSet == nullptr)
+		return;
+
+	cullingSet->numObjects = 0;
+	cullingSet->nodes.clear();
+	cullingSet->hasHierarchy = false;
+	cullingSet->hierarchyDirty = false;
+}
+
+LeanDX12Result AddCullingObject(CullingSet* cullingSet, const CULLING_BOUNDS* bounds, unsigned int* objectIndex)
+{
+	if (cullingSet == nullptr || bounds == nullptr || !IsValidBounds(bounds))
+		return LEANDX12_ERROR_INVALID_CALL;
+
+	if (cullingSet->numObjects == cullingSet->maxObjects)
+		return LEANDX12_ERROR_INSUFFICIENT_BUFFER_SIZE;
+
+	// O novo objeto ocupa a primeira posição livre; as posições dos demais objetos são mantidas.
+	unsigned int index = cullingSet->numObjects++;
+	cullingSet->objectAtSlot[index] = index;
+	cullingSet->slotOfObject[index] = index;
+	WriteSlot(cullingSet, index, bounds);
+
+	cullingSet->nodes.clear();
+	cullingSet->hasHierarchy = false;
+	cullingSet->hierarchyDirty = false;
+
+	if (objectIndex != nullptr)
+		*objectIndex = index;
+
+	return LEANDX12_OK;
+}
+
+LeanDX12Result SetCullingObjectBounds(CullingSet* cullingSet, unsigned int objectIndex, const CULLING_BOUNDS* bounds)
+{
+	if (cullingSet == nullptr || bounds == nullptr || !IsValidBounds(bounds) || objectIndex >= cullingSet->numObjects)
+		return LEANDX12_ERROR_INVALID_CALL;
+
+	WriteSlot(cullingSet, cullingSet->slotOfObject[objectIndex], bounds);
+	cullingSet->hierarchyDirty = cullingSet->hasHierarchy;
+	return LEANDX12_OK;
+}
+
+unsigned int GetCullingObjectCount(CullingSet* cullingSet)
+{
+	return cullingSet != nullptr ? cullingSet->numObjects : 0;
+}
+
+LeanDX12Result BuildCullingHierarchy(CullingSet* cullingSet)
+{
+	if (cullingSet == nullptr)
+		return LEANDX12_ERROR_INVALID_CALL;
+
+	cullingSet->nodes.clear();
+	cullingSet->hasHierarchy = false;
+	cullingSet->hierarchyDirty = false;
+
+	unsigned int numObjects = cullingSet->numObjects;
+	if (numObjects == 0)
+		return LEANDX12_OK;
+
+	std::vector<BUILD_ITEM> items(numObjects);
+	for (unsigned int slot = 0; slot < numObjects; slot++)
+	{
+		items[slot].centroid[0] = cullingSet->boxX[slot];
+		items[slot].centroid[1] = cullingSet->boxY[slot];
+		items[slot].centroid[2] = cullingSet->boxZ[slot];
+		items[slot].objectIndex = cullingSet->objectAtSlot[slot];
+	}
+
+	cullingSet->nodes.resize(1);
+	BuildNode(cullingSet->nodes, items, 0, 0, numObjects);
+
+	// Reordena os volumes para que os objetos de cada nó ocupem posições contíguas.
+	std::vector<float>* components[] =
+	{
+		&cullingSet->sphereX, &cullingSet->sphereY, &cullingSet->sphereZ, &cullingSet->sphereRadius,
+		&cullingSet->boxX, &cullingSet->boxY, &cullingSet->boxZ, &cullingSet->extentX, &cullingSet->extentY, &cullingSet->extentZ
+	};
+	std::vector<float> reordered(numObjects);
+	for (size_t i = 0; i < sizeof(components) / sizeof(components[0]); i++)
+	{
+		std::vector<float>& component = *components[i];
+		for (unsigned int slot = 0; slot < numObjects; slot++)
+			reordered[slot] = component[cullingSet->slotOfObject[items[slot].objectIndex]];
+		std::copy(reordered.begin(), reordered.end(), component.begin());
+	}
+
+	for (unsigned int slot = 0; slot < numObjects; slot++)
+	{
+		cullingSet->objectAtSlot[slot] = items[slot].objectIndex;
+		cullingSet->slotOfObject[items[slot].objectIndex] = slot;
+	}
+
+	RefitHierarchy(cullingSet);
+	cullingSet->hasHierarchy = true;
+	return LEANDX12_OK;
+}
+
+LeanDX12Result CullObjects(CullingSet* cullingSet, const FRUSTUM_PLANES* frustum, unsigned int* visibleObjects, unsigned int* numVisibleObjects)
+{
+	if (cullingSet == nullptr || frustum == nullptr || numVisibleObjects == nullptr || (cullingSet->numObjects > 0 && visibleObjects == nullptr))
+		return LEANDX12_ERROR_INVALID_CALL;
+
+	CULLING_STATS& stats = cullingSet->stats;
+	stats = CULLING_STATS();
+	stats.numObjects = cullingSet->numObjects;
+	stats.usedHierarchy = cullingSet->hasHierarchy;
+	stats.usedAVX2 = HasAVX2();
+
+	*numVisibleObjects = 0;
+	if (cullingSet->numObjects == 0)
+		return LEANDX12_OK;
+
+	if (cullingSet->hierarchyDirty)
+	{
+		RefitHierarchy(cullingSet);
+		cullingSet->hierarchyDirty = false;
+	}
+
+	CULL_JOB job;
+	job.cullingSet = cullingSet;
+	PreparePlanes(frustum, &job.planes);
+	job.visibleObjects = visibleObjects;
+	job.useAVX2 = stats.usedAVX2 != 0;
+
+	// Cada tarefa grava os visíveis a partir da primeira posição do seu intervalo, sem sobreposição com as demais tarefas.
+	std::vector<CULL_TASK>& tasks = cullingSet->tasks;
+	tasks.clear();
+
+	unsigned int numObjects = cullingSet->numObjects;
+	if (cullingSet->hasHierarchy)
+	{
+		unsigned int maxTaskObjects = std::max((unsigned int)CULLING_OBJECTS_PER_TASK, numObjects / (4 * GetParallelThreadCount()));
+		GatherTasks(cullingSet, job.planes, 0, CULLING_ALL_PLANES, maxTaskObjects);
+	}
+	else
+	{
+		for (unsigned int begin = 0; begin < numObjects; begin += CULLING_OBJECTS_PER_TASK)
+			tasks.push_back(MakeTask(CULLING_NO_NODE, CULLING_ALL_PLANES, false, begin, std::min(begin + CULLING_OBJECTS_PER_TASK, numObjects)));
+	}
+
+	job.tasks = tasks.data();
+	ParallelFor((unsigned int)tasks.size(), 1, CullTasks, &job);
+
+	unsigned int numVisible = 0;
+	for (size_t i = 0; i < tasks.size(); i++)
+	{
+		const CULL_TASK& task = tasks[i];
+		if (task.numVisible > 0 && numVisible != task.begin)
+			memmove(visibleObjects + numVisible, visibleObjects + task.begin, task.numVisible * sizeof(unsigned int));
+
+		numVisible += task.numVisible;
+		stats.numObjectsTested += task.numObjectsTested;
+		stats.numNodesVisited += task.numNodesVisited;
+		stats.numNodesRejected += task.numNodesRejected;
+		stats.numNodesAccepted += task.numNodesAccepted;
+	}
+
+	stats.numVisible = numVisible;
+	*numVisibleObjects = numVisible;
+	return LEANDX12_OK;
+}
+
+void GetCullingStats(CullingSet* cullingSet, CULLING_STATS* stats)
+{
+	if (cullingSet == nullptr || stats == nullptr)
+		return;
+
+	*stats = cullingSet->stats;
+}
@@ -0,0 +1,101 @@
+/*
+* LeanDX12 - Descarte por frustum
+* Descrição: Descarte dos objetos fora do volume de visão da câmera antes do envio dos desenhos. Cada objeto de um CullingSet possui
+* uma esfera e uma caixa alinhada aos eixos (AABB) envolventes, em coordenadas do mundo, e é considerado visível se nenhum dos dois
+* volumes estiver inteiramente fora de um dos seis planos do frustum.
+*
+*	Os volumes são armazenados em vetores separados por componente (SoA) e testados 8 objetos por vez com AVX2, quando disponível no
+*	processador (com uma implementação escalar equivalente nos demais casos). Os objetos são divididos entre as threads de
+*	LeanDX12Parallel.h e o resultado é uma lista compacta dos índices dos objetos visíveis, a ser percorrida pelo código de desenho.
+*
+*	Opcionalmente, BuildCullingHierarchy constrói uma hierarquia de volumes envolventes (BVH) sobre os objetos, que permite descartar (ou
+*	aceitar sem testes) grupos inteiros de objetos. Alterações nos volumes dos objetos são incorporadas à hierarquia (sem reconstrução) na
+*	chamada seguinte de CullObjects; objetos adicionados após a construção desativam a hierarquia até uma nova chamada de
+*	BuildCullingHierarchy.
+*
+*	Convenções:
+*		•	ExtractFrustumPlanes recebe a matriz de visão-projeção na convenção do DirectXMath (vetores linha, p' = p * M, armazenada
+*			por linhas como em XMFLOAT4X4) e profundidade de 0 a 1;
+*		•	TransformCullingBounds recebe uma matriz 3x4 aplicada a vetores coluna (p' = M * p), como INSTANCE_TRANSFORM de
+*			LeanDX12Instancing.h.
+*
+*	As funções de um mesmo CullingSet não devem ser chamadas por várias threads ao mesmo tempo.
+*
+*   Organização do arquivo de cabeçalho:
+*	1.	Estruturas
+*		•	Estruturas opacas
+*		•	Estruturas transparentes
+*	2.	Declaração das funções
+*/
+
+#ifndef _LEANDX12_CULLING_
+#define _LEANDX12_CULLING_
+
+#include <cstddef>
+
+#include "LeanDX12.h"
+
+// ------------------------------------------------------------ 1. Estruturas ------------------------------------------------------------- //
+
+// -------------------------------------------------------- 1.1. Estruturas opacas -------------------------------------------------------- //
+
+typedef struct CullingSet CullingSet;
+
+// ---------------------------------------------------- 1.2. Estruturas transparentes ----------------------------------------------------- //
+
+// Planos (a, b, c, d) com normais voltadas para o interior do frustum: um ponto p está do lado interno se a*x + b*y + c*z + d >= 0.
+// Ordem: esquerda, direita, inferior, superior, próximo e distante.
+typedef struct FRUSTUM_PLANES
+{
+	float planes[6][4];
+} FRUSTUM_PLANES;
+
+typedef struct CULLING_BOUNDS
+{
+	float sphereCenter[3];
+	float sphereRadius;
+	float aabbMin[3];
+	float aabbMax[3];
+} CULLING_BOUNDS;
+
+typedef struct CULLING_STATS
+{
+	unsigned int numObjects;
+	unsigned int numVisible;
+	unsigned int numObjectsTested;					// Objetos testados individualmente (os demais foram decididos pela hierarquia).
+	unsigned int numNodesVisited;
+	unsigned int numNodesRejected;					// Nós inteiramente fora do frustum.
+	unsigned int numNodesAccepted;					// Nós inteiramente dentro do frustum.
+	BOOLEAN usedHierarchy;
+	BOOLEAN usedAVX2;
+} CULLING_STATS;
+
+// ------------------------------------------------------ 2. Declaração das funções ------------------------------------------------------- //
+
+void ExtractFrustumPlanes(const float viewProjection[4][4], FRUSTUM_PLANES* frustum);
+// Calcula a AABB e a esfera envolvente (centrada na AABB) de numPositions posições (x, y, z em float), separadas por stride bytes (por
+// exemplo, os vértices carregados por LoadWavefrontOBJ, com stride = dataSizePerVertex).
+void ComputeCullingBounds(unsigned int numPositions, const void* pPositions, unsigned int stride, CULLING_BOUNDS* bounds);
+// Transforma volumes em coordenadas do modelo para coordenadas do mundo. O raio é multiplicado pela maior escala da matriz.
+void TransformCullingBounds(const CULLING_BOUNDS* bounds, const float transform[3][4], CULLING_BOUNDS* result);
+
+LeanDX12Result CreateCullingSet(unsigned int maxObjects, CullingSet** cullingSet);
+void DeleteCullingSet(CullingSet* cullingSet);
+// Remove todos os objetos e a hierarquia, preservando a memória alocada.
+void ResetCullingSet(CullingSet* cullingSet);
+// Adiciona um objeto e retorna o seu índice (os índices são sequenciais, a partir de 0).
+LeanDX12Result AddCullingObject(CullingSet* cullingSet, const CULLING_BOUNDS* bounds, unsigned int* objectIndex);
+LeanDX12Result SetCullingObjectBounds(CullingSet* cullingSet, unsigned int objectIndex, const CULLING_BOUNDS* bounds);
+unsigned int GetCullingObjectCount(CullingSet* cullingSet);
+
+// Constrói a hierarquia sobre os objetos atuais. A ordem dos objetos em memória é alterada para que cada nó corresponda a um
+// intervalo contíguo, portanto a lista de visíveis deixa de seguir a ordem dos índices.
+LeanDX12Result BuildCullingHierarchy(CullingSet* cullingSet);
+
+// Preenche visibleObjects com os índices dos objetos visíveis e numVisibleObjects com a sua quantidade. visibleObjects deve ter espaço
+// para GetCullingObjectCount índices.
+LeanDX12Result CullObjects(CullingSet* cullingSet, const FRUSTUM_PLANES* frustum, unsigned int* visibleObjects, unsigned int* numVisibleObjects);
+
+void GetCullingStats(CullingSet* cullingSet, CULLING_STATS* stats);
+
+#endif  // _LEANDX12_CULLING_
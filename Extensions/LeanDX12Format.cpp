@@ -0,0 +1,882 @@
+// Descrição: Implementação da conversão de formatos das extensões LeanDX12 (LeanDX12Format.h).
+
+#include <cmath>
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define LEANDX12_SSE2
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#define LEANDX12_TARGET_F16C
+#else
+#define LEANDX12_TARGET_F16C __attribute__((target("f16c")))
+#endif
+#endif
+
+#include "LeanDX12Format.h"
+#include "LeanDX12Parallel.h"
+
+// Número de texels decodificados por vez para o buffer intermediário RGBA (float).
+#define CONVERSION_CHUNK_SIZE 64
+// Quantidade mínima de texels por bloco de trabalho de ParallelFor.
+#define CONVERSION_TEXELS_PER_TASK 16384
+
+namespace
+{
+	typedef enum CHANNEL_TYPE
+	{
+		CHANNEL_TYPE_UNORM,
+		CHANNEL_TYPE_SNORM,
+		CHANNEL_TYPE_UINT,
+		CHANNEL_TYPE_SINT,
+		CHANNEL_TYPE_FLOAT
+	} CHANNEL_TYPE;
+
+	typedef enum FORMAT_LAYOUT
+	{
+		FORMAT_LAYOUT_PLAIN,
+		FORMAT_LAYOUT_R10G10B10A2,
+		FORMAT_LAYOUT_R10G10B10_XR_BIAS_A2,
+		FORMAT_LAYOUT_R11G11B10,
+		FORMAT_LAYOUT_D24S8,
+		FORMAT_LAYOUT_D32S8X24
+	} FORMAT_LAYOUT;
+
+	typedef struct FORMAT_INFO
+	{
+		FORMAT_LAYOUT layout;
+		CHANNEL_TYPE channelType;
+		unsigned int numChannels;
+		unsigned int channelSize;
+		unsigned int texelSize;
+		bool srgb;
+	} FORMAT_INFO;
+
+	bool GetFormatInfo(RESOURCE_FORMAT format, FORMAT_INFO* info)
+	{
+		FORMAT_LAYOUT layout = FORMAT_LAYOUT_PLAIN;
+		CHANNEL_TYPE type;
+		unsigned int numChannels, channelSize;
+		bool srgb = false;
+
+		switch (format)
+		{
+		case RESOURCE_FORMAT_R8G8B8A8_UNORM:		type = CHANNEL_TYPE_UNORM; numChannels = 4; channelSize = 1; break;
+		case RESOURCE_FORMAT_R8G8B8A8_UNORM_SRGB:	type = CHANNEL_TYPE_UNORM; numChannels = 4; channelSize = 1; srgb = true; break;
+		case RESOURCE_FORMAT_R8G8B8A8_SNORM:		type = CHANNEL_TYPE_SNORM; numChannels = 4; channelSize = 1; break;
+		case RESOURCE_FORMAT_R8G8B8A8_UINT:			type = CHANNEL_TYPE_UINT; numChannels = 4; channelSize = 1; break;
+		case RESOURCE_FORMAT_R8G8B8A8_SINT:			type = CHANNEL_TYPE_SINT; numChannels = 4; channelSize = 1; break;
+		case RESOURCE_FORMAT_R16G16B16A16_FLOAT:	type = CHANNEL_TYPE_FLOAT; numChannels = 4; channelSize = 2; break;
+		case RESOURCE_FORMAT_R16G16B16A16_UNORM:	type = CHANNEL_TYPE_UNORM; numChannels = 4; channelSize = 2; break;
+		case RESOURCE_FORMAT_R16G16B16A16_SNORM:	type = CHANNEL_TYPE_SNORM; numChannels = 4; channelSize = 2; break;
+		case RESOURCE_FORMAT_R16G16B16A16_UINT:		type = CHANNEL_TYPE_UINT; numChannels = 4; channelSize = 2; break;
+		case RESOURCE_FORMAT_R16G16B16A16_SINT:		type = CHANNEL_TYPE_SINT; numChannels = 4; channelSize = 2; break;
+		case RESOURCE_FORMAT_R32G32B32A32_FLOAT:	type = CHANNEL_TYPE_FLOAT; numChannels = 4; channelSize = 4; break;
+		case RESOURCE_FORMAT_R32G32B32A32_UINT:		type = CHANNEL_TYPE_UINT; numChannels = 4; channelSize = 4; break;
+		case RESOURCE_FORMAT_R32G32B32A32_SINT:		type = CHANNEL_TYPE_SINT; numChannels = 4; channelSize = 4; break;
+		case RESOURCE_FORMAT_R32G32B32_FLOAT:		type = CHANNEL_TYPE_FLOAT; numChannels = 3; channelSize = 4; break;
+		case RESOURCE_FORMAT_R32G32B32_UINT:		type = CHANNEL_TYPE_UINT; numChannels = 3; channelSize = 4; break;
+		case RESOURCE_FORMAT_R32G32B32_SINT:		type = CHANNEL_TYPE_SINT; numChannels = 3; channelSize = 4; break;
+		case RESOURCE_FORMAT_R8G8_UNORM:			type = CHANNEL_TYPE_UNORM; numChannels = 2; channelSize = 1; break;
+		case RESOURCE_FORMAT_R8G8_SNORM:			type = CHANNEL_TYPE_SNORM; numChannels = 2; channelSize = 1; break;
+		case RESOURCE_FORMAT_R8G8_UINT:				type = CHANNEL_TYPE_UINT; numChannels = 2; channelSize = 1; break;
+		case RESOURCE_FORMAT_R8G8_SINT:				type = CHANNEL_TYPE_SINT; numChannels = 2; channelSize = 1; break;
+		case RESOURCE_FORMAT_R16G16_FLOAT:			type = CHANNEL_TYPE_FLOAT; numChannels = 2; channelSize = 2; break;
+		case RESOURCE_FORMAT_R16G16_UNORM:			type = CHANNEL_TYPE_UNORM; numChannels = 2; channelSize = 2; break;
+		case RESOURCE_FORMAT_R16G16_SNORM:			type = CHANNEL_TYPE_SNORM; numChannels = 2; channelSize = 2; break;
+		case RESOURCE_FORMAT_R16G16_UINT:			type = CHANNEL_TYPE_UINT; numChannels = 2; channelSize = 2; break;
+		case RESOURCE_FORMAT_R16G16_SINT:			type = CHANNEL_TYPE_SINT; numChannels = 2; channelSize = 2; break;
+		case RESOURCE_FORMAT_R32G32_FLOAT:			type = CHANNEL_TYPE_FLOAT; numChannels = 2; channelSize = 4; break;
+		case RESOURCE_FORMAT_R32G32_UINT:			type = CHANNEL_TYPE_UINT; numChannels = 2; channelSize = 4; break;
+		case RESOURCE_FORMAT_R32G32_SINT:			type = CHANNEL_TYPE_SINT; numChannels = 2; channelSize = 4; break;
+		case RESOURCE_FORMAT_R8_UNORM:				type = CHANNEL_TYPE_UNORM; numChannels = 1; channelSize = 1; break;
+		case RESOURCE_FORMAT_R8_SNORM:				type = CHANNEL_TYPE_SNORM; numChannels = 1; channelSize = 1; break;
+		case RESOURCE_FORMAT_R8_UINT:				type = CHANNEL_TYPE_UINT; numChannels = 1; channelSize = 1; break;
+		case RESOURCE_FORMAT_R8_SINT:				type = CHANNEL_TYPE_SINT; numChannels = 1; channelSize = 1; break;
+		case RESOURCE_FORMAT_R16_FLOAT:				type = CHANNEL_TYPE_FLOAT; numChannels = 1; channelSize = 2; break;
+		case RESOURCE_FORMAT_R16_UNORM:				type = CHANNEL_TYPE_UNORM; numChannels = 1; channelSize = 2; break;
+		case RESOURCE_FORMAT_R16_SNORM:				type = CHANNEL_TYPE_SNORM; numChannels = 1; channelSize = 2; break;
+		case RESOURCE_FORMAT_R16_UINT:				type = CHANNEL_TYPE_UINT; numChannels = 1; channelSize = 2; break;
+		case RESOURCE_FORMAT_R16_SINT:				type = CHANNEL_TYPE_SINT; numChannels = 1; channelSize = 2; break;
+		case RESOURCE_FORMAT_R32_FLOAT:
+		case RESOURCE_FORMAT_D32_FLOAT:				type = CHANNEL_TYPE_FLOAT; numChannels = 1; channelSize = 4; break;
+		case RESOURCE_FORMAT_R32_UINT:				type = CHANNEL_TYPE_UINT; numChannels = 1; channelSize = 4; break;
+		case RESOURCE_FORMAT_R32_SINT:				type = CHANNEL_TYPE_SINT; numChannels = 1; channelSize = 4; break;
+		case RESOURCE_FORMAT_R10G10B10A2_UNORM:
+			layout = FORMAT_LAYOUT_R10G10B10A2; type = CHANNEL_TYPE_UNORM; numChannels = 4; channelSize = 1; break;
+		case RESOURCE_FORMAT_R10G10B10A2_UINT:
+			layout = FORMAT_LAYOUT_R10G10B10A2; type = CHANNEL_TYPE_UINT; numChannels = 4; channelSize = 1; break;
+		case RESOURCE_FORMAT_R10G10B10_XR_BIAS_A2_UNORM:
+			layout = FORMAT_LAYOUT_R10G10B10_XR_BIAS_A2; type = CHANNEL_TYPE_UNORM; numChannels = 4; channelSize = 1; break;
+		case RESOURCE_FORMAT_R11G11B10_FLOAT:
+			layout = FORMAT_LAYOUT_R11G11B10; type = CHANNEL_TYPE_FLOAT; numChannels = 3; channelSize = 1; break;
+		case RESOURCE_FORMAT_D24_UNORM_S8_UINT:
+			layout = FORMAT_LAYOUT_D24S8; type = CHANNEL_TYPE_UNORM; numChannels = 2; channelSize = 1; break;
+		case RESOURCE_FORMAT_D32_FLOAT_S8X24_UINT:
+			layout = FORMAT_LAYOUT_D32S8X24; type = CHANNEL_TYPE_FLOAT; numChannels = 2; channelSize = 1; break;
+		default:
+			return false;
+		}
+
+		info->layout = layout;
+		info->channelType = type;
+		info->numChannels = numChannels;
+		info->channelSize = channelSize;
+		info->srgb = srgb;
+
+		switch (layout)
+		{
+		case FORMAT_LAYOUT_PLAIN:		info->texelSize = numChannels * channelSize; break;
+		case FORMAT_LAYOUT_D32S8X24:	info->texelSize = 8; break;
+		default:						info->texelSize = 4; break;
+		}
+
+		return true;
+	}
+
+	// ------------------------------------------------------- Conversões escalares ------------------------------------------------------- //
+
+	inline unsigned int FloatBits(float value)
+	{
+		unsigned int bits;
+		memcpy(&bits, &value, sizeof(bits));
+		return bits;
+	}
+
+	inline float BitsToFloat(unsigned int bits)
+	{
+		float value;
+		memcpy(&value, &bits, sizeof(value));
+		return value;
+	}
+
+	// Satura em [0, 1]. NaN é convertido em 0.
+	inline float Saturate(float value)
+	{
+		return value > 0.0f ? (value < 1.0f ? value : 1.0f) : 0.0f;
+	}
+
+	// Converte um float positivo em um float sem sinal de 5 bits de expoente e mantissaBits bits de mantissa (float16 sem o bit de
+	// sinal, float11 e float10), com arredondamento para o par mais próximo.
+	unsigned int FloatToSmallFloat(unsigned int absBits, unsigned int mantissaBits)
+	{
+		const unsigned int infinity = 0x1Fu << mantissaBits;
+
+		if (absBits > 0x7F800000u)
+			return infinity | (1u << (mantissaBits - 1));
+		if (absBits >= 0x47800000u)
+			return infinity;
+
+		unsigned int result, remainder, halfway, shift;
+
+		if (absBits < 0x38800000u)
+		{
+			// Resultado subnormal.
+			shift = 136 - mantissaBits - (absBits >> 23);
+			if (shift > 24)
+				return 0;
+
+			unsigned int mantissa = (absBits & 0x007FFFFFu) | 0x00800000u;
+			result = mantissa >> shift;
+			remainder = mantissa & ((1u << shift) - 1);
+			halfway = 1u << (shift - 1);
+		}
+		else
+		{
+			shift = 23 - mantissaBits;
+			result = (absBits - 0x38000000u) >> shift;
+			remainder = absBits & ((1u << shift) - 1);
+			halfway = 1u << (shift - 1);
+		}
+
+		if (remainder > halfway || (remainder == halfway && (result & 1)))
+			result++;
+
+		return result;
+	}
+
+	float SmallFloatToFloat(unsigned int value, unsigned int mantissaBits)
+	{
+		unsigned int exponent = (value >> mantissaBits) & 0x1F;
+		unsigned int mantissa = value & ((1u << mantissaBits) - 1);
+
+		if (exponent == 0x1F)
+			return BitsToFloat(mantissa ? 0x7FC00000u | (mantissa << (23 - mantissaBits)) : 0x7F800000u);
+		if (exponent == 0)
+			return ldexpf((float)mantissa, -14 - (int)mantissaBits);
+
+		return BitsToFloat(((exponent + 112) << 23) | (mantissa << (23 - mantissaBits)));
+	}
+
+	inline unsigned int EncodeUnorm(float value, unsigned int maxValue)
+	{
+		return (unsigned int)(Saturate(value) * (float)maxValue + 0.5f);
+	}
+
+	inline float DecodeUnorm(unsigned int value, unsigned int maxValue)
+	{
+		return (float)value / (float)maxValue;
+	}
+
+	inline int EncodeSnorm(float value, int maxValue)
+	{
+		float clamped = value > -1.0f ? (value < 1.0f ? value : 1.0f) : (value <= -1.0f ? -1.0f : 0.0f);
+		float scaled = clamped * (float)maxValue;
+		return (int)(scaled >= 0.0f ? scaled + 0.5f : scaled - 0.5f);
+	}
+
+	inline float DecodeSnorm(int value, int maxValue)
+	{
+		float result = (float)value / (float)maxValue;
+		return result < -1.0f ? -1.0f : result;
+	}
+
+	inline unsigned int EncodeUint(float value, double maxValue)
+	{
+		double clamped = value > 0.0f ? (value < maxValue ? (double)value : maxValue) : 0.0;
+		return (unsigned int)(clamped + 0.5);
+	}
+
+	inline int EncodeSint(float value, double minValue, double maxValue)
+	{
+		double clamped = value > minValue ? (value < maxValue ? (double)value : maxValue) : (value <= minValue ? minValue : 0.0);
+		return (int)(clamped >= 0.0 ? clamped + 0.5 : clamped - 0.5);
+	}
+
+	float SrgbToLinear(float value)
+	{
+		if (value <= 0.04045f)
+			return value / 12.92f;
+		return powf((value + 0.055f) / 1.055f, 2.4f);
+	}
+
+	float LinearToSrgb(float value)
+	{
+		if (value <= 0.0031308f)
+			return value * 12.92f;
+		return 1.055f * powf(value, 1.0f / 2.4f) - 0.055f;
+	}
+
+	// Decodifica um texel para RGBA (float). Não aplica a conversão sRGB.
+	void DecodeTexel(const FORMAT_INFO& info, const unsigned char* pTexel, float rgba[4])
+	{
+		rgba[0] = rgba[1] = rgba[2] = 0.0f;
+		rgba[3] = 1.0f;
+
+		unsigned int packed;
+
+		switch (info.layout)
+		{
+		case FORMAT_LAYOUT_PLAIN:
+			for (unsigned int c = 0; c < info.numChannels; c++)
+			{
+				const unsigned char* pChannel = pTexel + c * info.channelSize;
+
+				if (info.channelSize == 1)
+				{
+					unsigned char u = pChannel[0];
+					signed char s = (signed char)u;
+					switch (info.channelType)
+					{
+					case CHANNEL_TYPE_UNORM: rgba[c] = DecodeUnorm(u, 0xFF); break;
+					case CHANNEL_TYPE_SNORM: rgba[c] = DecodeSnorm(s, 0x7F); break;
+					case CHANNEL_TYPE_UINT: rgba[c] = (float)u; break;
+					default: rgba[c] = (float)s; break;
+					}
+				}
+				else if (info.channelSize == 2)
+				{
+					unsigned short u;
+					memcpy(&u, pChannel, sizeof(u));
+					short s = (short)u;
+					switch (info.channelType)
+					{
+					case CHANNEL_TYPE_UNORM: rgba[c] = DecodeUnorm(u, 0xFFFF); break;
+					case CHANNEL_TYPE_SNORM: rgba[c] = DecodeSnorm(s, 0x7FFF); break;
+					case CHANNEL_TYPE_UINT: rgba[c] = (float)u; break;
+					case CHANNEL_TYPE_SINT: rgba[c] = (float)s; break;
+					default: rgba[c] = HalfToFloat(u); break;
+					}
+				}
+				else
+				{
+					unsigned int u;
+					memcpy(&u, pChannel, sizeof(u));
+					switch (info.channelType)
+					{
+					case CHANNEL_TYPE_UINT: rgba[c] = (float)u; break;
+					case CHANNEL_TYPE_SINT: rgba[c] = (float)(int)u; break;
+					default: rgba[c] = BitsToFloat(u); break;
+					}
+				}
+			}
+			break;
+
+		case FORMAT_LAYOUT_R10G10B10A2:
+			memcpy(&packed, pTexel, sizeof(packed));
+			if (info.channelType == CHANNEL_TYPE_UNORM)
+			{
+				rgba[0] = DecodeUnorm(packed & 0x3FF, 0x3FF);
+				rgba[1] = DecodeUnorm((packed >> 10) & 0x3FF, 0x3FF);
+				rgba[2] = DecodeUnorm((packed >> 20) & 0x3FF, 0x3FF);
+				rgba[3] = DecodeUnorm(packed >> 30, 0x3);
+			}
+			else
+			{
+				rgba[0] = (float)(packed & 0x3FF);
+				rgba[1] = (float)((packed >> 10) & 0x3FF);
+				rgba[2] = (float)((packed >> 20) & 0x3FF);
+				rgba[3] = (float)(packed >> 30);
+			}
+			break;
+
+		case FORMAT_LAYOUT_R10G10B10_XR_BIAS_A2:
+			memcpy(&packed, pTexel, sizeof(packed));
+			rgba[0] = ((float)(packed & 0x3FF) - 384.0f) / 510.0f;
+			rgba[1] = ((float)((packed >> 10) & 0x3FF) - 384.0f) / 510.0f;
+			rgba[2] = ((float)((packed >> 20) & 0x3FF) - 384.0f) / 510.0f;
+			rgba[3] = DecodeUnorm(packed >> 30, 0x3);
+			break;
+
+		case FORMAT_LAYOUT_R11G11B10:
+			memcpy(&packed, pTexel, sizeof(packed));
+			rgba[0] = SmallFloatToFloat(packed & 0x7FF, 6);
+			rgba[1] = SmallFloatToFloat((packed >> 11) & 0x7FF, 6);
+			rgba[2] = SmallFloatToFloat(packed >> 22, 5);
+			break;
+
+		case FORMAT_LAYOUT_D24S8:
+			memcpy(&packed, pTexel, sizeof(packed));
+			rgba[0] = DecodeUnorm(packed & 0xFFFFFF, 0xFFFFFF);
+			rgba[1] = (float)(packed >> 24);
+			break;
+
+		case FORMAT_LAYOUT_D32S8X24:
+			memcpy(&packed, pTexel, sizeof(packed));
+			rgba[0] = BitsToFloat(packed);
+			rgba[1] = (float)pTexel[4];
+			break;
+		}
+	}
+
+	// Codifica um texel RGBA (float) no formato de destino. Não aplica a conversão sRGB.
+	void EncodeTexel(const FORMAT_INFO& info, const float rgba[4], unsigned char* pTexel)
+	{
+		unsigned int packed;
+
+		switch (info.layout)
+		{
+		case FORMAT_LAYOUT_PLAIN:
+			for (unsigned int c = 0; c < info.numChannels; c++)
+			{
+				unsigned char* pChannel = pTexel + c * info.channelSize;
+
+				if (info.channelSize == 1)
+				{
+					switch (info.channelType)
+					{
+					case CHANNEL_TYPE_UNORM: pChannel[0] = (unsigned char)EncodeUnorm(rgba[c], 0xFF); break;
+					case CHANNEL_TYPE_SNORM: pChannel[0] = (unsigned char)(signed char)EncodeSnorm(rgba[c], 0x7F); break;
+					case CHANNEL_TYPE_UINT: pChannel[0] = (unsigned char)EncodeUint(rgba[c], 255.0); break;
+					default: pChannel[0] = (unsigned char)(signed char)EncodeSint(rgba[c], -128.0, 127.0); break;
+					}
+				}
+				else if (info.channelSize == 2)
+				{
+					unsigned short u;
+					switch (info.channelType)
+					{
+					case CHANNEL_TYPE_UNORM: u = (unsigned short)EncodeUnorm(rgba[c], 0xFFFF); break;
+					case CHANNEL_TYPE_SNORM: u = (unsigned short)(short)EncodeSnorm(rgba[c], 0x7FFF); break;
+					case CHANNEL_TYPE_UINT: u = (unsigned short)EncodeUint(rgba[c], 65535.0); break;
+					case CHANNEL_TYPE_SINT: u = (unsigned short)(short)EncodeSint(rgba[c], -32768.0, 32767.0); break;
+					default: u = FloatToHalf(rgba[c]); break;
+					}
+					memcpy(pChannel, &u, sizeof(u));
+				}
+				else
+				{
+					unsigned int u;
+					switch (info.channelType)
+					{
+					case CHANNEL_TYPE_UINT: u = EncodeUint(rgba[c], 4294967295.0); break;
+					case CHANNEL_TYPE_SINT: u = (unsigned int)EncodeSint(rgba[c], -2147483648.0, 2147483647.0); break;
+					default: u = FloatBits(rgba[c]); break;
+					}
+					memcpy(pChannel, &u, sizeof(u));
+				}
+			}
+			break;
+
+		case FORMAT_LAYOUT_R10G10B10A2:
+			if (info.channelType == CHANNEL_TYPE_UNORM)
+				packed = EncodeUnorm(rgba[0], 0x3FF) | (EncodeUnorm(rgba[1], 0x3FF) << 10) | (EncodeUnorm(rgba[2], 0x3FF) << 20) |
+					(EncodeUnorm(rgba[3], 0x3) << 30);
+			else
+				packed = EncodeUint(rgba[0], 1023.0) | (EncodeUint(rgba[1], 1023.0) << 10) | (EncodeUint(rgba[2], 1023.0) << 20) |
+					(EncodeUint(rgba[3], 3.0) << 30);
+			memcpy(pTexel, &packed, sizeof(packed));
+			break;
+
+		case FORMAT_LAYOUT_R10G10B10_XR_BIAS_A2:
+			packed = EncodeUint(rgba[0] * 510.0f + 384.0f, 1023.0) | (EncodeUint(rgba[1] * 510.0f + 384.0f, 1023.0) << 10) |
+				(EncodeUint(rgba[2] * 510.0f + 384.0f, 1023.0) << 20) | (EncodeUnorm(rgba[3], 0x3) << 30);
+			memcpy(pTexel, &packed, sizeof(packed));
+			break;
+
+		case FORMAT_LAYOUT_R11G11B10:
+		{
+			unsigned int channels[3];
+			for (unsigned int c = 0; c < 3; c++)
+			{
+				unsigned int bits = FloatBits(rgba[c]);
+				bool isNaN = (bits & 0x7FFFFFFFu) > 0x7F800000u;
+				channels[c] = (bits & 0x80000000u) && !isNaN ? 0 : FloatToSmallFloat(bits & 0x7FFFFFFFu, c < 2 ? 6 : 5);
+			}
+			packed = channels[0] | (channels[1] << 11) | (channels[2] << 22);
+			memcpy(pTexel, &packed, sizeof(packed));
+			break;
+		}
+
+		case FORMAT_LAYOUT_D24S8:
+			packed = EncodeUnorm(rgba[0], 0xFFFFFF) | (EncodeUint(rgba[1], 255.0) << 24);
+			memcpy(pTexel, &packed, sizeof(packed));
+			break;
+
+		case FORMAT_LAYOUT_D32S8X24:
+			packed = FloatBits(rgba[0]);
+			memcpy(pTexel, &packed, sizeof(packed));
+			packed = EncodeUint(rgba[1], 255.0);
+			memcpy(pTexel + 4, &packed, sizeof(packed));
+			break;
+		}
+	}
+
+	// ------------------------------------------------------ Tabelas de consulta sRGB ----------------------------------------------------- //
+
+	// srgbToLinear[i]: valor linear do byte sRGB i.
+	// linearToSrgbThresholds[k]: menor valor linear que é codificado como um byte sRGB maior ou igual a k + 1. As fronteiras são obtidas
+	// por busca binária sobre a própria conversão de referência, de modo que o resultado da tabela é idêntico ao da referência.
+	struct SrgbTables
+	{
+		float srgbToLinear[256];
+		float linearToSrgbThresholds[256];
+
+		SrgbTables()
+		{
+			for (unsigned int i = 0; i < 256; i++)
+				srgbToLinear[i] = SrgbToLinear(DecodeUnorm(i, 0xFF));
+
+			for (unsigned int k = 1; k < 256; k++)
+			{
+				unsigned int low = 0, high = FloatBits(1.0f);
+				while (low < high)
+				{
+					unsigned int middle = low + (high - low) / 2;
+					if (EncodeUnorm(LinearToSrgb(BitsToFloat(middle)), 0xFF) >= k)
+						high = middle;
+					else
+						low = middle + 1;
+				}
+				linearToSrgbThresholds[k - 1] = BitsToFloat(low);
+			}
+			linearToSrgbThresholds[255] = 2.0f;
+		}
+	};
+
+	const SrgbTables& GetSrgbTables()
+	{
+		static const SrgbTables tables;
+		return tables;
+	}
+
+	inline unsigned char EncodeSrgbByLookup(const SrgbTables& tables, float value)
+	{
+		value = Saturate(value);
+
+		// Busca binária sem desvios sobre as 255 fronteiras.
+		unsigned int index = 0;
+		for (unsigned int step = 128; step > 0; step >>= 1)
+			if (tables.linearToSrgbThresholds[index + step - 1] <= value)
+				index += step;
+
+		return (unsigned char)index;
+	}
+
+	// -------------------------------------------------------- Suporte a F16C -------------------------------------------------------------- //
+
+	bool DetectF16C()
+	{
+#if defined(LEANDX12_SSE2) && defined(_MSC_VER)
+		int cpuInfo[4];
+		__cpuid(cpuInfo, 1);
+		bool osxsave = (cpuInfo[2] & (1 << 27)) != 0;
+		bool avx = (cpuInfo[2] & (1 << 28)) != 0;
+		bool f16c = (cpuInfo[2] & (1 << 29)) != 0;
+		return osxsave && avx && f16c && (_xgetbv(0) & 0x6) == 0x6;
+#elif defined(LEANDX12_SSE2)
+		__builtin_cpu_init();
+		return __builtin_cpu_supports("avx") && __builtin_cpu_supports("f16c");
+#else
+		return false;
+#endif
+	}
+
+	bool HasF16C()
+	{
+		static const bool hasF16C = DetectF16C();
+		return hasF16C;
+	}
+
+	// ---------------------------------------------------- Decodificação e codificação de linhas ------------------------------------------- //
+
+#if defined(LEANDX12_SSE2)
+	LEANDX12_TARGET_F16C void DecodeHalfRowF16C(const unsigned char* pSrc, unsigned int numValues, float* pDest)
+	{
+		unsigned int i = 0;
+		for (; i + 4 <= numValues; i += 4)
+			_mm_storeu_ps(pDest + i, _mm_cvtph_ps(_mm_loadl_epi64((const __m128i*)(pSrc + 2 * i))));
+		for (; i < numValues; i++)
+		{
+			unsigned short half;
+			memcpy(&half, pSrc + 2 * i, sizeof(half));
+			pDest[i] = HalfToFloat(half);
+		}
+	}
+
+	LEANDX12_TARGET_F16C void EncodeHalfRowF16C(const float* pSrc, unsigned int numValues, unsigned char* pDest)
+	{
+		unsigned int i = 0;
+		for (; i + 4 <= numValues; i += 4)
+			_mm_storel_epi64((__m128i*)(pDest + 2 * i), _mm_cvtps_ph(_mm_loadu_ps(pSrc + i), _MM_FROUND_TO_NEAREST_INT));
+		for (; i < numValues; i++)
+		{
+			unsigned short half = FloatToHalf(pSrc[i]);
+			memcpy(pDest + 2 * i, &half, sizeof(half));
+		}
+	}
+#endif
+
+	// Decodifica numTexels texels para RGBA (float), utilizando os caminhos vetorizados e as tabelas quando disponíveis.
+	void DecodeRow(const FORMAT_INFO& info, RESOURCE_FORMAT format, const unsigned char* pSrc, unsigned int numTexels, float* pRGBA)
+	{
+		unsigned int i = 0;
+
+		switch (format)
+		{
+		case RESOURCE_FORMAT_R32G32B32A32_FLOAT:
+			memcpy(pRGBA, pSrc, numTexels * 16);
+			return;
+
+		case RESOURCE_FORMAT_R8G8B8A8_UNORM:
+#if defined(LEANDX12_SSE2)
+		{
+			const __m128i zero = _mm_setzero_si128();
+			const __m128 maxValue = _mm_set1_ps(255.0f);
+			for (; i + 4 <= numTexels; i += 4)
+			{
+				__m128i bytes = _mm_loadu_si128((const __m128i*)(pSrc + 4 * i));
+				__m128i low = _mm_unpacklo_epi8(bytes, zero);
+				__m128i high = _mm_unpackhi_epi8(bytes, zero);
+				_mm_storeu_ps(pRGBA + 4 * i, _mm_div_ps(_mm_cvtepi32_ps(_mm_unpacklo_epi16(low, zero)), maxValue));
+				_mm_storeu_ps(pRGBA + 4 * i + 4, _mm_div_ps(_mm_cvtepi32_ps(_mm_unpackhi_epi16(low, zero)), maxValue));
+				_mm_storeu_ps(pRGBA + 4 * i + 8, _mm_div_ps(_mm_cvtepi32_ps(_mm_unpacklo_epi16(high, zero)), maxValue));
+				_mm_storeu_ps(pRGBA + 4 * i + 12, _mm_div_ps(_mm_cvtepi32_ps(_mm_unpackhi_epi16(high, zero)), maxValue));
+			}
+		}
+#endif
+			break;
+
+		case RESOURCE_FORMAT_R8G8B8A8_UNORM_SRGB:
+		{
+			const SrgbTables& tables = GetSrgbTables();
+			for (; i < numTexels; i++)
+			{
+				pRGBA[4 * i] = tables.srgbToLinear[pSrc[4 * i]];
+				pRGBA[4 * i + 1] = tables.srgbToLinear[pSrc[4 * i + 1]];
+				pRGBA[4 * i + 2] = tables.srgbToLinear[pSrc[4 * i + 2]];
+				pRGBA[4 * i + 3] = DecodeUnorm(pSrc[4 * i + 3], 0xFF);
+			}
+			return;
+		}
+
+		case RESOURCE_FORMAT_R16G16B16A16_FLOAT:
+#if defined(LEANDX12_SSE2)
+			if (HasF16C())
+			{
+				DecodeHalfRowF16C(pSrc, 4 * numTexels, pRGBA);
+				return;
+			}
+#endif
+			break;
+
+		case RESOURCE_FORMAT_R10G10B10A2_UNORM:
+#if defined(LEANDX12_SSE2)
+		{
+			const __m128i mask10 = _mm_set1_epi32(0x3FF);
+			const __m128 maxValue = _mm_set1_ps(1023.0f);
+			const __m128 maxAlpha = _mm_set1_ps(3.0f);
+			for (; i + 4 <= numTexels; i += 4)
+			{
+				__m128i packed = _mm_loadu_si128((const __m128i*)(pSrc + 4 * i));
+				__m128 r = _mm_div_ps(_mm_cvtepi32_ps(_mm_and_si128(packed, mask10)), maxValue);
+				__m128 g = _mm_div_ps(_mm_cvtepi32_ps(_mm_and_si128(_mm_srli_epi32(packed, 10), mask10)), maxValue);
+				__m128 b = _mm_div_ps(_mm_cvtepi32_ps(_mm_and_si128(_mm_srli_epi32(packed, 20), mask10)), maxValue);
+				__m128 a = _mm_div_ps(_mm_cvtepi32_ps(_mm_srli_epi32(packed, 30)), maxAlpha);
+				_MM_TRANSPOSE4_PS(r, g, b, a);
+				_mm_storeu_ps(pRGBA + 4 * i, r);
+				_mm_storeu_ps(pRGBA + 4 * i + 4, g);
+				_mm_storeu_ps(pRGBA + 4 * i + 8, b);
+				_mm_storeu_ps(pRGBA + 4 * i + 12, a);
+			}
+		}
+#endif
+			break;
+
+		default:
+			break;
+		}
+
+		for (; i < numTexels; i++)
+			DecodeTexel(info, pSrc + i * info.texelSize, pRGBA + 4 * i);
+	}
+
+	// Codifica numTexels texels RGBA (float) no formato de destino.
+	void EncodeRow(const FORMAT_INFO& info, RESOURCE_FORMAT format, const float* pRGBA, unsigned int numTexels, unsigned char* pDest)
+	{
+		unsigned int i = 0;
+
+		switch (format)
+		{
+		case RESOURCE_FORMAT_R32G32B32A32_FLOAT:
+			memcpy(pDest, pRGBA, numTexels * 16);
+			return;
+
+		case RESOURCE_FORMAT_R8G8B8A8_UNORM:
+#if defined(LEANDX12_SSE2)
+		{
+			const __m128 zero = _mm_setzero_ps();
+			const __m128 one = _mm_set1_ps(1.0f);
+			const __m128 maxValue = _mm_set1_ps(255.0f);
+			const __m128 half = _mm_set1_ps(0.5f);
+			for (; i + 4 <= numTexels; i += 4)
+			{
+				__m128i texels[4];
+				for (unsigned int t = 0; t < 4; t++)
+				{
+					__m128 value = _mm_min_ps(_mm_max_ps(_mm_loadu_ps(pRGBA + 4 * (i + t)), zero), one);
+					texels[t] = _mm_cvttps_epi32(_mm_add_ps(_mm_mul_ps(value, maxValue), half));
+				}
+				__m128i words = _mm_packs_epi32(texels[0], texels[1]);
+				__m128i words2 = _mm_packs_epi32(texels[2], texels[3]);
+				_mm_storeu_si128((__m128i*)(pDest + 4 * i), _mm_packus_epi16(words, words2));
+			}
+		}
+#endif
+			break;
+
+		case RESOURCE_FORMAT_R8G8B8A8_UNORM_SRGB:
+		{
+			const SrgbTables& tables = GetSrgbTables();
+			for (; i < numTexels; i++)
+			{
+				pDest[4 * i] = EncodeSrgbByLookup(tables, pRGBA[4 * i]);
+				pDest[4 * i + 1] = EncodeSrgbByLookup(tables, pRGBA[4 * i + 1]);
+				pDest[4 * i + 2] = EncodeSrgbByLookup(tables, pRGBA[4 * i + 2]);
+				pDest[4 * i + 3] = (unsigned char)EncodeUnorm(pRGBA[4 * i + 3], 0xFF);
+			}
+			return;
+		}
+
+		case RESOURCE_FORMAT_R16G16B16A16_FLOAT:
+#if defined(LEANDX12_SSE2)
+			if (HasF16C())
+			{
+				EncodeHalfRowF16C(pRGBA, 4 * numTexels, pDest);
+				return;
+			}
+#endif
+			break;
+
+		case RESOURCE_FORMAT_R10G10B10A2_UNORM:
+#if defined(LEANDX12_SSE2)
+		{
+			const __m128 zero = _mm_setzero_ps();
+			const __m128 one = _mm_set1_ps(1.0f);
+			const __m128 maxValue = _mm_set1_ps(1023.0f);
+			const __m128 maxAlpha = _mm_set1_ps(3.0f);
+			const __m128 half = _mm_set1_ps(0.5f);
+			for (; i + 4 <= numTexels; i += 4)
+			{
+				__m128 r = _mm_loadu_ps(pRGBA + 4 * i);
+				__m128 g = _mm_loadu_ps(pRGBA + 4 * i + 4);
+				__m128 b = _mm_loadu_ps(pRGBA + 4 * i + 8);
+				__m128 a = _mm_loadu_ps(pRGBA + 4 * i + 12);
+				_MM_TRANSPOSE4_PS(r, g, b, a);
+
+				__m128i ri = _mm_cvttps_epi32(_mm_add_ps(_mm_mul_ps(_mm_min_ps(_mm_max_ps(r, zero), one), maxValue), half));
+				__m128i gi = _mm_cvttps_epi32(_mm_add_ps(_mm_mul_ps(_mm_min_ps(_mm_max_ps(g, zero), one), maxValue), half));
+				__m128i bi = _mm_cvttps_epi32(_mm_add_ps(_mm_mul_ps(_mm_min_ps(_mm_max_ps(b, zero), one), maxValue), half));
+				__m128i ai = _mm_cvttps_epi32(_mm_add_ps(_mm_mul_ps(_mm_min_ps(_mm_max_ps(a, zero), one), maxAlpha), half));
+
+				__m128i packed = _mm_or_si128(_mm_or_si128(ri, _mm_slli_epi32(gi, 10)), _mm_or_si128(_mm_slli_epi32(bi, 20), _mm_slli_epi32(ai, 30)));
+				_mm_storeu_si128((__m128i*)(pDest + 4 * i), packed);
+			}
+		}
+#endif
+			break;
+
+		default:
+			break;
+		}
+
+		for (; i < numTexels; i++)
+			EncodeTexel(info, pRGBA + 4 * i, pDest + i * info.texelSize);
+	}
+
+	// ---------------------------------------------------------- Conversão de imagens ------------------------------------------------------ //
+
+	typedef struct CONVERSION_JOB
+	{
+		RESOURCE_FORMAT srcFormat;
+		RESOURCE_FORMAT destFormat;
+		FORMAT_INFO srcInfo;
+		FORMAT_INFO destInfo;
+		const unsigned char* pSrcData;
+		unsigned char* pDestData;
+		unsigned long long srcRowPitch;
+		unsigned long long destRowPitch;
+		unsigned int width;
+	} CONVERSION_JOB;
+
+	void ConvertRows(unsigned int beginRow, unsigned int endRow, void* pUserData)
+	{
+		const CONVERSION_JOB* job = (const CONVERSION_JOB*)pUserData;
+		float rgba[4 * CONVERSION_CHUNK_SIZE];
+
+		for (unsigned int row = beginRow; row < endRow; row++)
+		{
+			const unsigned char* pSrcRow = job->pSrcData + row * job->srcRowPitch;
+			unsigned char* pDestRow = job->pDestData + row * job->destRowPitch;
+
+			if (job->srcFormat == job->destFormat)
+			{
+				memcpy(pDestRow, pSrcRow, (size_t)job->width * job->srcInfo.texelSize);
+				continue;
+			}
+
+			for (unsigned int x = 0; x < job->width; x += CONVERSION_CHUNK_SIZE)
+			{
+				unsigned int numTexels = job->width - x < CONVERSION_CHUNK_SIZE ? job->width - x : CONVERSION_CHUNK_SIZE;
+				DecodeRow(job->srcInfo, job->srcFormat, pSrcRow + x * job->srcInfo.texelSize, numTexels, rgba);
+				EncodeRow(job->destInfo, job->destFormat, rgba, numTexels, pDestRow + x * job->destInfo.texelSize);
+			}
+		}
+	}
+
+	LeanDX12Result PrepareConversion(
+		RESOURCE_FORMAT srcFormat, const void* pSrcData, unsigned long long srcRowPitch,
+		RESOURCE_FORMAT destFormat, void* pDestData, unsigned long long destRowPitch,
+		unsigned int width, CONVERSION_JOB* job)
+	{
+		if (pSrcData == nullptr || pDestData == nullptr)
+			return LEANDX12_ERROR_INVALID_CALL;
+
+		if (!GetFormatInfo(srcFormat, &job->srcInfo) || !GetFormatInfo(destFormat, &job->destInfo))
+			return LEANDX12_ERROR_INVALID_CALL;
+
+		job->srcFormat = srcFormat;
+		job->destFormat = destFormat;
+		job->pSrcData = (const unsigned char*)pSrcData;
+		job->pDestData = (unsigned char*)pDestData;
+		job->srcRowPitch = srcRowPitch ? srcRowPitch : (unsigned long long)width * job->srcInfo.texelSize;
+		job->destRowPitch = destRowPitch ? destRowPitch : (unsigned long long)width * job->destInfo.texelSize;
+		job->width = width;
+
+		if (job->srcRowPitch < (unsigned long long)width * job->srcInfo.texelSize ||
+			job->destRowPitch < (unsigned long long)width * job->destInfo.texelSize)
+			return LEANDX12_ERROR_INSUFFICIENT_BUFFER_SIZE;
+
+		return LEANDX12_OK;
+	}
+}
+
+// ------------------------------------------------------------ Funções públicas ------------------------------------------------------------ //
+
+BOOLEAN IsConversionSupported(RESOURCE_FORMAT format)
+{
+	FORMAT_INFO info;
+	return GetFormatInfo(format, &info);
+}
+
+LeanDX12Result ConvertFormat(
+	RESOURCE_FORMAT srcFormat, const void* pSrcData, unsigned long long srcRowPitch,
+	RESOURCE_FORMAT destFormat, void* pDestData, unsigned long long destRowPitch,
+	unsigned int width, unsigned int height)
+{
+	CONVERSION_JOB job;
+	LeanDX12Result result = PrepareConversion(srcFormat, pSrcData, srcRowPitch, destFormat, pDestData, destRowPitch, width, &job);
+	if (result != LEANDX12_OK)
+		return result;
+
+	if (width == 0 || height == 0)
+		return LEANDX12_OK;
+
+	unsigned int rowsPerTask = CONVERSION_TEXELS_PER_TASK / width;
+	ParallelFor(height, rowsPerTask > 0 ? rowsPerTask : 1, ConvertRows, &job);
+
+	return LEANDX12_OK;
+}
+
+LeanDX12Result ConvertFormatReference(
+	RESOURCE_FORMAT srcFormat, const void* pSrcData, unsigned long long srcRowPitch,
+	RESOURCE_FORMAT destFormat, void* pDestData, unsigned long long destRowPitch,
+	unsigned int width, unsigned int height)
+{
+	CONVERSION_JOB job;
+	LeanDX12Result result = PrepareConversion(srcFormat, pSrcData, srcRowPitch, destFormat, pDestData, destRowPitch, width, &job);
+	if (result != LEANDX12_OK)
+		return result;
+
+	float rgba[4];
+
+	for (unsigned int row = 0; row < height; row++)
+	{
+		// Formatos iguais são copiados, como em ConvertFormat: a passagem por float não preserva, por exemplo, os 24 bits de D24_UNORM.
+		if (srcFormat == destFormat)
+		{
+			memcpy(job.pDestData + row * job.destRowPitch, job.pSrcData + row * job.srcRowPitch, (size_t)width * job.srcInfo.texelSize);
+			continue;
+		}
+
+		for (unsigned int x = 0; x < width; x++)
+		{
+			DecodeTexel(job.srcInfo, job.pSrcData + row * job.srcRowPitch + x * job.srcInfo.texelSize, rgba);
+
+			if (job.srcInfo.srgb)
+				for (unsigned int c = 0; c < 3; c++)
+					rgba[c] = SrgbToLinear(rgba[c]);
+
+			if (job.destInfo.srgb)
+				for (unsigned int c = 0; c < 3; c++)
+					rgba[c] = LinearToSrgb(Saturate(rgba[c]));
+
+			EncodeTexel(job.destInfo, rgba, job.pDestData + row * job.destRowPitch + x * job.destInfo.texelSize);
+		}
+	}
+
+	return LEANDX12_OK;
+}
+
+unsigned short FloatToHalf(float value)
+{
+	unsigned int bits = FloatBits(value);
+	return (unsigned short)(((bits >> 16) & 0x8000u) | FloatToSmallFloat(bits & 0x7FFFFFFFu, 10));
+}
+
+float HalfToFloat(unsigned short value)
+{
+	float result = SmallFloatToFloat(value & 0x7FFFu, 10);
+	return (value & 0x8000u) ? -result : result;
+}
@@ -0,0 +1,53 @@
+/*
+* LeanDX12 - Conversão de formatos
+* Descrição: Conversão de imagens entre os formatos da enumeração RESOURCE_FORMAT na memória do sistema (RAM), para uso com os dados
+* obtidos por ReadbackData, enviados por UploadData ou gravados com SaveAsPNG.
+*
+*	A conversão é feita em duas etapas: os texels de origem são decodificados para RGBA em ponto flutuante de 32 bits e, em seguida,
+*	codificados no formato de destino. Os formatos mais comuns (R8G8B8A8, R16G16B16A16_FLOAT e R32G32B32A32_FLOAT) possuem caminhos
+*	vetorizados (SSE2 e F16C, quando disponíveis no processador) e o sRGB é convertido por tabelas de consulta. Imagens grandes são
+*	divididas por linhas entre as threads de LeanDX12Parallel.h.
+*
+*	Regras de conversão:
+*		•	UNORM/SNORM: arredondamento para o inteiro mais próximo após saturação;
+*		•	UINT/SINT: o valor inteiro é convertido para float (sem normalização) e vice-versa, com saturação;
+*		•	FLOAT (16, 11 e 10 bits): arredondamento para o par mais próximo; valores negativos em R11G11B10_FLOAT são convertidos em 0;
+*		•	Canais ausentes na origem assumem (0, 0, 0, 1);
+*		•	Formatos de profundidade: a profundidade é lida/gravada no canal R e o stencil no canal G.
+*
+*   Organização do arquivo de cabeçalho:
+*	1.	Declaração das funções
+*/
+
+#ifndef _LEANDX12_FORMAT_
+#define _LEANDX12_FORMAT_
+
+#include <cstddef>
+
+#include "LeanDX12.h"
+
+// ------------------------------------------------------ 1. Declaração das funções ------------------------------------------------------- //
+
+// Retorna verdadeiro se o formato puder ser utilizado como origem ou destino de ConvertFormat.
+BOOLEAN IsConversionSupported(RESOURCE_FORMAT format);
+
+// Converte uma imagem de width x height texels do formato srcFormat para destFormat. Os parâmetros srcRowPitch e destRowPitch indicam
+// a distância em bytes entre o início de duas linhas consecutivas; o valor 0 indica linhas contíguas (width * tamanho do texel).
+// Se srcFormat e destFormat forem iguais, as linhas são copiadas sem conversão.
+// Para converter volumes (texturas 3D), utilize height = altura * profundidade.
+LeanDX12Result ConvertFormat(
+	RESOURCE_FORMAT srcFormat, const void* pSrcData, unsigned long long srcRowPitch,
+	RESOURCE_FORMAT destFormat, void* pDestData, unsigned long long destRowPitch,
+	unsigned int width, unsigned int height);
+
+// Implementação escalar de referência de ConvertFormat (sem tabelas, sem SIMD e sem threads). Utilizada para validar o caminho otimizado.
+LeanDX12Result ConvertFormatReference(
+	RESOURCE_FORMAT srcFormat, const void* pSrcData, unsigned long long srcRowPitch,
+	RESOURCE_FORMAT destFormat, void* pDestData, unsigned long long destRowPitch,
+	unsigned int width, unsigned int height);
+
+// Conversões escalares de ponto flutuante de 32 bits para 16 bits (meia precisão) e vice-versa.
+unsigned short FloatToHalf(float value);
+float HalfToFloat(unsigned short value);
+
+#endif  // _LEANDX12_FORMAT_
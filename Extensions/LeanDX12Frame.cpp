@@ -0,0 +1,277 @@
+// Descrição: Implementação da cerca de quadros e da fila de liberação adiada das extensões LeanDX12 (LeanDX12Frame.h).
+
+#include <chrono>
+#include <mutex>
+#include <vector>
+
+#include "LeanDX12Frame.h"
+
+namespace
+{
+	typedef enum RESOURCE_KIND
+	{
+		RESOURCE_KIND_BUFFER,
+		RESOURCE_KIND_TEXTURE,
+		RESOURCE_KIND_RENDER_TARGET
+	} RESOURCE_KIND;
+
+	typedef struct DEFERRED_RELEASE
+	{
+		RESOURCE_KIND kind;
+		void* resource;
+		unsigned long long frameFence;
+	} DEFERRED_RELEASE;
+
+	typedef std::chrono::steady_clock Clock;
+
+	struct FrameState
+	{
+		std::mutex mutex;
+		// Os valores de cerca são acrescentados em ordem crescente, portanto os recursos prontos para exclusão estão sempre no início
+		// da fila (a partir de head).
+		std::vector<DEFERRED_RELEASE> releaseQueue;
+		size_t head = 0;
+		unsigned long long submittedFence = 0;
+		unsigned long long completedFence = 0;
+		unsigned int numReleasedLastPass = 0;
+		unsigned long long numReleasedTotal = 0;
+
+		// Tempos acumulados desde a última submissão. gpuIdleSince é válido enquanto gpuIdle for verdadeiro, isto é, desde que a última
+		// espera (ou RenderFrame) terminou sem que um novo quadro tenha sido submetido.
+		Clock::time_point lastSubmitTime = Clock::now();
+		Clock::duration cpuWaitTime = Clock::duration::zero();
+		Clock::time_point gpuIdleSince = Clock::now();
+		bool gpuIdle = true;
+		FRAME_TIMING_STATS timingStats = {};
+	};
+
+	FrameState& GetFrameState()
+	{
+		static FrameState state;
+		return state;
+	}
+
+	LeanDX12Result EnqueueRelease(RESOURCE_KIND kind, void* resource)
+	{
+		if (resource == nullptr)
+			return LEANDX12_ERROR_INVALID_CALL;
+
+		FrameState& state = GetFrameState();
+		std::lock_guard<std::mutex> lock(state.mutex);
+
+		DEFERRED_RELEASE release;
+		release.kind = kind;
+		release.resource = resource;
+		release.frameFence = state.submittedFence + 1;
+		state.releaseQueue.push_back(release);
+
+		return LEANDX12_OK;
+	}
+
+	void ReleaseResource(const DEFERRED_RELEASE& release)
+	{
+		switch (release.kind)
+		{
+		case RESOURCE_KIND_BUFFER: DeleteBuffer((Buffer*)release.resource); break;
+		case RESOURCE_KIND_TEXTURE: DeleteTexture((Texture*)release.resource); break;
+		case RESOURCE_KIND_RENDER_TARGET: DeleteRenderTarget((Texture*)release.resource); break;
+		}
+	}
+
+	float ToMilliseconds(Clock::duration duration)
+	{
+		return std::chrono::duration<float, std::milli>(duration).count();
+	}
+
+	// Contabiliza uma espera de start a end, ao final da qual todos os quadros submetidos estão concluídos.
+	void CompleteAllFrames(Clock::time_point start, Clock::time_point end)
+	{
+		FrameState& state = GetFrameState();
+		std::lock_guard<std::mutex> lock(state.mutex);
+		state.completedFence = state.submittedFence;
+		state.cpuWaitTime += end - start;
+		if (!state.gpuIdle)
+		{
+			state.gpuIdle = true;
+			state.gpuIdleSince = end;
+		}
+	}
+
+	// Aguarda todo o trabalho submetido, contabilizando o tempo de espera.
+	void WaitForAllFrames()
+	{
+		Clock::time_point start = Clock::now();
+		WaitForGPU();
+		CompleteAllFrames(start, Clock::now());
+	}
+
+	// Exclui, em uma única passagem, os recursos da fila marcados com valor de cerca menor ou igual a frameFence.
+	unsigned int ReleaseUpToFence(unsigned long long frameFence)
+	{
+		FrameState& state = GetFrameState();
+		std::vector<DEFERRED_RELEASE> batch;
+
+		{
+			std::lock_guard<std::mutex> lock(state.mutex);
+
+			size_t end = state.head;
+			while (end < state.releaseQueue.size() && state.releaseQueue[end].frameFence <= frameFence)
+				end++;
+
+			batch.assign(state.releaseQueue.begin() + state.head, state.releaseQueue.begin() + end);
+			state.head = end;
+
+			// Compacta a fila quando a parte já consumida for maior que a parte pendente.
+			if (state.head > 0 && state.head >= state.releaseQueue.size() - state.head)
+			{
+				state.releaseQueue.erase(state.releaseQueue.begin(), state.releaseQueue.begin() + state.head);
+				state.head = 0;
+			}
+		}
+
+		for (size_t i = 0; i < batch.size(); i++)
+			ReleaseResource(batch[i]);
+
+		std::lock_guard<std::mutex> lock(state.mutex);
+		state.numReleasedLastPass = (unsigned int)batch.size();
+		state.numReleasedTotal += batch.size();
+
+		return (unsigned int)batch.size();
+	}
+}
+
+unsigned long long SubmitFrame(BOOLEAN async)
+{
+	FrameState& state = GetFrameState();
+
+	Clock::time_point start = Clock::now();
+	if (async)
+		RenderFrameAsync();
+	else
+		RenderFrame();
+	Clock::time_point end = Clock::now();
+
+	unsigned long long frameFence;
+	{
+		std::lock_guard<std::mutex> lock(state.mutex);
+		frameFence = ++state.submittedFence;
+
+		FRAME_TIMING_STATS& stats = state.timingStats;
+		stats.cpuFrameTime = ToMilliseconds(start - state.lastSubmitTime);
+		stats.cpuWaitTime = ToMilliseconds(state.cpuWaitTime);
+		stats.gpuIdleTime = state.gpuIdle ? ToMilliseconds(start - state.gpuIdleSince) : 0.0f;
+
+		state.lastSubmitTime = start;
+		state.cpuWaitTime = Clock::duration::zero();
+		state.gpuIdle = false;
+
+		// RenderFrame aguarda a conclusão do quadro: o tempo de espera é contabilizado no próximo quadro.
+		if (!async)
+		{
+			state.completedFence = frameFence;
+			state.cpuWaitTime = end - start;
+			state.gpuIdle = true;
+			state.gpuIdleSince = end;
+		}
+	}
+
+	ReleaseCompletedResources();
+	return frameFence;
+}
+
+void WaitForFrame(unsigned long long frameFence)
+{
+	FrameState& state = GetFrameState();
+
+	bool wait;
+	{
+		std::lock_guard<std::mutex> lock(state.mutex);
+		wait = frameFence > state.completedFence;
+	}
+
+	// A biblioteca só permite aguardar todo o trabalho submetido, o que conclui todos os quadros de uma vez.
+	if (wait)
+		WaitForAllFrames();
+
+	ReleaseCompletedResources();
+}
+
+unsigned long long GetFrameFence()
+{
+	FrameState& state = GetFrameState();
+	std::lock_guard<std::mutex> lock(state.mutex);
+	return state.submittedFence + 1;
+}
+
+unsigned long long GetCompletedFrameFence()
+{
+	FrameState& state = GetFrameState();
+	std::lock_guard<std::mutex> lock(state.mutex);
+	return state.completedFence;
+}
+
+LeanDX12Result BeginFrame(PipelineState* pipelineState)
+{
+	// BeginScene aguarda a conclusão do quadro anterior: o tempo gasto nela é contabilizado como espera e, ao seu término, todos os
+	// quadros submetidos estão concluídos.
+	Clock::time_point start = Clock::now();
+	LeanDX12Result result = BeginScene(pipelineState);
+	if (result == LEANDX12_OK)
+		CompleteAllFrames(start, Clock::now());
+
+	ReleaseCompletedResources();
+	return result;
+}
+
+void GetFrameTimingStats(FRAME_TIMING_STATS* stats)
+{
+	if (stats == nullptr)
+		return;
+
+	FrameState& state = GetFrameState();
+	std::lock_guard<std::mutex> lock(state.mutex);
+
+	*stats = state.timingStats;
+	stats->numFramesInFlight = (unsigned int)(state.submittedFence - state.completedFence);
+}
+
+LeanDX12Result DeleteBufferDeferred(Buffer* buffer)
+{
+	return EnqueueRelease(RESOURCE_KIND_BUFFER, buffer);
+}
+
+LeanDX12Result DeleteTextureDeferred(Texture* texture)
+{
+	return EnqueueRelease(RESOURCE_KIND_TEXTURE, texture);
+}
+
+LeanDX12Result DeleteRenderTargetDeferred(Texture* renderTarget)
+{
+	return EnqueueRelease(RESOURCE_KIND_RENDER_TARGET, renderTarget);
+}
+
+unsigned int ReleaseCompletedResources()
+{
+	return ReleaseUpToFence(GetCompletedFrameFence());
+}
+
+void FlushDeferredReleases()
+{
+	WaitForAllFrames();
+
+	// Recursos marcados com o quadro em gravação também são liberados: após WaitForGPU não há trabalho pendente na GPU.
+	ReleaseUpToFence(~0ull);
+}
+
+void GetDeferredReleaseStats(DEFERRED_RELEASE_STATS* stats)
+{
+	if (stats == nullptr)
+		return;
+
+	FrameState& state = GetFrameState();
+	std::lock_guard<std::mutex> lock(state.mutex);
+
+	stats->numPendingResources = (unsigned int)(state.releaseQueue.size() - state.head);
+	stats->numReleasedLastPass = state.numReleasedLastPass;
+	stats->numReleasedTotal = state.numReleasedTotal;
+}
@@ -0,0 +1,87 @@
+/*
+* LeanDX12 - Quadros e liberação adiada de recursos
+* Descrição: Numeração dos quadros submetidos à GPU (cerca de quadros) e fila de exclusão adiada de recursos.
+*
+*	Cada quadro recebe um valor de cerca crescente no momento em que é submetido por SubmitFrame. Um recurso excluído por
+*	DeleteBufferDeferred, DeleteTextureDeferred ou DeleteRenderTargetDeferred é marcado com o valor de cerca do quadro em gravação e só é
+*	excluído de fato (DeleteBuffer, DeleteTexture ou DeleteRenderTarget) quando esse quadro for concluído pela GPU. Desta forma os
+*	recursos podem ser excluídos em qualquer ponto do quadro, sem a necessidade de chamar WaitForGPU.
+*
+*	A aplicação inicia cada quadro com BeginFrame, no lugar da primeira chamada a BeginScene do quadro, e o submete com
+*	SubmitFrame(TRUE). BeginFrame chama BeginScene e contabiliza o tempo gasto nela como espera pela GPU.
+*
+*	Nota: a biblioteca não mantém vários quadros em andamento. BeginScene aguarda a conclusão do quadro anterior (há uma única lista de
+*	comandos e uma única cerca), de modo que a GPU só executa o quadro submetido enquanto a CPU prepara o próximo até a sua primeira
+*	cena. Esta extensão apenas mede essa espera; ela não controla a profundidade da fila de quadros.
+*
+*	GetFrameTimingStats informa, para o último quadro submetido, o tempo de CPU do quadro, o tempo em que a CPU ficou bloqueada
+*	aguardando a GPU e uma estimativa (limite inferior) do tempo em que a GPU ficou sem trabalho aguardando a CPU.
+*
+*	As funções de exclusão adiada podem ser chamadas de qualquer thread. As demais funções devem ser chamadas da thread de renderização,
+*	no lugar de RenderFrame, RenderFrameAsync e WaitForGPU.
+*
+*   Organização do arquivo de cabeçalho:
+*	1.	Estruturas
+*	2.	Declaração das funções
+*		•	Cerca de quadros
+*		•	Tempos dos quadros
+*		•	Liberação adiada
+*/
+
+#ifndef _LEANDX12_FRAME_
+#define _LEANDX12_FRAME_
+
+#include <cstddef>
+
+#include "LeanDX12.h"
+
+// ------------------------------------------------------------ 1. Estruturas ------------------------------------------------------------- //
+
+typedef struct DEFERRED_RELEASE_STATS
+{
+	unsigned int numPendingResources;
+	unsigned int numReleasedLastPass;
+	unsigned long long numReleasedTotal;
+} DEFERRED_RELEASE_STATS;
+
+typedef struct FRAME_TIMING_STATS
+{
+	float cpuFrameTime;						// Milissegundos entre as duas últimas submissões.
+	float cpuWaitTime;						// Milissegundos em que a CPU aguardou a GPU (BeginFrame, inclusive em BeginScene,
+											// WaitForFrame ou RenderFrame).
+	float gpuIdleTime;						// Milissegundos em que a GPU certamente não tinha trabalho (limite inferior).
+	unsigned int numFramesInFlight;			// Quadros submetidos e ainda não concluídos (0 ou 1).
+} FRAME_TIMING_STATS;
+
+// ------------------------------------------------------ 2. Declaração das funções ------------------------------------------------------- //
+
+// -------------------------------------------------------- 2.1. Cerca de quadros --------------------------------------------------------- //
+
+// Submete o quadro gravado (RenderFrameAsync se async for verdadeiro, RenderFrame caso contrário) e retorna o valor de cerca atribuído a
+// ele. Os recursos cujos quadros já foram concluídos são liberados em seguida.
+unsigned long long SubmitFrame(BOOLEAN async);
+// Aguarda a conclusão do quadro frameFence (WaitForGPU, caso ainda não tenha sido concluído) e libera os recursos pendentes.
+void WaitForFrame(unsigned long long frameFence);
+// Valor de cerca do quadro em gravação (o próximo a ser submetido).
+unsigned long long GetFrameFence();
+// Valor de cerca do último quadro concluído pela GPU.
+unsigned long long GetCompletedFrameFence();
+
+// ------------------------------------------------------- 2.2. Tempos dos quadros -------------------------------------------------------- //
+
+// Inicia a primeira cena do quadro (BeginScene), contabilizando como espera o tempo em que BeginScene aguarda o quadro anterior.
+LeanDX12Result BeginFrame(PipelineState* pipelineState);
+void GetFrameTimingStats(FRAME_TIMING_STATS* stats);
+
+// -------------------------------------------------------- 2.3. Liberação adiada --------------------------------------------------------- //
+
+LeanDX12Result DeleteBufferDeferred(Buffer* buffer);
+LeanDX12Result DeleteTextureDeferred(Texture* texture);
+LeanDX12Result DeleteRenderTargetDeferred(Texture* renderTarget);
+// Exclui, em uma única passagem, todos os recursos cujos quadros já foram concluídos. Retorna o número de recursos excluídos.
+unsigned int ReleaseCompletedResources();
+// Aguarda a GPU e exclui todos os recursos pendentes (utilizar antes de ReleaseDevice).
+void FlushDeferredReleases();
+void GetDeferredReleaseStats(DEFERRED_RELEASE_STATS* stats);
+
+#endif  // _LEANDX12_FRAME_
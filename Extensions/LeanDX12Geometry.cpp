@@ -0,0 +1,280 @@
+// Descrição: Implementação da arena de geometria das extensões LeanDX12 (LeanDX12Geometry.h).
+
+#include <cstring>
+#include <map>
+#include <utility>
+#include <vector>
+
+#include "LeanDX12Geometry.h"
+
+namespace
+{
+	// Alocador de intervalos [offset, offset + size) dentro de [0, capacity). Os blocos livres são mantidos ordenados pelo início, o que
+	// permite fundir blocos vizinhos na liberação.
+	class RangeAllocator
+	{
+	public:
+		void Init(unsigned int capacity)
+		{
+			this->capacity = capacity;
+			freeBlocks.clear();
+			if (capacity > 0)
+				freeBlocks[0] = capacity;
+		}
+
+		bool Allocate(unsigned int size, unsigned int* offset)
+		{
+			if (size == 0)
+			{
+				*offset = 0;
+				return true;
+			}
+
+			for (std::map<unsigned int, unsigned int>::iterator block = freeBlocks.begin(); block != freeBlocks.end(); ++block)
+			{
+				if (block->second < size)
+					continue;
+
+				*offset = block->first;
+				unsigned int remaining = block->second - size;
+				freeBlocks.erase(block);
+				if (remaining > 0)
+					freeBlocks[*offset + size] = remaining;
+
+				return true;
+			}
+
+			return false;
+		}
+
+		void Free(unsigned int offset, unsigned int size)
+		{
+			if (size == 0)
+				return;
+
+			std::map<unsigned int, unsigned int>::iterator block = freeBlocks.insert(std::make_pair(offset, size)).first;
+
+			std::map<unsigned int, unsigned int>::iterator next = block;
+			++next;
+			if (next != freeBlocks.end() && block->first + block->second == next->first)
+			{
+				block->second += next->second;
+				freeBlocks.erase(next);
+			}
+
+			if (block != freeBlocks.begin())
+			{
+				std::map<unsigned int, unsigned int>::iterator previous = block;
+				--previous;
+				if (previous->first + previous->second == block->first)
+				{
+					previous->second += block->second;
+					freeBlocks.erase(block);
+				}
+			}
+		}
+
+		// Verifica se [offset, offset + size) não se sobrepõe a nenhum bloco livre (isto é, se pode ter sido alocado).
+		bool IsAllocated(unsigned int offset, unsigned int size) const
+		{
+			if (size == 0)
+				return true;
+			if (offset > capacity || size > capacity - offset)
+				return false;
+
+			std::map<unsigned int, unsigned int>::const_iterator next = freeBlocks.lower_bound(offset);
+			if (next != freeBlocks.end() && next->first < offset + size)
+				return false;
+			if (next != freeBlocks.begin())
+			{
+				--next;
+				if (next->first + next->second > offset)
+					return false;
+			}
+
+			return true;
+		}
+
+		unsigned int Extent() const
+		{
+			if (!freeBlocks.empty())
+			{
+				std::map<unsigned int, unsigned int>::const_reverse_iterator last = freeBlocks.rbegin();
+				if (last->first + last->second == capacity)
+					return last->first;
+			}
+
+			return capacity;
+		}
+
+		unsigned int FreeSize() const
+		{
+			unsigned int total = 0;
+			for (std::map<unsigned int, unsigned int>::const_iterator block = freeBlocks.begin(); block != freeBlocks.end(); ++block)
+				total += block->second;
+			return total;
+		}
+
+		unsigned int LargestFreeBlock() const
+		{
+			unsigned int largest = 0;
+			for (std::map<unsigned int, unsigned int>::const_iterator block = freeBlocks.begin(); block != freeBlocks.end(); ++block)
+				if (block->second > largest)
+					largest = block->second;
+			return largest;
+		}
+
+		unsigned int Capacity() const
+		{
+			return capacity;
+		}
+
+	private:
+		unsigned int capacity = 0;
+		std::map<unsigned int, unsigned int> freeBlocks;
+	};
+}
+
+struct GeometryArena
+{
+	unsigned int dataSizePerVertex;
+	std::vector<unsigned char> vertexData;
+	std::vector<unsigned int> indexData;
+	RangeAllocator vertexAllocator;
+	RangeAllocator indexAllocator;
+	unsigned int numMeshes = 0;
+};
+
+LeanDX12Result CreateGeometryArena(const GEOMETRY_ARENA_DESC* desc, GeometryArena** arena)
+{
+	if (desc == nullptr || arena == nullptr || desc->dataSizePerVertex == 0 || desc->maxVertices == 0)
+		return LEANDX12_ERROR_INVALID_CALL;
+
+	// SetVertexData e SetIndexData recebem o tamanho em bytes como unsigned int.
+	if ((unsigned long long)desc->dataSizePerVertex * desc->maxVertices > 0xFFFFFFFFull ||
+		(unsigned long long)desc->maxIndices * sizeof(unsigned int) > 0xFFFFFFFFull)
+		return LEANDX12_ERROR_INVALID_CALL;
+
+	GeometryArena* newArena = new GeometryArena;
+	newArena->dataSizePerVertex = desc->dataSizePerVertex;
+	newArena->vertexData.resize((size_t)desc->dataSizePerVertex * desc->maxVertices);
+	newArena->indexData.resize(desc->maxIndices);
+	newArena->vertexAllocator.Init(desc->maxVertices);
+	newArena->indexAllocator.Init(desc->maxIndices);
+
+	*arena = newArena;
+	return LEANDX12_OK;
+}
+
+void DeleteGeometryArena(GeometryArena* arena)
+{
+	delete arena;
+}
+
+LeanDX12Result AllocateMesh(GeometryArena* arena, const void* pVertices, unsigned int numVertices, const unsigned int* pIndices, unsigned int numIndices, MESH_RANGE* range)
+{
+	if (arena == nullptr || pVertices == nullptr || numVertices == 0 || (numIndices > 0 && pIndices == nullptr) || range == nullptr)
+		return LEANDX12_ERROR_INVALID_CALL;
+
+	unsigned int baseVertex, firstIndex;
+	if (!arena->vertexAllocator.Allocate(numVertices, &baseVertex))
+		return LEANDX12_ERROR_INSUFFICIENT_BUFFER_SIZE;
+	if (!arena->indexAllocator.Allocate(numIndices, &firstIndex))
+	{
+		arena->vertexAllocator.Free(baseVertex, numVertices);
+		return LEANDX12_ERROR_INSUFFICIENT_BUFFER_SIZE;
+	}
+
+	memcpy(&arena->vertexData[(size_t)baseVertex * arena->dataSizePerVertex], pVertices, (size_t)numVertices * arena->dataSizePerVertex);
+	if (numIndices > 0)
+		memcpy(&arena->indexData[firstIndex], pIndices, numIndices * sizeof(unsigned int));
+
+	range->baseVertex = baseVertex;
+	range->numVertices = numVertices;
+	range->firstIndex = firstIndex;
+	range->numIndices = numIndices;
+	arena->numMeshes++;
+
+	return LEANDX12_OK;
+}
+
+LeanDX12Result FreeMesh(GeometryArena* arena, const MESH_RANGE* range)
+{
+	if (arena == nullptr || range == nullptr || range->numVertices == 0 || arena->numMeshes == 0)
+		return LEANDX12_ERROR_INVALID_CALL;
+
+	if (!arena->vertexAllocator.IsAllocated(range->baseVertex, range->numVertices) ||
+		!arena->indexAllocator.IsAllocated(range->firstIndex, range->numIndices))
+		return LEANDX12_ERROR_OFFSET_OUT_OF_RANGE;
+
+	arena->vertexAllocator.Free(range->baseVertex, range->numVertices);
+	arena->indexAllocator.Free(range->firstIndex, range->numIndices);
+	arena->numMeshes--;
+
+	return LEANDX12_OK;
+}
+
+void GetGeometryArenaData(GeometryArena* arena, void** pVertexData, unsigned int* vertexDataSize, unsigned int** pIndexData, unsigned int* indexDataSize)
+{
+	if (arena == nullptr)
+		return;
+
+	if (pVertexData != nullptr)
+		*pVertexData = arena->vertexData.data();
+	if (vertexDataSize != nullptr)
+		*vertexDataSize = arena->vertexAllocator.Extent() * arena->dataSizePerVertex;
+	if (pIndexData != nullptr)
+		*pIndexData = arena->indexData.data();
+	if (indexDataSize != nullptr)
+		*indexDataSize = arena->indexAllocator.Extent() * (unsigned int)sizeof(unsigned int);
+}
+
+unsigned int GetGeometryArenaDataSizePerVertex(GeometryArena* arena)
+{
+	return arena != nullptr ? arena->dataSizePerVertex : 0;
+}
+
+LeanDX12Result BindGeometryArena(GeometryArena* arena)
+{
+	if (arena == nullptr)
+		return LEANDX12_ERROR_INVALID_CALL;
+
+	void* pVertexData;
+	unsigned int* pIndexData;
+	unsigned int vertexDataSize, indexDataSize;
+	GetGeometryArenaData(arena, &pVertexData, &vertexDataSize, &pIndexData, &indexDataSize);
+
+	if (vertexDataSize == 0)
+		return LEANDX12_ERROR_INVALID_CALL;
+
+	LeanDX12Result result = SetVertexData(pVertexData, vertexDataSize, arena->dataSizePerVertex);
+	if (result != LEANDX12_OK || indexDataSize == 0)
+		return result;
+
+	return SetIndexData(pIndexData, indexDataSize);
+}
+
+void DrawMesh(const MESH_RANGE* range, unsigned int instanceCount, unsigned int startInstanceLocation)
+{
+	if (range == nullptr)
+		return;
+
+	if (range->numIndices > 0)
+		DrawIndexedInstanced(range->numIndices, instanceCount, range->firstIndex, range->baseVertex, startInstanceLocation);
+	else
+		DrawInstanced(range->numVertices, instanceCount, range->baseVertex, startInstanceLocation);
+}
+
+void GetGeometryArenaStats(GeometryArena* arena, GEOMETRY_ARENA_STATS* stats)
+{
+	if (arena == nullptr || stats == nullptr)
+		return;
+
+	stats->numMeshes = arena->numMeshes;
+	stats->numUsedVertices = arena->vertexAllocator.Capacity() - arena->vertexAllocator.FreeSize();
+	stats->numUsedIndices = arena->indexAllocator.Capacity() - arena->indexAllocator.FreeSize();
+	stats->largestFreeVertexBlock = arena->vertexAllocator.LargestFreeBlock();
+	stats->largestFreeIndexBlock = arena->indexAllocator.LargestFreeBlock();
+	stats->vertexExtent = arena->vertexAllocator.Extent();
+	stats->indexExtent = arena->indexAllocator.Extent();
+}
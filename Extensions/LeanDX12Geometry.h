@@ -0,0 +1,84 @@
+/*
+* LeanDX12 - Arena de geometria
+* Descrição: Armazenamento persistente de malhas em um único bloco de vértices e um único bloco de índices. Cada malha é copiada uma única
+* vez para a arena (AllocateMesh) e referenciada pelos seus intervalos (baseVertex, firstIndex), sem concatenações nem cópias a cada
+* quadro.
+*
+*	A capacidade da arena é definida na criação e a sua memória nunca é realocada, portanto os ponteiros retornados por
+*	GetGeometryArenaData permanecem válidos durante toda a vida da arena (podendo ser utilizados em contextos de comandos e na fila de
+*	renderização). Os intervalos liberados por FreeMesh são reaproveitados (primeiro bloco livre suficiente, com fusão de blocos vizinhos).
+*
+*	BindGeometryArena envia, uma vez por cena, os dados da arena até o fim do último bloco ocupado (SetVertexData e SetIndexData), e
+*	DrawMesh desenha uma malha a partir dos seus intervalos. Uma malha não deve ser liberada enquanto houver comandos gravados, ainda não
+*	executados, que a referenciem.
+*
+*   Organização do arquivo de cabeçalho:
+*	1.	Estruturas
+*		•	Estruturas opacas
+*		•	Estruturas transparentes
+*	2.	Declaração das funções
+*/
+
+#ifndef _LEANDX12_GEOMETRY_
+#define _LEANDX12_GEOMETRY_
+
+#include <cstddef>
+
+#include "LeanDX12.h"
+
+// ------------------------------------------------------------ 1. Estruturas ------------------------------------------------------------- //
+
+// -------------------------------------------------------- 1.1. Estruturas opacas -------------------------------------------------------- //
+
+typedef struct GeometryArena GeometryArena;
+
+// ---------------------------------------------------- 1.2. Estruturas transparentes ----------------------------------------------------- //
+
+typedef struct GEOMETRY_ARENA_DESC
+{
+	unsigned int dataSizePerVertex;
+	unsigned int maxVertices;
+	unsigned int maxIndices;
+} GEOMETRY_ARENA_DESC;
+
+typedef struct MESH_RANGE
+{
+	unsigned int baseVertex;
+	unsigned int numVertices;
+	unsigned int firstIndex;
+	unsigned int numIndices;						// 0 = malha não indexada.
+} MESH_RANGE;
+
+typedef struct GEOMETRY_ARENA_STATS
+{
+	unsigned int numMeshes;
+	unsigned int numUsedVertices;
+	unsigned int numUsedIndices;
+	unsigned int largestFreeVertexBlock;
+	unsigned int largestFreeIndexBlock;
+	unsigned int vertexExtent;						// Vértices enviados por BindGeometryArena (até o fim do último bloco ocupado).
+	unsigned int indexExtent;
+} GEOMETRY_ARENA_STATS;
+
+// ------------------------------------------------------ 2. Declaração das funções ------------------------------------------------------- //
+
+LeanDX12Result CreateGeometryArena(const GEOMETRY_ARENA_DESC* desc, GeometryArena** arena);
+void DeleteGeometryArena(GeometryArena* arena);
+
+// Copia a malha para a arena. Os índices são relativos ao primeiro vértice da malha. Retorna LEANDX12_ERROR_INSUFFICIENT_BUFFER_SIZE se
+// não houver um bloco livre suficiente.
+LeanDX12Result AllocateMesh(GeometryArena* arena, const void* pVertices, unsigned int numVertices, const unsigned int* pIndices, unsigned int numIndices, MESH_RANGE* range);
+LeanDX12Result FreeMesh(GeometryArena* arena, const MESH_RANGE* range);
+
+// Ponteiros e tamanhos (em bytes, até o fim do último bloco ocupado) dos dados da arena.
+void GetGeometryArenaData(GeometryArena* arena, void** pVertexData, unsigned int* vertexDataSize, unsigned int** pIndexData, unsigned int* indexDataSize);
+unsigned int GetGeometryArenaDataSizePerVertex(GeometryArena* arena);
+
+// Envia os dados da arena para a cena atual.
+LeanDX12Result BindGeometryArena(GeometryArena* arena);
+// Desenha a malha (DrawIndexedInstanced ou, para malhas não indexadas, DrawInstanced) com os dados enviados por BindGeometryArena.
+void DrawMesh(const MESH_RANGE* range, unsigned int instanceCount, unsigned int startInstanceLocation);
+
+void GetGeometryArenaStats(GeometryArena* arena, GEOMETRY_ARENA_STATS* stats);
+
+#endif  // _LEANDX12_GEOMETRY_
@@ -0,0 +1,175 @@
+// Descrição: Implementação do desenho indireto das extensões LeanDX12 (LeanDX12Indirect.h).
+
+#include <cstring>
+#include <vector>
+
+#include "LeanDX12Indirect.h"
+
+struct IndirectArgumentBuilder
+{
+	INDIRECT_COMMAND_SIGNATURE_DESC signature;
+	unsigned int stride;
+	std::vector<unsigned int> arguments;
+	unsigned int commandCount = 0;
+};
+
+namespace
+{
+	// Maior número de constantes aceito por uma assinatura (limite de 64 palavras de 32 bits da assinatura raiz do Direct3D 12).
+	const unsigned int MAX_INDIRECT_32BIT_CONSTANTS = 64;
+
+	bool IsValidSignature(const INDIRECT_COMMAND_SIGNATURE_DESC* signature)
+	{
+		return signature != nullptr && signature->num32bitConstants <= MAX_INDIRECT_32BIT_CONSTANTS;
+	}
+
+	unsigned int DrawArgumentsSize(const INDIRECT_COMMAND_SIGNATURE_DESC* signature)
+	{
+		return signature->indexed ? sizeof(DRAW_INDEXED_ARGUMENTS) : sizeof(DRAW_ARGUMENTS);
+	}
+
+	void WriteCommand(const INDIRECT_COMMAND_SIGNATURE_DESC* signature, unsigned int* pCommand, unsigned int descriptorTableOffset, const void* pConstants, const void* pDrawArguments)
+	{
+		if (signature->hasDescriptorTableOffset)
+			*pCommand++ = descriptorTableOffset;
+
+		if (signature->num32bitConstants > 0)
+		{
+			memcpy(pCommand, pConstants, signature->num32bitConstants * sizeof(unsigned int));
+			pCommand += signature->num32bitConstants;
+		}
+
+		memcpy(pCommand, pDrawArguments, DrawArgumentsSize(signature));
+	}
+}
+
+unsigned int GetIndirectCommandStride(const INDIRECT_COMMAND_SIGNATURE_DESC* signature)
+{
+	if (!IsValidSignature(signature))
+		return 0;
+
+	return (signature->hasDescriptorTableOffset ? sizeof(unsigned int) : 0) + signature->num32bitConstants * sizeof(unsigned int) +
+		DrawArgumentsSize(signature);
+}
+
+LeanDX12Result WriteIndirectCommand(const INDIRECT_COMMAND_SIGNATURE_DESC* signature, void* pArgumentData, unsigned int commandIndex, unsigned int descriptorTableOffset, const void* pConstants, const void* pDrawArguments)
+{
+	if (!IsValidSignature(signature) || pArgumentData == nullptr || pDrawArguments == nullptr ||
+		(signature->num32bitConstants > 0 && pConstants == nullptr))
+		return LEANDX12_ERROR_INVALID_CALL;
+
+	unsigned char* pCommand = (unsigned char*)pArgumentData + (size_t)commandIndex * GetIndirectCommandStride(signature);
+	WriteCommand(signature, (unsigned int*)pCommand, descriptorTableOffset, pConstants, pDrawArguments);
+
+	return LEANDX12_OK;
+}
+
+LeanDX12Result CreateIndirectArgumentBuilder(const INDIRECT_COMMAND_SIGNATURE_DESC* signature, IndirectArgumentBuilder** builder)
+{
+	if (!IsValidSignature(signature) || builder == nullptr)
+		return LEANDX12_ERROR_INVALID_CALL;
+
+	IndirectArgumentBuilder* newBuilder = new IndirectArgumentBuilder;
+	newBuilder->signature = *signature;
+	newBuilder->stride = GetIndirectCommandStride(signature);
+
+	*builder = newBuilder;
+	return LEANDX12_OK;
+}
+
+void DeleteIndirectArgumentBuilder(IndirectArgumentBuilder* builder)
+{
+	delete builder;
+}
+
+void ResetIndirectArgumentBuilder(IndirectArgumentBuilder* builder)
+{
+	if (builder == nullptr)
+		return;
+
+	builder->arguments.clear();
+	builder->commandCount = 0;
+}
+
+LeanDX12Result AppendIndirectCommand(IndirectArgumentBuilder* builder, unsigned int descriptorTableOffset, const void* pConstants, const void* pDrawArguments)
+{
+	if (builder == nullptr || pDrawArguments == nullptr || (builder->signature.num32bitConstants > 0 && pConstants == nullptr))
+		return LEANDX12_ERROR_INVALID_CALL;
+
+	size_t offset = builder->arguments.size();
+	builder->arguments.resize(offset + builder->stride / sizeof(unsigned int));
+	WriteCommand(&builder->signature, &builder->arguments[offset], descriptorTableOffset, pConstants, pDrawArguments);
+	builder->commandCount++;
+
+	return LEANDX12_OK;
+}
+
+void GetIndirectArguments(IndirectArgumentBuilder* builder, const void** pArgumentData, unsigned int* commandCount)
+{
+	if (builder == nullptr)
+		return;
+
+	if (pArgumentData != nullptr)
+		*pArgumentData = builder->arguments.data();
+	if (commandCount != nullptr)
+		*commandCount = builder->commandCount;
+}
+
+LeanDX12Result ExecuteIndirect(const INDIRECT_COMMAND_SIGNATURE_DESC* signature, unsigned int maxCommandCount, const void* pArgumentData, const unsigned int* pCount)
+{
+	if (!IsValidSignature(signature) || (maxCommandCount > 0 && pArgumentData == nullptr))
+		return LEANDX12_ERROR_INVALID_CALL;
+
+	unsigned int commandCount = pCount != nullptr && *pCount < maxCommandCount ? *pCount : maxCommandCount;
+	unsigned int stride = GetIndirectCommandStride(signature) / sizeof(unsigned int);
+	unsigned int num32bitConstants = signature->num32bitConstants;
+
+	const unsigned int* pCommand = (const unsigned int*)pArgumentData;
+	const unsigned int* pPreviousCommand = nullptr;
+
+	for (unsigned int i = 0; i < commandCount; i++, pPreviousCommand = pCommand, pCommand += stride)
+	{
+		const unsigned int* pField = pCommand;
+		LeanDX12Result result;
+
+		if (signature->hasDescriptorTableOffset)
+		{
+			if (pPreviousCommand == nullptr || *pField != *pPreviousCommand)
+			{
+				result = MapDescriptorTableOffsetToBaseRegister(*pField);
+				if (result != LEANDX12_OK)
+					return result;
+			}
+			pField++;
+		}
+
+		if (num32bitConstants > 0)
+		{
+			if (pPreviousCommand == nullptr ||
+				memcmp(pField, pPreviousCommand + (pField - pCommand), num32bitConstants * sizeof(unsigned int)) != 0)
+			{
+				result = Set32bitConstants(signature->shaderRegister, num32bitConstants, (void*)pField, 0);
+				if (result != LEANDX12_OK)
+					return result;
+			}
+			pField += num32bitConstants;
+		}
+
+		if (signature->indexed)
+		{
+			const DRAW_INDEXED_ARGUMENTS* arguments = (const DRAW_INDEXED_ARGUMENTS*)pField;
+			if (arguments->indexCountPerInstance > 0 && arguments->instanceCount > 0)
+				DrawIndexedInstanced(arguments->indexCountPerInstance, arguments->instanceCount, arguments->startIndexLocation,
+					arguments->baseVertexLocation, arguments->startInstanceLocation);
+		}
+		else
+		{
+			const DRAW_ARGUMENTS* arguments = (const DRAW_ARGUMENTS*)pField;
+			if (arguments->vertexCountPerInstance > 0 && arguments->instanceCount > 0)
+				DrawInstanced(arguments->vertexCountPerInstance, arguments->instanceCount, arguments->startVertexLocation,
+					arguments->startInstanceLocation);
+		}
+	}
+
+	return LEANDX12_OK;
+}
@@ -0,0 +1,91 @@
+/*
+* LeanDX12 - Desenho indireto
+* Descrição: Emissão de vários desenhos em uma única chamada a partir de um vetor de argumentos, no formato das assinaturas de comando
+* do ExecuteIndirect do Direct3D 12.
+*
+*	A assinatura (INDIRECT_COMMAND_SIGNATURE_DESC) define o conteúdo de cada comando do vetor, nesta ordem: deslocamento da tabela de
+*	descritores (opcional), num32bitConstants constantes de 32 bits para shaderRegister (opcional) e os argumentos do desenho
+*	(DRAW_ARGUMENTS ou DRAW_INDEXED_ARGUMENTS). Todos os campos têm 4 bytes e os comandos são contíguos (GetIndirectCommandStride bytes).
+*
+*	O vetor pode ser preenchido por qualquer código da aplicação: pelo construtor de argumentos (IndirectArgumentBuilder), ou por
+*	WriteIndirectCommand, que escreve um comando em uma posição fixa e pode ser chamada por várias threads ao mesmo tempo (em posições
+*	distintas). ExecuteIndirect emite os comandos na cena atual, opcionalmente limitados por um contador (pCount).
+*
+*	Nota: ExecuteIndirect é uma emulação na CPU. LeanDX12.h não expõe assinaturas de comando, buffers de argumentos na GPU nem o
+*	ExecuteIndirect do Direct3D 12, portanto o vetor de argumentos e o contador são lidos pela CPU no momento da chamada, e cada comando
+*	é convertido nas chamadas correspondentes de LeanDX12.h (MapDescriptorTableOffsetToBaseRegister, Set32bitConstants e
+*	DrawInstanced ou DrawIndexedInstanced), com o custo de processador de cada uma. Os argumentos não podem ser gerados pela GPU (por
+*	exemplo, por um compute shader de descarte), e o ganho se limita a descartar as trocas de estado repetidas entre comandos
+*	consecutivos. O formato dos argumentos segue o do Direct3D 12 para que o mesmo vetor possa ser utilizado quando a biblioteca expuser
+*	o ExecuteIndirect real.
+*
+*   Organização do arquivo de cabeçalho:
+*	1.	Estruturas
+*		•	Estruturas opacas
+*		•	Estruturas transparentes
+*	2.	Declaração das funções
+*/
+
+#ifndef _LEANDX12_INDIRECT_
+#define _LEANDX12_INDIRECT_
+
+#include <cstddef>
+
+#include "LeanDX12.h"
+
+// ------------------------------------------------------------ 1. Estruturas ------------------------------------------------------------- //
+
+// -------------------------------------------------------- 1.1. Estruturas opacas -------------------------------------------------------- //
+
+typedef struct IndirectArgumentBuilder IndirectArgumentBuilder;
+
+// ---------------------------------------------------- 1.2. Estruturas transparentes ----------------------------------------------------- //
+
+typedef struct DRAW_ARGUMENTS
+{
+	unsigned int vertexCountPerInstance;
+	unsigned int instanceCount;
+	unsigned int startVertexLocation;
+	unsigned int startInstanceLocation;
+} DRAW_ARGUMENTS;
+
+typedef struct DRAW_INDEXED_ARGUMENTS
+{
+	unsigned int indexCountPerInstance;
+	unsigned int instanceCount;
+	unsigned int startIndexLocation;
+	unsigned int baseVertexLocation;
+	unsigned int startInstanceLocation;
+} DRAW_INDEXED_ARGUMENTS;
+
+typedef struct INDIRECT_COMMAND_SIGNATURE_DESC
+{
+	BOOLEAN indexed;								// DRAW_INDEXED_ARGUMENTS (TRUE) ou DRAW_ARGUMENTS (FALSE).
+	BOOLEAN hasDescriptorTableOffset;
+	unsigned int shaderRegister;
+	unsigned int num32bitConstants;					// 0 = sem constantes.
+} INDIRECT_COMMAND_SIGNATURE_DESC;
+
+// ------------------------------------------------------ 2. Declaração das funções ------------------------------------------------------- //
+
+// Tamanho, em bytes, de um comando da assinatura.
+unsigned int GetIndirectCommandStride(const INDIRECT_COMMAND_SIGNATURE_DESC* signature);
+
+// Escreve o comando commandIndex em pArgumentData. pConstants é ignorado se a assinatura não possuir constantes, e pDrawArguments aponta
+// para DRAW_INDEXED_ARGUMENTS ou DRAW_ARGUMENTS, conforme a assinatura.
+LeanDX12Result WriteIndirectCommand(const INDIRECT_COMMAND_SIGNATURE_DESC* signature, void* pArgumentData, unsigned int commandIndex, unsigned int descriptorTableOffset, const void* pConstants, const void* pDrawArguments);
+
+LeanDX12Result CreateIndirectArgumentBuilder(const INDIRECT_COMMAND_SIGNATURE_DESC* signature, IndirectArgumentBuilder** builder);
+void DeleteIndirectArgumentBuilder(IndirectArgumentBuilder* builder);
+// Descarta os comandos, preservando a memória alocada.
+void ResetIndirectArgumentBuilder(IndirectArgumentBuilder* builder);
+LeanDX12Result AppendIndirectCommand(IndirectArgumentBuilder* builder, unsigned int descriptorTableOffset, const void* pConstants, const void* pDrawArguments);
+// Ponteiro para o vetor de argumentos (válido até a próxima adição de comandos) e número de comandos.
+void GetIndirectArguments(IndirectArgumentBuilder* builder, const void** pArgumentData, unsigned int* commandCount);
+
+// Emite min(maxCommandCount, *pCount) comandos (maxCommandCount se pCount for NULL) na cena atual, um a um, pela CPU (ver a nota acima).
+// Como no Direct3D 12, um contador maior que maxCommandCount não é um erro: os comandos além de maxCommandCount não são lidos.
+// Os deslocamentos de tabela de descritores e as constantes só são enviados quando forem diferentes dos do comando anterior.
+LeanDX12Result ExecuteIndirect(const INDIRECT_COMMAND_SIGNATURE_DESC* signature, unsigned int maxCommandCount, const void* pArgumentData, const unsigned int* pCount = NULL);
+
+#endif  // _LEANDX12_INDIRECT_
@@ -0,0 +1,130 @@
+// Descrição: Implementação das transformações por instância das extensões LeanDX12 (LeanDX12Instancing.h).
+
+#include <cmath>
+#include <cstring>
+#include <vector>
+
+#include "LeanDX12Instancing.h"
+
+struct InstanceBuffer
+{
+	std::vector<INSTANCE_TRANSFORM> transforms;
+	unsigned int numInstances = 0;
+};
+
+void ComposeInstanceTransform(const float position[3], const float rotation[3], const float scale[3], INSTANCE_TRANSFORM* transform)
+{
+	if (transform == nullptr)
+		return;
+
+	const float degreesToRadians = 3.14159265358979f / 180.0f;
+	float pitch = rotation != nullptr ? rotation[0] * degreesToRadians : 0.0f;
+	float yaw = rotation != nullptr ? rotation[1] * degreesToRadians : 0.0f;
+	float roll = rotation != nullptr ? rotation[2] * degreesToRadians : 0.0f;
+
+	float cp = cosf(pitch), sp = sinf(pitch);
+	float cy = cosf(yaw), sy = sinf(yaw);
+	float cr = cosf(roll), sr = sinf(roll);
+
+	// R = Ry * Rx * Rz: roll, em seguida pitch e, por último, yaw.
+	float rotationMatrix[3][3] =
+	{
+		{ cy * cr + sy * sp * sr, sy * sp * cr - cy * sr, sy * cp },
+		{ cp * sr, cp * cr, -sp },
+		{ cy * sp * sr - sy * cr, sy * sr + cy * sp * cr, cy * cp }
+	};
+
+	for (int row = 0; row < 3; row++)
+	{
+		for (int column = 0; column < 3; column++)
+			transform->rows[row][column] = rotationMatrix[row][column] * (scale != nullptr ? scale[column] : 1.0f);
+
+		transform->rows[row][3] = position != nullptr ? position[row] : 0.0f;
+	}
+}
+
+void GetInstanceTransformInputElements(const char* semanticName, INPUT_ELEMENT_DESC elements[3])
+{
+	if (elements == nullptr)
+		return;
+
+	for (unsigned int i = 0; i < 3; i++)
+	{
+		memset(&elements[i], 0, sizeof(INPUT_ELEMENT_DESC));
+		elements[i].SemanticName = semanticName;
+		elements[i].SemanticIndex = i;
+		elements[i].Format = RESOURCE_FORMAT_R32G32B32A32_FLOAT;
+		elements[i].InstanceDataStepRate = 1;
+	}
+}
+
+LeanDX12Result CreateInstanceBuffer(unsigned int maxInstances, InstanceBuffer** instanceBuffer)
+{
+	// SetInstanceData recebe o tamanho em bytes como unsigned int.
+	if (instanceBuffer == nullptr || maxInstances == 0 || (unsigned long long)maxInstances * sizeof(INSTANCE_TRANSFORM) > 0xFFFFFFFFull)
+		return LEANDX12_ERROR_INVALID_CALL;
+
+	InstanceBuffer* newBuffer = new InstanceBuffer;
+	newBuffer->transforms.resize(maxInstances);
+
+	*instanceBuffer = newBuffer;
+	return LEANDX12_OK;
+}
+
+void DeleteInstanceBuffer(InstanceBuffer* instanceBuffer)
+{
+	delete instanceBuffer;
+}
+
+void ResetInstanceBuffer(InstanceBuffer* instanceBuffer)
+{
+	if (instanceBuffer != nullptr)
+		instanceBuffer->numInstances = 0;
+}
+
+INSTANCE_TRANSFORM* AllocateInstances(InstanceBuffer* instanceBuffer, unsigned int numInstances, unsigned int* firstInstance)
+{
+	if (instanceBuffer == nullptr || numInstances > instanceBuffer->transforms.size() - instanceBuffer->numInstances)
+		return nullptr;
+
+	unsigned int first = instanceBuffer->numInstances;
+	instanceBuffer->numInstances += numInstances;
+
+	if (firstInstance != nullptr)
+		*firstInstance = first;
+
+	// Aritmética sobre data(): com numInstances = 0 e o buffer cheio, first é igual ao tamanho do vetor e não pode ser indexado.
+	return instanceBuffer->transforms.data() + first;
+}
+
+LeanDX12Result AddInstances(InstanceBuffer* instanceBuffer, unsigned int numInstances, const INSTANCE_TRANSFORM* transforms, unsigned int* firstInstance)
+{
+	if (instanceBuffer == nullptr || (numInstances > 0 && transforms == nullptr))
+		return LEANDX12_ERROR_INVALID_CALL;
+
+	INSTANCE_TRANSFORM* destination = AllocateInstances(instanceBuffer, numInstances, firstInstance);
+	if (destination == nullptr)
+		return LEANDX12_ERROR_INSUFFICIENT_BUFFER_SIZE;
+
+	memcpy(destination, transforms, numInstances * sizeof(INSTANCE_TRANSFORM));
+	return LEANDX12_OK;
+}
+
+unsigned int GetInstanceCount(InstanceBuffer* instanceBuffer)
+{
+	return instanceBuffer != nullptr ? instanceBuffer->numInstances : 0;
+}
+
+const INSTANCE_TRANSFORM* GetInstanceData(InstanceBuffer* instanceBuffer)
+{
+	return instanceBuffer != nullptr ? instanceBuffer->transforms.data() : nullptr;
+}
+
+LeanDX12Result BindInstanceBuffer(InstanceBuffer* instanceBuffer)
+{
+	if (instanceBuffer == nullptr || instanceBuffer->numInstances == 0)
+		return LEANDX12_ERROR_INVALID_CALL;
+
+	return SetInstanceData(instanceBuffer->transforms.data(), instanceBuffer->numInstances * sizeof(INSTANCE_TRANSFORM),
+		sizeof(INSTANCE_TRANSFORM), 1);
+}
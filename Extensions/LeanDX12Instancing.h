@@ -0,0 +1,65 @@
+/*
+* LeanDX12 - Transformações por instância
+* Descrição: Envio das transformações das instâncias como dados de instância (SetInstanceData), permitindo desenhar N instâncias de
+* uma malha com um único desenho (instanceCount = N), sem um buffer de constantes e um descritor por instância.
+*
+*	Cada transformação é uma matriz 3x4 (INSTANCE_TRANSFORM, 48 bytes) em ordem de linhas, aplicada a vetores coluna:
+*	p' = M * (x, y, z, 1). As linhas são lidas pelo shader como três elementos float4 consecutivos (GetInstanceTransformInputElements):
+*
+*		float4 p = float4(input.position, 1.0f);
+*		float3 world = float3(dot(input.world0, p), dot(input.world1, p), dot(input.world2, p));
+*
+*	As transformações do quadro são acumuladas em um InstanceBuffer (AddInstances ou, sem cópia, AllocateInstances), enviadas uma única
+*	vez por cena (BindInstanceBuffer) e desenhadas a partir da primeira instância de cada grupo (por exemplo, DrawMesh de
+*	LeanDX12Geometry.h com startInstanceLocation = firstInstance). A capacidade é definida na criação e a memória nunca é realocada.
+*
+*   Organização do arquivo de cabeçalho:
+*	1.	Estruturas
+*		•	Estruturas opacas
+*		•	Estruturas transparentes
+*	2.	Declaração das funções
+*/
+
+#ifndef _LEANDX12_INSTANCING_
+#define _LEANDX12_INSTANCING_
+
+#include <cstddef>
+
+#include "LeanDX12.h"
+
+// ------------------------------------------------------------ 1. Estruturas ------------------------------------------------------------- //
+
+// -------------------------------------------------------- 1.1. Estruturas opacas -------------------------------------------------------- //
+
+typedef struct InstanceBuffer InstanceBuffer;
+
+// ---------------------------------------------------- 1.2. Estruturas transparentes ----------------------------------------------------- //
+
+typedef struct INSTANCE_TRANSFORM
+{
+	float rows[3][4];
+} INSTANCE_TRANSFORM;
+
+// ------------------------------------------------------ 2. Declaração das funções ------------------------------------------------------- //
+
+// Compõe escala, rotação (pitch, yaw e roll em graus, na convenção de XMMatrixRotationRollPitchYaw) e translação. scale pode ser NULL.
+void ComposeInstanceTransform(const float position[3], const float rotation[3], const float scale[3], INSTANCE_TRANSFORM* transform);
+// Preenche os três elementos (semanticName, índices 0 a 2, RESOURCE_FORMAT_R32G32B32A32_FLOAT) a serem adicionados aos elementos de
+// instância do layout de entrada.
+void GetInstanceTransformInputElements(const char* semanticName, INPUT_ELEMENT_DESC elements[3]);
+
+LeanDX12Result CreateInstanceBuffer(unsigned int maxInstances, InstanceBuffer** instanceBuffer);
+void DeleteInstanceBuffer(InstanceBuffer* instanceBuffer);
+// Descarta as instâncias, preservando a memória alocada.
+void ResetInstanceBuffer(InstanceBuffer* instanceBuffer);
+LeanDX12Result AddInstances(InstanceBuffer* instanceBuffer, unsigned int numInstances, const INSTANCE_TRANSFORM* transforms, unsigned int* firstInstance);
+// Reserva numInstances transformações, a serem preenchidas pela aplicação, e retorna o ponteiro para a primeira delas (NULL se não houver
+// espaço). Com numInstances = 0, o ponteiro retornado não deve ser acessado.
+INSTANCE_TRANSFORM* AllocateInstances(InstanceBuffer* instanceBuffer, unsigned int numInstances, unsigned int* firstInstance);
+unsigned int GetInstanceCount(InstanceBuffer* instanceBuffer);
+const INSTANCE_TRANSFORM* GetInstanceData(InstanceBuffer* instanceBuffer);
+
+// Envia todas as transformações para a cena atual (SetInstanceData com taxa de 1 instância).
+LeanDX12Result BindInstanceBuffer(InstanceBuffer* instanceBuffer);
+
+#endif  // _LEANDX12_INSTANCING_
@@ -0,0 +1,524 @@
+// Descrição: Implementação do descarte por oclusão das extensões LeanDX12 (LeanDX12Occlusion.h).
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <vector>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define LEANDX12_SSE2
+#include <emmintrin.h>
+#endif
+
+#include "LeanDX12Occlusion.h"
+#include "LeanDX12Parallel.h"
+
+// Dimensões dos blocos da tela rasterizados em paralelo e dos grupos de pixels da hierarquia de profundidade.
+#define OCCLUSION_TILE_WIDTH 32
+#define OCCLUSION_TILE_HEIGHT 16
+#define OCCLUSION_BLOCK_WIDTH 8
+#define OCCLUSION_BLOCK_HEIGHT 4
+// Os triângulos são recortados em |x|, |y| <= OCCLUSION_GUARD_BAND * w, limitando as coordenadas de tela usadas na rasterização.
+#define OCCLUSION_GUARD_BAND 2.0f
+// Quantidade mínima de objetos por bloco de trabalho de ParallelFor.
+#define OCCLUSION_OBJECTS_PER_TASK 256
+
+namespace
+{
+	// Triângulo preparado para a rasterização: funções de aresta (A * x + B * y + C >= 0 no interior), plano de profundidade e
+	// retângulo de pixels (inclusivo).
+	typedef struct OCCLUDER_TRIANGLE
+	{
+		float edgeA[3], edgeB[3], edgeC[3];
+		float depthA, depthB, depthC;
+		int minX, minY, maxX, maxY;
+	} OCCLUDER_TRIANGLE;
+
+	typedef struct CLIP_VERTEX
+	{
+		float x, y, z, w;
+	} CLIP_VERTEX;
+
+	CLIP_VERTEX TransformPosition(const float matrix[4][4], const float position[3])
+	{
+		CLIP_VERTEX vertex;
+		vertex.x = position[0] * matrix[0][0] + position[1] * matrix[1][0] + position[2] * matrix[2][0] + matrix[3][0];
+		vertex.y = position[0] * matrix[0][1] + position[1] * matrix[1][1] + position[2] * matrix[2][1] + matrix[3][1];
+		vertex.z = position[0] * matrix[0][2] + position[1] * matrix[1][2] + position[2] * matrix[2][2] + matrix[3][2];
+		vertex.w = position[0] * matrix[0][3] + position[1] * matrix[1][3] + position[2] * matrix[2][3] + matrix[3][3];
+		return vertex;
+	}
+
+	// Distância (com sinal) do vértice aos planos de recorte: próximo (z >= 0) e banda de guarda.
+	float ClipDistance(const CLIP_VERTEX& vertex, int plane)
+	{
+		switch (plane)
+		{
+		case 0: return vertex.z;
+		case 1: return OCCLUSION_GUARD_BAND * vertex.w - vertex.x;
+		case 2: return OCCLUSION_GUARD_BAND * vertex.w + vertex.x;
+		case 3: return OCCLUSION_GUARD_BAND * vertex.w - vertex.y;
+		default: return OCCLUSION_GUARD_BAND * vertex.w + vertex.y;
+		}
+	}
+
+	// Recorta o polígono (Sutherland-Hodgman) contra os cinco planos. Cada plano adiciona no máximo um vértice.
+	unsigned int ClipPolygon(CLIP_VERTEX* vertices, unsigned int numVertices)
+	{
+		CLIP_VERTEX clipped[8];
+
+		for (int plane = 0; plane < 5 && numVertices >= 3; plane++)
+		{
+			unsigned int numClipped = 0;
+			for (unsigned int i = 0; i < numVertices; i++)
+			{
+				const CLIP_VERTEX& current = vertices[i];
+				const CLIP_VERTEX& next = vertices[(i + 1) % numVertices];
+				float currentDistance = ClipDistance(current, plane);
+				float nextDistance = ClipDistance(next, plane);
+
+				if (currentDistance >= 0.0f)
+					clipped[numClipped++] = current;
+
+				if ((currentDistance >= 0.0f) != (nextDistance >= 0.0f))
+				{
+					float t = currentDistance / (currentDistance - nextDistance);
+					CLIP_VERTEX intersection;
+					intersection.x = current.x + t * (next.x - current.x);
+					intersection.y = current.y + t * (next.y - current.y);
+					intersection.z = current.z + t * (next.z - current.z);
+					intersection.w = current.w + t * (next.w - current.w);
+					clipped[numClipped++] = intersection;
+				}
+			}
+
+			memcpy(vertices, clipped, numClipped * sizeof(CLIP_VERTEX));
+			numVertices = numClipped;
+		}
+
+		return numVertices >= 3 ? numVertices : 0;
+	}
+}
+
+struct OcclusionBuffer
+{
+	unsigned int width = 0, height = 0;
+	unsigned int numTilesX = 0, numTilesY = 0;
+	unsigned int numBlocksX = 0, numBlocksY = 0;
+	std::vector<float> depth;
+	std::vector<float> blockMaxDepth;
+	std::vector<OCCLUDER_TRIANGLE> triangles;
+	std::vector<std::vector<unsigned int>> tileTriangles;
+	std::vector<unsigned char> objectResults;
+	OCCLUSION_STATS stats = {};
+};
+
+namespace
+{
+	// Prepara e distribui entre os blocos da tela um triângulo em coordenadas de tela (x, y em pixels e z em profundidade).
+	void AddTriangle(OcclusionBuffer* occlusionBuffer, const float x[3], const float y[3], const float z[3])
+	{
+		float area = (x[1] - x[0]) * (y[2] - y[0]) - (x[2] - x[0]) * (y[1] - y[0]);
+		if (!(fabsf(area) > 1e-8f))
+			return;
+
+		// Apenas os pixels cujos centros (i + 0.5) estão dentro do retângulo do triângulo podem ser cobertos.
+		int minX = std::max(0, (int)ceilf(std::min(x[0], std::min(x[1], x[2])) - 0.5f));
+		int minY = std::max(0, (int)ceilf(std::min(y[0], std::min(y[1], y[2])) - 0.5f));
+		int maxX = std::min((int)occlusionBuffer->width - 1, (int)floorf(std::max(x[0], std::max(x[1], x[2])) - 0.5f));
+		int maxY = std::min((int)occlusionBuffer->height - 1, (int)floorf(std::max(y[0], std::max(y[1], y[2])) - 0.5f));
+		if (minX > maxX || minY > maxY)
+			return;
+
+		OCCLUDER_TRIANGLE triangle;
+		float orientation = area > 0.0f ? 1.0f : -1.0f;
+		for (int edge = 0; edge < 3; edge++)
+		{
+			int next = (edge + 1) % 3;
+			triangle.edgeA[edge] = orientation * (y[edge] - y[next]);
+			triangle.edgeB[edge] = orientation * (x[next] - x[edge]);
+			triangle.edgeC[edge] = orientation * (x[edge] * y[next] - x[next] * y[edge]);
+		}
+
+		triangle.depthA = ((z[1] - z[0]) * (y[2] - y[0]) - (z[2] - z[0]) * (y[1] - y[0])) / area;
+		triangle.depthB = ((z[2] - z[0]) * (x[1] - x[0]) - (z[1] - z[0]) * (x[2] - x[0])) / area;
+		triangle.depthC = z[0] - triangle.depthA * x[0] - triangle.depthB * y[0];
+		triangle.minX = minX;
+		triangle.minY = minY;
+		triangle.maxX = maxX;
+		triangle.maxY = maxY;
+
+		unsigned int triangleIndex = (unsigned int)occlusionBuffer->triangles.size();
+		occlusionBuffer->triangles.push_back(triangle);
+		occlusionBuffer->stats.numOccluderTriangles++;
+
+		for (int tileY = minY / OCCLUSION_TILE_HEIGHT; tileY <= maxY / OCCLUSION_TILE_HEIGHT; tileY++)
+		{
+			for (int tileX = minX / OCCLUSION_TILE_WIDTH; tileX <= maxX / OCCLUSION_TILE_WIDTH; tileX++)
+			{
+				occlusionBuffer->tileTriangles[tileY * occlusionBuffer->numTilesX + tileX].push_back(triangleIndex);
+				occlusionBuffer->stats.numBinnedTriangles++;
+			}
+		}
+	}
+
+	// Rasteriza as linhas [minY, maxY] e colunas [minX, maxX] do triângulo, com minX múltiplo de 4 e maxX dentro do mesmo bloco da tela.
+	void RasterizeTriangle(OcclusionBuffer* occlusionBuffer, const OCCLUDER_TRIANGLE& triangle, int minX, int minY, int maxX, int maxY)
+	{
+		for (int y = minY; y <= maxY; y++)
+		{
+			float pixelY = (float)y + 0.5f;
+			float rowEdge0 = triangle.edgeB[0] * pixelY + triangle.edgeC[0];
+			float rowEdge1 = triangle.edgeB[1] * pixelY + triangle.edgeC[1];
+			float rowEdge2 = triangle.edgeB[2] * pixelY + triangle.edgeC[2];
+			float rowDepth = triangle.depthB * pixelY + triangle.depthC;
+			float* pRow = &occlusionBuffer->depth[(size_t)y * occlusionBuffer->width];
+
+#if defined(LEANDX12_SSE2)
+			const __m128 zero = _mm_setzero_ps();
+			const __m128 pixelOffsets = _mm_setr_ps(0.5f, 1.5f, 2.5f, 3.5f);
+
+			for (int x = minX; x <= maxX; x += 4)
+			{
+				__m128 pixelX = _mm_add_ps(_mm_set1_ps((float)x), pixelOffsets);
+				__m128 edge0 = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(triangle.edgeA[0]), pixelX), _mm_set1_ps(rowEdge0));
+				__m128 edge1 = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(triangle.edgeA[1]), pixelX), _mm_set1_ps(rowEdge1));
+				__m128 edge2 = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(triangle.edgeA[2]), pixelX), _mm_set1_ps(rowEdge2));
+				__m128 inside = _mm_and_ps(_mm_and_ps(_mm_cmpge_ps(edge0, zero), _mm_cmpge_ps(edge1, zero)), _mm_cmpge_ps(edge2, zero));
+				if (_mm_movemask_ps(inside) == 0)
+					continue;
+
+				__m128 depth = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(triangle.depthA), pixelX), _mm_set1_ps(rowDepth));
+				__m128 current = _mm_loadu_ps(pRow + x);
+				__m128 nearest = _mm_min_ps(current, depth);
+				_mm_storeu_ps(pRow + x, _mm_or_ps(_mm_and_ps(inside, nearest), _mm_andnot_ps(inside, current)));
+			}
+#else
+			for (int x = minX; x <= maxX; x++)
+			{
+				float pixelX = (float)x + 0.5f;
+				if (triangle.edgeA[0] * pixelX + rowEdge0 >= 0.0f && triangle.edgeA[1] * pixelX + rowEdge1 >= 0.0f &&
+					triangle.edgeA[2] * pixelX + rowEdge2 >= 0.0f)
+				{
+					float depth = triangle.depthA * pixelX + rowDepth;
+					if (depth < pRow[x])
+						pRow[x] = depth;
+				}
+			}
+#endif
+		}
+	}
+
+	void RasterizeTiles(unsigned int begin, unsigned int end, void* pUserData)
+	{
+		OcclusionBuffer* occlusionBuffer = (OcclusionBuffer*)pUserData;
+
+		for (unsigned int tile = begin; tile < end; tile++)
+		{
+			int tileMinX = (int)(tile % occlusionBuffer->numTilesX) * OCCLUSION_TILE_WIDTH;
+			int tileMinY = (int)(tile / occlusionBuffer->numTilesX) * OCCLUSION_TILE_HEIGHT;
+			int tileMaxX = std::min(tileMinX + OCCLUSION_TILE_WIDTH, (int)occlusionBuffer->width) - 1;
+			int tileMaxY = std::min(tileMinY + OCCLUSION_TILE_HEIGHT, (int)occlusionBuffer->height) - 1;
+
+			const std::vector<unsigned int>& triangles = occlusionBuffer->tileTriangles[tile];
+			for (size_t i = 0; i < triangles.size(); i++)
+			{
+				const OCCLUDER_TRIANGLE& triangle = occlusionBuffer->triangles[triangles[i]];
+				RasterizeTriangle(occlusionBuffer, triangle, std::max(triangle.minX, tileMinX) & ~3, std::max(triangle.minY, tileMinY),
+					std::min(triangle.maxX, tileMaxX), std::min(triangle.maxY, tileMaxY));
+			}
+
+			// Profundidade máxima dos grupos de pixels do bloco.
+			for (int blockY = tileMinY / OCCLUSION_BLOCK_HEIGHT; blockY <= tileMaxY / OCCLUSION_BLOCK_HEIGHT; blockY++)
+			{
+				for (int blockX = tileMinX / OCCLUSION_BLOCK_WIDTH; blockX <= tileMaxX / OCCLUSION_BLOCK_WIDTH; blockX++)
+				{
+					float maxDepth = 0.0f;
+					for (int y = blockY * OCCLUSION_BLOCK_HEIGHT; y < (blockY + 1) * OCCLUSION_BLOCK_HEIGHT; y++)
+						for (int x = blockX * OCCLUSION_BLOCK_WIDTH; x < (blockX + 1) * OCCLUSION_BLOCK_WIDTH; x++)
+							maxDepth = std::max(maxDepth, occlusionBuffer->depth[(size_t)y * occlusionBuffer->width + x]);
+
+					occlusionBuffer->blockMaxDepth[(size_t)blockY * occlusionBuffer->numBlocksX + blockX] = maxDepth;
+				}
+			}
+		}
+	}
+
+	// Retorna verdadeiro se a AABB puder estar visível. pixelTested indica se foram necessários testes por pixel.
+	bool TestBox(const OcclusionBuffer* occlusionBuffer, const float viewProjection[4][4], const float aabbMin[3], const float aabbMax[3], bool* pixelTested)
+	{
+		*pixelTested = false;
+
+		float minX = INFINITY, minY = INFINITY, maxX = -INFINITY, maxY = -INFINITY, minDepth = INFINITY;
+		for (int corner = 0; corner < 8; corner++)
+		{
+			const float position[3] =
+			{
+				(corner & 1) != 0 ? aabbMax[0] : aabbMin[0],
+				(corner & 2) != 0 ? aabbMax[1] : aabbMin[1],
+				(corner & 4) != 0 ? aabbMax[2] : aabbMin[2]
+			};
+
+			// Caixas que cruzam o plano próximo são consideradas visíveis.
+			CLIP_VERTEX vertex = TransformPosition(viewProjection, position);
+			if (!(vertex.z >= 0.0f) || !(vertex.w > 0.0f))
+				return true;
+
+			float inverseW = 1.0f / vertex.w;
+			float screenX = (vertex.x * inverseW * 0.5f + 0.5f) * occlusionBuffer->width;
+			float screenY = (0.5f - vertex.y * inverseW * 0.5f) * occlusionBuffer->height;
+			minX = std::min(minX, screenX);
+			maxX = std::max(maxX, screenX);
+			minY = std::min(minY, screenY);
+			maxY = std::max(maxY, screenY);
+			minDepth = std::min(minDepth, vertex.z * inverseW);
+		}
+
+		// Pixels tocados pelo retângulo projetado (e não apenas aqueles cujos centros estão dentro dele).
+		if (maxX <= 0.0f || maxY <= 0.0f || minX >= (float)occlusionBuffer->width || minY >= (float)occlusionBuffer->height)
+			return false;
+
+		int pixelMinX = std::max(0, (int)floorf(minX));
+		int pixelMinY = std::max(0, (int)floorf(minY));
+		int pixelMaxX = std::min((int)occlusionBuffer->width - 1, (int)ceilf(maxX) - 1);
+		int pixelMaxY = std::min((int)occlusionBuffer->height - 1, (int)ceilf(maxY) - 1);
+		pixelMaxX = std::max(pixelMaxX, pixelMinX);
+		pixelMaxY = std::max(pixelMaxY, pixelMinY);
+
+		for (int blockY = pixelMinY / OCCLUSION_BLOCK_HEIGHT; blockY <= pixelMaxY / OCCLUSION_BLOCK_HEIGHT; blockY++)
+		{
+			for (int blockX = pixelMinX / OCCLUSION_BLOCK_WIDTH; blockX <= pixelMaxX / OCCLUSION_BLOCK_WIDTH; blockX++)
+			{
+				if (minDepth > occlusionBuffer->blockMaxDepth[(size_t)blockY * occlusionBuffer->numBlocksX + blockX])
+					continue;
+
+				*pixelTested = true;
+
+				int y0 = std::max(pixelMinY, blockY * OCCLUSION_BLOCK_HEIGHT);
+				int y1 = std::min(pixelMaxY, blockY * OCCLUSION_BLOCK_HEIGHT + OCCLUSION_BLOCK_HEIGHT - 1);
+				int x0 = std::max(pixelMinX, blockX * OCCLUSION_BLOCK_WIDTH);
+				int x1 = std::min(pixelMaxX, blockX * OCCLUSION_BLOCK_WIDTH + OCCLUSION_BLOCK_WIDTH - 1);
+
+				for (int y = y0; y <= y1; y++)
+				{
+					const float* pRow = &occlusionBuffer->depth[(size_t)y * occlusionBuffer->width];
+					for (int x = x0; x <= x1; x++)
+						if (minDepth <= pRow[x])
+							return true;
+				}
+			}
+		}
+
+		return false;
+	}
+
+	typedef struct OCCLUSION_TEST_JOB
+	{
+		OcclusionBuffer* occlusionBuffer;
+		const float (*viewProjection)[4];
+		const CULLING_BOUNDS* bounds;
+		const unsigned int* objectIndices;
+	} OCCLUSION_TEST_JOB;
+
+	// Resultado por objeto: bit 0 = visível, bit 1 = testado por pixel.
+	void TestObjects(unsigned int begin, unsigned int end, void* pUserData)
+	{
+		const OCCLUSION_TEST_JOB* job = (const OCCLUSION_TEST_JOB*)pUserData;
+
+		for (unsigned int i = begin; i < end; i++)
+		{
+			const CULLING_BOUNDS& bounds = job->bounds[job->objectIndices[i]];
+			bool pixelTested;
+			bool visible = TestBox(job->occlusionBuffer, job->viewProjection, bounds.aabbMin, bounds.aabbMax, &pixelTested);
+			job->occlusionBuffer->objectResults[i] = (unsigned char)((visible ? 1 : 0) | (pixelTested ? 2 : 0));
+		}
+	}
+}
+
+LeanDX12Result CreateOcclusionBuffer(unsigned int width, unsigned int height, OcclusionBuffer** occlusionBuffer)
+{
+	if (occlusionBuffer == nullptr || width == 0 || height == 0 || width % OCCLUSION_BLOCK_WIDTH != 0 ||
+		height % OCCLUSION_BLOCK_HEIGHT != 0 || width > 0x4000 || height > 0x4000)
+		return LEANDX12_ERROR_INVALID_CALL;
+
+	OcclusionBuffer* newBuffer = new OcclusionBuffer;
+	newBuffer->width = width;
+	newBuffer->height = height;
+	newBuffer->numTilesX = (width + OCCLUSION_TILE_WIDTH - 1) / OCCLUSION_TILE_WIDTH;
+	newBuffer->numTilesY = (height + OCCLUSION_TILE_HEIGHT - 1) / OCCLUSION_TILE_HEIGHT;
+	newBuffer->numBlocksX = width / OCCLUSION_BLOCK_WIDTH;
+	newBuffer->numBlocksY = height / OCCLUSION_BLOCK_HEIGHT;
+	newBuffer->depth.resize((size_t)width * height);
+	newBuffer->blockMaxDepth.resize((size_t)newBuffer->numBlocksX * newBuffer->numBlocksY);
+	newBuffer->tileTriangles.resize((size_t)newBuffer->numTilesX * newBuffer->numTilesY);
+	ClearOcclusionBuffer(newBuffer);
+
+	*occlusionBuffer = newBuffer;
+	return LEANDX12_OK;
+}
+
+void DeleteOcclusionBuffer(OcclusionBuffer* occlusionBuffer)
+{
+	delete occlusionBuffer;
+}
+
+void ClearOcclusionBuffer(OcclusionBuffer* occlusionBuffer)
+{
+	if (occlusionBuffer == nullptr)
+		return;
+
+	std::fill(occlusionBuffer->depth.begin(), occlusionBuffer->depth.end(), 1.0f);
+	std::fill(occlusionBuffer->blockMaxDepth.begin(), occlusionBuffer->blockMaxDepth.end(), 1.0f);
+	occlusionBuffer->triangles.clear();
+	for (size_t i = 0; i < occlusionBuffer->tileTriangles.size(); i++)
+		occlusionBuffer->tileTriangles[i].clear();
+
+	occlusionBuffer->stats = OCCLUSION_STATS();
+}
+
+LeanDX12Result AddOccluder(OcclusionBuffer* occlusionBuffer, const float worldViewProjection[4][4], unsigned int numPositions, const void* pPositions, unsigned int stride, unsigned int numIndices, const unsigned int* pIndices)
+{
+	if (occlusionBuffer == nullptr || worldViewProjection == nullptr || (numPositions > 0 && pPositions == nullptr))
+		return LEANDX12_ERROR_INVALID_CALL;
+
+	unsigned int numTriangleVertices = pIndices != nullptr ? numIndices : numPositions;
+	if (numTriangleVertices % 3 != 0)
+		return LEANDX12_ERROR_INVALID_CALL;
+
+	if (pIndices != nullptr)
+		for (unsigned int i = 0; i < numIndices; i++)
+			if (pIndices[i] >= numPositions)
+				return LEANDX12_ERROR_OFFSET_OUT_OF_RANGE;
+
+	if (stride == 0)
+		stride = 3 * sizeof(float);
+
+	const unsigned char* pData = (const unsigned char*)pPositions;
+	occlusionBuffer->stats.numOccluders++;
+
+	for (unsigned int i = 0; i < numTriangleVertices; i += 3)
+	{
+		CLIP_VERTEX vertices[8];
+		bool inside = true;
+
+		for (unsigned int corner = 0; corner < 3; corner++)
+		{
+			unsigned int index = pIndices != nullptr ? pIndices[i + corner] : i + corner;
+			float position[3];
+			memcpy(position, pData + (size_t)index * stride, sizeof(position));
+			vertices[corner] = TransformPosition(worldViewProjection, position);
+		}
+
+		// Triângulos inteiramente fora de um dos planos são descartados; os demais só são recortados se cruzarem algum plano.
+		bool outside = false;
+		for (int plane = 0; plane < 5 && !outside; plane++)
+		{
+			int numOutside = 0;
+			for (int corner = 0; corner < 3; corner++)
+				if (!(ClipDistance(vertices[corner], plane) >= 0.0f))
+					numOutside++;
+
+			outside = numOutside == 3;
+			inside = inside && numOutside == 0;
+		}
+
+		if (outside)
+			continue;
+
+		unsigned int numVertices = inside ? 3 : ClipPolygon(vertices, 3);
+
+		float screenX[8], screenY[8], screenDepth[8];
+		for (unsigned int vertex = 0; vertex < numVertices; vertex++)
+		{
+			float inverseW = 1.0f / vertices[vertex].w;
+			screenX[vertex] = (vertices[vertex].x * inverseW * 0.5f + 0.5f) * occlusionBuffer->width;
+			screenY[vertex] = (0.5f - vertices[vertex].y * inverseW * 0.5f) * occlusionBuffer->height;
+			screenDepth[vertex] = vertices[vertex].z * inverseW;
+		}
+
+		for (unsigned int vertex = 1; vertex + 1 < numVertices; vertex++)
+		{
+			const float x[3] = { screenX[0], screenX[vertex], screenX[vertex + 1] };
+			const float y[3] = { screenY[0], screenY[vertex], screenY[vertex + 1] };
+			const float z[3] = { screenDepth[0], screenDepth[vertex], screenDepth[vertex + 1] };
+			AddTriangle(occlusionBuffer, x, y, z);
+		}
+	}
+
+	return LEANDX12_OK;
+}
+
+LeanDX12Result RasterizeOccluders(OcclusionBuffer* occlusionBuffer)
+{
+	if (occlusionBuffer == nullptr)
+		return LEANDX12_ERROR_INVALID_CALL;
+
+	ParallelFor((unsigned int)occlusionBuffer->tileTriangles.size(), 1, RasterizeTiles, occlusionBuffer);
+
+	occlusionBuffer->triangles.clear();
+	for (size_t i = 0; i < occlusionBuffer->tileTriangles.size(); i++)
+		occlusionBuffer->tileTriangles[i].clear();
+
+	return LEANDX12_OK;
+}
+
+BOOLEAN TestOcclusionBox(OcclusionBuffer* occlusionBuffer, const float viewProjection[4][4], const float aabbMin[3], const float aabbMax[3])
+{
+	if (occlusionBuffer == nullptr || viewProjection == nullptr || aabbMin == nullptr || aabbMax == nullptr)
+		return 1;
+
+	bool pixelTested;
+	return TestBox(occlusionBuffer, viewProjection, aabbMin, aabbMax, &pixelTested) ? 1 : 0;
+}
+
+LeanDX12Result CullOccludedObjects(OcclusionBuffer* occlusionBuffer, const float viewProjection[4][4], const CULLING_BOUNDS* bounds, unsigned int numObjects, const unsigned int* objectIndices, unsigned int* visibleObjects, unsigned int* numVisibleObjects)
+{
+	if (occlusionBuffer == nullptr || viewProjection == nullptr || numVisibleObjects == nullptr ||
+		(numObjects > 0 && (bounds == nullptr || objectIndices == nullptr || visibleObjects == nullptr)))
+		return LEANDX12_ERROR_INVALID_CALL;
+
+	occlusionBuffer->objectResults.resize(numObjects);
+
+	OCCLUSION_TEST_JOB job;
+	job.occlusionBuffer = occlusionBuffer;
+	job.viewProjection = viewProjection;
+	job.bounds = bounds;
+	job.objectIndices = objectIndices;
+	ParallelFor(numObjects, OCCLUSION_OBJECTS_PER_TASK, TestObjects, &job);
+
+	// A compactação é feita na thread chamadora, o que permite visibleObjects == objectIndices.
+	unsigned int numVisible = 0;
+	unsigned int numPixelTests = 0;
+	for (unsigned int i = 0; i < numObjects; i++)
+	{
+		unsigned char result = occlusionBuffer->objectResults[i];
+		if ((result & 1) != 0)
+			visibleObjects[numVisible++] = objectIndices[i];
+		if ((result & 2) != 0)
+			numPixelTests++;
+	}
+
+	occlusionBuffer->stats.numObjectsTested = numObjects;
+	occlusionBuffer->stats.numObjectsOccluded = numObjects - numVisible;
+	occlusionBuffer->stats.numPixelTests = numPixelTests;
+
+	*numVisibleObjects = numVisible;
+	return LEANDX12_OK;
+}
+
+LeanDX12Result GetOcclusionDepth(OcclusionBuffer* occlusionBuffer, float* pDepth)
+{
+	if (occlusionBuffer == nullptr || pDepth == nullptr)
+		return LEANDX12_ERROR_INVALID_CALL;
+
+	memcpy(pDepth, occlusionBuffer->depth.data(), occlusionBuffer->depth.size() * sizeof(float));
+	return LEANDX12_OK;
+}
+
+void GetOcclusionStats(OcclusionBuffer* occlusionBuffer, OCCLUSION_STATS* stats)
+{
+	if (occlusionBuffer == nullptr || stats == nullptr)
+		return;
+
+	*stats = occlusionBuffer->stats;
+}
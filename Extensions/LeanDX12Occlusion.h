@@ -0,0 +1,81 @@
+/*
+* LeanDX12 - Descarte por oclusão
+* Descrição: Descarte dos objetos escondidos por outros objetos, por meio de um buffer de profundidade de baixa resolução preenchido na
+* CPU. Um pequeno conjunto de malhas oclusoras (paredes, pisos, objetos grandes) é rasterizado no buffer e as AABBs dos objetos são
+* testadas contra ele antes da montagem da lista de desenhos.
+*
+*	Etapas de um quadro:
+*		1.	ClearOcclusionBuffer;
+*		2.	AddOccluder para cada malha oclusora: os triângulos são transformados, recortados (plano próximo e banda de guarda) e
+*			distribuídos entre os blocos da tela aos quais pertencem;
+*		3.	RasterizeOccluders: os blocos da tela são rasterizados em paralelo pelas threads de LeanDX12Parallel.h (SSE2, quando
+*			disponível), cada um apenas com os seus triângulos. Ao final, a profundidade máxima de cada grupo de 8x4 pixels é registrada
+*			(hierarquia de profundidade);
+*		4.	TestOcclusionBox ou CullOccludedObjects (em paralelo): a AABB projetada do objeto é comparada primeiro com a profundidade
+*			máxima dos grupos e, apenas quando necessário, com os pixels.
+*
+*	A profundidade segue a convenção do Direct3D (0 no plano próximo, 1 no distante) e as matrizes seguem a convenção do DirectXMath
+*	(vetores linha, p' = p * M, armazenadas por linhas como em XMFLOAT4X4), como em LeanDX12Culling.h. O teste é conservador para objetos
+*	que cruzam o plano próximo (considerados visíveis); a precisão dos contornos é limitada à resolução do buffer.
+*
+*	As funções de um mesmo OcclusionBuffer não devem ser chamadas por várias threads ao mesmo tempo, com exceção de TestOcclusionBox, que
+*	pode ser chamada de qualquer thread após RasterizeOccluders.
+*
+*   Organização do arquivo de cabeçalho:
+*	1.	Estruturas
+*		•	Estruturas opacas
+*		•	Estruturas transparentes
+*	2.	Declaração das funções
+*/
+
+#ifndef _LEANDX12_OCCLUSION_
+#define _LEANDX12_OCCLUSION_
+
+#include <cstddef>
+
+#include "LeanDX12.h"
+#include "LeanDX12Culling.h"
+
+// ------------------------------------------------------------ 1. Estruturas ------------------------------------------------------------- //
+
+// -------------------------------------------------------- 1.1. Estruturas opacas -------------------------------------------------------- //
+
+typedef struct OcclusionBuffer OcclusionBuffer;
+
+// ---------------------------------------------------- 1.2. Estruturas transparentes ----------------------------------------------------- //
+
+typedef struct OCCLUSION_STATS
+{
+	unsigned int numOccluders;
+	unsigned int numOccluderTriangles;				// Triângulos após o recorte e o descarte dos triângulos fora da tela.
+	unsigned int numBinnedTriangles;				// Soma dos triângulos de todos os blocos da tela.
+	unsigned int numObjectsTested;
+	unsigned int numObjectsOccluded;
+	unsigned int numPixelTests;						// Objetos que precisaram de testes por pixel após a hierarquia.
+} OCCLUSION_STATS;
+
+// ------------------------------------------------------ 2. Declaração das funções ------------------------------------------------------- //
+
+// width deve ser múltiplo de 8 e height múltiplo de 4 (por exemplo, 320 x 180 para uma tela 16:9).
+LeanDX12Result CreateOcclusionBuffer(unsigned int width, unsigned int height, OcclusionBuffer** occlusionBuffer);
+void DeleteOcclusionBuffer(OcclusionBuffer* occlusionBuffer);
+
+// Preenche a profundidade com 1 e descarta os oclusores adicionados.
+void ClearOcclusionBuffer(OcclusionBuffer* occlusionBuffer);
+// Adiciona uma malha oclusora formada por numIndices / 3 triângulos (pIndices = NULL: numPositions / 3 triângulos não indexados). As
+// posições (x, y, z em float) estão separadas por stride bytes e são transformadas por worldViewProjection. Ambas as faces dos
+// triângulos são rasterizadas.
+LeanDX12Result AddOccluder(OcclusionBuffer* occlusionBuffer, const float worldViewProjection[4][4], unsigned int numPositions, const void* pPositions, unsigned int stride, unsigned int numIndices, const unsigned int* pIndices);
+LeanDX12Result RasterizeOccluders(OcclusionBuffer* occlusionBuffer);
+
+// Retorna verdadeiro se alguma parte da AABB (em coordenadas do mundo) dentro da tela puder estar visível.
+BOOLEAN TestOcclusionBox(OcclusionBuffer* occlusionBuffer, const float viewProjection[4][4], const float aabbMin[3], const float aabbMax[3]);
+// Testa as AABBs dos objetos objectIndices[0 .. numObjects) (índices de bounds) e grava em visibleObjects os índices dos objetos não
+// ocultos, na mesma ordem. visibleObjects pode ser o próprio objectIndices, por exemplo para filtrar a lista gerada por CullObjects.
+LeanDX12Result CullOccludedObjects(OcclusionBuffer* occlusionBuffer, const float viewProjection[4][4], const CULLING_BOUNDS* bounds, unsigned int numObjects, const unsigned int* objectIndices, unsigned int* visibleObjects, unsigned int* numVisibleObjects);
+
+// Copia a profundidade (width * height valores em float, por linhas) para depuração.
+LeanDX12Result GetOcclusionDepth(OcclusionBuffer* occlusionBuffer, float* pDepth);
+void GetOcclusionStats(OcclusionBuffer* occlusionBuffer, OCCLUSION_STATS* stats);
+
+#endif  // _LEANDX12_OCCLUSION_
@@ -0,0 +1,157 @@
+// Descrição: Implementação do pool de threads das extensões LeanDX12 (LeanDX12Parallel.h).
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "LeanDX12Parallel.h"
+
+namespace
+{
+	// Trabalho em execução no pool. Apenas um trabalho é executado por vez; chamadas concorrentes de ParallelFor aguardam em submitMutex.
+	struct ParallelJob
+	{
+		PARALLEL_FUNCTION function;
+		void* pUserData;
+		unsigned int count;
+		unsigned int grainSize;
+		std::atomic<unsigned long long> nextItem;		// 64 bits: os incrementos após o último bloco não voltam a zero.
+		std::atomic<unsigned int> pendingWorkers;
+	};
+
+	struct ThreadPool
+	{
+		std::vector<std::thread> workers;
+		std::mutex mutex;
+		std::condition_variable wakeCondition;
+		std::condition_variable doneCondition;
+		std::mutex submitMutex;
+		ParallelJob job;
+		unsigned long long generation = 0;
+		bool shutdown = false;
+
+		ThreadPool();
+		~ThreadPool();
+	};
+
+	// Verdadeiro nas threads de trabalho e na thread chamadora enquanto ela processa blocos: chamadas aninhadas de ParallelFor são
+	// executadas sequencialmente (submitMutex já pertence ao trabalho em execução).
+	thread_local bool isInsideJob = false;
+
+	void RunJob(ParallelJob* job)
+	{
+		for (;;)
+		{
+			unsigned long long begin = job->nextItem.fetch_add(job->grainSize);
+			if (begin >= job->count)
+				break;
+
+			unsigned long long end = begin + job->grainSize < job->count ? begin + job->grainSize : job->count;
+			job->function((unsigned int)begin, (unsigned int)end, job->pUserData);
+		}
+	}
+
+	void WorkerMain(ThreadPool* pool)
+	{
+		isInsideJob = true;
+		unsigned long long lastGeneration = 0;
+
+		for (;;)
+		{
+			{
+				std::unique_lock<std::mutex> lock(pool->mutex);
+				pool->wakeCondition.wait(lock, [&] { return pool->shutdown || pool->generation != lastGeneration; });
+				if (pool->shutdown)
+					return;
+				lastGeneration = pool->generation;
+			}
+
+			RunJob(&pool->job);
+
+			if (pool->job.pendingWorkers.fetch_sub(1) == 1)
+			{
+				std::lock_guard<std::mutex> lock(pool->mutex);
+				pool->doneCondition.notify_one();
+			}
+		}
+	}
+
+	ThreadPool::ThreadPool()
+	{
+		unsigned int numThreads = std::thread::hardware_concurrency();
+		if (numThreads < 1)
+			numThreads = 1;
+
+		for (unsigned int i = 0; i < numThreads - 1; i++)
+			workers.emplace_back(WorkerMain, this);
+	}
+
+	ThreadPool::~ThreadPool()
+	{
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			shutdown = true;
+		}
+		wakeCondition.notify_all();
+
+		for (size_t i = 0; i < workers.size(); i++)
+			workers[i].join();
+	}
+
+	ThreadPool& GetThreadPool()
+	{
+		static ThreadPool pool;
+		return pool;
+	}
+}
+
+void ParallelFor(unsigned int count, unsigned int grainSize, PARALLEL_FUNCTION function, void* pUserData)
+{
+	if (count == 0 || function == nullptr)
+		return;
+
+	if (grainSize < 1)
+		grainSize = 1;
+
+	if (isInsideJob || count <= grainSize)
+	{
+		function(0, count, pUserData);
+		return;
+	}
+
+	ThreadPool& pool = GetThreadPool();
+	if (pool.workers.empty())
+	{
+		function(0, count, pUserData);
+		return;
+	}
+
+	std::lock_guard<std::mutex> submitLock(pool.submitMutex);
+
+	pool.job.function = function;
+	pool.job.pUserData = pUserData;
+	pool.job.count = count;
+	pool.job.grainSize = grainSize;
+	pool.job.nextItem.store(0);
+	pool.job.pendingWorkers.store((unsigned int)pool.workers.size());
+
+	{
+		std::lock_guard<std::mutex> lock(pool.mutex);
+		pool.generation++;
+	}
+	pool.wakeCondition.notify_all();
+
+	isInsideJob = true;
+	RunJob(&pool.job);
+	isInsideJob = false;
+
+	std::unique_lock<std::mutex> lock(pool.mutex);
+	pool.doneCondition.wait(lock, [&] { return pool.job.pendingWorkers.load() == 0; });
+}
+
+unsigned int GetParallelThreadCount()
+{
+	return (unsigned int)GetThreadPool().workers.size() + 1;
+}
@@ -0,0 +1,26 @@
+/*
+* LeanDX12 - Execução paralela
+* Descrição: Pool de threads compartilhado pelas extensões da biblioteca LeanDX12. As threads de trabalho são criadas uma única vez
+* (na primeira chamada) e reaproveitadas por todas as chamadas de ParallelFor.
+*
+*   Organização do arquivo de cabeçalho:
+*	1.	Declaração das funções
+*/
+
+#ifndef _LEANDX12_PARALLEL_
+#define _LEANDX12_PARALLEL_
+
+// ------------------------------------------------------ 1. Declaração das funções ------------------------------------------------------- //
+
+// Função executada sobre o intervalo [begin, end) de itens.
+typedef void (*PARALLEL_FUNCTION)(unsigned int begin, unsigned int end, void* pUserData);
+
+// Divide o intervalo [0, count) em blocos de grainSize itens e os distribui entre as threads de trabalho. A thread que chama a função
+// também processa blocos e só retorna quando todos os blocos tiverem sido processados. Chamadas feitas de dentro de um bloco, em
+// qualquer thread (paralelismo aninhado), são executadas sequencialmente.
+void ParallelFor(unsigned int count, unsigned int grainSize, PARALLEL_FUNCTION function, void* pUserData);
+
+// Número de threads que participam de ParallelFor (threads de trabalho + thread chamadora).
+unsigned int GetParallelThreadCount();
+
+#endif  // _LEANDX12_PARALLEL_
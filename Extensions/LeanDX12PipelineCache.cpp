@@ -0,0 +1,278 @@
+// Descrição: Implementação do cache de pipelines das extensões LeanDX12 (LeanDX12PipelineCache.h).
+
+#include <cstring>
+#include <future>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include "LeanDX12PipelineCache.h"
+
+namespace
+{
+	typedef enum OBJECT_KIND
+	{
+		OBJECT_KIND_BLEND_STATE,
+		OBJECT_KIND_RASTERIZER_STATE,
+		OBJECT_KIND_DEPTH_STENCIL_STATE,
+		OBJECT_KIND_INPUT_LAYOUT,
+		OBJECT_KIND_ROOT_SIGNATURE,
+		OBJECT_KIND_PIPELINE_STATE,
+		NUM_OBJECT_KINDS
+	} OBJECT_KIND;
+
+	typedef struct CACHE_ENTRY
+	{
+		LeanDX12Result result;
+		void* object;
+	} CACHE_ENTRY;
+
+	// Cada entrada é criada por uma única thread; as demais threads que solicitarem a mesma descrição aguardam a criação, sem bloquear
+	// a criação de objetos com outras descrições.
+	struct PipelineCache
+	{
+		std::mutex mutex;
+		std::unordered_map<std::string, std::shared_future<CACHE_ENTRY>> objects[NUM_OBJECT_KINDS];
+		unsigned long long numHits = 0;
+		unsigned long long numMisses = 0;
+	};
+
+	PipelineCache& GetPipelineCache()
+	{
+		static PipelineCache cache;
+		return cache;
+	}
+
+	// Chave de uma descrição, montada campo a campo (a comparação direta das estruturas incluiria os bytes de preenchimento).
+	class KeyWriter
+	{
+	public:
+		template <typename T>
+		KeyWriter& operator<<(const T& value)
+		{
+			key.append((const char*)&value, sizeof(T));
+			return *this;
+		}
+
+		KeyWriter& operator<<(const char* text)
+		{
+			if (text == nullptr)
+				return *this << (unsigned int)~0u;
+
+			unsigned int length = (unsigned int)strlen(text);
+			*this << length;
+			key.append(text, length);
+			return *this;
+		}
+
+		const std::string& Key() const
+		{
+			return key;
+		}
+
+	private:
+		std::string key;
+	};
+
+	template <typename CREATE_FUNCTION>
+	LeanDX12Result GetOrCreate(OBJECT_KIND kind, const std::string& key, CREATE_FUNCTION create, void** object)
+	{
+		PipelineCache& cache = GetPipelineCache();
+		std::promise<CACHE_ENTRY> promise;
+		std::shared_future<CACHE_ENTRY> future;
+		bool creator = false;
+
+		{
+			std::lock_guard<std::mutex> lock(cache.mutex);
+
+			std::unordered_map<std::string, std::shared_future<CACHE_ENTRY>>::iterator entry = cache.objects[kind].find(key);
+			if (entry == cache.objects[kind].end())
+			{
+				future = promise.get_future().share();
+				cache.objects[kind][key] = future;
+				cache.numMisses++;
+				creator = true;
+			}
+			else
+			{
+				future = entry->second;
+				cache.numHits++;
+			}
+		}
+
+		if (creator)
+		{
+			CACHE_ENTRY created;
+			created.object = nullptr;
+			created.result = create(&created.object);
+			promise.set_value(created);
+
+			// Descrições que falharam não permanecem no cache, permitindo uma nova tentativa.
+			if (created.result != LEANDX12_OK)
+			{
+				std::lock_guard<std::mutex> lock(cache.mutex);
+				cache.objects[kind].erase(key);
+			}
+		}
+
+		const CACHE_ENTRY& entry = future.get();
+		if (entry.result == LEANDX12_OK)
+			*object = entry.object;
+
+		return entry.result;
+	}
+
+	void WriteInputElements(KeyWriter& key, unsigned int numElements, const INPUT_ELEMENT_DESC* elements)
+	{
+		key << numElements;
+		for (unsigned int i = 0; i < numElements; i++)
+			key << elements[i].SemanticName << elements[i].SemanticIndex << elements[i].Format << elements[i].InstanceDataStepRate;
+	}
+}
+
+LeanDX12Result GetBlendState(const BLEND_DESC* blendDesc, BlendState** blendState)
+{
+	if (blendDesc == nullptr || blendState == nullptr)
+		return LEANDX12_ERROR_INVALID_CALL;
+
+	KeyWriter key;
+	key << blendDesc->AlphaToCoverage << blendDesc->BlendEnable << blendDesc->SrcBlend << blendDesc->DestBlend << blendDesc->BlendOp <<
+		blendDesc->SrcBlendAlpha << blendDesc->DestBlendAlpha << blendDesc->BlendOpAlpha << blendDesc->LogicOpEnable << blendDesc->LogicOp;
+
+	BLEND_DESC desc = *blendDesc;
+	return GetOrCreate(OBJECT_KIND_BLEND_STATE, key.Key(), [desc](void** object)
+	{
+		BlendState* state;
+		LeanDX12Result result = InitBlendState(&state);
+		if (result == LEANDX12_OK && (result = SetBlendState(desc, state)) == LEANDX12_OK)
+			*object = state;
+		return result;
+	}, (void**)blendState);
+}
+
+LeanDX12Result GetRasterizerState(const RASTERIZER_DESC* rasterizerDesc, RasterizerState** rasterizerState)
+{
+	if (rasterizerDesc == nullptr || rasterizerState == nullptr)
+		return LEANDX12_ERROR_INVALID_CALL;
+
+	KeyWriter key;
+	key << rasterizerDesc->FillMode << rasterizerDesc->CullMode << rasterizerDesc->FrontCounterClockwise << rasterizerDesc->DepthBias <<
+		rasterizerDesc->DepthBiasClamp << rasterizerDesc->SlopeScaledDepthBias << rasterizerDesc->DepthClipEnable <<
+		rasterizerDesc->MultisampleEnable << rasterizerDesc->AntialiasedLineEnable << rasterizerDesc->ConservativeRaster <<
+		rasterizerDesc->SampleCount << rasterizerDesc->SampleQuality;
+
+	RASTERIZER_DESC desc = *rasterizerDesc;
+	return GetOrCreate(OBJECT_KIND_RASTERIZER_STATE, key.Key(), [desc](void** object)
+	{
+		RasterizerState* state;
+		LeanDX12Result result = InitRasterizerState(&state);
+		if (result == LEANDX12_OK && (result = SetRasterizerState(desc, state)) == LEANDX12_OK)
+			*object = state;
+		return result;
+	}, (void**)rasterizerState);
+}
+
+LeanDX12Result GetDepthStencilState(const DEPTH_STENCIL_DESC* depthStencilDesc, DepthStencilState** depthStencilState)
+{
+	if (depthStencilDesc == nullptr || depthStencilState == nullptr)
+		return LEANDX12_ERROR_INVALID_CALL;
+
+	KeyWriter key;
+	key << depthStencilDesc->DepthEnable << depthStencilDesc->DepthFunc << depthStencilDesc->StencilEnable <<
+		depthStencilDesc->StencilReadMask << depthStencilDesc->StencilWriteMask << depthStencilDesc->FrontFaceStencilFunc <<
+		depthStencilDesc->FrontFaceStencilPassOp << depthStencilDesc->FrontFaceStencilDepthFailOp << depthStencilDesc->FrontFaceStencilFailOp <<
+		depthStencilDesc->BackFaceStencilFunc << depthStencilDesc->BackFaceStencilPassOp << depthStencilDesc->BackFaceStencilDepthFailOp <<
+		depthStencilDesc->BackFaceStencilFailOp;
+
+	DEPTH_STENCIL_DESC desc = *depthStencilDesc;
+	return GetOrCreate(OBJECT_KIND_DEPTH_STENCIL_STATE, key.Key(), [desc](void** object)
+	{
+		DepthStencilState* state;
+		LeanDX12Result result = InitDepthStencilState(&state);
+		if (result == LEANDX12_OK && (result = SetDepthStencilState(desc, state)) == LEANDX12_OK)
+			*object = state;
+		return result;
+	}, (void**)depthStencilState);
+}
+
+LeanDX12Result GetInputLayout(unsigned int numVertexDataElements, const INPUT_ELEMENT_DESC* vertexDataElements, unsigned int numInstanceDataElements, const INPUT_ELEMENT_DESC* instanceDataElements, InputLayout** inputLayout)
+{
+	if ((numVertexDataElements > 0 && vertexDataElements == nullptr) || (numInstanceDataElements > 0 && instanceDataElements == nullptr) ||
+		inputLayout == nullptr)
+		return LEANDX12_ERROR_INVALID_CALL;
+
+	KeyWriter key;
+	WriteInputElements(key, numVertexDataElements, vertexDataElements);
+	WriteInputElements(key, numInstanceDataElements, instanceDataElements);
+
+	return GetOrCreate(OBJECT_KIND_INPUT_LAYOUT, key.Key(), [=](void** object)
+	{
+		InputLayout* layout;
+		LeanDX12Result result = CreateInputLayout(numVertexDataElements, (INPUT_ELEMENT_DESC*)vertexDataElements, numInstanceDataElements,
+			(INPUT_ELEMENT_DESC*)instanceDataElements, &layout);
+		if (result == LEANDX12_OK)
+			*object = layout;
+		return result;
+	}, (void**)inputLayout);
+}
+
+LeanDX12Result GetRootSignature(unsigned int num32bitConstants, const unsigned int* num32bitValues, unsigned int numConstantBuffers, unsigned int numShaderResources, RootSignature** rootSignature)
+{
+	if ((num32bitConstants > 0 && num32bitValues == nullptr) || rootSignature == nullptr)
+		return LEANDX12_ERROR_INVALID_CALL;
+
+	KeyWriter key;
+	key << num32bitConstants;
+	for (unsigned int i = 0; i < num32bitConstants; i++)
+		key << num32bitValues[i];
+	key << numConstantBuffers << numShaderResources;
+
+	return GetOrCreate(OBJECT_KIND_ROOT_SIGNATURE, key.Key(), [=](void** object)
+	{
+		RootSignature* signature;
+		LeanDX12Result result = CreateRootSignature(num32bitConstants, (unsigned int*)num32bitValues, numConstantBuffers, numShaderResources, &signature);
+		if (result == LEANDX12_OK)
+			*object = signature;
+		return result;
+	}, (void**)rootSignature);
+}
+
+LeanDX12Result GetGraphicsPipelineState(const GRAPHICS_PIPELINE_STATE_DESC* graphicsPipelineStateDesc, PipelineState** pipelineState)
+{
+	if (graphicsPipelineStateDesc == nullptr || pipelineState == nullptr)
+		return LEANDX12_ERROR_INVALID_CALL;
+
+	const GRAPHICS_PIPELINE_STATE_DESC& desc = *graphicsPipelineStateDesc;
+
+	KeyWriter key;
+	key << desc.rootSignature << desc.inputLayout << desc.vertexShader << desc.hullShader << desc.domainShader << desc.geometryShader <<
+		desc.pixelShader << desc.primitiveTopologyType << desc.rasterState << desc.blendState << desc.depthStencilState <<
+		desc.renderTargetFormat << desc.depthStencilFormat;
+
+	return GetOrCreate(OBJECT_KIND_PIPELINE_STATE, key.Key(), [desc](void** object)
+	{
+		PipelineState* state;
+		LeanDX12Result result = CreateGraphicsPipelineState(desc, &state);
+		if (result == LEANDX12_OK)
+			*object = state;
+		return result;
+	}, (void**)pipelineState);
+}
+
+void GetPipelineCacheStats(PIPELINE_CACHE_STATS* stats)
+{
+	if (stats == nullptr)
+		return;
+
+	PipelineCache& cache = GetPipelineCache();
+	std::lock_guard<std::mutex> lock(cache.mutex);
+
+	stats->numBlendStates = (unsigned int)cache.objects[OBJECT_KIND_BLEND_STATE].size();
+	stats->numRasterizerStates = (unsigned int)cache.objects[OBJECT_KIND_RASTERIZER_STATE].size();
+	stats->numDepthStencilStates = (unsigned int)cache.objects[OBJECT_KIND_DEPTH_STENCIL_STATE].size();
+	stats->numInputLayouts = (unsigned int)cache.objects[OBJECT_KIND_INPUT_LAYOUT].size();
+	stats->numRootSignatures = (unsigned int)cache.objects[OBJECT_KIND_ROOT_SIGNATURE].size();
+	stats->numPipelineStates = (unsigned int)cache.objects[OBJECT_KIND_PIPELINE_STATE].size();
+	stats->numHits = cache.numHits;
+	stats->numMisses = cache.numMisses;
+}
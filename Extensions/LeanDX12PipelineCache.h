@@ -0,0 +1,51 @@
+/*
+* LeanDX12 - Cache de pipelines
+* Descrição: Reaproveitamento de objetos do pipeline gráfico com descrições idênticas. Cada objeto é criado uma única vez por descrição
+* e as chamadas seguintes com o mesmo conteúdo retornam o objeto já criado.
+*
+*	Os estados de blend, rasterização e profundidade/stencil, os layouts de entrada e as assinaturas raiz são identificados pelo conteúdo das suas descrições
+*	(os nomes semânticos são comparados como texto). Os pipelines são identificados pelo conteúdo de GRAPHICS_PIPELINE_STATE_DESC, no qual
+*	os objetos referenciados são comparados pelo endereço: utilizando os objetos retornados por este módulo (e shaders sem duplicatas),
+*	descrições com o mesmo conteúdo resultam no mesmo pipeline.
+*
+*	A biblioteca não possui funções de exclusão para estes objetos, portanto eles permanecem válidos até o fim do programa. As funções
+*	podem ser chamadas de qualquer thread.
+*
+*   Organização do arquivo de cabeçalho:
+*	1.	Estruturas
+*	2.	Declaração das funções
+*/
+
+#ifndef _LEANDX12_PIPELINE_CACHE_
+#define _LEANDX12_PIPELINE_CACHE_
+
+#include <cstddef>
+
+#include "LeanDX12.h"
+
+// ------------------------------------------------------------ 1. Estruturas ------------------------------------------------------------- //
+
+typedef struct PIPELINE_CACHE_STATS
+{
+	unsigned int numBlendStates;
+	unsigned int numRasterizerStates;
+	unsigned int numDepthStencilStates;
+	unsigned int numInputLayouts;
+	unsigned int numRootSignatures;
+	unsigned int numPipelineStates;
+	unsigned long long numHits;						// Chamadas atendidas por objetos já criados.
+	unsigned long long numMisses;					// Chamadas que criaram um novo objeto.
+} PIPELINE_CACHE_STATS;
+
+// ------------------------------------------------------ 2. Declaração das funções ------------------------------------------------------- //
+
+LeanDX12Result GetBlendState(const BLEND_DESC* blendDesc, BlendState** blendState);
+LeanDX12Result GetRasterizerState(const RASTERIZER_DESC* rasterizerDesc, RasterizerState** rasterizerState);
+LeanDX12Result GetDepthStencilState(const DEPTH_STENCIL_DESC* depthStencilDesc, DepthStencilState** depthStencilState);
+LeanDX12Result GetInputLayout(unsigned int numVertexDataElements, const INPUT_ELEMENT_DESC* vertexDataElements, unsigned int numInstanceDataElements, const INPUT_ELEMENT_DESC* instanceDataElements, InputLayout** inputLayout);
+LeanDX12Result GetRootSignature(unsigned int num32bitConstants, const unsigned int* num32bitValues, unsigned int numConstantBuffers, unsigned int numShaderResources, RootSignature** rootSignature);
+LeanDX12Result GetGraphicsPipelineState(const GRAPHICS_PIPELINE_STATE_DESC* graphicsPipelineStateDesc, PipelineState** pipelineState);
+
+void GetPipelineCacheStats(PIPELINE_CACHE_STATS* stats);
+
+#endif  // _LEANDX12_PIPELINE_CACHE_
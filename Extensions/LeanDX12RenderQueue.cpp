@@ -0,0 +1,403 @@
+// Descrição: Implementação da fila de renderização das extensões LeanDX12 (LeanDX12RenderQueue.h).
+
+#include <cstring>
+#include <utility>
+#include <vector>
+
+#include "LeanDX12RenderQueue.h"
+
+struct RenderQueue
+{
+	std::vector<RENDER_QUEUE_DRAW> draws;
+	// Vetores de trabalho da ordenação, preservados entre os quadros.
+	std::vector<unsigned long long> keys, tempKeys;
+	std::vector<unsigned int> order, tempOrder;
+	// Desenhos emitidos (após o agrupamento) e buffer de dados de instância gerado.
+	std::vector<RENDER_QUEUE_DRAW> emitDraws;
+	std::vector<unsigned char> instanceData;
+	bool instancingEnabled = true;
+	RENDER_QUEUE_STATS stats = {};
+};
+
+namespace
+{
+	// Estado enviado ao dispositivo durante a emissão. Os campos inválidos (após uma troca de cena) são sempre enviados.
+	typedef struct EMIT_STATE
+	{
+		PipelineState* pipelineState;
+		unsigned int numScenes;
+		bool inScene;
+		bool valid;
+		PRIMITIVE_TOPOLOGY primitiveTopology;
+		void* pVertexData;
+		unsigned int vertexDataSize;
+		unsigned int dataSizePerVertex;
+		void* pInstanceData;
+		unsigned int instanceDataSize;
+		unsigned int dataSizePerInstance;
+		unsigned int instanceStepRate;
+		unsigned int* pIndexData;
+		unsigned int indexDataSize;
+		bool hasDescriptorTableOffset;
+		unsigned int descriptorTableOffset;
+		unsigned int shaderRegister;
+		unsigned int num32bitConstants;
+		unsigned int constants[RENDER_QUEUE_MAX_32BIT_CONSTANTS];
+	} EMIT_STATE;
+
+	// Ordenação estável (LSD, 8 bits por passagem) dos índices pelas chaves. Passagens em que todas as chaves possuem o mesmo dígito são
+	// ignoradas, o que é comum quando os bits mais significativos (passo e pipeline) variam pouco.
+	void RadixSort(RenderQueue* queue)
+	{
+		size_t count = queue->draws.size();
+
+		queue->keys.resize(count);
+		queue->order.resize(count);
+		queue->tempKeys.resize(count);
+		queue->tempOrder.resize(count);
+
+		for (size_t i = 0; i < count; i++)
+		{
+			queue->keys[i] = queue->draws[i].sortKey;
+			queue->order[i] = (unsigned int)i;
+		}
+
+		unsigned long long* keys = queue->keys.data();
+		unsigned long long* tempKeys = queue->tempKeys.data();
+		unsigned int* order = queue->order.data();
+		unsigned int* tempOrder = queue->tempOrder.data();
+
+		for (unsigned int shift = 0; shift < 64; shift += 8)
+		{
+			size_t histogram[256] = {};
+			for (size_t i = 0; i < count; i++)
+				histogram[(keys[i] >> shift) & 0xFF]++;
+
+			if (histogram[(keys[0] >> shift) & 0xFF] == count)
+				continue;
+
+			size_t offset = 0;
+			for (unsigned int digit = 0; digit < 256; digit++)
+			{
+				size_t digitCount = histogram[digit];
+				histogram[digit] = offset;
+				offset += digitCount;
+			}
+
+			for (size_t i = 0; i < count; i++)
+			{
+				size_t destination = histogram[(keys[i] >> shift) & 0xFF]++;
+				tempKeys[destination] = keys[i];
+				tempOrder[destination] = order[i];
+			}
+
+			std::swap(keys, tempKeys);
+			std::swap(order, tempOrder);
+		}
+
+		// Após um número ímpar de passagens o resultado está nos vetores temporários.
+		if (order != queue->order.data())
+			queue->order.swap(queue->tempOrder);
+	}
+
+	bool IsMergeable(const RENDER_QUEUE_DRAW& draw)
+	{
+		return draw.pMergeInstanceData != nullptr && draw.mergeInstanceDataSize > 0 && draw.pInstanceData == nullptr && draw.instanceCount == 1;
+	}
+
+	// Dois desenhos agrupáveis podem ser agrupados se todo o estado e os argumentos (exceto os dados da instância) forem iguais.
+	bool CanMerge(const RENDER_QUEUE_DRAW& first, const RENDER_QUEUE_DRAW& draw)
+	{
+		return IsMergeable(draw) && draw.mergeInstanceDataSize == first.mergeInstanceDataSize &&
+			draw.pipelineState == first.pipelineState && draw.primitiveTopology == first.primitiveTopology &&
+			draw.pVertexData == first.pVertexData && draw.vertexDataSize == first.vertexDataSize &&
+			draw.dataSizePerVertex == first.dataSizePerVertex && draw.pIndexData == first.pIndexData &&
+			draw.indexDataSize == first.indexDataSize && draw.hasDescriptorTableOffset == first.hasDescriptorTableOffset &&
+			(!draw.hasDescriptorTableOffset || draw.descriptorTableOffset == first.descriptorTableOffset) &&
+			draw.shaderRegister == first.shaderRegister && draw.num32bitConstants == first.num32bitConstants &&
+			memcmp(draw.constants, first.constants, draw.num32bitConstants * sizeof(unsigned int)) == 0 &&
+			draw.countPerInstance == first.countPerInstance && draw.startIndexCount == first.startIndexCount &&
+			draw.startVertexCount == first.startVertexCount;
+	}
+
+	// Monta a lista de desenhos a emitir, na ordem da ordenação, agrupando os desenhos agrupáveis consecutivos. Os dados de instância de
+	// cada grupo são copiados para o buffer gerado, alinhados ao tamanho dos dados de uma instância, e o buffer inteiro é utilizado como
+	// dados de instância (o grupo é selecionado por startInstanceLocation), o que evita trocas de estado entre grupos.
+	void BuildEmitDraws(RenderQueue* queue)
+	{
+		std::vector<RENDER_QUEUE_DRAW>& emitDraws = queue->emitDraws;
+		std::vector<unsigned char>& instanceData = queue->instanceData;
+		std::vector<std::pair<size_t, size_t>> groups;		// (índice do desenho emitido, deslocamento no buffer)
+
+		emitDraws.clear();
+		instanceData.clear();
+
+		for (size_t i = 0; i < queue->order.size(); )
+		{
+			const RENDER_QUEUE_DRAW& first = queue->draws[queue->order[i]];
+			if (!IsMergeable(first))
+			{
+				emitDraws.push_back(first);
+				i++;
+				continue;
+			}
+
+			size_t stride = first.mergeInstanceDataSize;
+			size_t offset = (instanceData.size() + stride - 1) / stride * stride;
+
+			size_t end = i + 1;
+			if (queue->instancingEnabled)
+				while (end < queue->order.size() && CanMerge(first, queue->draws[queue->order[end]]))
+					end++;
+
+			instanceData.resize(offset + (end - i) * stride);
+			for (size_t j = i; j < end; j++)
+				memcpy(&instanceData[offset + (j - i) * stride], queue->draws[queue->order[j]].pMergeInstanceData, stride);
+
+			RENDER_QUEUE_DRAW draw = first;
+			draw.instanceCount = (unsigned int)(end - i);
+			groups.push_back(std::make_pair(emitDraws.size(), offset));
+			emitDraws.push_back(draw);
+
+			queue->stats.numInstancedDraws++;
+			queue->stats.numDrawsMerged += (unsigned int)(end - i - 1);
+			i = end;
+		}
+
+		// Os ponteiros só são preenchidos após o buffer estar completo, pois ele pode ser realocado durante o agrupamento.
+		for (size_t i = 0; i < groups.size(); i++)
+		{
+			RENDER_QUEUE_DRAW& draw = emitDraws[groups[i].first];
+			unsigned int stride = draw.mergeInstanceDataSize;
+			draw.pInstanceData = instanceData.data();
+			draw.instanceDataSize = (unsigned int)(instanceData.size() / stride * stride);
+			draw.dataSizePerInstance = stride;
+			draw.instanceStepRate = 1;
+			draw.startInstanceLocation = (unsigned int)(groups[i].second / stride);
+		}
+	}
+
+	// Emite (ou apenas conta, se execute for falso) as trocas de estado de um desenho e, em seguida, o desenho.
+	LeanDX12Result EmitDraw(const RENDER_QUEUE_DRAW& draw, EMIT_STATE& state, bool execute, RENDER_QUEUE_SCENE_CALLBACK sceneCallback, void* pUserData, unsigned int* numStateChanges)
+	{
+		LeanDX12Result result;
+
+		if (state.numScenes == 0 || draw.pipelineState != state.pipelineState)
+		{
+			if (execute)
+			{
+				if (state.inScene)
+				{
+					EndScene();
+					state.inScene = false;
+				}
+
+				result = BeginScene(draw.pipelineState);
+				if (result != LEANDX12_OK)
+					return result;
+				state.inScene = true;
+
+				if (sceneCallback != nullptr)
+				{
+					result = sceneCallback(draw.pipelineState, state.numScenes, pUserData);
+					if (result != LEANDX12_OK)
+						return result;
+				}
+			}
+
+			state.pipelineState = draw.pipelineState;
+			state.numScenes++;
+			state.valid = false;
+			(*numStateChanges)++;
+		}
+
+		if (!state.valid || draw.primitiveTopology != state.primitiveTopology)
+		{
+			if (execute)
+				SetPrimitiveTopology(draw.primitiveTopology);
+
+			state.primitiveTopology = draw.primitiveTopology;
+			(*numStateChanges)++;
+		}
+
+		if (!state.valid || draw.pVertexData != state.pVertexData || draw.vertexDataSize != state.vertexDataSize ||
+			draw.dataSizePerVertex != state.dataSizePerVertex)
+		{
+			if (execute && (result = SetVertexData(draw.pVertexData, draw.vertexDataSize, draw.dataSizePerVertex)) != LEANDX12_OK)
+				return result;
+
+			state.pVertexData = draw.pVertexData;
+			state.vertexDataSize = draw.vertexDataSize;
+			state.dataSizePerVertex = draw.dataSizePerVertex;
+			(*numStateChanges)++;
+		}
+
+		if (draw.pInstanceData != nullptr && (!state.valid || draw.pInstanceData != state.pInstanceData ||
+			draw.instanceDataSize != state.instanceDataSize || draw.dataSizePerInstance != state.dataSizePerInstance ||
+			draw.instanceStepRate != state.instanceStepRate))
+		{
+			if (execute && (result = SetInstanceData(draw.pInstanceData, draw.instanceDataSize, draw.dataSizePerInstance, draw.instanceStepRate)) != LEANDX12_OK)
+				return result;
+
+			state.pInstanceData = draw.pInstanceData;
+			state.instanceDataSize = draw.instanceDataSize;
+			state.dataSizePerInstance = draw.dataSizePerInstance;
+			state.instanceStepRate = draw.instanceStepRate;
+			(*numStateChanges)++;
+		}
+
+		if (draw.pIndexData != nullptr && (!state.valid || draw.pIndexData != state.pIndexData || draw.indexDataSize != state.indexDataSize))
+		{
+			if (execute && (result = SetIndexData(draw.pIndexData, draw.indexDataSize)) != LEANDX12_OK)
+				return result;
+
+			state.pIndexData = draw.pIndexData;
+			state.indexDataSize = draw.indexDataSize;
+			(*numStateChanges)++;
+		}
+
+		if (draw.hasDescriptorTableOffset && (!state.valid || !state.hasDescriptorTableOffset ||
+			draw.descriptorTableOffset != state.descriptorTableOffset))
+		{
+			if (execute && (result = MapDescriptorTableOffsetToBaseRegister(draw.descriptorTableOffset)) != LEANDX12_OK)
+				return result;
+
+			state.hasDescriptorTableOffset = true;
+			state.descriptorTableOffset = draw.descriptorTableOffset;
+			(*numStateChanges)++;
+		}
+
+		if (draw.num32bitConstants > 0 && (!state.valid || draw.shaderRegister != state.shaderRegister ||
+			draw.num32bitConstants != state.num32bitConstants ||
+			memcmp(draw.constants, state.constants, draw.num32bitConstants * sizeof(unsigned int)) != 0))
+		{
+			if (execute && (result = Set32bitConstants(draw.shaderRegister, draw.num32bitConstants, (void*)draw.constants, 0)) != LEANDX12_OK)
+				return result;
+
+			state.shaderRegister = draw.shaderRegister;
+			state.num32bitConstants = draw.num32bitConstants;
+			memcpy(state.constants, draw.constants, draw.num32bitConstants * sizeof(unsigned int));
+			(*numStateChanges)++;
+		}
+
+		state.valid = true;
+
+		if (execute)
+		{
+			if (draw.pIndexData != nullptr)
+				DrawIndexedInstanced(draw.countPerInstance, draw.instanceCount, draw.startIndexCount, draw.startVertexCount, draw.startInstanceLocation);
+			else
+				DrawInstanced(draw.countPerInstance, draw.instanceCount, draw.startVertexCount, draw.startInstanceLocation);
+		}
+
+		return LEANDX12_OK;
+	}
+}
+
+unsigned long long MakeRenderSortKey(unsigned int pass, unsigned int pipelineIndex, PRIMITIVE_TOPOLOGY primitiveTopology, unsigned int material, float depth)
+{
+	if (!(depth > 0.0f))
+		depth = 0.0f;
+	if (depth > 1.0f)
+		depth = 1.0f;
+
+	unsigned long long quantizedDepth = (unsigned long long)(depth * (float)0xFFFFFF);
+
+	return ((unsigned long long)(pass & 0xF) << 60) |
+		((unsigned long long)(pipelineIndex & 0xFFF) << 48) |
+		((unsigned long long)(primitiveTopology & 0x7F) << 41) |
+		((unsigned long long)(material & 0x1FFFF) << 24) |
+		quantizedDepth;
+}
+
+LeanDX12Result CreateRenderQueue(RenderQueue** queue)
+{
+	if (queue == nullptr)
+		return LEANDX12_ERROR_INVALID_CALL;
+
+	*queue = new RenderQueue;
+	return LEANDX12_OK;
+}
+
+void DeleteRenderQueue(RenderQueue* queue)
+{
+	delete queue;
+}
+
+void ResetRenderQueue(RenderQueue* queue)
+{
+	if (queue != nullptr)
+		queue->draws.clear();
+}
+
+LeanDX12Result AddRenderQueueDraw(RenderQueue* queue, const RENDER_QUEUE_DRAW* draw)
+{
+	if (queue == nullptr || draw == nullptr || draw->pipelineState == nullptr || draw->pVertexData == nullptr)
+		return LEANDX12_ERROR_INVALID_CALL;
+	if (draw->num32bitConstants > RENDER_QUEUE_MAX_32BIT_CONSTANTS)
+		return LEANDX12_ERROR_NUMBER_OF_CONSTANTS_EXCEEDED_REGISTER_LIMIT;
+
+	queue->draws.push_back(*draw);
+	return LEANDX12_OK;
+}
+
+unsigned int GetRenderQueueDrawCount(RenderQueue* queue)
+{
+	return queue != nullptr ? (unsigned int)queue->draws.size() : 0;
+}
+
+void SetRenderQueueInstancing(RenderQueue* queue, BOOLEAN enable)
+{
+	if (queue != nullptr)
+		queue->instancingEnabled = enable != 0;
+}
+
+LeanDX12Result ExecuteRenderQueue(RenderQueue* queue, RENDER_QUEUE_SCENE_CALLBACK sceneCallback, void* pUserData)
+{
+	if (queue == nullptr)
+		return LEANDX12_ERROR_INVALID_CALL;
+
+	RENDER_QUEUE_STATS& stats = queue->stats;
+	stats = RENDER_QUEUE_STATS();
+	stats.numDraws = (unsigned int)queue->draws.size();
+
+	if (queue->draws.empty())
+		return LEANDX12_OK;
+
+	// Contagem das trocas de estado que seriam emitidas na ordem de inserção, com o mesmo agrupamento e o mesmo descarte de estados
+	// repetidos da emissão ordenada, para comparação. Os contadores de agrupamento são os da emissão ordenada.
+	queue->order.resize(queue->draws.size());
+	for (size_t i = 0; i < queue->order.size(); i++)
+		queue->order[i] = (unsigned int)i;
+	BuildEmitDraws(queue);
+	stats.numInstancedDraws = 0;
+	stats.numDrawsMerged = 0;
+
+	EMIT_STATE state = {};
+	for (size_t i = 0; i < queue->emitDraws.size(); i++)
+		EmitDraw(queue->emitDraws[i], state, false, nullptr, nullptr, &stats.numStateChangesUnsorted);
+
+	RadixSort(queue);
+	BuildEmitDraws(queue);
+
+	state = EMIT_STATE();
+	LeanDX12Result result = LEANDX12_OK;
+	for (size_t i = 0; i < queue->emitDraws.size() && result == LEANDX12_OK; i++)
+		result = EmitDraw(queue->emitDraws[i], state, true, sceneCallback, pUserData, &stats.numStateChanges);
+
+	if (state.inScene)
+		EndScene();
+
+	stats.numScenes = state.numScenes;
+	stats.numStateChangesSaved = stats.numStateChangesUnsorted > stats.numStateChanges ? stats.numStateChangesUnsorted - stats.numStateChanges : 0;
+
+	return result;
+}
+
+void GetRenderQueueStats(RenderQueue* queue, RENDER_QUEUE_STATS* stats)
+{
+	if (queue == nullptr || stats == nullptr)
+		return;
+
+	*stats = queue->stats;
+}
@@ -0,0 +1,112 @@
+/*
+* LeanDX12 - Fila de renderização
+* Descrição: Fila de desenhos ordenados por chave. A aplicação adiciona os desenhos do quadro em qualquer ordem, cada um com uma chave de
+* ordenação de 64 bits, e ExecuteRenderQueue os ordena (radix sort) e os emite com o menor número possível de trocas de estado.
+*
+*	Cada desenho descreve todo o estado de que necessita (pipeline, topologia, dados de vértices/instâncias/índices, deslocamento da tabela
+*	de descritores e constantes). Durante a emissão, um estado só é enviado quando for diferente do estado do desenho anterior; a troca de
+*	pipeline encerra a cena atual e inicia uma nova (EndScene/BeginScene), seguida da função de preparação da cena, responsável por
+*	definir o render target, viewports e retângulos de recorte. Como BeginScene pode reinicializar o estado, todo o estado é enviado
+*	novamente após uma troca de cena.
+*
+*	A chave pode ser montada com MakeRenderSortKey, que ordena, da maior para a menor prioridade, por passo, pipeline, topologia, material
+*	e profundidade. Os dados de vértices, instâncias e índices NÃO são copiados: os ponteiros devem permanecer válidos até a execução.
+*
+*	Desenhos com instanceCount = 1 podem informar os dados da sua instância em pMergeInstanceData (no lugar de pInstanceData). Após a
+*	ordenação, desenhos consecutivos com o mesmo estado e os mesmos argumentos (exceto os dados da instância) são agrupados em um único
+*	desenho instanciado, cujos dados de instância são copiados para um buffer gerado pela fila. Para que desenhos da mesma malha fiquem
+*	consecutivos, a chave não deve diferenciá-los (por exemplo, profundidade 0 para desenhos opacos da mesma malha e material).
+*
+*	GetRenderQueueStats informa o número de trocas de estado emitidas, o número que seria emitido na ordem de inserção e o número de
+*	desenhos agrupados.
+*
+*   Organização do arquivo de cabeçalho:
+*	1.	Estruturas
+*		•	Estruturas opacas
+*		•	Estruturas transparentes
+*	2.	Declaração das funções
+*/
+
+#ifndef _LEANDX12_RENDER_QUEUE_
+#define _LEANDX12_RENDER_QUEUE_
+
+#include <cstddef>
+
+#include "LeanDX12.h"
+
+#define RENDER_QUEUE_MAX_32BIT_CONSTANTS 16
+
+// ------------------------------------------------------------ 1. Estruturas ------------------------------------------------------------- //
+
+// -------------------------------------------------------- 1.1. Estruturas opacas -------------------------------------------------------- //
+
+typedef struct RenderQueue RenderQueue;
+
+// ---------------------------------------------------- 1.2. Estruturas transparentes ----------------------------------------------------- //
+
+typedef struct RENDER_QUEUE_DRAW
+{
+	unsigned long long sortKey;
+	PipelineState* pipelineState;
+	PRIMITIVE_TOPOLOGY primitiveTopology;
+
+	void* pVertexData;
+	unsigned int vertexDataSize;
+	unsigned int dataSizePerVertex;
+	void* pInstanceData;							// NULL = sem dados de instâncias.
+	unsigned int instanceDataSize;
+	unsigned int dataSizePerInstance;
+	unsigned int instanceStepRate;
+	unsigned int* pIndexData;						// NULL = DrawInstanced.
+	unsigned int indexDataSize;
+	const void* pMergeInstanceData;					// Dados da instância para o agrupamento (NULL = desenho não agrupável).
+	unsigned int mergeInstanceDataSize;
+
+	BOOLEAN hasDescriptorTableOffset;
+	unsigned int descriptorTableOffset;
+	unsigned int shaderRegister;
+	unsigned int num32bitConstants;					// 0 = sem constantes.
+	unsigned int constants[RENDER_QUEUE_MAX_32BIT_CONSTANTS];
+
+	unsigned int countPerInstance;					// Índices (desenho indexado) ou vértices por instância.
+	unsigned int instanceCount;
+	unsigned int startIndexCount;
+	unsigned int startVertexCount;
+	unsigned int startInstanceLocation;
+} RENDER_QUEUE_DRAW;
+
+typedef struct RENDER_QUEUE_STATS
+{
+	unsigned int numDraws;
+	unsigned int numScenes;
+	unsigned int numStateChanges;					// Trocas de estado emitidas (cenas, topologia, dados, descritores e constantes).
+	unsigned int numStateChangesUnsorted;			// Trocas de estado que seriam emitidas na ordem de inserção (com agrupamento).
+	unsigned int numStateChangesSaved;
+	unsigned int numInstancedDraws;					// Desenhos emitidos a partir de pMergeInstanceData.
+	unsigned int numDrawsMerged;					// Desenhos eliminados pelo agrupamento.
+} RENDER_QUEUE_STATS;
+
+// Chamada após cada BeginScene emitido pela fila. sceneIndex é 0 na primeira cena da execução (onde, por exemplo, Clear deve ser feito).
+typedef LeanDX12Result (*RENDER_QUEUE_SCENE_CALLBACK)(PipelineState* pipelineState, unsigned int sceneIndex, void* pUserData);
+
+// ------------------------------------------------------ 2. Declaração das funções ------------------------------------------------------- //
+
+// Chave com passo (4 bits), pipeline (12 bits), topologia (7 bits), material (17 bits) e profundidade em [0, 1] (24 bits). Para desenhos
+// transparentes (de trás para frente), utilizar 1 - depth.
+unsigned long long MakeRenderSortKey(unsigned int pass, unsigned int pipelineIndex, PRIMITIVE_TOPOLOGY primitiveTopology, unsigned int material, float depth);
+
+LeanDX12Result CreateRenderQueue(RenderQueue** queue);
+void DeleteRenderQueue(RenderQueue* queue);
+// Descarta os desenhos adicionados, preservando a memória alocada.
+void ResetRenderQueue(RenderQueue* queue);
+LeanDX12Result AddRenderQueueDraw(RenderQueue* queue, const RENDER_QUEUE_DRAW* draw);
+unsigned int GetRenderQueueDrawCount(RenderQueue* queue);
+// Ativa ou desativa o agrupamento de desenhos (ativado por padrão).
+void SetRenderQueueInstancing(RenderQueue* queue, BOOLEAN enable);
+
+// Ordena os desenhos pela chave (ordenação estável) e os emite, terminando com EndScene. Não deve ser chamada dentro de uma cena. Os
+// desenhos são mantidos na fila até ResetRenderQueue.
+LeanDX12Result ExecuteRenderQueue(RenderQueue* queue, RENDER_QUEUE_SCENE_CALLBACK sceneCallback, void* pUserData);
+void GetRenderQueueStats(RenderQueue* queue, RENDER_QUEUE_STATS* stats);
+
+#endif  // _LEANDX12_RENDER_QUEUE_
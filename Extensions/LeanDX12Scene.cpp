@@ -0,0 +1,494 @@
+// Descrição: Implementação do grafo de cena das extensões LeanDX12 (LeanDX12Scene.h).
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <vector>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define LEANDX12_SSE2
+#include <emmintrin.h>
+#endif
+
+#include "LeanDX12Parallel.h"
+#include "LeanDX12Scene.h"
+
+// Quantidade mínima de nós por bloco de trabalho de ParallelFor.
+#define SCENE_NODES_PER_TASK 4096
+// Valor de nodeAtSlot para posições de nós excluídos (liberadas na próxima reorganização).
+#define SCENE_NO_NODE 0xFFFFFFFFu
+
+struct Scene
+{
+	unsigned int maxNodes = 0;
+	unsigned int numNodes = 0;
+
+	// Dados por identificador de nó.
+	unsigned int numNodeIds = 0;
+	std::vector<unsigned int> parentOfNode, slotOfNode, levelOfNode, numChildren, freeNodes;
+	std::vector<unsigned char> alive;
+
+	// Dados por posição, ordenados por nível. A posição 0 é a raiz virtual (identidade), pai dos nós sem pai.
+	unsigned int numSlots = 1;
+	std::vector<float> local[12], world[12];					// Elementos das matrizes 3x4 (índice = linha * 4 + coluna).
+	std::vector<unsigned int> parentSlot, nodeAtSlot;
+	std::vector<unsigned char> dirty, changed;
+	std::vector<INSTANCE_TRANSFORM*> instances;
+	std::vector<unsigned int> levelBegin;						// Nível l: posições [levelBegin[l], levelBegin[l + 1]).
+
+	bool layoutDirty = false;
+	bool anyDirty = false;
+	unsigned int minDirtyLevel = 1;
+	SCENE_STATS stats = {};
+};
+
+namespace
+{
+	const float identity[12] = { 1.0f, 0.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f };
+
+	bool IsValidNode(const Scene* scene, unsigned int node)
+	{
+		return node < scene->numNodeIds && scene->alive[node] != 0;
+	}
+
+	void MarkDirty(Scene* scene, unsigned int node)
+	{
+		scene->dirty[scene->slotOfNode[node]] = 1;
+		scene->anyDirty = true;
+		if (!scene->layoutDirty)
+			scene->minDirtyLevel = std::min(scene->minDirtyLevel, scene->levelOfNode[node]);
+	}
+
+	template <typename T>
+	void PermuteSlots(std::vector<T>& values, const std::vector<unsigned int>& sourceSlots, std::vector<T>& temp)
+	{
+		temp.resize(values.size());
+		for (size_t slot = 0; slot < sourceSlots.size(); slot++)
+			temp[slot] = values[sourceSlots[slot]];
+		std::copy(temp.begin(), temp.begin() + sourceSlots.size(), values.begin());
+	}
+
+	// Recalcula os níveis dos nós e os reordena por nível (mantendo a ordem relativa dentro de cada nível), descartando as posições
+	// dos nós excluídos.
+	void RebuildLayout(Scene* scene)
+	{
+		std::vector<unsigned int>& levelOfNode = scene->levelOfNode;
+		for (unsigned int node = 0; node < scene->numNodeIds; node++)
+			levelOfNode[node] = 0;
+
+		unsigned int numLevels = 1;
+		std::vector<unsigned int> chain;
+		for (unsigned int node = 0; node < scene->numNodeIds; node++)
+		{
+			if (scene->alive[node] == 0 || levelOfNode[node] != 0)
+				continue;
+
+			unsigned int ancestor = node;
+			while (ancestor != SCENE_NO_PARENT && levelOfNode[ancestor] == 0)
+			{
+				chain.push_back(ancestor);
+				ancestor = scene->parentOfNode[ancestor];
+			}
+
+			unsigned int level = ancestor == SCENE_NO_PARENT ? 0 : levelOfNode[ancestor];
+			for (size_t i = chain.size(); i-- > 0; )
+				levelOfNode[chain[i]] = ++level;
+
+			numLevels = std::max(numLevels, level + 1);
+			chain.clear();
+		}
+
+		std::vector<unsigned int> levelCursor(numLevels + 1, 0);
+		for (unsigned int node = 0; node < scene->numNodeIds; node++)
+			if (scene->alive[node] != 0)
+				levelCursor[levelOfNode[node] + 1]++;
+
+		levelCursor[1] = 1;
+		for (unsigned int level = 1; level <= numLevels; level++)
+			levelCursor[level] += levelCursor[level - 1];
+		scene->levelBegin = levelCursor;
+
+		std::vector<unsigned int> sourceSlots(scene->numNodes + 1);
+		sourceSlots[0] = 0;
+		for (unsigned int slot = 1; slot < scene->numSlots; slot++)
+		{
+			unsigned int node = scene->nodeAtSlot[slot];
+			if (node != SCENE_NO_NODE)
+				sourceSlots[levelCursor[levelOfNode[node]]++] = slot;
+		}
+
+		std::vector<float> tempFloats;
+		for (int element = 0; element < 12; element++)
+		{
+			PermuteSlots(scene->local[element], sourceSlots, tempFloats);
+			PermuteSlots(scene->world[element], sourceSlots, tempFloats);
+		}
+
+		std::vector<unsigned char> tempBytes;
+		PermuteSlots(scene->dirty, sourceSlots, tempBytes);
+		std::vector<INSTANCE_TRANSFORM*> tempInstances;
+		PermuteSlots(scene->instances, sourceSlots, tempInstances);
+		std::vector<unsigned int> tempIndices;
+		PermuteSlots(scene->nodeAtSlot, sourceSlots, tempIndices);
+
+		scene->numSlots = scene->numNodes + 1;
+		for (unsigned int slot = 1; slot < scene->numSlots; slot++)
+			scene->slotOfNode[scene->nodeAtSlot[slot]] = slot;
+		for (unsigned int slot = 1; slot < scene->numSlots; slot++)
+		{
+			unsigned int parent = scene->parentOfNode[scene->nodeAtSlot[slot]];
+			scene->parentSlot[slot] = parent == SCENE_NO_PARENT ? 0 : scene->slotOfNode[parent];
+		}
+
+		scene->layoutDirty = false;
+		scene->minDirtyLevel = 1;
+		scene->stats.layoutRebuilt = 1;
+	}
+
+	void WriteInstance(const Scene* scene, unsigned int slot)
+	{
+		INSTANCE_TRANSFORM* pInstance = scene->instances[slot];
+		for (int row = 0; row < 3; row++)
+			for (int column = 0; column < 4; column++)
+				pInstance->rows[row][column] = scene->world[row * 4 + column][slot];
+	}
+
+	void ComputeWorld(Scene* scene, unsigned int slot)
+	{
+		unsigned int parent = scene->parentSlot[slot];
+		float parentWorld[12], local[12];
+		for (int element = 0; element < 12; element++)
+		{
+			parentWorld[element] = scene->world[element][parent];
+			local[element] = scene->local[element][slot];
+		}
+
+		for (int row = 0; row < 3; row++)
+		{
+			for (int column = 0; column < 4; column++)
+			{
+				float value = parentWorld[row * 4 + 0] * local[column] + parentWorld[row * 4 + 1] * local[4 + column] +
+					parentWorld[row * 4 + 2] * local[8 + column];
+				if (column == 3)
+					value += parentWorld[row * 4 + 3];
+				scene->world[row * 4 + column][slot] = value;
+			}
+		}
+	}
+
+	typedef struct UPDATE_JOB
+	{
+		Scene* scene;
+		unsigned int firstSlot;
+		std::atomic<unsigned int> numNodesUpdated;
+		std::atomic<unsigned int> numInstancesWritten;
+	} UPDATE_JOB;
+
+	// Atualiza as posições [firstSlot + begin, firstSlot + end) de um mesmo nível. Os pais pertencem a níveis já atualizados.
+	void UpdateNodes(unsigned int begin, unsigned int end, void* pUserData)
+	{
+		UPDATE_JOB* job = (UPDATE_JOB*)pUserData;
+		Scene* scene = job->scene;
+		unsigned int slot = job->firstSlot + begin;
+		unsigned int lastSlot = job->firstSlot + end;
+		unsigned int numNodesUpdated = 0, numInstancesWritten = 0;
+
+#if defined(LEANDX12_SSE2)
+		for (; slot + 4 <= lastSlot; slot += 4)
+		{
+			int changedMask = 0;
+			for (unsigned int lane = 0; lane < 4; lane++)
+			{
+				unsigned char changed = scene->dirty[slot + lane] | scene->changed[scene->parentSlot[slot + lane]];
+				scene->changed[slot + lane] = changed;
+				changedMask |= changed << lane;
+			}
+
+			if (changedMask == 0)
+				continue;
+
+			const unsigned int* parents = &scene->parentSlot[slot];
+			__m128 parentWorld[12], local[12];
+			for (int element = 0; element < 12; element++)
+			{
+				const float* pWorld = scene->world[element].data();
+				parentWorld[element] = _mm_setr_ps(pWorld[parents[0]], pWorld[parents[1]], pWorld[parents[2]], pWorld[parents[3]]);
+				local[element] = _mm_loadu_ps(&scene->local[element][slot]);
+			}
+
+			__m128 mask = _mm_castsi128_ps(_mm_setr_epi32((changedMask & 1) != 0 ? -1 : 0, (changedMask & 2) != 0 ? -1 : 0,
+				(changedMask & 4) != 0 ? -1 : 0, (changedMask & 8) != 0 ? -1 : 0));
+
+			for (int row = 0; row < 3; row++)
+			{
+				for (int column = 0; column < 4; column++)
+				{
+					__m128 value = _mm_add_ps(_mm_add_ps(_mm_mul_ps(parentWorld[row * 4 + 0], local[column]),
+						_mm_mul_ps(parentWorld[row * 4 + 1], local[4 + column])), _mm_mul_ps(parentWorld[row * 4 + 2], local[8 + column]));
+					if (column == 3)
+						value = _mm_add_ps(value, parentWorld[row * 4 + 3]);
+
+					float* pWorld = &scene->world[row * 4 + column][slot];
+					_mm_storeu_ps(pWorld, _mm_or_ps(_mm_and_ps(mask, value), _mm_andnot_ps(mask, _mm_loadu_ps(pWorld))));
+				}
+			}
+
+			for (unsigned int lane = 0; lane < 4; lane++)
+			{
+				if ((changedMask & (1 << lane)) == 0)
+					continue;
+
+				numNodesUpdated++;
+				scene->dirty[slot + lane] = 0;
+				if (scene->instances[slot + lane] != nullptr)
+				{
+					WriteInstance(scene, slot + lane);
+					numInstancesWritten++;
+				}
+			}
+		}
+#endif
+
+		for (; slot < lastSlot; slot++)
+		{
+			unsigned char changed = scene->dirty[slot] | scene->changed[scene->parentSlot[slot]];
+			scene->changed[slot] = changed;
+			if (changed == 0)
+				continue;
+
+			ComputeWorld(scene, slot);
+			numNodesUpdated++;
+			scene->dirty[slot] = 0;
+			if (scene->instances[slot] != nullptr)
+			{
+				WriteInstance(scene, slot);
+				numInstancesWritten++;
+			}
+		}
+
+		job->numNodesUpdated += numNodesUpdated;
+		job->numInstancesWritten += numInstancesWritten;
+	}
+}
+
+LeanDX12Result CreateScene(unsigned int maxNodes, Scene** scene)
+{
+	if (scene == nullptr || maxNodes == 0 || maxNodes >= SCENE_NO_PARENT - 1)
+		return LEANDX12_ERROR_INVALID_CALL;
+
+	Scene* newScene = new Scene;
+	newScene->maxNodes = maxNodes;
+
+	size_t numSlots = (size_t)maxNodes + 1;
+	for (int element = 0; element < 12; element++)
+	{
+		newScene->local[element].assign(numSlots, identity[element]);
+		newScene->world[element].assign(numSlots, identity[element]);
+	}
+
+	newScene->parentSlot.assign(numSlots, 0);
+	newScene->nodeAtSlot.assign(numSlots, SCENE_NO_NODE);
+	newScene->dirty.assign(numSlots, 0);
+	newScene->changed.assign(numSlots, 0);
+	newScene->instances.assign(numSlots, nullptr);
+	newScene->levelBegin = { 0, 1 };
+
+	newScene->parentOfNode.resize(maxNodes);
+	newScene->slotOfNode.resize(maxNodes);
+	newScene->levelOfNode.resize(maxNodes);
+	newScene->numChildren.resize(maxNodes);
+	newScene->alive.assign(maxNodes, 0);
+
+	*scene = newScene;
+	return LEANDX12_OK;
+}
+
+void DeleteScene(Scene* scene)
+{
+	delete scene;
+}
+
+LeanDX12Result CreateSceneNode(Scene* scene, unsigned int parent, unsigned int* node)
+{
+	if (scene == nullptr || node == nullptr || (parent != SCENE_NO_PARENT && !IsValidNode(scene, parent)))
+		return LEANDX12_ERROR_INVALID_CALL;
+
+	if (scene->numNodes == scene->maxNodes)
+		return LEANDX12_ERROR_INSUFFICIENT_BUFFER_SIZE;
+
+	// As posições dos nós excluídos só são liberadas na reorganização.
+	if (scene->numSlots == scene->maxNodes + 1)
+		RebuildLayout(scene);
+
+	unsigned int newNode;
+	if (!scene->freeNodes.empty())
+	{
+		newNode = scene->freeNodes.back();
+		scene->freeNodes.pop_back();
+	}
+	else
+		newNode = scene->numNodeIds++;
+
+	unsigned int slot = scene->numSlots++;
+	for (int element = 0; element < 12; element++)
+	{
+		scene->local[element][slot] = identity[element];
+		scene->world[element][slot] = identity[element];
+	}
+	scene->parentSlot[slot] = parent == SCENE_NO_PARENT ? 0 : scene->slotOfNode[parent];
+	scene->nodeAtSlot[slot] = newNode;
+	scene->changed[slot] = 0;
+	scene->instances[slot] = nullptr;
+
+	scene->alive[newNode] = 1;
+	scene->parentOfNode[newNode] = parent;
+	scene->slotOfNode[newNode] = slot;
+	scene->numChildren[newNode] = 0;
+	if (parent != SCENE_NO_PARENT)
+		scene->numChildren[parent]++;
+
+	scene->numNodes++;
+	scene->layoutDirty = true;
+	MarkDirty(scene, newNode);
+
+	*node = newNode;
+	return LEANDX12_OK;
+}
+
+LeanDX12Result DeleteSceneNode(Scene* scene, unsigned int node)
+{
+	if (scene == nullptr || !IsValidNode(scene, node) || scene->numChildren[node] != 0)
+		return LEANDX12_ERROR_INVALID_CALL;
+
+	unsigned int slot = scene->slotOfNode[node];
+	scene->nodeAtSlot[slot] = SCENE_NO_NODE;
+	scene->dirty[slot] = 0;
+	scene->instances[slot] = nullptr;
+
+	if (scene->parentOfNode[node] != SCENE_NO_PARENT)
+		scene->numChildren[scene->parentOfNode[node]]--;
+
+	scene->alive[node] = 0;
+	scene->freeNodes.push_back(node);
+	scene->numNodes--;
+	scene->layoutDirty = true;
+	return LEANDX12_OK;
+}
+
+LeanDX12Result SetSceneNodeParent(Scene* scene, unsigned int node, unsigned int parent)
+{
+	if (scene == nullptr || !IsValidNode(scene, node) || (parent != SCENE_NO_PARENT && !IsValidNode(scene, parent)))
+		return LEANDX12_ERROR_INVALID_CALL;
+
+	// O novo pai não pode ser o próprio nó nem um dos seus descendentes.
+	for (unsigned int ancestor = parent; ancestor != SCENE_NO_PARENT; ancestor = scene->parentOfNode[ancestor])
+		if (ancestor == node)
+			return LEANDX12_ERROR_INVALID_CALL;
+
+	unsigned int oldParent = scene->parentOfNode[node];
+	if (oldParent == parent)
+		return LEANDX12_OK;
+
+	if (oldParent != SCENE_NO_PARENT)
+		scene->numChildren[oldParent]--;
+	if (parent != SCENE_NO_PARENT)
+		scene->numChildren[parent]++;
+
+	scene->parentOfNode[node] = parent;
+	scene->layoutDirty = true;
+	MarkDirty(scene, node);
+	return LEANDX12_OK;
+}
+
+LeanDX12Result SetSceneNodeTransform(Scene* scene, unsigned int node, const float position[3], const float rotation[3], const float scale[3])
+{
+	INSTANCE_TRANSFORM local;
+	ComposeInstanceTransform(position, rotation, scale, &local);
+	return SetSceneNodeLocalMatrix(scene, node, &local);
+}
+
+LeanDX12Result SetSceneNodeLocalMatrix(Scene* scene, unsigned int node, const INSTANCE_TRANSFORM* local)
+{
+	if (scene == nullptr || local == nullptr || !IsValidNode(scene, node))
+		return LEANDX12_ERROR_INVALID_CALL;
+
+	unsigned int slot = scene->slotOfNode[node];
+	for (int row = 0; row < 3; row++)
+		for (int column = 0; column < 4; column++)
+			scene->local[row * 4 + column][slot] = local->rows[row][column];
+
+	MarkDirty(scene, node);
+	return LEANDX12_OK;
+}
+
+LeanDX12Result SetSceneNodeInstance(Scene* scene, unsigned int node, INSTANCE_TRANSFORM* pInstance)
+{
+	if (scene == nullptr || !IsValidNode(scene, node))
+		return LEANDX12_ERROR_INVALID_CALL;
+
+	scene->instances[scene->slotOfNode[node]] = pInstance;
+	if (pInstance != nullptr)
+		MarkDirty(scene, node);
+
+	return LEANDX12_OK;
+}
+
+LeanDX12Result UpdateScene(Scene* scene)
+{
+	if (scene == nullptr)
+		return LEANDX12_ERROR_INVALID_CALL;
+
+	scene->stats = SCENE_STATS();
+	if (scene->layoutDirty)
+		RebuildLayout(scene);
+
+	unsigned int numLevels = (unsigned int)scene->levelBegin.size() - 1;
+	scene->stats.numNodes = scene->numNodes;
+	scene->stats.numLevels = numLevels - 1;
+
+	if (!scene->anyDirty)
+		return LEANDX12_OK;
+
+	// Os níveis anteriores ao primeiro nível alterado não são percorridos, portanto os indicadores de alteração do nível anterior a ele
+	// (lidos pelos filhos) são reiniciados.
+	unsigned int firstLevel = std::max(1u, scene->minDirtyLevel);
+	std::fill(scene->changed.begin() + scene->levelBegin[firstLevel - 1], scene->changed.begin() + scene->levelBegin[firstLevel], 0);
+
+	UPDATE_JOB job;
+	job.scene = scene;
+	job.numNodesUpdated = 0;
+	job.numInstancesWritten = 0;
+
+	for (unsigned int level = firstLevel; level < numLevels; level++)
+	{
+		job.firstSlot = scene->levelBegin[level];
+		ParallelFor(scene->levelBegin[level + 1] - scene->levelBegin[level], SCENE_NODES_PER_TASK, UpdateNodes, &job);
+	}
+
+	scene->stats.numNodesUpdated = job.numNodesUpdated;
+	scene->stats.numInstancesWritten = job.numInstancesWritten;
+	scene->anyDirty = false;
+	scene->minDirtyLevel = numLevels;
+	return LEANDX12_OK;
+}
+
+LeanDX12Result GetSceneNodeWorldMatrix(Scene* scene, unsigned int node, INSTANCE_TRANSFORM* world)
+{
+	if (scene == nullptr || world == nullptr || !IsValidNode(scene, node))
+		return LEANDX12_ERROR_INVALID_CALL;
+
+	unsigned int slot = scene->slotOfNode[node];
+	for (int row = 0; row < 3; row++)
+		for (int column = 0; column < 4; column++)
+			world->rows[row][column] = scene->world[row * 4 + column][slot];
+
+	return LEANDX12_OK;
+}
+
+void GetSceneStats(Scene* scene, SCENE_STATS* stats)
+{
+	if (scene == nullptr || stats == nullptr)
+		return;
+
+	*stats = scene->stats;
+}
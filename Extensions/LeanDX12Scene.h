@@ -0,0 +1,75 @@
+/*
+* LeanDX12 - Grafo de cena
+* Descrição: Hierarquia de nós com transformações locais e do mundo, atualizadas apenas nas subárvores alteradas.
+*
+*	As transformações são matrizes 3x4 (INSTANCE_TRANSFORM de LeanDX12Instancing.h, aplicadas a vetores coluna) armazenadas em vetores
+*	separados por elemento (SoA) e ordenadas pela profundidade dos nós na hierarquia. UpdateScene percorre os níveis a partir do primeiro
+*	nível com alterações; em cada nível, os nós são divididos entre as threads de LeanDX12Parallel.h e apenas os nós alterados (ou com
+*	ancestrais alterados) têm a sua matriz do mundo recalculada (mundo = mundo do pai * local), 4 nós por vez com SSE2 quando disponível.
+*
+*	Cada nó pode ser associado a uma transformação de instância (por exemplo, reservada uma única vez com AllocateInstances em um
+*	InstanceBuffer que não é reiniciado a cada quadro). A matriz do mundo é gravada na instância apenas quando o nó é alterado, portanto
+*	os dados enviados por BindInstanceBuffer só são reescritos para os objetos que se moveram.
+*
+*	Alterações na hierarquia (criação, exclusão e troca de pai) reorganizam os vetores na chamada seguinte de UpdateScene. As funções de
+*	uma mesma cena não devem ser chamadas por várias threads ao mesmo tempo.
+*
+*   Organização do arquivo de cabeçalho:
+*	1.	Estruturas
+*		•	Estruturas opacas
+*		•	Estruturas transparentes
+*	2.	Declaração das funções
+*/
+
+#ifndef _LEANDX12_SCENE_
+#define _LEANDX12_SCENE_
+
+#include <cstddef>
+
+#include "LeanDX12.h"
+#include "LeanDX12Instancing.h"
+
+// Valor de parent para nós sem pai.
+#define SCENE_NO_PARENT 0xFFFFFFFFu
+
+// ------------------------------------------------------------ 1. Estruturas ------------------------------------------------------------- //
+
+// -------------------------------------------------------- 1.1. Estruturas opacas -------------------------------------------------------- //
+
+typedef struct Scene Scene;
+
+// ---------------------------------------------------- 1.2. Estruturas transparentes ----------------------------------------------------- //
+
+typedef struct SCENE_STATS
+{
+	unsigned int numNodes;
+	unsigned int numLevels;
+	unsigned int numNodesUpdated;					// Nós com a matriz do mundo recalculada na última atualização.
+	unsigned int numInstancesWritten;				// Transformações de instância gravadas na última atualização.
+	BOOLEAN layoutRebuilt;							// Os vetores foram reorganizados na última atualização.
+} SCENE_STATS;
+
+// ------------------------------------------------------ 2. Declaração das funções ------------------------------------------------------- //
+
+LeanDX12Result CreateScene(unsigned int maxNodes, Scene** scene);
+void DeleteScene(Scene* scene);
+
+// Cria um nó com transformação local identidade. Os identificadores dos nós excluídos são reaproveitados.
+LeanDX12Result CreateSceneNode(Scene* scene, unsigned int parent, unsigned int* node);
+// Exclui um nó sem filhos.
+LeanDX12Result DeleteSceneNode(Scene* scene, unsigned int node);
+LeanDX12Result SetSceneNodeParent(Scene* scene, unsigned int node, unsigned int parent);
+
+// Define a transformação local a partir de escala, rotação e translação (como ComposeInstanceTransform) ou diretamente pela matriz.
+LeanDX12Result SetSceneNodeTransform(Scene* scene, unsigned int node, const float position[3], const float rotation[3], const float scale[3]);
+LeanDX12Result SetSceneNodeLocalMatrix(Scene* scene, unsigned int node, const INSTANCE_TRANSFORM* local);
+// Associa o nó à transformação de instância pInstance (NULL desfaz a associação). A matriz do mundo é gravada na próxima atualização.
+LeanDX12Result SetSceneNodeInstance(Scene* scene, unsigned int node, INSTANCE_TRANSFORM* pInstance);
+
+LeanDX12Result UpdateScene(Scene* scene);
+// Retorna a matriz do mundo calculada na última atualização.
+LeanDX12Result GetSceneNodeWorldMatrix(Scene* scene, unsigned int node, INSTANCE_TRANSFORM* world);
+
+void GetSceneStats(Scene* scene, SCENE_STATS* stats);
+
+#endif  // _LEANDX12_SCENE_
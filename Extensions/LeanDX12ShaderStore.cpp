@@ -0,0 +1,334 @@
+// Descrição: Implementação do armazenamento de shaders das extensões LeanDX12 (LeanDX12ShaderStore.h).
+
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "LeanDX12Parallel.h"
+#include "LeanDX12ShaderStore.h"
+
+namespace
+{
+	typedef struct SHADER_ENTRY
+	{
+		ShaderBinary* shaderBinary;
+		unsigned long long hash;
+		std::vector<unsigned char> contents;
+		unsigned int refCount;
+	} SHADER_ENTRY;
+
+	typedef struct MAPPED_FILE
+	{
+		const unsigned char* pData;
+		size_t size;
+#ifdef _WIN32
+		HANDLE file;
+		HANDLE mapping;
+#endif
+	} MAPPED_FILE;
+
+	typedef struct READ_JOB
+	{
+		const char* filename;
+		MAPPED_FILE file;
+		bool opened;
+		unsigned long long hash;
+	} READ_JOB;
+
+	bool MapFile(const char* filename, MAPPED_FILE* file)
+	{
+		file->pData = nullptr;
+		file->size = 0;
+
+#ifdef _WIN32
+		file->mapping = NULL;
+		file->file = CreateFileA(filename, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+		if (file->file == INVALID_HANDLE_VALUE)
+			return false;
+
+		LARGE_INTEGER size;
+		if (!GetFileSizeEx(file->file, &size))
+		{
+			CloseHandle(file->file);
+			return false;
+		}
+
+		file->size = (size_t)size.QuadPart;
+		if (file->size == 0)
+			return true;
+
+		file->mapping = CreateFileMappingA(file->file, NULL, PAGE_READONLY, 0, 0, NULL);
+		if (file->mapping != NULL)
+			file->pData = (const unsigned char*)MapViewOfFile(file->mapping, FILE_MAP_READ, 0, 0, 0);
+
+		if (file->pData == nullptr)
+		{
+			if (file->mapping != NULL)
+				CloseHandle(file->mapping);
+			CloseHandle(file->file);
+			return false;
+		}
+#else
+		int descriptor = open(filename, O_RDONLY);
+		if (descriptor < 0)
+			return false;
+
+		struct stat status;
+		if (fstat(descriptor, &status) != 0)
+		{
+			close(descriptor);
+			return false;
+		}
+
+		file->size = (size_t)status.st_size;
+		if (file->size > 0)
+		{
+			void* pData = mmap(nullptr, file->size, PROT_READ, MAP_PRIVATE, descriptor, 0);
+			file->pData = pData != MAP_FAILED ? (const unsigned char*)pData : nullptr;
+		}
+
+		// O mapeamento permanece válido após o fechamento do descritor.
+		close(descriptor);
+		if (file->size > 0 && file->pData == nullptr)
+			return false;
+#endif
+
+		return true;
+	}
+
+	void UnmapFile(MAPPED_FILE* file)
+	{
+#ifdef _WIN32
+		if (file->pData != nullptr)
+			UnmapViewOfFile(file->pData);
+		if (file->mapping != NULL)
+			CloseHandle(file->mapping);
+		CloseHandle(file->file);
+#else
+		if (file->pData != nullptr)
+			munmap((void*)file->pData, file->size);
+#endif
+	}
+
+	// FNV-1a de 64 bits.
+	unsigned long long HashContents(const unsigned char* pData, size_t size)
+	{
+		unsigned long long hash = 0xCBF29CE484222325ull;
+		for (size_t i = 0; i < size; i++)
+		{
+			hash ^= pData[i];
+			hash *= 0x100000001B3ull;
+		}
+		return hash;
+	}
+
+	void ReadFiles(unsigned int begin, unsigned int end, void* pUserData)
+	{
+		READ_JOB* jobs = (READ_JOB*)pUserData;
+
+		for (unsigned int i = begin; i < end; i++)
+		{
+			jobs[i].opened = MapFile(jobs[i].filename, &jobs[i].file);
+			if (jobs[i].opened)
+				jobs[i].hash = HashContents(jobs[i].file.pData, jobs[i].file.size);
+		}
+	}
+}
+
+struct ShaderStore
+{
+	std::mutex mutex;
+	std::vector<std::unique_ptr<SHADER_ENTRY>> entries;
+	std::unordered_multimap<unsigned long long, SHADER_ENTRY*> entriesByHash;
+	std::unordered_map<std::string, SHADER_ENTRY*> entriesByFilename;
+	std::unordered_map<ShaderBinary*, SHADER_ENTRY*> entriesByBinary;
+	SHADER_STORE_STATS stats = {};
+};
+
+namespace
+{
+	SHADER_ENTRY* FindEntry(ShaderStore* store, unsigned long long hash, const unsigned char* pData, size_t size)
+	{
+		typedef std::unordered_multimap<unsigned long long, SHADER_ENTRY*>::iterator Iterator;
+		std::pair<Iterator, Iterator> range = store->entriesByHash.equal_range(hash);
+
+		for (Iterator entry = range.first; entry != range.second; ++entry)
+		{
+			const std::vector<unsigned char>& contents = entry->second->contents;
+			if (contents.size() == size && (size == 0 || memcmp(contents.data(), pData, size) == 0))
+				return entry->second;
+		}
+
+		return nullptr;
+	}
+
+	SHADER_ENTRY* FindEntry(ShaderStore* store, ShaderBinary* shaderBinary)
+	{
+		std::unordered_map<ShaderBinary*, SHADER_ENTRY*>::iterator entry = store->entriesByBinary.find(shaderBinary);
+		return entry != store->entriesByBinary.end() ? entry->second : nullptr;
+	}
+}
+
+LeanDX12Result CreateShaderStore(ShaderStore** store)
+{
+	if (store == nullptr)
+		return LEANDX12_ERROR_INVALID_CALL;
+
+	*store = new ShaderStore;
+	return LEANDX12_OK;
+}
+
+void DeleteShaderStore(ShaderStore* store)
+{
+	delete store;
+}
+
+LeanDX12Result LoadShaders(ShaderStore* store, unsigned int numShaders, const char* const* filenames, ShaderBinary** shaderBinaries)
+{
+	if (store == nullptr || (numShaders > 0 && (filenames == nullptr || shaderBinaries == nullptr)))
+		return LEANDX12_ERROR_INVALID_CALL;
+
+	for (unsigned int i = 0; i < numShaders; i++)
+		if (filenames[i] == nullptr)
+			return LEANDX12_ERROR_INVALID_CALL;
+
+	std::lock_guard<std::mutex> lock(store->mutex);
+	store->stats.numFilesRequested += numShaders;
+
+	// Arquivos já carregados pelo nome não são lidos novamente.
+	std::vector<SHADER_ENTRY*> resolved(numShaders, nullptr);
+	std::vector<READ_JOB> jobs;
+	std::unordered_map<std::string, unsigned int> jobsByFilename;
+
+	for (unsigned int i = 0; i < numShaders; i++)
+	{
+		std::unordered_map<std::string, SHADER_ENTRY*>::iterator entry = store->entriesByFilename.find(filenames[i]);
+		if (entry != store->entriesByFilename.end())
+		{
+			resolved[i] = entry->second;
+			continue;
+		}
+
+		if (jobsByFilename.find(filenames[i]) != jobsByFilename.end())
+			continue;
+
+		READ_JOB job = {};
+		job.filename = filenames[i];
+		jobsByFilename[filenames[i]] = (unsigned int)jobs.size();
+		jobs.push_back(job);
+	}
+
+	ParallelFor((unsigned int)jobs.size(), 1, ReadFiles, jobs.data());
+
+	LeanDX12Result result = LEANDX12_OK;
+	for (size_t i = 0; i < jobs.size(); i++)
+		if (!jobs[i].opened)
+			result = LEANDX12_ERROR_OPEN_FILE_FAILED;
+
+	// Os binários distintos são carregados pela thread chamadora, na ordem da lista.
+	for (size_t i = 0; i < jobs.size() && result == LEANDX12_OK; i++)
+	{
+		READ_JOB& job = jobs[i];
+		store->stats.numFilesRead++;
+		store->stats.bytesRead += job.file.size;
+
+		SHADER_ENTRY* entry = FindEntry(store, job.hash, job.file.pData, job.file.size);
+		if (entry != nullptr)
+			store->stats.numDuplicateFiles++;
+		else
+		{
+			ShaderBinary* shaderBinary;
+			result = LoadShaderFromFile(job.filename, &shaderBinary);
+			if (result != LEANDX12_OK)
+				break;
+
+			std::unique_ptr<SHADER_ENTRY> newEntry(new SHADER_ENTRY);
+			newEntry->shaderBinary = shaderBinary;
+			newEntry->hash = job.hash;
+			newEntry->contents.assign(job.file.pData, job.file.pData + job.file.size);
+			newEntry->refCount = 0;
+
+			entry = newEntry.get();
+			store->entries.push_back(std::move(newEntry));
+			store->entriesByHash.insert(std::make_pair(job.hash, entry));
+			store->entriesByBinary[shaderBinary] = entry;
+		}
+
+		store->entriesByFilename[job.filename] = entry;
+	}
+
+	for (size_t i = 0; i < jobs.size(); i++)
+		if (jobs[i].opened)
+			UnmapFile(&jobs[i].file);
+
+	if (result != LEANDX12_OK)
+		return result;
+
+	for (unsigned int i = 0; i < numShaders; i++)
+	{
+		if (resolved[i] == nullptr)
+			resolved[i] = store->entriesByFilename[filenames[i]];
+
+		resolved[i]->refCount++;
+		shaderBinaries[i] = resolved[i]->shaderBinary;
+	}
+
+	return LEANDX12_OK;
+}
+
+unsigned int AddShaderReference(ShaderStore* store, ShaderBinary* shaderBinary)
+{
+	if (store == nullptr)
+		return 0;
+
+	std::lock_guard<std::mutex> lock(store->mutex);
+	SHADER_ENTRY* entry = FindEntry(store, shaderBinary);
+	return entry != nullptr ? ++entry->refCount : 0;
+}
+
+unsigned int ReleaseShader(ShaderStore* store, ShaderBinary* shaderBinary)
+{
+	if (store == nullptr)
+		return 0;
+
+	std::lock_guard<std::mutex> lock(store->mutex);
+	SHADER_ENTRY* entry = FindEntry(store, shaderBinary);
+	if (entry == nullptr || entry->refCount == 0)
+		return 0;
+
+	return --entry->refCount;
+}
+
+void GetShaderStoreStats(ShaderStore* store, SHADER_STORE_STATS* stats)
+{
+	if (store == nullptr || stats == nullptr)
+		return;
+
+	std::lock_guard<std::mutex> lock(store->mutex);
+
+	*stats = store->stats;
+	stats->numShaders = (unsigned int)store->entries.size();
+	stats->numReferencedShaders = 0;
+	for (size_t i = 0; i < store->entries.size(); i++)
+		if (store->entries[i]->refCount > 0)
+			stats->numReferencedShaders++;
+}
@@ -0,0 +1,65 @@
+/*
+* LeanDX12 - Armazenamento de shaders
+* Descrição: Carregamento de listas de shaders compilados (.cso) com leitura paralela dos arquivos e eliminação de binários duplicados.
+*
+*	LoadShaders lê todos os arquivos da lista em paralelo (arquivos mapeados em memória, distribuídos entre as threads de
+*	LeanDX12Parallel.h) e identifica cada binário pelo seu conteúdo. Arquivos com conteúdo idêntico, na mesma lista ou em chamadas
+*	anteriores, resultam no mesmo ShaderBinary, e apenas os binários distintos são carregados por LoadShaderFromFile (a partir do cache
+*	de arquivos do sistema, já preenchido pela leitura paralela). Arquivos já carregados pelo mesmo nome não são lidos novamente.
+*
+*	Apenas a leitura e o cálculo do hash dos arquivos são paralelos. LeanDX12.h só cria um ShaderBinary a partir de um arquivo
+*	(LoadShaderFromFile), e as suas funções não podem ser chamadas por várias threads ao mesmo tempo, portanto os binários distintos
+*	são criados um a um pela thread chamadora, que lê cada arquivo novamente.
+*
+*	Cada ShaderBinary retornado recebe uma referência, liberada por ReleaseShader. A biblioteca não possui função de exclusão de
+*	ShaderBinary, portanto binários sem referências permanecem no armazenamento e são reaproveitados em carregamentos futuros.
+*
+*	As funções de um mesmo armazenamento podem ser chamadas de qualquer thread.
+*
+*   Organização do arquivo de cabeçalho:
+*	1.	Estruturas
+*		•	Estruturas opacas
+*		•	Estruturas transparentes
+*	2.	Declaração das funções
+*/
+
+#ifndef _LEANDX12_SHADER_STORE_
+#define _LEANDX12_SHADER_STORE_
+
+#include <cstddef>
+
+#include "LeanDX12.h"
+
+// ------------------------------------------------------------ 1. Estruturas ------------------------------------------------------------- //
+
+// -------------------------------------------------------- 1.1. Estruturas opacas -------------------------------------------------------- //
+
+typedef struct ShaderStore ShaderStore;
+
+// ---------------------------------------------------- 1.2. Estruturas transparentes ----------------------------------------------------- //
+
+typedef struct SHADER_STORE_STATS
+{
+	unsigned int numShaders;						// Binários distintos no armazenamento.
+	unsigned int numReferencedShaders;				// Binários com pelo menos uma referência.
+	unsigned long long numFilesRequested;
+	unsigned long long numFilesRead;
+	unsigned long long numDuplicateFiles;			// Arquivos lidos cujo conteúdo já estava no armazenamento.
+	unsigned long long bytesRead;
+} SHADER_STORE_STATS;
+
+// ------------------------------------------------------ 2. Declaração das funções ------------------------------------------------------- //
+
+LeanDX12Result CreateShaderStore(ShaderStore** store);
+// Os ShaderBinary carregados permanecem válidos após a exclusão do armazenamento.
+void DeleteShaderStore(ShaderStore* store);
+
+// Carrega numShaders arquivos em shaderBinaries. Em caso de erro, nenhuma referência é adicionada.
+LeanDX12Result LoadShaders(ShaderStore* store, unsigned int numShaders, const char* const* filenames, ShaderBinary** shaderBinaries);
+// Adiciona ou libera uma referência e retorna o número de referências restantes.
+unsigned int AddShaderReference(ShaderStore* store, ShaderBinary* shaderBinary);
+unsigned int ReleaseShader(ShaderStore* store, ShaderBinary* shaderBinary);
+
+void GetShaderStoreStats(ShaderStore* store, SHADER_STORE_STATS* stats);
+
+#endif  // _LEANDX12_SHADER_STORE_
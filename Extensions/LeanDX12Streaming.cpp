@@ -0,0 +1,436 @@
+// Descrição: Implementação do gerenciador de streaming de texturas das extensões LeanDX12 (LeanDX12Streaming.h).
+
+#include <algorithm>
+#include <cmath>
+#include <queue>
+#include <utility>
+#include <vector>
+
+#include "LeanDX12Streaming.h"
+#include "LeanDX12Frame.h"
+
+#define DEFAULT_MIP_TAIL_MAX_DIMENSION 64
+
+struct StreamedTexture
+{
+	TextureStreamer* streamer;
+	Texture* resource;
+	unsigned int width;
+	unsigned int height;
+	unsigned int depth;
+	unsigned short mipLevels;
+	RESOURCE_FORMAT format;
+	unsigned int texelSize;
+	unsigned short mipTailFirstLevel;
+	unsigned short requestedMipLevel;
+	unsigned short residentMipLevel;
+	float priority;
+	unsigned long long lastUsedUpdate;
+	unsigned long long residentBytes;
+	LOAD_MIP_CALLBACK loadMip;
+	void* pUserData;
+};
+
+struct TextureStreamer
+{
+	TEXTURE_STREAMER_DESC desc;
+	STREAMING_DEVICE device;
+	std::vector<StreamedTexture*> textures;
+	std::vector<unsigned char> stagingData;
+	unsigned long long residentBytes;
+	unsigned long long currentUpdate;
+	unsigned int numUploadsLastUpdate;
+	unsigned long long uploadedBytesLastUpdate;
+	unsigned int numEvictionsLastUpdate;
+};
+
+namespace
+{
+	LeanDX12Result CreateUploadBufferDefault(unsigned long long sizeInBytes, Buffer** buffer)
+	{
+		return CreateBuffer(sizeInBytes, BUFFER_TYPE_UPLOAD, buffer);
+	}
+
+	LeanDX12Result SetPrivateDataAsyncDefault(Texture* texture, unsigned short mipLevel, unsigned long long* sizeInBytes, Buffer* uploadBuffer)
+	{
+		return SetPrivateDataAsync(texture, mipLevel, sizeInBytes, uploadBuffer);
+	}
+
+	unsigned int MipDimension(unsigned int dimension, unsigned short mipLevel)
+	{
+		unsigned int result = dimension >> mipLevel;
+		return result > 0 ? result : 1;
+	}
+
+	unsigned long long MipBytes(const StreamedTexture* texture, unsigned short mipLevel)
+	{
+		return (unsigned long long)texture->texelSize * MipDimension(texture->width, mipLevel) *
+			MipDimension(texture->height, mipLevel) * MipDimension(texture->depth, mipLevel);
+	}
+
+	LeanDX12Result LoadMip(StreamedTexture* texture, unsigned short mipLevel)
+	{
+		TextureStreamer* streamer = texture->streamer;
+		const STREAMING_DEVICE& device = streamer->device;
+
+		unsigned long long dataSize = MipBytes(texture, mipLevel);
+		if (streamer->stagingData.size() < dataSize)
+			streamer->stagingData.resize((size_t)dataSize);
+
+		LeanDX12Result result = texture->loadMip(texture->pUserData, mipLevel, streamer->stagingData.data(), dataSize);
+		if (result != LEANDX12_OK)
+			return result;
+
+		unsigned long long uploadBufferSize;
+		result = device.SetPrivateDataAsync(texture->resource, mipLevel, &uploadBufferSize, NULL);
+		if (result != LEANDX12_OK && result != LEANDX12_INFO_REQUIRED_BUFFER_SIZE)
+			return result;
+
+		Buffer* uploadBuffer;
+		result = device.CreateUploadBuffer(uploadBufferSize, &uploadBuffer);
+		if (result != LEANDX12_OK)
+			return result;
+
+		result = device.UploadData(uploadBuffer, NULL, texture->texelSize,
+			MipDimension(texture->width, mipLevel), MipDimension(texture->height, mipLevel), MipDimension(texture->depth, mipLevel),
+			streamer->stagingData.data());
+		if (result == LEANDX12_OK)
+			result = device.SetPrivateDataAsync(texture->resource, mipLevel, NULL, uploadBuffer);
+
+		device.DeleteUploadBuffer(uploadBuffer);
+		return result;
+	}
+
+	// Nível mínimo (mais detalhado) que deve ser preservado ao descartar níveis de uma textura.
+	unsigned short EvictionFloor(const StreamedTexture* texture)
+	{
+		if (texture->lastUsedUpdate == texture->streamer->currentUpdate)
+			return std::min(texture->requestedMipLevel, texture->mipTailFirstLevel);
+		return texture->mipTailFirstLevel;
+	}
+
+	bool CompareLeastRecentlyUsed(const StreamedTexture* a, const StreamedTexture* b)
+	{
+		return a->lastUsedUpdate < b->lastUsedUpdate;
+	}
+
+	// Descarta os níveis mais detalhados das texturas utilizadas há mais tempo até que bytesNeeded caibam no orçamento. Nenhum nível é
+	// descartado se o espaço liberado não for suficiente.
+	bool Evict(TextureStreamer* streamer, unsigned long long bytesNeeded, const StreamedTexture* exclude)
+	{
+		std::vector<StreamedTexture*> candidates;
+		unsigned long long evictableBytes = 0;
+		for (size_t i = 0; i < streamer->textures.size(); i++)
+		{
+			StreamedTexture* texture = streamer->textures[i];
+			unsigned short floor = EvictionFloor(texture);
+			if (texture == exclude || texture->residentMipLevel >= floor)
+				continue;
+
+			candidates.push_back(texture);
+			for (unsigned short mipLevel = texture->residentMipLevel; mipLevel < floor; mipLevel++)
+				evictableBytes += MipBytes(texture, mipLevel);
+		}
+
+		if (streamer->residentBytes - evictableBytes + bytesNeeded > streamer->desc.memoryBudget)
+			return false;
+
+		std::sort(candidates.begin(), candidates.end(), CompareLeastRecentlyUsed);
+
+		for (size_t i = 0; i < candidates.size(); i++)
+		{
+			StreamedTexture* texture = candidates[i];
+			unsigned short floor = EvictionFloor(texture);
+
+			while (texture->residentMipLevel < floor && streamer->residentBytes + bytesNeeded > streamer->desc.memoryBudget)
+			{
+				unsigned long long bytes = MipBytes(texture, texture->residentMipLevel);
+				texture->residentMipLevel++;
+				texture->residentBytes -= bytes;
+				streamer->residentBytes -= bytes;
+				streamer->numEvictionsLastUpdate++;
+				streamer->device.SetActiveMipLevel(texture->resource, texture->residentMipLevel);
+			}
+
+			if (streamer->residentBytes + bytesNeeded <= streamer->desc.memoryBudget)
+				break;
+		}
+
+		return true;
+	}
+
+	float StreamingPriority(const StreamedTexture* texture)
+	{
+		return texture->priority * (float)(texture->residentMipLevel - texture->requestedMipLevel);
+	}
+}
+
+void GetDefaultStreamingDevice(STREAMING_DEVICE* device)
+{
+	if (device == nullptr)
+		return;
+
+	device->CreateTexture = CreateTexture;
+	device->DeleteTexture = DeleteTextureDeferred;
+	device->CreateUploadBuffer = CreateUploadBufferDefault;
+	device->DeleteUploadBuffer = DeleteBufferDeferred;
+	device->UploadData = UploadData;
+	device->SetPrivateDataAsync = SetPrivateDataAsyncDefault;
+	device->SetActiveMipLevel = SetActiveMipLevel;
+	device->TexelSize = TexelSize;
+}
+
+LeanDX12Result CreateTextureStreamer(const TEXTURE_STREAMER_DESC* desc, const STREAMING_DEVICE* device, TextureStreamer** streamer)
+{
+	if (desc == nullptr || streamer == nullptr)
+		return LEANDX12_ERROR_INVALID_CALL;
+
+	TextureStreamer* newStreamer = new TextureStreamer;
+	newStreamer->desc = *desc;
+	if (newStreamer->desc.mipTailMaxDimension == 0)
+		newStreamer->desc.mipTailMaxDimension = DEFAULT_MIP_TAIL_MAX_DIMENSION;
+
+	if (device != nullptr)
+		newStreamer->device = *device;
+	else
+		GetDefaultStreamingDevice(&newStreamer->device);
+
+	newStreamer->residentBytes = 0;
+	newStreamer->currentUpdate = 0;
+	newStreamer->numUploadsLastUpdate = 0;
+	newStreamer->uploadedBytesLastUpdate = 0;
+	newStreamer->numEvictionsLastUpdate = 0;
+
+	*streamer = newStreamer;
+	return LEANDX12_OK;
+}
+
+void DeleteTextureStreamer(TextureStreamer* streamer)
+{
+	if (streamer == nullptr)
+		return;
+
+	while (!streamer->textures.empty())
+		DeleteStreamedTexture(streamer, streamer->textures.back());
+
+	delete streamer;
+}
+
+LeanDX12Result CreateStreamedTexture(
+	TextureStreamer* streamer,
+	unsigned int width, unsigned int height, unsigned int depth, unsigned short mipLevels, RESOURCE_FORMAT format,
+	unsigned int offsetFromDescriptorTableStart,
+	LOAD_MIP_CALLBACK loadMip, void* pUserData,
+	StreamedTexture** texture)
+{
+	if (streamer == nullptr || texture == nullptr || loadMip == nullptr || width == 0 || height == 0 || depth == 0 || mipLevels == 0)
+		return LEANDX12_ERROR_INVALID_CALL;
+
+	StreamedTexture* newTexture = new StreamedTexture;
+	newTexture->streamer = streamer;
+	newTexture->width = width;
+	newTexture->height = height;
+	newTexture->depth = depth;
+	newTexture->mipLevels = mipLevels;
+	newTexture->format = format;
+	newTexture->texelSize = streamer->device.TexelSize(format);
+	newTexture->priority = 0.0f;
+	newTexture->lastUsedUpdate = streamer->currentUpdate;
+	newTexture->residentBytes = 0;
+	newTexture->loadMip = loadMip;
+	newTexture->pUserData = pUserData;
+
+	unsigned short tailFirstLevel = 0;
+	while (tailFirstLevel < mipLevels - 1 &&
+		std::max(std::max(MipDimension(width, tailFirstLevel), MipDimension(height, tailFirstLevel)), MipDimension(depth, tailFirstLevel)) >
+		streamer->desc.mipTailMaxDimension)
+		tailFirstLevel++;
+
+	newTexture->mipTailFirstLevel = tailFirstLevel;
+	newTexture->requestedMipLevel = tailFirstLevel;
+	newTexture->residentMipLevel = mipLevels;
+
+	LeanDX12Result result = streamer->device.CreateTexture(width, height, depth, mipLevels, format, &newTexture->resource, offsetFromDescriptorTableStart);
+	if (result != LEANDX12_OK)
+	{
+		delete newTexture;
+		return result;
+	}
+
+	// A cauda de mipmaps é carregada imediatamente e permanece residente até a exclusão da textura.
+	for (int mipLevel = mipLevels - 1; mipLevel >= tailFirstLevel; mipLevel--)
+	{
+		result = LoadMip(newTexture, (unsigned short)mipLevel);
+		if (result != LEANDX12_OK)
+		{
+			streamer->device.DeleteTexture(newTexture->resource);
+			delete newTexture;
+			return result;
+		}
+
+		unsigned long long bytes = MipBytes(newTexture, (unsigned short)mipLevel);
+		newTexture->residentMipLevel = (unsigned short)mipLevel;
+		newTexture->residentBytes += bytes;
+		streamer->residentBytes += bytes;
+	}
+
+	streamer->device.SetActiveMipLevel(newTexture->resource, newTexture->residentMipLevel);
+	streamer->textures.push_back(newTexture);
+
+	*texture = newTexture;
+	return LEANDX12_OK;
+}
+
+LeanDX12Result DeleteStreamedTexture(TextureStreamer* streamer, StreamedTexture* texture)
+{
+	if (streamer == nullptr || texture == nullptr || texture->streamer != streamer)
+		return LEANDX12_ERROR_INVALID_CALL;
+
+	std::vector<StreamedTexture*>::iterator it = std::find(streamer->textures.begin(), streamer->textures.end(), texture);
+	if (it == streamer->textures.end())
+		return LEANDX12_ERROR_INVALID_CALL;
+
+	*it = streamer->textures.back();
+	streamer->textures.pop_back();
+
+	streamer->residentBytes -= texture->residentBytes;
+	LeanDX12Result result = streamer->device.DeleteTexture(texture->resource);
+	delete texture;
+
+	return result;
+}
+
+Texture* GetStreamedTextureResource(StreamedTexture* texture)
+{
+	return texture != nullptr ? texture->resource : nullptr;
+}
+
+LeanDX12Result RequestMipLevel(StreamedTexture* texture, unsigned short mipLevel, float priority)
+{
+	if (texture == nullptr)
+		return LEANDX12_ERROR_INVALID_CALL;
+
+	if (mipLevel >= texture->mipLevels)
+		mipLevel = texture->mipLevels - 1;
+
+	// Várias solicitações no mesmo quadro: prevalece o nível mais detalhado e a maior prioridade.
+	if (texture->lastUsedUpdate != texture->streamer->currentUpdate)
+	{
+		texture->requestedMipLevel = mipLevel;
+		texture->priority = priority;
+		texture->lastUsedUpdate = texture->streamer->currentUpdate;
+	}
+	else
+	{
+		texture->requestedMipLevel = std::min(texture->requestedMipLevel, mipLevel);
+		texture->priority = std::max(texture->priority, priority);
+	}
+
+	return LEANDX12_OK;
+}
+
+unsigned short ComputeRequiredMipLevel(unsigned int textureWidth, unsigned int textureHeight, float screenWidth, float screenHeight)
+{
+	if (screenWidth <= 0.0f || screenHeight <= 0.0f)
+		return 0xFFFF;
+
+	float ratio = std::max((float)textureWidth / screenWidth, (float)textureHeight / screenHeight);
+	if (ratio <= 1.0f)
+		return 0;
+
+	return (unsigned short)std::min(floorf(log2f(ratio)), 15.0f);
+}
+
+LeanDX12Result UpdateTextureStreamer(TextureStreamer* streamer)
+{
+	if (streamer == nullptr)
+		return LEANDX12_ERROR_INVALID_CALL;
+
+	streamer->numUploadsLastUpdate = 0;
+	streamer->uploadedBytesLastUpdate = 0;
+	streamer->numEvictionsLastUpdate = 0;
+
+	typedef std::pair<float, StreamedTexture*> QueueEntry;
+	std::priority_queue<QueueEntry> queue;
+
+	for (size_t i = 0; i < streamer->textures.size(); i++)
+	{
+		StreamedTexture* texture = streamer->textures[i];
+		if (texture->lastUsedUpdate == streamer->currentUpdate && texture->requestedMipLevel < texture->residentMipLevel)
+			queue.push(QueueEntry(StreamingPriority(texture), texture));
+	}
+
+	LeanDX12Result result = LEANDX12_OK;
+
+	while (!queue.empty())
+	{
+		if (streamer->desc.maxUploadsPerUpdate != 0 && streamer->numUploadsLastUpdate >= streamer->desc.maxUploadsPerUpdate)
+			break;
+
+		StreamedTexture* texture = queue.top().second;
+		queue.pop();
+
+		unsigned short mipLevel = texture->residentMipLevel - 1;
+		unsigned long long bytes = MipBytes(texture, mipLevel);
+
+		if (streamer->desc.maxUploadBytesPerUpdate != 0 && streamer->numUploadsLastUpdate > 0 &&
+			streamer->uploadedBytesLastUpdate + bytes > streamer->desc.maxUploadBytesPerUpdate)
+			continue;
+
+		if (streamer->residentBytes + bytes > streamer->desc.memoryBudget && !Evict(streamer, bytes, texture))
+			continue;
+
+		result = LoadMip(texture, mipLevel);
+		if (result != LEANDX12_OK)
+			break;
+
+		texture->residentMipLevel = mipLevel;
+		texture->residentBytes += bytes;
+		streamer->residentBytes += bytes;
+		streamer->numUploadsLastUpdate++;
+		streamer->uploadedBytesLastUpdate += bytes;
+		streamer->device.SetActiveMipLevel(texture->resource, mipLevel);
+
+		if (texture->requestedMipLevel < texture->residentMipLevel)
+			queue.push(QueueEntry(StreamingPriority(texture), texture));
+	}
+
+	streamer->currentUpdate++;
+	return result;
+}
+
+void GetStreamedTextureStats(StreamedTexture* texture, STREAMED_TEXTURE_STATS* stats)
+{
+	if (texture == nullptr || stats == nullptr)
+		return;
+
+	stats->mipLevels = texture->mipLevels;
+	stats->mipTailFirstLevel = texture->mipTailFirstLevel;
+	stats->requestedMipLevel = texture->requestedMipLevel;
+	stats->residentMipLevel = texture->residentMipLevel;
+	stats->residentBytes = texture->residentBytes;
+	stats->lastUsedUpdate = texture->lastUsedUpdate;
+}
+
+void GetTextureStreamerStats(TextureStreamer* streamer, TEXTURE_STREAMER_STATS* stats)
+{
+	if (streamer == nullptr || stats == nullptr)
+		return;
+
+	stats->numTextures = (unsigned int)streamer->textures.size();
+	stats->numPendingTextures = 0;
+	for (size_t i = 0; i < streamer->textures.size(); i++)
+	{
+		// Como em UpdateTextureStreamer, apenas as solicitações da última atualização (ou do quadro atual) estão pendentes.
+		const StreamedTexture* texture = streamer->textures[i];
+		if (texture->lastUsedUpdate + 1 >= streamer->currentUpdate && texture->requestedMipLevel < texture->residentMipLevel)
+			stats->numPendingTextures++;
+	}
+
+	stats->residentBytes = streamer->residentBytes;
+	stats->memoryBudget = streamer->desc.memoryBudget;
+	stats->numUploadsLastUpdate = streamer->numUploadsLastUpdate;
+	stats->uploadedBytesLastUpdate = streamer->uploadedBytesLastUpdate;
+	stats->numEvictionsLastUpdate = streamer->numEvictionsLastUpdate;
+	stats->numUpdates = streamer->currentUpdate;
+}
@@ -0,0 +1,115 @@
+/*
+* LeanDX12 - Streaming de texturas
+* Descrição: Gerenciador de streaming de níveis de mipmap construído sobre CreateTexture, SetPrivateDataAsync e SetActiveMipLevel.
+*
+*	Cada textura gerenciada mantém sempre residente a sua cauda de mipmaps (os níveis cuja maior dimensão é menor ou igual a
+*	mipTailMaxDimension), carregada no momento da criação. Os níveis mais detalhados são carregados sob demanda: a aplicação informa, a cada
+*	quadro, o nível de mipmap necessário para cada textura visível (RequestMipLevel) e UpdateTextureStreamer envia os níveis pendentes em
+*	ordem de prioridade, respeitando o orçamento de memória e os limites de envio por quadro. Quando o orçamento é excedido, os níveis mais
+*	detalhados das texturas utilizadas há mais tempo (LRU) são descartados.
+*
+*	Os níveis residentes são sempre contíguos (do nível residente mais detalhado até o último nível da cadeia) e o nível ativo da textura
+*	(SetActiveMipLevel) acompanha o nível residente mais detalhado. O orçamento contabiliza os bytes dos níveis residentes.
+*
+*	As operações sobre o dispositivo são feitas por meio da tabela STREAMING_DEVICE. GetDefaultStreamingDevice preenche a tabela com as
+*	funções de LeanDX12.h (com os buffers de envio excluídos por DeleteBufferDeferred, de LeanDX12Frame.h); outras tabelas podem ser
+*	utilizadas para simular o dispositivo.
+*
+*	As funções deste módulo devem ser chamadas da thread de renderização.
+*
+*   Organização do arquivo de cabeçalho:
+*	1.	Estruturas
+*		•	Estruturas opacas
+*		•	Estruturas transparentes
+*	2.	Declaração das funções
+*/
+
+#ifndef _LEANDX12_STREAMING_
+#define _LEANDX12_STREAMING_
+
+#include <cstddef>
+
+#include "LeanDX12.h"
+
+// ------------------------------------------------------------ 1. Estruturas ------------------------------------------------------------- //
+
+// -------------------------------------------------------- 1.1. Estruturas opacas -------------------------------------------------------- //
+
+typedef struct TextureStreamer TextureStreamer;
+typedef struct StreamedTexture StreamedTexture;
+
+// ---------------------------------------------------- 1.2. Estruturas transparentes ----------------------------------------------------- //
+
+// Carrega os dados (texels contíguos, sem preenchimento entre linhas) do nível mipLevel em pData.
+typedef LeanDX12Result (*LOAD_MIP_CALLBACK)(void* pUserData, unsigned short mipLevel, void* pData, unsigned long long dataSize);
+
+typedef struct STREAMING_DEVICE
+{
+	LeanDX12Result (*CreateTexture)(unsigned int width, unsigned int height, unsigned int depth, unsigned short mipLevels, RESOURCE_FORMAT format, Texture** texture, unsigned int offsetFromDescriptorTableStart);
+	LeanDX12Result (*DeleteTexture)(Texture* texture);
+	LeanDX12Result (*CreateUploadBuffer)(unsigned long long sizeInBytes, Buffer** buffer);
+	LeanDX12Result (*DeleteUploadBuffer)(Buffer* buffer);
+	LeanDX12Result (*UploadData)(Buffer* uploadBuffer, unsigned long long* requiredBufferSize, unsigned int texelSize, unsigned int textureWidth, unsigned int textureHeight, unsigned int textureDepth, void* pData);
+	LeanDX12Result (*SetPrivateDataAsync)(Texture* texture, unsigned short mipLevel, unsigned long long* sizeInBytes, Buffer* uploadBuffer);
+	LeanDX12Result (*SetActiveMipLevel)(Texture* texture, unsigned short mipLevel);
+	unsigned int (*TexelSize)(RESOURCE_FORMAT resourceFormat);
+} STREAMING_DEVICE;
+
+typedef struct TEXTURE_STREAMER_DESC
+{
+	unsigned long long memoryBudget;			// Bytes de níveis residentes permitidos (as caudas de mipmaps não são descartadas).
+	unsigned int mipTailMaxDimension;			// 0 = 64 texels.
+	unsigned int maxUploadsPerUpdate;			// 0 = sem limite.
+	unsigned long long maxUploadBytesPerUpdate;	// 0 = sem limite.
+} TEXTURE_STREAMER_DESC;
+
+typedef struct STREAMED_TEXTURE_STATS
+{
+	unsigned short mipLevels;
+	unsigned short mipTailFirstLevel;
+	unsigned short requestedMipLevel;
+	unsigned short residentMipLevel;
+	unsigned long long residentBytes;
+	unsigned long long lastUsedUpdate;
+} STREAMED_TEXTURE_STATS;
+
+typedef struct TEXTURE_STREAMER_STATS
+{
+	unsigned int numTextures;
+	unsigned int numPendingTextures;			// Texturas solicitadas na última atualização (ou no quadro atual) cujo nível residente
+												// é menos detalhado que o solicitado.
+	unsigned long long residentBytes;
+	unsigned long long memoryBudget;
+	unsigned int numUploadsLastUpdate;
+	unsigned long long uploadedBytesLastUpdate;
+	unsigned int numEvictionsLastUpdate;
+	unsigned long long numUpdates;
+} TEXTURE_STREAMER_STATS;
+
+// ------------------------------------------------------ 2. Declaração das funções ------------------------------------------------------- //
+
+void GetDefaultStreamingDevice(STREAMING_DEVICE* device);
+
+LeanDX12Result CreateTextureStreamer(const TEXTURE_STREAMER_DESC* desc, const STREAMING_DEVICE* device, TextureStreamer** streamer);
+void DeleteTextureStreamer(TextureStreamer* streamer);
+
+LeanDX12Result CreateStreamedTexture(
+	TextureStreamer* streamer,
+	unsigned int width, unsigned int height, unsigned int depth, unsigned short mipLevels, RESOURCE_FORMAT format,
+	unsigned int offsetFromDescriptorTableStart,
+	LOAD_MIP_CALLBACK loadMip, void* pUserData,
+	StreamedTexture** texture);
+LeanDX12Result DeleteStreamedTexture(TextureStreamer* streamer, StreamedTexture* texture);
+Texture* GetStreamedTextureResource(StreamedTexture* texture);
+
+// Solicita o nível de mipmap mipLevel para o quadro atual. Texturas com maior prioridade são atendidas primeiro.
+LeanDX12Result RequestMipLevel(StreamedTexture* texture, unsigned short mipLevel, float priority = 1.0f);
+// Nível de mipmap necessário para exibir uma textura de textureWidth x textureHeight texels ocupando screenWidth x screenHeight pixels.
+unsigned short ComputeRequiredMipLevel(unsigned int textureWidth, unsigned int textureHeight, float screenWidth, float screenHeight);
+// Processa as solicitações do quadro: descarta níveis (LRU) quando necessário e envia os níveis pendentes em ordem de prioridade.
+LeanDX12Result UpdateTextureStreamer(TextureStreamer* streamer);
+
+void GetStreamedTextureStats(StreamedTexture* texture, STREAMED_TEXTURE_STATS* stats);
+void GetTextureStreamerStats(TextureStreamer* streamer, TEXTURE_STREAMER_STATS* stats);
+
+#endif  // _LEANDX12_STREAMING_
@@ -0,0 +1,190 @@
+// Descrição: Validação da conversão de formatos (LeanDX12Format.h): ConvertFormat (tabelas, SIMD e threads) é comparada com a
+// implementação escalar de referência (ConvertFormatReference) para todos os pares de formatos de origem e destino.
+//
+// Compilação (a partir da raiz do repositório):
+//	g++ -std=c++14 -O2 -I. -IExtensions Tests/LeanDX12FormatTest.cpp Extensions/LeanDX12Format.cpp Extensions/LeanDX12Parallel.cpp
+//		-pthread
+
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <vector>
+
+#include "LeanDX12Format.h"
+#include "LeanDX12Parallel.h"
+
+// Imagem grande o suficiente para ser dividida em vários blocos de ParallelFor (CONVERSION_TEXELS_PER_TASK texels por bloco), com
+// largura que não é múltipla do tamanho dos grupos de texels (64) nem dos vetores (4 e 8 texels).
+#define IMAGE_WIDTH 333
+#define IMAGE_HEIGHT 160
+// Espaço de sobra no fim das linhas (row pitch maior que a linha) e deslocamento dos ponteiros, que deixa os dados desalinhados.
+#define ROW_PADDING 24
+#define POINTER_OFFSET 1
+#define MAX_TEXEL_SIZE 16
+
+namespace
+{
+	int numFailures = 0;
+
+	void Check(bool condition, const char* description, int line)
+	{
+		if (!condition)
+		{
+			printf("Falha (linha %d): %s\n", line, description);
+			numFailures++;
+		}
+	}
+
+#define CHECK(condition) Check((condition), #condition, __LINE__)
+
+	std::vector<RESOURCE_FORMAT> GetSupportedFormats()
+	{
+		std::vector<RESOURCE_FORMAT> formats;
+		for (unsigned int format = RESOURCE_FORMAT_UNKNOWN + 1; format <= RESOURCE_FORMAT_D32_FLOAT_S8X24_UINT; format++)
+			if (IsConversionSupported((RESOURCE_FORMAT)format))
+				formats.push_back((RESOURCE_FORMAT)format);
+		return formats;
+	}
+
+	// Tamanho do texel, obtido pelo menor row pitch aceito por ConvertFormat para uma linha de um texel.
+	unsigned int GetTexelSize(RESOURCE_FORMAT format)
+	{
+		unsigned char src[MAX_TEXEL_SIZE] = {}, dest[MAX_TEXEL_SIZE];
+		for (unsigned int size = 1; size < MAX_TEXEL_SIZE; size++)
+			if (ConvertFormatReference(RESOURCE_FORMAT_R32G32B32A32_FLOAT, src, 0, format, dest, size, 1, 1) == LEANDX12_OK)
+				return size;
+		return MAX_TEXEL_SIZE;
+	}
+
+	// Imagem de origem: linhas pares com bytes aleatórios (inclusive NaN, infinitos e subnormais nos formatos de ponto flutuante) e
+	// linhas ímpares codificadas a partir de valores em [-1.5, 2.5] e de valores inteiros, que cobrem as faixas usuais dos formatos.
+	void FillSource(RESOURCE_FORMAT format, unsigned int texelSize, std::mt19937& random, unsigned char* pData, size_t rowPitch,
+		unsigned int width, unsigned int height)
+	{
+		std::uniform_real_distribution<float> unit(-1.5f, 2.5f);
+		std::uniform_int_distribution<int> integer(-300, 70000);
+		std::vector<float> rgba((size_t)width * 4);
+
+		for (unsigned int row = 0; row < height; row++)
+		{
+			unsigned char* pRow = pData + row * rowPitch;
+			if (row % 2 == 0)
+			{
+				for (size_t i = 0; i < (size_t)width * texelSize; i++)
+					pRow[i] = (unsigned char)random();
+				continue;
+			}
+
+			for (size_t i = 0; i < rgba.size(); i++)
+				rgba[i] = row % 4 == 1 ? unit(random) : (float)integer(random);
+			ConvertFormatReference(RESOURCE_FORMAT_R32G32B32A32_FLOAT, rgba.data(), 0, format, pRow, 0, width, 1);
+		}
+	}
+
+	// Os texels diferentes só são aceitos se, decodificados, os canais diferentes forem NaN nos dois resultados.
+	bool DiffersOnlyInNaNPayload(RESOURCE_FORMAT format, const unsigned char* pA, const unsigned char* pB)
+	{
+		float a[4], b[4];
+		ConvertFormatReference(format, pA, 0, RESOURCE_FORMAT_R32G32B32A32_FLOAT, a, 0, 1, 1);
+		ConvertFormatReference(format, pB, 0, RESOURCE_FORMAT_R32G32B32A32_FLOAT, b, 0, 1, 1);
+
+		for (int c = 0; c < 4; c++)
+			if (memcmp(&a[c], &b[c], sizeof(float)) != 0 && !(std::isnan(a[c]) && std::isnan(b[c])))
+				return false;
+		return true;
+	}
+
+	// Converte a imagem pelos dois caminhos e compara os texels e os bytes de sobra das linhas (que não podem ser alterados).
+	unsigned int CompareConversion(RESOURCE_FORMAT srcFormat, RESOURCE_FORMAT destFormat, unsigned int destTexelSize,
+		const unsigned char* pSrc, size_t srcRowPitch, unsigned int width, unsigned int height)
+	{
+		size_t destRowPitch = (size_t)width * destTexelSize + ROW_PADDING;
+		std::vector<unsigned char> optimized(destRowPitch * height + POINTER_OFFSET, 0xCD);
+		std::vector<unsigned char> reference(optimized);
+		unsigned char* pOptimized = optimized.data() + POINTER_OFFSET;
+		unsigned char* pReference = reference.data() + POINTER_OFFSET;
+
+		CHECK(ConvertFormat(srcFormat, pSrc, srcRowPitch, destFormat, pOptimized, destRowPitch, width, height) == LEANDX12_OK);
+		CHECK(ConvertFormatReference(srcFormat, pSrc, srcRowPitch, destFormat, pReference, destRowPitch, width, height) == LEANDX12_OK);
+
+		unsigned int numMismatches = 0;
+		for (unsigned int row = 0; row < height; row++)
+		{
+			for (unsigned int x = 0; x < width; x++)
+			{
+				size_t offset = row * destRowPitch + (size_t)x * destTexelSize;
+				if (memcmp(pOptimized + offset, pReference + offset, destTexelSize) != 0 &&
+					!DiffersOnlyInNaNPayload(destFormat, pOptimized + offset, pReference + offset))
+				{
+					if (numMismatches == 0)
+						printf("Diferença %u -> %u no texel (%u, %u)\n", srcFormat, destFormat, x, row);
+					numMismatches++;
+				}
+			}
+
+			size_t padding = row * destRowPitch + (size_t)width * destTexelSize;
+			for (size_t i = 0; i < ROW_PADDING; i++)
+				if (pOptimized[padding + i] != 0xCD)
+					numMismatches++;
+		}
+
+		return numMismatches;
+	}
+}
+
+int main()
+{
+	std::vector<RESOURCE_FORMAT> formats = GetSupportedFormats();
+	CHECK(formats.size() > 40);
+	CHECK(IMAGE_HEIGHT * IMAGE_WIDTH > 2 * 16384);
+
+	std::mt19937 random(2024);
+	unsigned int numPairs = 0, numMismatchedPairs = 0;
+
+	for (size_t i = 0; i < formats.size(); i++)
+	{
+		RESOURCE_FORMAT srcFormat = formats[i];
+		unsigned int srcTexelSize = GetTexelSize(srcFormat);
+
+		size_t srcRowPitch = (size_t)IMAGE_WIDTH * srcTexelSize + ROW_PADDING;
+		std::vector<unsigned char> source(srcRowPitch * IMAGE_HEIGHT + POINTER_OFFSET);
+		unsigned char* pSrc = source.data() + POINTER_OFFSET;
+		FillSource(srcFormat, srcTexelSize, random, pSrc, srcRowPitch, IMAGE_WIDTH, IMAGE_HEIGHT);
+
+		for (size_t j = 0; j < formats.size(); j++)
+		{
+			RESOURCE_FORMAT destFormat = formats[j];
+			unsigned int destTexelSize = GetTexelSize(destFormat);
+
+			// Imagem completa (várias threads) e faixas estreitas, que só percorrem as caudas escalares dos caminhos vetorizados.
+			unsigned int numMismatches = CompareConversion(srcFormat, destFormat, destTexelSize, pSrc, srcRowPitch,
+				IMAGE_WIDTH, IMAGE_HEIGHT);
+			for (unsigned int width = 1; width <= 9; width++)
+				numMismatches += CompareConversion(srcFormat, destFormat, destTexelSize, pSrc, srcRowPitch, width, 4);
+
+			numPairs++;
+			if (numMismatches != 0)
+			{
+				printf("%u -> %u: %u texels diferentes\n", srcFormat, destFormat, numMismatches);
+				numMismatchedPairs++;
+			}
+		}
+	}
+
+	CHECK(numMismatchedPairs == 0);
+
+	// Funções escalares de meia precisão: ida e volta exata para todos os valores que não são NaN.
+	unsigned int numHalfMismatches = 0;
+	for (unsigned int value = 0; value < 0x10000; value++)
+	{
+		bool isNaN = (value & 0x7C00u) == 0x7C00u && (value & 0x03FFu) != 0;
+		if (!isNaN && FloatToHalf(HalfToFloat((unsigned short)value)) != value)
+			numHalfMismatches++;
+	}
+	CHECK(numHalfMismatches == 0);
+
+	printf("%u pares de formatos comparados, %u threads\n", numPairs, GetParallelThreadCount());
+	printf(numFailures == 0 ? "LeanDX12FormatTest: OK\n" : "LeanDX12FormatTest: %d falha(s)\n", numFailures);
+	return numFailures == 0 ? 0 : 1;
+}
@@ -0,0 +1,287 @@
+// Descrição: Teste do desenho indireto (LeanDX12Indirect.h) sobre o backend nulo: formato dos comandos gerados pelo construtor de
+// argumentos e por WriteIndirectCommand, e emissão por ExecuteIndirect (contador, limite de comandos e trocas de estado repetidas).
+//
+// Compilação (a partir da raiz do repositório, sem Windows, com o backend nulo no lugar de LeanDX12.lib):
+//	g++ -std=c++14 -I. -IExtensions -IBackends Tests/LeanDX12IndirectTest.cpp Extensions/LeanDX12Indirect.cpp
+//		Extensions/LeanDX12Format.cpp Extensions/LeanDX12Parallel.cpp Backends/LeanDX12Null.cpp -pthread
+
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+#include "LeanDX12Indirect.h"
+#include "LeanDX12NullInternal.h"
+
+#define NUM_COMMANDS 6
+#define NUM_CONSTANTS 3
+#define CONSTANTS_REGISTER 1
+
+namespace
+{
+	int numFailures = 0;
+
+	void Check(bool condition, const char* description, int line)
+	{
+		if (!condition)
+		{
+			printf("Falha (linha %d): %s\n", line, description);
+			numFailures++;
+		}
+	}
+
+#define CHECK(condition) Check((condition), #condition, __LINE__)
+
+	// Estado observado pelo backend nulo em cada desenho executado.
+	struct EXECUTED_DRAW
+	{
+		NULL_DRAW_DESC draw;
+		unsigned int descriptorTableOffset;
+		unsigned int constants[NUM_CONSTANTS];
+	};
+
+	void OnDraw(const NULL_DRAW_DESC* draw, void* pUserData)
+	{
+		std::vector<EXECUTED_DRAW>* draws = (std::vector<EXECUTED_DRAW>*)pUserData;
+
+		EXECUTED_DRAW executed;
+		executed.draw = *draw;
+		executed.descriptorTableOffset = GetNullDevice().descriptorTableBase;
+		memcpy(executed.constants, GetNullConstantRegister(CONSTANTS_REGISTER), sizeof(executed.constants));
+		draws->push_back(executed);
+	}
+
+	// Comandos de teste: o deslocamento muda a cada dois comandos e as constantes a cada três, para exercitar o descarte das trocas
+	// repetidas.
+	void GetCommand(unsigned int index, unsigned int* descriptorTableOffset, unsigned int constants[NUM_CONSTANTS],
+		DRAW_INDEXED_ARGUMENTS* arguments)
+	{
+		*descriptorTableOffset = 10 + index / 2;
+		for (unsigned int c = 0; c < NUM_CONSTANTS; c++)
+			constants[c] = 100 * (index / 3) + c;
+
+		arguments->indexCountPerInstance = 3 * (index + 1);
+		arguments->instanceCount = 1 + index % 2;
+		arguments->startIndexLocation = index;
+		arguments->baseVertexLocation = 1000 + index;
+		arguments->startInstanceLocation = 2 * index;
+	}
+
+	PipelineState* CreatePipeline()
+	{
+		BlendState* blendState;
+		RasterizerState* rasterizerState;
+		DepthStencilState* depthStencilState;
+		InitBlendState(&blendState);
+		InitRasterizerState(&rasterizerState);
+		InitDepthStencilState(&depthStencilState);
+
+		// Registrador b0 sem uso e NUM_CONSTANTS constantes em b1 (shaderRegister da assinatura de comando).
+		unsigned int num32bitValues[2] = { 1, NUM_CONSTANTS };
+		RootSignature* rootSignature;
+		CreateRootSignature(2, num32bitValues, 0, 0, &rootSignature);
+
+		ShaderBinary* vertexShader;
+		RegisterNullShader("IndirectVS.cso", NULL);
+		LoadShaderFromFile("IndirectVS.cso", &vertexShader);
+
+		GRAPHICS_PIPELINE_STATE_DESC desc;
+		memset(&desc, 0, sizeof(desc));
+		desc.rootSignature = rootSignature;
+		desc.vertexShader = vertexShader;
+		desc.primitiveTopologyType = PRIMITIVE_TOPOLOGY_TYPE_TRIANGLE;
+		desc.rasterState = rasterizerState;
+		desc.blendState = blendState;
+		desc.depthStencilState = depthStencilState;
+		desc.renderTargetFormat = RESOURCE_FORMAT_R8G8B8A8_UNORM;
+
+		PipelineState* pipelineState = NULL;
+		CHECK(CreateGraphicsPipelineState(desc, &pipelineState) == LEANDX12_OK);
+		return pipelineState;
+	}
+
+	// Emite os comandos em uma cena e retorna os desenhos e as chamadas de troca de estado observadas.
+	LeanDX12Result Execute(PipelineState* pipelineState, Texture* renderTarget, std::vector<unsigned int>& indices,
+		const INDIRECT_COMMAND_SIGNATURE_DESC* signature, unsigned int maxCommandCount, const void* pArgumentData,
+		const unsigned int* pCount, std::vector<EXECUTED_DRAW>* draws, unsigned int* numOffsetChanges, unsigned int* numConstantChanges)
+	{
+		VIEWPORT viewport = { 0, 0, 64, 64 };
+
+		BeginScene(pipelineState);
+		SetRenderTarget(renderTarget);
+		SetViewports(1, &viewport);
+		SetScissorRects(1, &viewport);
+		SetPrimitiveTopology(PRIMITIVE_TOPOLOGY_TRIANGLELIST);
+		SetIndexData(indices.data(), (unsigned int)(indices.size() * sizeof(unsigned int)));
+
+		draws->clear();
+		ClearNullRecordedCalls();
+		SetNullCallRecording(1);
+		LeanDX12Result result = ExecuteIndirect(signature, maxCommandCount, pArgumentData, pCount);
+		SetNullCallRecording(0);
+		EndScene();
+
+		unsigned int numCalls = 0;
+		GetNullRecordedCalls(&numCalls, NULL);
+		std::vector<NULL_CALL> calls(numCalls);
+		if (numCalls > 0)
+			GetNullRecordedCalls(&numCalls, calls.data());
+
+		*numOffsetChanges = *numConstantChanges = 0;
+		for (const NULL_CALL& call : calls)
+		{
+			CHECK(call.result == LEANDX12_OK);
+			if (call.type == NULL_CALL_MAP_DESCRIPTOR_TABLE_OFFSET_TO_BASE_REGISTER)
+				(*numOffsetChanges)++;
+			else if (call.type == NULL_CALL_SET_32BIT_CONSTANTS)
+				(*numConstantChanges)++;
+		}
+
+		return result;
+	}
+
+	// Verifica se os desenhos executados correspondem aos comandos 0 a numDraws - 1.
+	bool MatchesCommands(const std::vector<EXECUTED_DRAW>& draws, unsigned int numDraws)
+	{
+		if (draws.size() != numDraws)
+			return false;
+
+		for (unsigned int i = 0; i < numDraws; i++)
+		{
+			unsigned int descriptorTableOffset, constants[NUM_CONSTANTS];
+			DRAW_INDEXED_ARGUMENTS arguments;
+			GetCommand(i, &descriptorTableOffset, constants, &arguments);
+
+			const NULL_DRAW_DESC& draw = draws[i].draw;
+			if (!draw.indexed || draw.countPerInstance != arguments.indexCountPerInstance ||
+				draw.instanceCount != arguments.instanceCount || draw.startLocation != arguments.startIndexLocation ||
+				draw.baseVertexLocation != arguments.baseVertexLocation || draw.startInstanceLocation != arguments.startInstanceLocation ||
+				draws[i].descriptorTableOffset != descriptorTableOffset ||
+				memcmp(draws[i].constants, constants, sizeof(constants)) != 0)
+				return false;
+		}
+
+		return true;
+	}
+}
+
+int main()
+{
+	// Formato dos comandos: deslocamento, constantes e argumentos, nesta ordem, sem espaçamento entre os campos e entre os comandos.
+	INDIRECT_COMMAND_SIGNATURE_DESC signature = { 1, 1, CONSTANTS_REGISTER, NUM_CONSTANTS };
+	unsigned int stride = GetIndirectCommandStride(&signature);
+	CHECK(stride == sizeof(unsigned int) + NUM_CONSTANTS * sizeof(unsigned int) + sizeof(DRAW_INDEXED_ARGUMENTS));
+
+	INDIRECT_COMMAND_SIGNATURE_DESC drawSignature = { 0, 0, 0, 0 };
+	CHECK(GetIndirectCommandStride(&drawSignature) == sizeof(DRAW_ARGUMENTS));
+
+	INDIRECT_COMMAND_SIGNATURE_DESC invalidSignature = { 1, 0, 0, 65 };
+	IndirectArgumentBuilder* invalidBuilder = NULL;
+	CHECK(GetIndirectCommandStride(&invalidSignature) == 0);
+	CHECK(CreateIndirectArgumentBuilder(&invalidSignature, &invalidBuilder) == LEANDX12_ERROR_INVALID_CALL);
+
+	IndirectArgumentBuilder* builder = NULL;
+	CHECK(CreateIndirectArgumentBuilder(&signature, &builder) == LEANDX12_OK);
+	std::vector<unsigned char> written((size_t)NUM_COMMANDS * stride);
+
+	for (unsigned int i = 0; i < NUM_COMMANDS; i++)
+	{
+		unsigned int descriptorTableOffset, constants[NUM_CONSTANTS];
+		DRAW_INDEXED_ARGUMENTS arguments;
+		GetCommand(i, &descriptorTableOffset, constants, &arguments);
+
+		CHECK(AppendIndirectCommand(builder, descriptorTableOffset, constants, &arguments) == LEANDX12_OK);
+		CHECK(WriteIndirectCommand(&signature, written.data(), i, descriptorTableOffset, constants, &arguments) == LEANDX12_OK);
+	}
+	CHECK(AppendIndirectCommand(builder, 0, NULL, &written[0]) == LEANDX12_ERROR_INVALID_CALL);
+
+	const void* pArgumentData = NULL;
+	unsigned int commandCount = 0;
+	GetIndirectArguments(builder, &pArgumentData, &commandCount);
+	CHECK(commandCount == NUM_COMMANDS);
+	CHECK(memcmp(pArgumentData, written.data(), written.size()) == 0);
+
+	for (unsigned int i = 0; i < NUM_COMMANDS; i++)
+	{
+		unsigned int descriptorTableOffset, constants[NUM_CONSTANTS];
+		DRAW_INDEXED_ARGUMENTS arguments;
+		GetCommand(i, &descriptorTableOffset, constants, &arguments);
+
+		const unsigned char* pCommand = (const unsigned char*)pArgumentData + (size_t)i * stride;
+		CHECK(memcmp(pCommand, &descriptorTableOffset, sizeof(unsigned int)) == 0);
+		CHECK(memcmp(pCommand + sizeof(unsigned int), constants, sizeof(constants)) == 0);
+		CHECK(memcmp(pCommand + sizeof(unsigned int) + sizeof(constants), &arguments, sizeof(arguments)) == 0);
+	}
+
+	// Emissão pelo backend nulo.
+	DisplayAdapter* adapter = NULL;
+	CHECK(GetHighestPerformanceAdapter("11.0", &adapter) == LEANDX12_OK);
+	CHECK(CreateDevice(adapter, "11.0") == LEANDX12_OK);
+
+	PipelineState* pipelineState = CreatePipeline();
+	float clearColor[4] = { 0, 0, 0, 1 };
+	Texture* renderTarget = NULL;
+	CHECK(CreateRenderTarget(64, 64, RESOURCE_FORMAT_R8G8B8A8_UNORM, clearColor, 1, 0, &renderTarget) == LEANDX12_OK);
+	std::vector<unsigned int> indices(64, 0);
+
+	std::vector<EXECUTED_DRAW> draws;
+	NULL_BACKEND_HOOKS hooks = { OnDraw, NULL, &draws };
+	SetNullBackendHooks(&hooks);
+	unsigned int numOffsetChanges, numConstantChanges;
+
+	// Sem contador: todos os maxCommandCount comandos, com um deslocamento a cada dois comandos e constantes a cada três.
+	CHECK(Execute(pipelineState, renderTarget, indices, &signature, NUM_COMMANDS, pArgumentData, NULL, &draws, &numOffsetChanges,
+		&numConstantChanges) == LEANDX12_OK);
+	CHECK(MatchesCommands(draws, NUM_COMMANDS));
+	CHECK(numOffsetChanges == NUM_COMMANDS / 2);
+	CHECK(numConstantChanges == NUM_COMMANDS / 3);
+
+	// Contador menor que o limite: apenas os *pCount primeiros comandos.
+	unsigned int count = 2;
+	CHECK(Execute(pipelineState, renderTarget, indices, &signature, NUM_COMMANDS, pArgumentData, &count, &draws, &numOffsetChanges,
+		&numConstantChanges) == LEANDX12_OK);
+	CHECK(MatchesCommands(draws, 2));
+
+	count = 0;
+	CHECK(Execute(pipelineState, renderTarget, indices, &signature, NUM_COMMANDS, pArgumentData, &count, &draws, &numOffsetChanges,
+		&numConstantChanges) == LEANDX12_OK);
+	CHECK(draws.empty() && numOffsetChanges == 0 && numConstantChanges == 0);
+
+	// Contador maior que o limite (como um contador escrito pela GPU): limitado a maxCommandCount, e os comandos seguintes são
+	// descartados sem serem lidos (com 1000, o vetor de 4 comandos seria lido além do fim, o que o sanitizador de endereços detecta).
+	count = 5;
+	CHECK(Execute(pipelineState, renderTarget, indices, &signature, 4, pArgumentData, &count, &draws, &numOffsetChanges,
+		&numConstantChanges) == LEANDX12_OK);
+	CHECK(MatchesCommands(draws, 4));
+
+	count = 1000;
+	std::vector<unsigned char> firstCommands((const unsigned char*)pArgumentData, (const unsigned char*)pArgumentData + 4 * stride);
+	CHECK(Execute(pipelineState, renderTarget, indices, &signature, 4, firstCommands.data(), &count, &draws, &numOffsetChanges,
+		&numConstantChanges) == LEANDX12_OK);
+	CHECK(MatchesCommands(draws, 4));
+
+	// Comandos sem instâncias ou sem índices não são emitidos.
+	unsigned int emptyOffset = 0, emptyConstants[NUM_CONSTANTS] = {};
+	DRAW_INDEXED_ARGUMENTS emptyArguments = { 0, 5, 0, 0, 0 };
+	std::vector<unsigned char> emptyCommand(stride);
+	CHECK(WriteIndirectCommand(&signature, emptyCommand.data(), 0, emptyOffset, emptyConstants, &emptyArguments) == LEANDX12_OK);
+	CHECK(Execute(pipelineState, renderTarget, indices, &signature, 1, emptyCommand.data(), NULL, &draws, &numOffsetChanges,
+		&numConstantChanges) == LEANDX12_OK);
+	CHECK(draws.empty());
+
+	// Parâmetros inválidos.
+	CHECK(ExecuteIndirect(&signature, 1, NULL) == LEANDX12_ERROR_INVALID_CALL);
+	CHECK(ExecuteIndirect(&invalidSignature, 1, pArgumentData) == LEANDX12_ERROR_INVALID_CALL);
+	CHECK(ExecuteIndirect(&signature, 0, NULL) == LEANDX12_OK);
+
+	NULL_BACKEND_STATS stats;
+	GetNullBackendStats(&stats);
+	CHECK(stats.numValidationErrors == 0);
+
+	SetNullBackendHooks(NULL);
+	DeleteIndirectArgumentBuilder(builder);
+	DeleteRenderTarget(renderTarget);
+	ReleaseDevice();
+
+	printf(numFailures == 0 ? "LeanDX12IndirectTest: OK\n" : "LeanDX12IndirectTest: %d falha(s)\n", numFailures);
+	return numFailures == 0 ? 0 : 1;
+}
@@ -0,0 +1,243 @@
+// Descrição: Teste do descarte por oclusão (LeanDX12Occlusion.h) em uma cena sintética: uma parede e um piso oclusores (o piso cruza o
+// plano próximo), caixas em posições conhecidas e caixas aleatórias comparadas com a visibilidade analítica da parede.
+//
+// Compilação (a partir da raiz do repositório):
+//	g++ -std=c++14 -O2 -I. -IExtensions Tests/LeanDX12OcclusionTest.cpp Extensions/LeanDX12Occlusion.cpp Extensions/LeanDX12Parallel.cpp
+//		-pthread
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include "LeanDX12Occlusion.h"
+
+#define BUFFER_WIDTH 320
+#define BUFFER_HEIGHT 180
+#define NEAR_PLANE 0.1f
+#define FAR_PLANE 1000.0f
+// Parede no plano z = WALL_DISTANCE, com |x|, |y| <= WALL_HALF_SIZE, e piso no plano y = FLOOR_HEIGHT.
+#define WALL_DISTANCE 10.0f
+#define WALL_HALF_SIZE 5.0f
+#define FLOOR_HEIGHT -2.0f
+#define NUM_RANDOM_BOXES 20000
+
+namespace
+{
+	int numFailures = 0;
+
+	void Check(bool condition, const char* description, int line)
+	{
+		if (!condition)
+		{
+			printf("Falha (linha %d): %s\n", line, description);
+			numFailures++;
+		}
+	}
+
+#define CHECK(condition) Check((condition), #condition, __LINE__)
+
+	typedef std::chrono::steady_clock Clock;
+
+	float ElapsedMilliseconds(Clock::time_point start)
+	{
+		return std::chrono::duration<float, std::milli>(Clock::now() - start).count();
+	}
+
+	// Câmera na origem olhando para +z (matriz de visão identidade) com a projeção de XMMatrixPerspectiveFovLH (vetores linha).
+	float viewProjection[4][4] = {};
+	float xScale, yScale;
+
+	void BuildViewProjection()
+	{
+		yScale = 1.0f / tanf(0.5f * 1.0471976f);
+		xScale = yScale * BUFFER_HEIGHT / BUFFER_WIDTH;
+		viewProjection[0][0] = xScale;
+		viewProjection[1][1] = yScale;
+		viewProjection[2][2] = FAR_PLANE / (FAR_PLANE - NEAR_PLANE);
+		viewProjection[2][3] = 1.0f;
+		viewProjection[3][2] = -NEAR_PLANE * FAR_PLANE / (FAR_PLANE - NEAR_PLANE);
+	}
+
+	void AddQuad(OcclusionBuffer* occlusionBuffer, const float corners[4][3])
+	{
+		const unsigned int indices[6] = { 0, 1, 2, 0, 2, 3 };
+		CHECK(AddOccluder(occlusionBuffer, viewProjection, 4, corners, 0, 6, indices) == LEANDX12_OK);
+	}
+
+	bool IsVisible(OcclusionBuffer* occlusionBuffer, float minX, float minY, float minZ, float maxX, float maxY, float maxZ)
+	{
+		const float aabbMin[3] = { minX, minY, minZ };
+		const float aabbMax[3] = { maxX, maxY, maxZ };
+		return TestOcclusionBox(occlusionBuffer, viewProjection, aabbMin, aabbMax) != 0;
+	}
+
+	// Um ponto atrás da parede está escondido se a sua projeção cair dentro da projeção da parede, ampliada por margin (em NDC).
+	bool IsHiddenByWall(float x, float y, float z, float margin)
+	{
+		if (z <= WALL_DISTANCE)
+			return false;
+
+		float wallX = WALL_HALF_SIZE / WALL_DISTANCE * xScale + margin * 2.0f / BUFFER_WIDTH;
+		float wallY = WALL_HALF_SIZE / WALL_DISTANCE * yScale + margin * 2.0f / BUFFER_HEIGHT;
+		return fabsf(x / z * xScale) <= wallX && fabsf(y / z * yScale) <= wallY;
+	}
+
+	// Um ponto à frente da câmera está dentro da tela, reduzida por margin pixels, se a sua projeção estiver dentro dela.
+	bool IsOnScreen(float x, float y, float z, float margin)
+	{
+		float screenX = 1.0f - margin * 2.0f / BUFFER_WIDTH;
+		float screenY = 1.0f - margin * 2.0f / BUFFER_HEIGHT;
+		return fabsf(x / z * xScale) <= screenX && fabsf(y / z * yScale) <= screenY;
+	}
+
+	void TestKnownBoxes(OcclusionBuffer* occlusionBuffer)
+	{
+		// Caixa atrás do centro da parede: oculta.
+		CHECK(!IsVisible(occlusionBuffer, -1.0f, -1.0f, 20.0f, 1.0f, 1.0f, 22.0f));
+		// Caixa na frente da parede: visível.
+		CHECK(IsVisible(occlusionBuffer, -1.0f, -1.0f, 5.0f, 1.0f, 1.0f, 6.0f));
+		// Caixa atrás da parede, mas parcialmente fora do seu contorno: visível.
+		CHECK(IsVisible(occlusionBuffer, 8.0f, -1.0f, 20.0f, 14.0f, 1.0f, 22.0f));
+		// Caixa que atravessa a parede: visível.
+		CHECK(IsVisible(occlusionBuffer, -1.0f, -1.0f, 8.0f, 1.0f, 1.0f, 12.0f));
+		// Caixa sob o piso, vista através dele: oculta (o piso recortado no plano próximo cobre a parte inferior da tela).
+		CHECK(!IsVisible(occlusionBuffer, 10.0f, -10.0f, 20.0f, 12.0f, -5.0f, 22.0f));
+		// Caixa sobre o piso, fora da parede: visível.
+		CHECK(IsVisible(occlusionBuffer, 10.0f, -1.0f, 20.0f, 12.0f, 1.0f, 22.0f));
+		// Caixas que cruzam o plano próximo são sempre consideradas visíveis, mesmo que a parte à frente da câmera esteja oculta.
+		CHECK(IsVisible(occlusionBuffer, -1.0f, -1.0f, -50.0f, 1.0f, 1.0f, 30.0f));
+		CHECK(IsVisible(occlusionBuffer, 10.0f, -10.0f, 0.0f, 12.0f, -5.0f, 22.0f));
+		CHECK(IsVisible(occlusionBuffer, -1.0f, -1.0f, 0.05f, 1.0f, 1.0f, 0.2f));
+		// Caixa fora da tela: não visível.
+		CHECK(!IsVisible(occlusionBuffer, 100.0f, -1.0f, 20.0f, 101.0f, 1.0f, 22.0f));
+	}
+
+	// Caixas aleatórias atrás da parede e acima do piso: uma caixa oculta não pode ter nenhum vértice dentro da tela e fora da parede
+	// (com a margem de um pixel da resolução do buffer), e uma caixa com todos os vértices dentro da parede reduzida em dois pixels deve
+	// ser oculta. Como as caixas são pequenas em relação à parede e a projeção de cada caixa é convexa, basta testar os vértices.
+	void TestRandomBoxes(OcclusionBuffer* occlusionBuffer)
+	{
+		std::mt19937 random(1234);
+		std::uniform_real_distribution<float> centerX(-8.0f, 8.0f), centerY(-1.5f, 8.0f), centerZ(11.0f, 60.0f), size(0.1f, 3.0f);
+		std::uniform_real_distribution<float> nearZ(-5.0f, NEAR_PLANE);
+
+		std::vector<CULLING_BOUNDS> bounds(NUM_RANDOM_BOXES);
+		std::vector<unsigned int> objectIndices(NUM_RANDOM_BOXES), visibleObjects(NUM_RANDOM_BOXES);
+		for (unsigned int i = 0; i < NUM_RANDOM_BOXES; i++)
+		{
+			float x = centerX(random), y = centerY(random), z = centerZ(random), halfSize = 0.5f * size(random);
+			bounds[i].aabbMin[0] = x - halfSize;
+			bounds[i].aabbMin[1] = std::max(y - halfSize, FLOOR_HEIGHT + 0.01f);
+			bounds[i].aabbMin[2] = std::max(z - halfSize, WALL_DISTANCE + 0.01f);
+			bounds[i].aabbMax[0] = x + halfSize;
+			bounds[i].aabbMax[1] = y + halfSize;
+			bounds[i].aabbMax[2] = z + halfSize;
+			// Um a cada oito objetos cruza o plano próximo.
+			if (i % 8 == 7)
+				bounds[i].aabbMin[2] = nearZ(random);
+			objectIndices[i] = i;
+		}
+
+		Clock::time_point start = Clock::now();
+		unsigned int numVisible;
+		CHECK(CullOccludedObjects(occlusionBuffer, viewProjection, bounds.data(), NUM_RANDOM_BOXES, objectIndices.data(),
+			visibleObjects.data(), &numVisible) == LEANDX12_OK);
+		float cullTime = ElapsedMilliseconds(start);
+
+		std::vector<bool> visible(NUM_RANDOM_BOXES, false);
+		for (unsigned int i = 0; i < numVisible; i++)
+			visible[visibleObjects[i]] = true;
+
+		unsigned int numFalseOccluded = 0, numMissedOccluded = 0, numNearVisible = 0, numHidden = 0;
+		for (unsigned int i = 0; i < NUM_RANDOM_BOXES; i++)
+		{
+			const CULLING_BOUNDS& box = bounds[i];
+			bool outsideExpanded = false, insideReduced = true;
+			for (int corner = 0; corner < 8; corner++)
+			{
+				float x = (corner & 1) != 0 ? box.aabbMax[0] : box.aabbMin[0];
+				float y = (corner & 2) != 0 ? box.aabbMax[1] : box.aabbMin[1];
+				float z = (corner & 4) != 0 ? box.aabbMax[2] : box.aabbMin[2];
+				outsideExpanded = outsideExpanded || (IsOnScreen(x, y, z, 1.0f) && !IsHiddenByWall(x, y, z, 1.0f));
+				insideReduced = insideReduced && IsHiddenByWall(x, y, z, -2.0f);
+			}
+
+			if (box.aabbMin[2] < NEAR_PLANE)
+			{
+				numNearVisible += visible[i] ? 1 : 0;
+				continue;
+			}
+
+			numHidden += insideReduced ? 1 : 0;
+			if (!visible[i] && outsideExpanded)
+				numFalseOccluded++;
+			if (visible[i] && insideReduced)
+				numMissedOccluded++;
+		}
+
+		CHECK(numFalseOccluded == 0);
+		CHECK(numMissedOccluded == 0);
+		CHECK(numNearVisible == NUM_RANDOM_BOXES / 8);
+		CHECK(numHidden > 0);
+
+		OCCLUSION_STATS stats;
+		GetOcclusionStats(occlusionBuffer, &stats);
+		CHECK(stats.numObjectsTested == NUM_RANDOM_BOXES);
+		CHECK(stats.numObjectsOccluded == NUM_RANDOM_BOXES - numVisible);
+
+		printf("CullOccludedObjects: %u caixas em %.3f ms (%u ocultas, %u testadas por pixel)\n", NUM_RANDOM_BOXES, cullTime,
+			stats.numObjectsOccluded, stats.numPixelTests);
+	}
+}
+
+int main()
+{
+	BuildViewProjection();
+
+	OcclusionBuffer* occlusionBuffer;
+	CHECK(CreateOcclusionBuffer(BUFFER_WIDTH, BUFFER_HEIGHT, &occlusionBuffer) == LEANDX12_OK);
+
+	const float wall[4][3] =
+	{
+		{ -WALL_HALF_SIZE, WALL_HALF_SIZE, WALL_DISTANCE }, { WALL_HALF_SIZE, WALL_HALF_SIZE, WALL_DISTANCE },
+		{ WALL_HALF_SIZE, -WALL_HALF_SIZE, WALL_DISTANCE }, { -WALL_HALF_SIZE, -WALL_HALF_SIZE, WALL_DISTANCE }
+	};
+	// O piso começa atrás da câmera e é recortado no plano próximo.
+	const float floor[4][3] =
+	{
+		{ -100.0f, FLOOR_HEIGHT, -10.0f }, { 100.0f, FLOOR_HEIGHT, -10.0f },
+		{ 100.0f, FLOOR_HEIGHT, 200.0f }, { -100.0f, FLOOR_HEIGHT, 200.0f }
+	};
+
+	Clock::time_point start = Clock::now();
+	ClearOcclusionBuffer(occlusionBuffer);
+	AddQuad(occlusionBuffer, wall);
+	AddQuad(occlusionBuffer, floor);
+	CHECK(RasterizeOccluders(occlusionBuffer) == LEANDX12_OK);
+	float rasterizeTime = ElapsedMilliseconds(start);
+
+	OCCLUSION_STATS stats;
+	GetOcclusionStats(occlusionBuffer, &stats);
+	CHECK(stats.numOccluders == 2);
+
+	// A profundidade do centro da tela é a da parede, e a da última linha é a do piso (mais próximo que a parede).
+	std::vector<float> depth(BUFFER_WIDTH * BUFFER_HEIGHT);
+	CHECK(GetOcclusionDepth(occlusionBuffer, depth.data()) == LEANDX12_OK);
+	float wallDepth = viewProjection[2][2] + viewProjection[3][2] / WALL_DISTANCE;
+	CHECK(fabsf(depth[(BUFFER_HEIGHT / 2) * BUFFER_WIDTH + BUFFER_WIDTH / 2] - wallDepth) < 1e-4f);
+	CHECK(depth[(BUFFER_HEIGHT - 1) * BUFFER_WIDTH] < wallDepth);
+	CHECK(depth[0] == 1.0f);
+
+	printf("RasterizeOccluders: %u triângulos em %.3f ms\n", stats.numOccluderTriangles, rasterizeTime);
+
+	TestKnownBoxes(occlusionBuffer);
+	TestRandomBoxes(occlusionBuffer);
+
+	DeleteOcclusionBuffer(occlusionBuffer);
+
+	printf(numFailures == 0 ? "LeanDX12OcclusionTest: OK\n" : "LeanDX12OcclusionTest: %d falha(s)\n", numFailures);
+	return numFailures == 0 ? 0 : 1;
+}
@@ -0,0 +1,258 @@
+// Descrição: Teste do gerenciador de streaming de texturas (LeanDX12Streaming.h) sobre um dispositivo simulado: orçamento de memória,
+// descarte LRU, limites de envio por quadro e contagem de texturas pendentes.
+//
+// Compilação (a partir da raiz do repositório, sem Windows, com o backend nulo no lugar de LeanDX12.lib):
+//	g++ -std=c++14 -I. -IExtensions -IBackends Tests/LeanDX12StreamingTest.cpp Extensions/LeanDX12Streaming.cpp
+//		Extensions/LeanDX12Frame.cpp Extensions/LeanDX12Format.cpp Extensions/LeanDX12Parallel.cpp Backends/LeanDX12Null.cpp -pthread
+
+#include <cstdio>
+#include <cstdint>
+#include <map>
+
+#include "LeanDX12Streaming.h"
+
+#define TEXTURE_SIZE 256
+#define MIP_LEVELS 9
+#define TEXEL_SIZE 4
+// Bytes da cauda de mipmaps (níveis 2 a 8, até 64 x 64 texels) e dos níveis 0 e 1 de uma textura de 256 x 256 texels.
+#define TAIL_BYTES (TEXEL_SIZE * (64 * 64 + 32 * 32 + 16 * 16 + 8 * 8 + 4 * 4 + 2 * 2 + 1))
+#define DETAIL_BYTES (TEXEL_SIZE * (256 * 256 + 128 * 128))
+
+namespace
+{
+	int numFailures = 0;
+
+	void Check(bool condition, const char* description, int line)
+	{
+		if (!condition)
+		{
+			printf("Falha (linha %d): %s\n", line, description);
+			numFailures++;
+		}
+	}
+
+#define CHECK(condition) Check((condition), #condition, __LINE__)
+
+	// Dispositivo simulado: registra os níveis enviados e o nível ativo de cada textura.
+	struct SimulatedDevice
+	{
+		uintptr_t nextHandle = 1;
+		std::map<Texture*, unsigned short> activeMipLevel;
+		std::map<Texture*, unsigned int> uploadedLevels;		// Bits dos níveis enviados.
+		unsigned int numUploads = 0;
+		unsigned long long uploadedBytes = 0;
+		unsigned long long lastUploadSize = 0;
+		unsigned int numLiveUploadBuffers = 0;
+	} simulated;
+
+	LeanDX12Result CreateTextureSimulated(unsigned int, unsigned int, unsigned int, unsigned short, RESOURCE_FORMAT, Texture** texture,
+		unsigned int)
+	{
+		*texture = (Texture*)(simulated.nextHandle++);
+		simulated.activeMipLevel[*texture] = 0;
+		simulated.uploadedLevels[*texture] = 0;
+		return LEANDX12_OK;
+	}
+
+	LeanDX12Result DeleteTextureSimulated(Texture* texture)
+	{
+		simulated.activeMipLevel.erase(texture);
+		simulated.uploadedLevels.erase(texture);
+		return LEANDX12_OK;
+	}
+
+	LeanDX12Result CreateUploadBufferSimulated(unsigned long long, Buffer** buffer)
+	{
+		*buffer = (Buffer*)(simulated.nextHandle++);
+		simulated.numLiveUploadBuffers++;
+		return LEANDX12_OK;
+	}
+
+	LeanDX12Result DeleteUploadBufferSimulated(Buffer*)
+	{
+		simulated.numLiveUploadBuffers--;
+		return LEANDX12_OK;
+	}
+
+	LeanDX12Result UploadDataSimulated(Buffer*, unsigned long long*, unsigned int texelSize, unsigned int width, unsigned int height,
+		unsigned int depth, void*)
+	{
+		simulated.lastUploadSize = (unsigned long long)texelSize * width * height * depth;
+		return LEANDX12_OK;
+	}
+
+	LeanDX12Result SetPrivateDataAsyncSimulated(Texture* texture, unsigned short mipLevel, unsigned long long* sizeInBytes,
+		Buffer* uploadBuffer)
+	{
+		if (uploadBuffer == NULL)
+		{
+			*sizeInBytes = (unsigned long long)TEXEL_SIZE * (TEXTURE_SIZE >> mipLevel) * (TEXTURE_SIZE >> mipLevel);
+			return LEANDX12_INFO_REQUIRED_BUFFER_SIZE;
+		}
+
+		simulated.uploadedLevels[texture] |= 1u << mipLevel;
+		simulated.numUploads++;
+		simulated.uploadedBytes += simulated.lastUploadSize;
+		return LEANDX12_OK;
+	}
+
+	LeanDX12Result SetActiveMipLevelSimulated(Texture* texture, unsigned short mipLevel)
+	{
+		simulated.activeMipLevel[texture] = mipLevel;
+		return LEANDX12_OK;
+	}
+
+	unsigned int TexelSizeSimulated(RESOURCE_FORMAT)
+	{
+		return TEXEL_SIZE;
+	}
+
+	LeanDX12Result LoadMipSimulated(void*, unsigned short, void*, unsigned long long)
+	{
+		return LEANDX12_OK;
+	}
+
+	const STREAMING_DEVICE simulatedDevice =
+	{
+		CreateTextureSimulated, DeleteTextureSimulated, CreateUploadBufferSimulated, DeleteUploadBufferSimulated, UploadDataSimulated,
+		SetPrivateDataAsyncSimulated, SetActiveMipLevelSimulated, TexelSizeSimulated
+	};
+
+	StreamedTexture* CreateTestTexture(TextureStreamer* streamer)
+	{
+		StreamedTexture* texture = NULL;
+		CHECK(CreateStreamedTexture(streamer, TEXTURE_SIZE, TEXTURE_SIZE, 1, MIP_LEVELS, RESOURCE_FORMAT_R8G8B8A8_UNORM, 0,
+			LoadMipSimulated, NULL, &texture) == LEANDX12_OK);
+		return texture;
+	}
+
+	unsigned short ResidentMipLevel(StreamedTexture* texture)
+	{
+		STREAMED_TEXTURE_STATS stats;
+		GetStreamedTextureStats(texture, &stats);
+		return stats.residentMipLevel;
+	}
+
+	// Orçamento para as caudas de quatro texturas e os níveis completos de duas.
+	void TestBudgetAndEviction()
+	{
+		TEXTURE_STREAMER_DESC desc = {};
+		desc.memoryBudget = 4 * TAIL_BYTES + 2 * DETAIL_BYTES;
+
+		TextureStreamer* streamer;
+		CHECK(CreateTextureStreamer(&desc, &simulatedDevice, &streamer) == LEANDX12_OK);
+
+		StreamedTexture* textures[4];
+		for (int i = 0; i < 4; i++)
+			textures[i] = CreateTestTexture(streamer);
+
+		TEXTURE_STREAMER_STATS stats;
+		GetTextureStreamerStats(streamer, &stats);
+		CHECK(stats.residentBytes == 4 * TAIL_BYTES);
+		CHECK(stats.numPendingTextures == 0);
+		CHECK(ResidentMipLevel(textures[0]) == 2);
+		CHECK(simulated.activeMipLevel[GetStreamedTextureResource(textures[0])] == 2);
+
+		// Quadro 1: as texturas 0 e 1 cabem no orçamento sem descartes.
+		RequestMipLevel(textures[0], 0);
+		RequestMipLevel(textures[1], 0);
+		CHECK(UpdateTextureStreamer(streamer) == LEANDX12_OK);
+		GetTextureStreamerStats(streamer, &stats);
+		CHECK(stats.numUploadsLastUpdate == 4);
+		CHECK(stats.uploadedBytesLastUpdate == 2 * DETAIL_BYTES);
+		CHECK(stats.numEvictionsLastUpdate == 0);
+		CHECK(stats.residentBytes == desc.memoryBudget);
+		CHECK(stats.numPendingTextures == 0);
+		CHECK(ResidentMipLevel(textures[0]) == 0 && ResidentMipLevel(textures[1]) == 0);
+
+		// Quadro 2: a textura 0 continua em uso; os níveis da textura 1 (a menos recente) são descartados para a textura 2.
+		RequestMipLevel(textures[0], 0);
+		RequestMipLevel(textures[2], 0);
+		CHECK(UpdateTextureStreamer(streamer) == LEANDX12_OK);
+		GetTextureStreamerStats(streamer, &stats);
+		CHECK(stats.numEvictionsLastUpdate == 2);
+		CHECK(stats.residentBytes <= desc.memoryBudget);
+		CHECK(ResidentMipLevel(textures[0]) == 0);
+		CHECK(ResidentMipLevel(textures[1]) == 2);
+		CHECK(ResidentMipLevel(textures[2]) == 0);
+		CHECK(simulated.activeMipLevel[GetStreamedTextureResource(textures[1])] == 2);
+		// A textura 1 não foi solicitada neste quadro: não está pendente, embora o seu último nível solicitado não esteja residente.
+		CHECK(stats.numPendingTextures == 0);
+
+		// Quadro 3: as texturas 0 e 2 estão em uso e ocupam o orçamento; a textura 3 não pode ser carregada.
+		RequestMipLevel(textures[0], 0);
+		RequestMipLevel(textures[2], 0);
+		RequestMipLevel(textures[3], 0, 0.5f);
+		CHECK(UpdateTextureStreamer(streamer) == LEANDX12_OK);
+		GetTextureStreamerStats(streamer, &stats);
+		CHECK(stats.numUploadsLastUpdate == 0);
+		CHECK(stats.numEvictionsLastUpdate == 0);
+		CHECK(stats.numPendingTextures == 1);
+		CHECK(ResidentMipLevel(textures[3]) == 2);
+
+		// Quadro 4 sem solicitações: nenhuma textura pendente.
+		CHECK(UpdateTextureStreamer(streamer) == LEANDX12_OK);
+		GetTextureStreamerStats(streamer, &stats);
+		CHECK(stats.numPendingTextures == 0);
+
+		CHECK(simulated.numLiveUploadBuffers == 0);
+		DeleteTextureStreamer(streamer);
+		CHECK(simulated.activeMipLevel.empty());
+	}
+
+	void TestUploadLimits()
+	{
+		TEXTURE_STREAMER_DESC desc = {};
+		desc.memoryBudget = 1ull << 30;
+		desc.maxUploadsPerUpdate = 1;
+
+		TextureStreamer* streamer;
+		CHECK(CreateTextureStreamer(&desc, &simulatedDevice, &streamer) == LEANDX12_OK);
+		StreamedTexture* texture = CreateTestTexture(streamer);
+		unsigned int firstUpload = simulated.numUploads;
+
+		// Um nível por quadro, do menos detalhado para o mais detalhado.
+		RequestMipLevel(texture, 0);
+		CHECK(UpdateTextureStreamer(streamer) == LEANDX12_OK);
+		TEXTURE_STREAMER_STATS stats;
+		GetTextureStreamerStats(streamer, &stats);
+		CHECK(stats.numUploadsLastUpdate == 1);
+		CHECK(ResidentMipLevel(texture) == 1);
+		CHECK(stats.numPendingTextures == 1);
+
+		RequestMipLevel(texture, 0);
+		CHECK(UpdateTextureStreamer(streamer) == LEANDX12_OK);
+		GetTextureStreamerStats(streamer, &stats);
+		CHECK(ResidentMipLevel(texture) == 0);
+		CHECK(stats.numPendingTextures == 0);
+		CHECK(simulated.numUploads - firstUpload == 2);
+		CHECK((simulated.uploadedLevels[GetStreamedTextureResource(texture)] & 3u) == 3u);
+
+		DeleteTextureStreamer(streamer);
+
+		// Limite de bytes: o primeiro envio do quadro é sempre aceito; o nível 0 (256 KB) fica para o quadro seguinte.
+		desc.maxUploadsPerUpdate = 0;
+		desc.maxUploadBytesPerUpdate = TEXEL_SIZE * 128 * 128;
+		CHECK(CreateTextureStreamer(&desc, &simulatedDevice, &streamer) == LEANDX12_OK);
+		texture = CreateTestTexture(streamer);
+		RequestMipLevel(texture, 0);
+		CHECK(UpdateTextureStreamer(streamer) == LEANDX12_OK);
+		GetTextureStreamerStats(streamer, &stats);
+		CHECK(stats.uploadedBytesLastUpdate == TEXEL_SIZE * 128 * 128);
+		CHECK(ResidentMipLevel(texture) == 1);
+
+		RequestMipLevel(texture, 0);
+		CHECK(UpdateTextureStreamer(streamer) == LEANDX12_OK);
+		CHECK(ResidentMipLevel(texture) == 0);
+		DeleteTextureStreamer(streamer);
+	}
+}
+
+int main()
+{
+	TestBudgetAndEviction();
+	TestUploadLimits();
+
+	printf(numFailures == 0 ? "LeanDX12StreamingTest: OK\n" : "LeanDX12StreamingTest: %d falha(s)\n", numFailures);
+	return numFailures == 0 ? 0 : 1;
+}